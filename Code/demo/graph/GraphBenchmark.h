@@ -0,0 +1,1204 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines benchmarks of the graph models (construction, lookups, traversals)
+*/
+
+#ifndef GRAPHBENCHMARK_H
+#define GRAPHBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include "graph/DGraphModel.h"
+#include "graph/UGraphModel.h"
+#include "graph/TopoSorter.h"
+#include "graph/ParallelBFS.h"
+#include "graph/DynamicTopoOrder.h"
+#include "graph/SCCFinder.h"
+#include "graph/GraphAnalytics.h"
+#include "graph/GraphIO.h"
+#include "graph/VertexIds.h"
+#include "util/DynamicBitset.h"
+#include "heap/Heap.h"
+#include <cmath>
+#include <fstream>
+#include <cstdio>
+using namespace std;
+
+bool intVertexEQ(int& lhs, int& rhs){
+    return lhs == rhs;
+}
+string intVertex2str(int& vertex){
+    return to_string(vertex);
+}
+int intVertexHash(int& vertex, int capacity){
+    return (int)((unsigned int)vertex % (unsigned int)capacity);
+}
+
+/*
+! randomEdgeList(nvertices, nedges, seed): nedges random (from, to) pairs over 0..nvertices-1
+*/
+vector<pair<int, int>> randomEdgeList(int nvertices, long long nedges, unsigned int seed=2024){
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> pick(0, nvertices - 1);
+    vector<pair<int, int>> edges(nedges);
+    for(long long idx=0; idx < nedges; idx++) edges[idx] = make_pair(pick(engine), pick(engine));
+    return edges;
+}
+
+/*
+! graphBuildRun(nvertices, edges, vertexHash, times)
+? Functionality:
+    * Builds a DGraphModel<int> (add every vertex, connect every edge), then asks
+      inDegree of every vertex, then destroys the graph.
+    * times[0..2]: build, lookup and teardown time in ms.
+? Return:
+    * long long: sum of the in-degrees (= number of distinct edges), as a checksum
+*/
+long long graphBuildRun(int nvertices, vector<pair<int, int>>& edges, int (*vertexHash)(int&, int), double* times){
+    auto start = chrono::steady_clock::now();
+    DGraphModel<int>* graph = new DGraphModel<int>(&intVertexEQ, &intVertex2str, vertexHash);
+    for(int vertex=0; vertex < nvertices; vertex++) graph->add(vertex);
+    for(auto& edge: edges) graph->connect(edge.first, edge.second);
+    auto built = chrono::steady_clock::now();
+
+    long long checksum = 0;
+    for(int vertex=0; vertex < nvertices; vertex++) checksum += graph->inDegree(vertex);
+    auto looked = chrono::steady_clock::now();
+
+    delete graph;
+    auto stop = chrono::steady_clock::now();
+    times[0] = chrono::duration<double, std::milli>(built - start).count();
+    times[1] = chrono::duration<double, std::milli>(looked - built).count();
+    times[2] = chrono::duration<double, std::milli>(stop - looked).count();
+    return checksum;
+}
+
+/*
+! graphConstructionBenchmark(avgDegree, linearLimit)
+? Functionality:
+    * Graph construction with and without the vertex -> node hash index, at 10^4 .. 10^6
+      vertices and avgDegree edges per vertex.
+    * Without the index, every lookup scans the vertex list (construction is O(E*V)),
+      so that variant only runs up to linearLimit vertices.
+*/
+void graphConstructionBenchmark(int avgDegree=4, int linearLimit=20000){
+    int sizes[] = {10000, 100000, 1000000};
+    cout << "DGraphModel<int> construction, " << avgDegree << " edges per vertex (ms)" << endl;
+    cout << left << setw(12) << "vertices" << setw(12) << "index"
+         << right << setw(12) << "build" << setw(12) << "inDegree" << setw(12) << "teardown" << endl;
+    cout << fixed << setprecision(1);
+    for(int nvertices: sizes){
+        vector<pair<int, int>> edges = randomEdgeList(nvertices, (long long)nvertices * avgDegree);
+        double times[3];
+        long long hashed = graphBuildRun(nvertices, edges, &intVertexHash, times);
+        cout << left << setw(12) << nvertices << setw(12) << "hash"
+             << right << setw(12) << times[0] << setw(12) << times[1] << setw(12) << times[2] << endl;
+        if(nvertices > linearLimit){
+            cout << left << setw(12) << nvertices << setw(12) << "linear"
+                 << right << setw(12) << "-" << setw(12) << "-" << setw(12) << "-" << "   (skipped: O(E*V))" << endl;
+            continue;
+        }
+        long long linear = graphBuildRun(nvertices, edges, 0, times);
+        cout << left << setw(12) << nvertices << setw(12) << "linear"
+             << right << setw(12) << times[0] << setw(12) << times[1] << setw(12) << times[2]
+             << (linear == hashed ? "" : "   FAIL") << endl;
+    }
+}
+
+/*
+! linkedTraversal / csrTraversal(graph, nvertices, depthFirst)
+* Visits every vertex of a DGraphModel<int> over 0..nvertices-1 (or of its snapshot),
+* breadth-first with a queue or depth-first with a stack, from each unvisited root.
+* Returns a checksum of the visiting order.
+*/
+long long linkedTraversal(DGraphModel<int>* graph, int nvertices, bool depthFirst){
+    vector<char> visited(nvertices, 0);
+    vector<int> pending;
+    long long checksum = 0, order = 0;
+    for(int root=0; root < nvertices; root++){
+        if(visited[root]) continue;
+        pending.assign(1, root);
+        visited[root] = 1;
+        size_t head = 0;
+        while(depthFirst ? !pending.empty() : head < pending.size()){
+            int vertex;
+            if(depthFirst){
+                vertex = pending.back();
+                pending.pop_back();
+            }
+            else vertex = pending[head++];
+            checksum += vertex * (++order);
+            DLinkedList<int> neighbors = graph->getOutwardEdges(vertex);
+            for(int next: neighbors){
+                if(!visited[next]){
+                    visited[next] = 1;
+                    pending.push_back(next);
+                }
+            }
+        }
+    }
+    return checksum;
+}
+long long csrTraversal(CSRGraph<int>* csr, int nvertices, bool depthFirst){
+    vector<char> visited(nvertices, 0);
+    vector<int> pending;
+    long long checksum = 0, order = 0;
+    for(int root=0; root < nvertices; root++){
+        if(visited[root]) continue;
+        pending.assign(1, root);
+        visited[root] = 1;
+        size_t head = 0;
+        while(depthFirst ? !pending.empty() : head < pending.size()){
+            int id;
+            if(depthFirst){
+                id = pending.back();
+                pending.pop_back();
+            }
+            else id = pending[head++];
+            checksum += csr->vertex(id) * (++order);
+            for(int next: csr->neighbors(id)){
+                if(!visited[next]){
+                    visited[next] = 1;
+                    pending.push_back(next);
+                }
+            }
+        }
+    }
+    return checksum;
+}
+
+/*
+! csrTraversalBenchmark(nvertices, avgDegree)
+? Functionality:
+    * Random DAG (edges from the smaller to the larger vertex) as a hash-indexed
+      DGraphModel<int> and as its CSRGraph snapshot (freeze() time included in the
+      table): BFS, DFS and both TopoSorter modes on each form; the CSR results must
+      equal the linked ones.
+*/
+void csrTraversalBenchmark(int nvertices=100000, int avgDegree=8){
+    vector<pair<int, int>> edges = randomEdgeList(nvertices, (long long)nvertices * avgDegree, 7);
+    DGraphModel<int> graph(&intVertexEQ, &intVertex2str, &intVertexHash);
+    for(int vertex=0; vertex < nvertices; vertex++) graph.add(vertex);
+    for(auto& edge: edges){
+        if(edge.first == edge.second) continue;
+        if(edge.first < edge.second) graph.connect(edge.first, edge.second);
+        else graph.connect(edge.second, edge.first);
+    }
+
+    auto start = chrono::steady_clock::now();
+    CSRGraph<int>* csr = graph.freeze();
+    double freezeMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Traversals on " << nvertices << " vertices / " << csr->edgeCount() << " edges (ms), freeze(): "
+         << fixed << setprecision(1) << freezeMs << endl;
+    cout << left << setw(12) << "algorithm" << right << setw(12) << "linked" << setw(12) << "CSR" << endl;
+
+    string names[] = {"BFS", "DFS", "topo BFS", "topo DFS"};
+    for(int kind=0; kind < 4; kind++){
+        double times[2];
+        bool same = true;
+        if(kind < 2){
+            long long checksums[2];
+            start = chrono::steady_clock::now();
+            checksums[0] = linkedTraversal(&graph, nvertices, kind == 1);
+            times[0] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+            start = chrono::steady_clock::now();
+            checksums[1] = csrTraversal(csr, nvertices, kind == 1);
+            times[1] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+            same = checksums[0] == checksums[1];
+        }
+        else{
+            int mode = kind == 2 ? TopoSorter<int>::BFS : TopoSorter<int>::DFS;
+            TopoSorter<int> linkedSorter(&graph, &intVertexHash);
+            TopoSorter<int> csrSorter(csr);
+            start = chrono::steady_clock::now();
+            DLinkedList<int> linkedOrder = linkedSorter.sort(mode);
+            times[0] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+            start = chrono::steady_clock::now();
+            DLinkedList<int> csrOrder = csrSorter.sort(mode);
+            times[1] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+            auto lit = linkedOrder.begin();
+            auto cit = csrOrder.begin();
+            for(; lit != linkedOrder.end() && cit != csrOrder.end(); lit++, cit++) if(*lit != *cit) same = false;
+            same = same && linkedOrder.size() == csrOrder.size();
+        }
+        cout << left << setw(12) << names[kind] << right << setw(12) << times[0] << setw(12) << times[1]
+             << (same ? "" : "   MISMATCH") << endl;
+    }
+    delete csr;
+}
+
+/*
+! edgeLookupBenchmark(nvertices, avgDegree, nqueries)
+? Functionality:
+    * connected() and weight() on a dense random DGraphModel<int>, with the per-vertex
+      edge index off (scan of the adjacency list) and on (setEdgeIndex(true)),
+      then getInwardEdges() of every vertex (reverse adjacency lists).
+*/
+void edgeLookupBenchmark(int nvertices=2000, int avgDegree=256, int nqueries=1000000){
+    vector<pair<int, int>> edges = randomEdgeList(nvertices, (long long)nvertices * avgDegree, 11);
+    vector<pair<int, int>> queries = randomEdgeList(nvertices, nqueries, 12);
+    DGraphModel<int> graph(&intVertexEQ, &intVertex2str, &intVertexHash);
+    for(int vertex=0; vertex < nvertices; vertex++) graph.add(vertex);
+    for(auto& edge: edges) graph.connect(edge.first, edge.second, 1);
+
+    cout << "Edge lookups on " << nvertices << " vertices, ~" << avgDegree << " edges per vertex, "
+         << nqueries << " queries (ms)" << endl;
+    cout << fixed << setprecision(1);
+    long long found[2];
+    for(int indexed=0; indexed < 2; indexed++){
+        graph.setEdgeIndex(indexed == 1);
+        auto start = chrono::steady_clock::now();
+        found[indexed] = 0;
+        for(auto& query: queries){
+            if(graph.connected(query.first, query.second)) found[indexed] += (long long)graph.weight(query.first, query.second);
+        }
+        double ms = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        cout << left << setw(24) << (indexed ? "edge index" : "adjacency scan") << right << setw(12) << ms
+             << (indexed == 1 && found[0] != found[1] ? "   MISMATCH" : "") << endl;
+    }
+
+    auto start = chrono::steady_clock::now();
+    long long inward = 0;
+    for(int vertex=0; vertex < nvertices; vertex++) inward += graph.getInwardEdges(vertex).size();
+    double ms = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << left << setw(24) << "getInwardEdges (all)" << right << setw(12) << ms << "   " << inward << " edges" << endl;
+}
+
+/*
+! roadGridGraph(width, height, seed)
+? Functionality:
+    * Road-like CSRGraph<int>: vertex y*width + x is an intersection at (x, y) of a grid,
+      linked both ways to its 4 neighbours; each road weighs its length (1) times a
+      random detour factor in [1, 2), so the straight-line distance is a lower bound.
+    * About 4 * width * height directed edges (500 x 500 -> 10^6).
+*/
+int roadGridWidth = 1;
+float roadGridHeuristic(int& vertex, int& goal){
+    float dx = (float)(vertex % roadGridWidth - goal % roadGridWidth);
+    float dy = (float)(vertex / roadGridWidth - goal / roadGridWidth);
+    return std::sqrt(dx * dx + dy * dy);
+}
+CSRGraph<int>* roadGridGraph(int width, int height, unsigned int seed=99){
+    int nvertices = width * height;
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> detour(1.0f, 2.0f);
+    int* offsets = new int[nvertices + 1];
+    vector<int> targets;
+    vector<float> weights;
+    int dx[] = {1, -1, 0, 0}, dy[] = {0, 0, 1, -1};
+    offsets[0] = 0;
+    for(int id=0; id < nvertices; id++){
+        int x = id % width, y = id / width;
+        for(int dir=0; dir < 4; dir++){
+            int nx = x + dx[dir], ny = y + dy[dir];
+            if(nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            targets.push_back(ny * width + nx);
+            weights.push_back(detour(engine));
+        }
+        offsets[id + 1] = (int)targets.size();
+    }
+    int* targetArray = new int[targets.size()];
+    float* weightArray = new float[weights.size()];
+    std::copy(targets.begin(), targets.end(), targetArray);
+    std::copy(weights.begin(), weights.end(), weightArray);
+    int* vertexData = new int[nvertices];
+    for(int id=0; id < nvertices; id++) vertexData[id] = id;
+    roadGridWidth = width;
+    return new CSRGraph<int>(nvertices, vertexData, offsets, targetArray, weightArray, true,
+                             &intVertexEQ, &intVertex2str);
+}
+
+/*
+! lazyHeapDijkstra(csr, source, dist): the textbook baseline, Heap<T> without
+* decrease-key: every improvement pushes a new (dist, id) entry, stale ones are skipped.
+*/
+struct DistEntry{
+    float dist;
+    int id;
+    bool operator<(const DistEntry& other) const{ return dist < other.dist; }
+    bool operator>(const DistEntry& other) const{ return dist > other.dist; }
+    bool operator==(const DistEntry& other) const{ return dist == other.dist; }
+};
+ostream& operator<<(ostream& os, const DistEntry& entry){
+    return os << "(" << entry.dist << ", " << entry.id << ")";
+}
+void lazyHeapDijkstra(CSRGraph<int>* csr, int source, float* dist){
+    for(int id=0; id < csr->size(); id++) dist[id] = std::numeric_limits<float>::infinity();
+    Heap<DistEntry> heap;
+    dist[source] = 0;
+    heap.push(DistEntry{0, source});
+    while(!heap.empty()){
+        DistEntry entry = heap.pop();
+        if(entry.dist > dist[entry.id]) continue;
+        for(int edge=csr->edgeBegin(entry.id); edge < csr->edgeEnd(entry.id); edge++){
+            int to = csr->target(edge);
+            float next = entry.dist + csr->weightAt(edge);
+            if(next < dist[to]){
+                dist[to] = next;
+                heap.push(DistEntry{next, to});
+            }
+        }
+    }
+}
+
+/*
+! shortestPathBenchmark(width, height, nqueries)
+? Functionality:
+    * On roadGridGraph(width, height):
+        - one-to-all: lazy Heap<T> Dijkstra, DGraphAlgorithm::dijkstra (indexed heap)
+          and DGraphAlgorithm::bellmanFord (SPFA); the distances must agree,
+        - nqueries random point-to-point queries: Dijkstra with early exit,
+          bidirectional Dijkstra, A* with the straight-line heuristic; the costs must
+          agree; mean time and mean number of settled vertices per query.
+*/
+void shortestPathBenchmark(int width=500, int height=500, int nqueries=50){
+    CSRGraph<int>* csr = roadGridGraph(width, height);
+    CSRGraph<int>* reverse = csr->transpose();
+    int nvertices = csr->size();
+    cout << "Shortest paths on a " << width << " x " << height << " road grid: "
+         << nvertices << " vertices, " << csr->edgeCount() << " edges" << endl;
+    cout << fixed << setprecision(1);
+
+    vector<float> reference(nvertices), dist(nvertices);
+    vector<int> parent(nvertices);
+    auto start = chrono::steady_clock::now();
+    lazyHeapDijkstra(csr, 0, reference.data());
+    double lazyMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    DGraphAlgorithm<int>::dijkstra(csr, 0, dist.data(), parent.data());
+    double indexedMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    bool same = dist == reference;
+    start = chrono::steady_clock::now();
+    DGraphAlgorithm<int>::bellmanFord(csr, 0, dist.data(), parent.data());
+    double spfaMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    bool spfaSame = true;
+    for(int id=0; id < nvertices; id++)
+        if(std::fabs(dist[id] - reference[id]) > 1e-3f * (1 + reference[id])) spfaSame = false;
+
+    cout << left << setw(28) << "one-to-all" << right << setw(12) << "ms" << endl;
+    cout << left << setw(28) << "Dijkstra, lazy Heap<T>" << right << setw(12) << lazyMs << endl;
+    cout << left << setw(28) << "Dijkstra, IndexedHeap" << right << setw(12) << indexedMs << (same ? "" : "   MISMATCH") << endl;
+    cout << left << setw(28) << "Bellman-Ford (SPFA)" << right << setw(12) << spfaMs << (spfaSame ? "" : "   MISMATCH") << endl;
+
+    std::mt19937 engine(3);
+    std::uniform_int_distribution<int> pick(0, nvertices - 1);
+    double times[3] = {0, 0, 0};
+    long long settled[3] = {0, 0, 0};
+    bool agree = true;
+    for(int query=0; query < nqueries; query++){
+        int source = pick(engine), target = pick(engine);
+        float costs[3];
+        int count;
+        start = chrono::steady_clock::now();
+        settled[0] += DGraphAlgorithm<int>::dijkstra(csr, source, dist.data(), parent.data(), target);
+        costs[0] = dist[target];
+        times[0] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        costs[1] = DGraphAlgorithm<int>::bidirectionalDijkstra(csr, reverse, source, target, 0, &count);
+        times[1] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        settled[1] += count;
+        start = chrono::steady_clock::now();
+        costs[2] = DGraphAlgorithm<int>::aStar(csr, source, target, &roadGridHeuristic, 0, &count);
+        times[2] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        settled[2] += count;
+        for(int kind=1; kind < 3; kind++)
+            if(std::fabs(costs[kind] - costs[0]) > 1e-3f * (1 + costs[0])) agree = false;
+    }
+    string names[] = {"Dijkstra, early exit", "bidirectional Dijkstra", "A*, straight line"};
+    cout << left << setw(28) << "point-to-point (mean)" << right << setw(12) << "ms" << setw(12) << "settled" << endl;
+    for(int kind=0; kind < 3; kind++)
+        cout << left << setw(28) << names[kind] << right << setw(12) << times[kind] / nqueries
+             << setw(12) << settled[kind] / nqueries << endl;
+    if(!agree) cout << "point-to-point costs MISMATCH" << endl;
+    delete reverse;
+    delete csr;
+}
+
+/*
+! csrFromEdges(nvertices, edges): CSRGraph<int> over 0..nvertices-1 built straight from
+* an edge list (counting sort by source), without going through a DGraphModel
+*/
+CSRGraph<int>* csrFromEdges(int nvertices, vector<pair<int, int>>& edges){
+    int* offsets = new int[nvertices + 1]();
+    for(auto& edge: edges) offsets[edge.first + 1]++;
+    for(int id=0; id < nvertices; id++) offsets[id + 1] += offsets[id];
+    int* targets = new int[edges.size() > 0 ? edges.size() : 1];
+    float* weights = new float[edges.size() > 0 ? edges.size() : 1];
+    vector<int> fill(offsets, offsets + nvertices);
+    for(auto& edge: edges){
+        int slot = fill[edge.first]++;
+        targets[slot] = edge.second;
+        weights[slot] = 1;
+    }
+    int* vertexData = new int[nvertices > 0 ? nvertices : 1];
+    for(int id=0; id < nvertices; id++) vertexData[id] = id;
+    return new CSRGraph<int>(nvertices, vertexData, offsets, targets, weights, true, &intVertexEQ, &intVertex2str);
+}
+
+/*
+! parallelGraphBenchmark(nvertices, avgDegree, threadCounts)
+? Functionality:
+    * Random DAG (nvertices, avgDegree edges per vertex): sequential Kahn (bfsSort)
+      against TopoSorter::parallelKahn; random digraph: sequential queue BFS against
+      ParallelBFS (direction-optimizing), for each thread count; plus dfsSort on a
+      chain of nvertices vertices (the iterative DFS needs no call stack).
+*/
+void parallelGraphBenchmark(int nvertices=1000000, int avgDegree=8, vector<int> threadCounts={1, 2, 4, 8}){
+    vector<pair<int, int>> edges = randomEdgeList(nvertices, (long long)nvertices * avgDegree, 21);
+    CSRGraph<int>* digraph = csrFromEdges(nvertices, edges);
+    for(auto& edge: edges){
+        if(edge.first > edge.second) std::swap(edge.first, edge.second);
+        else if(edge.first == edge.second) edge.second = (edge.first + 1) % nvertices;
+        if(edge.first > edge.second) std::swap(edge.first, edge.second);
+    }
+    CSRGraph<int>* dag = csrFromEdges(nvertices, edges);
+    vector<int> order(nvertices), depth(nvertices), reference(nvertices);
+    cout << "Parallel graph kernels, " << nvertices << " vertices, " << dag->edgeCount() << " edges (ms), "
+         << thread::hardware_concurrency() << " hardware threads" << endl;
+    cout << fixed << setprecision(1);
+
+    auto start = chrono::steady_clock::now();
+    TopoSorter<int> sorter(dag);
+    DLinkedList<int> sequential = sorter.bfsSort();
+    double kahnMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    std::fill(reference.begin(), reference.end(), -1);
+    vector<int> queue(1, 0);
+    reference[0] = 0;
+    for(size_t head=0; head < queue.size(); head++){
+        for(int next: digraph->neighbors(queue[head])){
+            if(reference[next] == -1){
+                reference[next] = reference[queue[head]] + 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    double bfsMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+    cout << left << setw(16) << "threads" << right << setw(14) << "Kahn" << setw(14) << "BFS"
+         << setw(16) << "BFS down/up" << endl;
+    cout << left << setw(16) << "sequential" << right << setw(14) << kahnMs << setw(14) << bfsMs << endl;
+    for(int nthreads: threadCounts){
+        ThreadPool pool(nthreads);
+        start = chrono::steady_clock::now();
+        int count = TopoSorter<int>::parallelKahn(dag, &pool, order.data());
+        double parallelKahnMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        ParallelBFS<int> bfs(digraph, &pool);
+        start = chrono::steady_clock::now();
+        bfs.search(0, depth.data());
+        double parallelBfsMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        string steps = to_string(bfs.getTopDownSteps()) + "/" + to_string(bfs.getBottomUpSteps());
+        cout << left << setw(16) << nthreads << right << setw(14) << parallelKahnMs << setw(14) << parallelBfsMs
+             << setw(16) << steps
+             << (count == sequential.size() ? "" : "   Kahn MISMATCH")
+             << (depth == reference ? "" : "   BFS MISMATCH") << endl;
+    }
+    delete dag;
+    delete digraph;
+
+    vector<pair<int, int>> chain;
+    for(int vertex=0; vertex + 1 < nvertices; vertex++) chain.push_back(make_pair(vertex, vertex + 1));
+    CSRGraph<int>* deep = csrFromEdges(nvertices, chain);
+    start = chrono::steady_clock::now();
+    TopoSorter<int> deepSorter(deep);
+    DLinkedList<int> deepOrder = deepSorter.dfsSort();
+    double deepMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << "dfsSort on a chain of " << nvertices << " vertices: " << deepMs << " ms"
+         << (deepOrder.size() == nvertices ? "" : "   MISMATCH") << endl;
+    delete deep;
+}
+
+/*
+! xMapKahnSort / xMapDfsSort(graph, hash)
+* Topological sort as TopoSorter did before the snapshots: per-vertex state in an
+* xMap (in-degrees, visited flags), neighbours from getOutwardEdges(). DFS keeps a
+* stack of (vertex, neighbour list, next neighbour) instead of recursing; the orders
+* are the ones of TopoSorter::bfsSort / dfsSort.
+*/
+DLinkedList<int> xMapKahnSort(DGraphModel<int>* graph, int (*hash)(int&, int)){
+    DLinkedList<int> result;
+    Queue<int> zeroInDegreeQueue;
+    xMap<int, int> inDegreeMap(hash);
+    DLinkedList<int> vertices = graph->vertices();
+    for(int vertex: vertices){
+        inDegreeMap.put(vertex, graph->inDegree(vertex));
+        if(graph->inDegree(vertex) == 0) zeroInDegreeQueue.push(vertex);
+    }
+    while(!zeroInDegreeQueue.empty()){
+        int vertex = zeroInDegreeQueue.pop();
+        result.add(vertex);
+        DLinkedList<int> neighbors = graph->getOutwardEdges(vertex);
+        for(int neighbor: neighbors){
+            int inDegree = inDegreeMap.get(neighbor) - 1;
+            inDegreeMap.put(neighbor, inDegree);
+            if(inDegree == 0) zeroInDegreeQueue.push(neighbor);
+        }
+    }
+    return result;
+}
+DLinkedList<int> xMapDfsSort(DGraphModel<int>* graph, int (*hash)(int&, int)){
+    struct Frame{
+        int vertex;
+        DLinkedList<int>* neighbors;
+        DLinkedList<int>::Iterator next;
+    };
+    DLinkedList<int> result;
+    xMap<int, bool> visited(hash);
+    DLinkedList<int> vertices = graph->vertices();
+    for(int vertex: vertices) visited.put(vertex, false);
+    vector<Frame> stack;
+    for(int root: vertices){
+        if(visited.get(root)) continue;
+        visited.put(root, true);
+        DLinkedList<int>* neighbors = new DLinkedList<int>(graph->getOutwardEdges(root));
+        stack.push_back({root, neighbors, neighbors->begin()});
+        while(!stack.empty()){
+            Frame& top = stack.back();
+            if(top.next != top.neighbors->end()){
+                int next = *top.next;
+                top.next++;
+                if(!visited.get(next)){
+                    visited.put(next, true);
+                    neighbors = new DLinkedList<int>(graph->getOutwardEdges(next));
+                    stack.push_back({next, neighbors, neighbors->begin()});
+                }
+            }
+            else{
+                result.add(0, top.vertex);
+                delete top.neighbors;
+                stack.pop_back();
+            }
+        }
+    }
+    return result;
+}
+
+/*
+! flaggedDfs<Flags>(csr, visited): finish-order checksum of a DFS over the snapshot
+* visited (all false) is an XMapFlags, CharFlags or DynamicBitset: the same search
+* with the visited flags in a hash map, one byte per id, or one bit per id.
+*/
+struct XMapFlags{
+    xMap<int, bool> map;
+    XMapFlags(int nvertices): map(&intVertexHash){
+        for(int id=0; id < nvertices; id++) map.put(id, false);
+    }
+    bool testAndSet(int id){
+        if(map.get(id)) return true;
+        map.put(id, true);
+        return false;
+    }
+};
+struct CharFlags{
+    vector<char> flags;
+    CharFlags(int nvertices): flags(nvertices, 0){}
+    bool testAndSet(int id){
+        if(flags[id]) return true;
+        flags[id] = 1;
+        return false;
+    }
+};
+template<class Flags>
+long long flaggedDfs(CSRGraph<int>* csr, Flags& visited){
+    int nvertices = csr->size();
+    const int* offsets = csr->getOffsets();
+    const int* targets = csr->getTargets();
+    vector<int> stack(nvertices), nextEdge(nvertices);
+    long long checksum = 0, order = 0;
+    for(int root=0; root < nvertices; root++){
+        if(visited.testAndSet(root)) continue;
+        int top = 0;
+        stack[0] = root;
+        nextEdge[0] = offsets[root];
+        while(top >= 0){
+            int id = stack[top];
+            if(nextEdge[top] < offsets[id + 1]){
+                int next = targets[nextEdge[top]++];
+                if(!visited.testAndSet(next)){
+                    stack[++top] = next;
+                    nextEdge[top] = offsets[next];
+                }
+            }
+            else{
+                checksum += (long long)id * (++order);
+                top--;
+            }
+        }
+    }
+    return checksum;
+}
+
+/*
+! topoSortBenchmark(nvertices, avgDegree)
+? Functionality:
+    * Random DAG (edges follow a hidden random order) as a hash-indexed DGraphModel<int>.
+    * Before / after: xMapKahnSort and xMapDfsSort against TopoSorter::bfsSort and
+      dfsSort (freeze() included: dense ids, int in-degrees, bitset visited flags);
+      the orders must be equal.
+    * Then the visited flags alone: flaggedDfs on the snapshot with xMap<int, bool>,
+      vector<char> and DynamicBitset flags, and a VertexIds index of the vertices
+      against xMap<int, int>.
+*/
+void topoSortBenchmark(int nvertices=1000000, int avgDegree=4){
+    std::mt19937 engine(50);
+    vector<int> hidden(nvertices);
+    for(int vertex=0; vertex < nvertices; vertex++) hidden[vertex] = vertex;
+    std::shuffle(hidden.begin(), hidden.end(), engine);
+    vector<pair<int, int>> edges = randomEdgeList(nvertices, (long long)nvertices * avgDegree, 51);
+    DGraphModel<int> graph(&intVertexEQ, &intVertex2str, &intVertexHash);
+    for(int vertex=0; vertex < nvertices; vertex++) graph.add(vertex);
+    for(auto& edge: edges){
+        if(edge.first == edge.second) continue;
+        graph.connect(hidden[std::min(edge.first, edge.second)], hidden[std::max(edge.first, edge.second)]);
+    }
+
+    cout << "Topological sort, " << nvertices << " vertices, " << avgDegree << " edges per vertex (ms)" << endl;
+    cout << left << setw(12) << "mode" << right << setw(16) << "xMap (before)" << setw(16) << "dense (after)" << endl;
+    cout << fixed << setprecision(1);
+    string names[] = {"BFS (Kahn)", "DFS"};
+    for(int kind=0; kind < 2; kind++){
+        auto start = chrono::steady_clock::now();
+        DLinkedList<int> before = kind == 0 ? xMapKahnSort(&graph, &intVertexHash) : xMapDfsSort(&graph, &intVertexHash);
+        double beforeMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        TopoSorter<int> sorter(&graph, &intVertexHash);
+        DLinkedList<int> after = sorter.sort(kind == 0 ? TopoSorter<int>::BFS : TopoSorter<int>::DFS);
+        double afterMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        bool same = before.size() == after.size();
+        auto bit = before.begin();
+        auto ait = after.begin();
+        for(; same && bit != before.end(); bit++, ait++) same = *bit == *ait;
+        cout << left << setw(12) << names[kind] << right << setw(16) << beforeMs << setw(16) << afterMs
+             << (same ? "" : "   MISMATCH") << endl;
+    }
+
+    CSRGraph<int>* csr = graph.freeze();
+    cout << "Visited flags of a DFS on the snapshot:" << endl;
+    cout << left << setw(24) << "flags" << right << setw(12) << "ms" << setw(14) << "flag bytes" << endl;
+    long long checksums[3];
+    double times[3];
+    long long bytes[3];
+    auto start = chrono::steady_clock::now();
+    XMapFlags hashed(nvertices);
+    checksums[0] = flaggedDfs(csr, hashed);
+    times[0] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    bytes[0] = -1;
+    start = chrono::steady_clock::now();
+    CharFlags bytewise(nvertices);
+    checksums[1] = flaggedDfs(csr, bytewise);
+    times[1] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    bytes[1] = nvertices;
+    start = chrono::steady_clock::now();
+    DynamicBitset bitwise(nvertices);
+    checksums[2] = flaggedDfs(csr, bitwise);
+    times[2] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    bytes[2] = bitwise.memoryBytes();
+    string flagNames[] = {"xMap<int, bool>", "vector<char>", "DynamicBitset"};
+    for(int kind=0; kind < 3; kind++){
+        cout << left << setw(24) << flagNames[kind] << right << setw(12) << times[kind] << setw(14);
+        if(bytes[kind] < 0) cout << "-";
+        else cout << bytes[kind];
+        cout << (checksums[kind] == checksums[0] ? "" : "   MISMATCH") << endl;
+    }
+
+    //vertex -> id: build the index, then look every vertex up once
+    long long sums[2] = {0, 0};
+    start = chrono::steady_clock::now();
+    xMap<int, int> map(&intVertexHash);
+    for(int id=0; id < nvertices; id++) map.put(csr->vertex(id), id);
+    for(int vertex=0; vertex < nvertices; vertex++) sums[0] += map.get(vertex);
+    double mapMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    VertexIds<int> ids(&intVertexHash, 0, nvertices);
+    for(int id=0; id < nvertices; id++) ids.intern(csr->vertex(id));
+    for(int vertex=0; vertex < nvertices; vertex++) sums[1] += ids.indexOf(vertex);
+    double idsMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << "Vertex ids (build + " << nvertices << " lookups):" << endl;
+    cout << left << setw(24) << "xMap<int, int>" << right << setw(12) << mapMs << endl;
+    cout << left << setw(24) << "VertexIds<int>" << right << setw(12) << idsMs
+         << (sums[0] == sums[1] ? "" : "   MISMATCH") << endl;
+    delete csr;
+}
+
+/*
+! dynamicTopoBenchmark(nvertices, nedges, samples)
+? Functionality:
+    * Random insertion stream on a DGraphModel<int>: nedges edges that respect a hidden
+      random order, except every 10th one which is reversed; an edge that would close
+      a cycle is rejected.
+    * DynamicTopoOrder keeps the order after every insertion; the alternative is a
+      full TopoSorter::bfsSort() after every insertion, timed at "samples" points of
+      the stream and reported per insertion.
+*/
+void dynamicTopoBenchmark(int nvertices=10000, int nedges=50000, int samples=20){
+    std::mt19937 engine(17);
+    vector<int> hidden(nvertices);
+    for(int vertex=0; vertex < nvertices; vertex++) hidden[vertex] = vertex;
+    std::shuffle(hidden.begin(), hidden.end(), engine);
+    vector<pair<int, int>> stream = randomEdgeList(nvertices, nedges, 18);
+    for(int idx=0; idx < nedges; idx++){
+        pair<int, int>& edge = stream[idx];
+        if(edge.first == edge.second) edge.second = (edge.second + 1) % nvertices;
+        edge = make_pair(hidden[std::min(edge.first, edge.second)], hidden[std::max(edge.first, edge.second)]);
+        if(idx % 10 == 9) std::swap(edge.first, edge.second);
+    }
+
+    DGraphModel<int> graph(&intVertexEQ, &intVertex2str, &intVertexHash);
+    DynamicTopoOrder<int> topo(&graph);
+    for(int vertex=0; vertex < nvertices; vertex++) topo.add(vertex);
+    vector<pair<int, int>> accepted;
+    double incrementalMs = 0, resortMs = 0;
+    int resorts = 0;
+    bool valid = true;
+    for(int idx=0; idx < nedges; idx++){
+        auto start = chrono::steady_clock::now();
+        bool added = topo.tryConnect(stream[idx].first, stream[idx].second);
+        incrementalMs += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        if(added) accepted.push_back(stream[idx]);
+
+        if((idx + 1) % (nedges / samples > 0 ? nedges / samples : 1) == 0){
+            start = chrono::steady_clock::now();
+            TopoSorter<int> sorter(&graph);
+            DLinkedList<int> order = sorter.bfsSort();
+            resortMs += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+            resorts++;
+            if(order.size() != nvertices) valid = false;
+        }
+    }
+    for(auto& edge: accepted)
+        if(!topo.precedes(edge.first, edge.second)) valid = false;
+
+    cout << "Topological order under " << nedges << " insertions, " << nvertices << " vertices" << endl;
+    cout << fixed << setprecision(4);
+    cout << left << setw(28) << "method" << right << setw(16) << "ms / insertion" << endl;
+    cout << left << setw(28) << "DynamicTopoOrder" << right << setw(16) << incrementalMs / nedges
+         << (valid ? "" : "   INVALID") << endl;
+    cout << left << setw(28) << "full bfsSort each time" << right << setw(16) << resortMs / resorts << endl;
+    cout << "vertices moved per insertion: " << setprecision(2) << (double)topo.getMovedVertices() / nedges
+         << ", cycles rejected: " << nedges - (int)accepted.size() << endl;
+}
+
+/*
+! undirectedCsr(nvertices, edges, seed): undirected CSRGraph<int> with every edge of the
+* list stored both ways (self-loops dropped), weights uniform in [0, 100)
+*/
+CSRGraph<int>* undirectedCsr(int nvertices, vector<pair<int, int>>& edges, unsigned int seed=5){
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> pickWeight(0.0f, 100.0f);
+    int* offsets = new int[nvertices + 1]();
+    for(auto& edge: edges){
+        if(edge.first == edge.second) continue;
+        offsets[edge.first + 1]++;
+        offsets[edge.second + 1]++;
+    }
+    for(int id=0; id < nvertices; id++) offsets[id + 1] += offsets[id];
+    int* targets = new int[offsets[nvertices] > 0 ? offsets[nvertices] : 1];
+    float* weights = new float[offsets[nvertices] > 0 ? offsets[nvertices] : 1];
+    vector<int> fill(offsets, offsets + nvertices);
+    for(auto& edge: edges){
+        if(edge.first == edge.second) continue;
+        float weight = pickWeight(engine);
+        int slot = fill[edge.first]++;
+        targets[slot] = edge.second;
+        weights[slot] = weight;
+        slot = fill[edge.second]++;
+        targets[slot] = edge.first;
+        weights[slot] = weight;
+    }
+    int* vertexData = new int[nvertices > 0 ? nvertices : 1];
+    for(int id=0; id < nvertices; id++) vertexData[id] = id;
+    return new CSRGraph<int>(nvertices, vertexData, offsets, targets, weights, false, &intVertexEQ, &intVertex2str);
+}
+
+/*
+! spanningTreeBenchmark(nvertices, nedges, threadCounts)
+? Functionality:
+    * Random undirected graph with nedges weighted edges (CSR): Kruskal and Prim
+      (the weights must agree), components with UnionFind and with parallel label
+      propagation per thread count (the labels must agree).
+    * Then the same on a hash-indexed UGraphModel<int> with nedges / 10 edges, through
+      UGraphAlgorithm (freeze() and the result graph included).
+*/
+void spanningTreeBenchmark(int nvertices=500000, int nedges=1000000, vector<int> threadCounts={1, 2, 4}){
+    vector<pair<int, int>> edges = randomEdgeList(nvertices, nedges, 31);
+    CSRGraph<int>* csr = undirectedCsr(nvertices, edges);
+    cout << "Spanning forest and components, " << nvertices << " vertices, " << csr->edgeCount() / 2
+         << " undirected edges (ms)" << endl;
+    cout << fixed << setprecision(1);
+    vector<int> from(nvertices), to(nvertices), label(nvertices), reference(nvertices);
+    vector<float> weight(nvertices);
+
+    double totals[2];
+    int sizes[2];
+    double times[2];
+    for(int kind=0; kind < 2; kind++){
+        auto start = chrono::steady_clock::now();
+        sizes[kind] = kind == 0 ? UGraphAlgorithm<int>::kruskal(csr, from.data(), to.data(), weight.data())
+                                : UGraphAlgorithm<int>::prim(csr, from.data(), to.data(), weight.data());
+        times[kind] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        totals[kind] = 0;
+        for(int idx=0; idx < sizes[kind]; idx++) totals[kind] += weight[idx];
+    }
+    bool same = sizes[0] == sizes[1] && std::fabs(totals[0] - totals[1]) < 1e-6 * (1 + totals[0]);
+    cout << left << setw(30) << "Kruskal (UnionFind)" << right << setw(12) << times[0] << endl;
+    cout << left << setw(30) << "Prim (IndexedHeap)" << right << setw(12) << times[1]
+         << (same ? "" : "   MISMATCH") << endl;
+
+    auto start = chrono::steady_clock::now();
+    int ncomponents = UGraphAlgorithm<int>::components(csr, reference.data());
+    double ufMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << left << setw(30) << "components, UnionFind" << right << setw(12) << ufMs
+         << "   " << ncomponents << " components" << endl;
+    for(int nthreads: threadCounts){
+        ThreadPool pool(nthreads);
+        start = chrono::steady_clock::now();
+        int count = UGraphAlgorithm<int>::parallelComponents(csr, label.data(), &pool);
+        double lpMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        string name = "components, propagation x" + to_string(nthreads);
+        cout << left << setw(30) << name << right << setw(12) << lpMs
+             << (count == ncomponents && label == reference ? "" : "   MISMATCH") << endl;
+    }
+    delete csr;
+
+    int modelEdges = nedges / 10, modelVertices = nvertices / 10;
+    vector<pair<int, int>> small = randomEdgeList(modelVertices, modelEdges, 32);
+    UGraphModel<int> model(&intVertexEQ, &intVertex2str, &intVertexHash);
+    for(int vertex=0; vertex < modelVertices; vertex++) model.add(vertex);
+    std::mt19937 engine(33);
+    for(auto& edge: small) model.connect(edge.first, edge.second, (float)(engine() % 1000));
+    UGraphAlgorithm<int> algorithm;
+    start = chrono::steady_clock::now();
+    UGraphModel<int> *tree = algorithm.minSpanningTree(&model);
+    double modelMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    delete tree;
+    start = chrono::steady_clock::now();
+    DLinkedList<DLinkedList<int>*> groups = algorithm.connectedComponents(&model);
+    double groupsMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    for(DLinkedList<int>* group: groups) delete group;
+    cout << "UGraphModel, " << modelVertices << " vertices / " << modelEdges << " edges: minSpanningTree "
+         << modelMs << " ms, connectedComponents " << groupsMs << " ms" << endl;
+}
+
+/*
+! samePartition(first, second, nvertices): true if two component numberings group the
+* vertices the same way (the numbers themselves may differ)
+*/
+bool samePartition(vector<int>& first, vector<int>& second, int nvertices){
+    vector<int> map(nvertices, -1), back(nvertices, -1);
+    for(int id=0; id < nvertices; id++){
+        if(map[first[id]] == -1 && back[second[id]] == -1){
+            map[first[id]] = second[id];
+            back[second[id]] = first[id];
+        }
+        if(map[first[id]] != second[id]) return false;
+    }
+    return true;
+}
+
+/*
+! sccBenchmark(nvertices, avgDegrees)
+? Functionality:
+    * Random digraphs with nvertices vertices and avgDegree * nvertices edges (below 1 many
+      small components, above 1 one giant component): Tarjan, Kosaraju (transpose included,
+      the partitions must agree), condensation and findCycle.
+    * Then one cycle through all nvertices vertices: every search goes nvertices deep,
+      which a recursive DFS could not do on a default call stack.
+*/
+void sccBenchmark(int nvertices=1000000, vector<double> avgDegrees={0.5, 1.5, 4, 16}){
+    cout << "Strongly connected components, " << nvertices << " vertices (ms)" << endl;
+    cout << fixed << setprecision(1);
+    cout << right << setw(8) << "degree" << setw(10) << "Tarjan" << setw(10) << "Kosaraju"
+         << setw(10) << "condense" << setw(10) << "cycle" << setw(12) << "components"
+         << setw(12) << "largest" << setw(12) << "DAG edges" << endl;
+    vector<int> tarjan(nvertices), kosaraju(nvertices);
+    for(double degree: avgDegrees){
+        vector<pair<int, int>> edges = randomEdgeList(nvertices, (long long)(degree * nvertices), 41);
+        CSRGraph<int>* csr = csrFromEdges(nvertices, edges);
+
+        auto start = chrono::steady_clock::now();
+        int ncomponents = SCCFinder<int>::tarjan(csr, tarjan.data());
+        double tarjanMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        CSRGraph<int>* reverse = csr->transpose();
+        int count = SCCFinder<int>::kosaraju(csr, reverse, kosaraju.data());
+        double kosarajuMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        delete reverse;
+        start = chrono::steady_clock::now();
+        CSRGraph<int>* dag = SCCFinder<int>::condense(csr, tarjan.data(), ncomponents);
+        double condenseMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        SCCFinder<int>::findCycle(csr);
+        double cycleMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        vector<int> sizes(ncomponents, 0);
+        for(int id=0; id < nvertices; id++) sizes[tarjan[id]]++;
+        bool valid = count == ncomponents && samePartition(tarjan, kosaraju, nvertices);
+        //topological numbering: every edge of the condensation goes to a higher number
+        for(int from=0; from < dag->size(); from++)
+            for(int to: dag->neighbors(from)) if(to <= from) valid = false;
+        cout << right << setw(8) << setprecision(1) << degree << setw(10) << tarjanMs << setw(10) << kosarajuMs
+             << setw(10) << condenseMs << setw(10) << cycleMs << setw(12) << ncomponents
+             << setw(12) << *std::max_element(sizes.begin(), sizes.end()) << setw(12) << dag->edgeCount()
+             << (valid ? "" : "   MISMATCH") << endl;
+        delete dag;
+        delete csr;
+    }
+
+    vector<pair<int, int>> ring;
+    for(int vertex=0; vertex < nvertices; vertex++) ring.push_back(make_pair(vertex, (vertex + 1) % nvertices));
+    CSRGraph<int>* csr = csrFromEdges(nvertices, ring);
+    auto start = chrono::steady_clock::now();
+    int ncomponents = SCCFinder<int>::tarjan(csr, tarjan.data());
+    double tarjanMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    DLinkedList<int> cycle;
+    start = chrono::steady_clock::now();
+    SCCFinder<int>::findCycle(csr, &cycle);
+    double cycleMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << "one cycle of " << nvertices << " vertices: Tarjan " << tarjanMs << " ms (" << ncomponents
+         << " component), findCycle " << cycleMs << " ms (" << cycle.size() - 1 << " vertices)" << endl;
+    delete csr;
+}
+
+/*
+! pushPageRank(csr, rank, damping, iterations): the textbook baseline, every vertex adds
+* rank / outDegree to each out-neighbour (scattered writes), sequential
+*/
+void pushPageRank(CSRGraph<int>* csr, double* rank, double damping, int iterations){
+    int nvertices = csr->size();
+    vector<double> next(nvertices);
+    for(int id=0; id < nvertices; id++) rank[id] = 1.0 / nvertices;
+    for(int iteration=0; iteration < iterations; iteration++){
+        double dangling = 0;
+        for(int id=0; id < nvertices; id++) if(csr->outDegree(id) == 0) dangling += rank[id];
+        double base = ((1.0 - damping) + damping * dangling) / nvertices;
+        std::fill(next.begin(), next.end(), base);
+        for(int from=0; from < nvertices; from++){
+            int out = csr->outDegree(from);
+            if(out == 0) continue;
+            double share = damping * rank[from] / out;
+            for(int to: csr->neighbors(from)) next[to] += share;
+        }
+        std::copy(next.begin(), next.end(), rank);
+    }
+}
+
+/*
+! pageRankBenchmark(nvertices, nedges, threadCounts)
+? Functionality:
+    * Two digraphs with nvertices vertices and nedges edges: uniform random targets, and
+      skewed targets (id = n * u^3, a few hubs with very large in-degree).
+    * 20 PageRank iterations: sequential push baseline, then GraphAnalytics (pull) without
+      a pool and on each thread count (the ranks must be identical for every thread count
+      and match the baseline); then PageRank to tolerance 1e-8, personalized PageRank from
+      10 seeds and closeness from 32 sampled sources.
+*/
+void pageRankBenchmark(int nvertices=1000000, long long nedges=10000000, vector<int> threadCounts={1, 2, 4, 8}){
+    const int iterations = 20;
+    for(int skewed=0; skewed < 2; skewed++){
+        vector<pair<int, int>> edges = randomEdgeList(nvertices, nedges, 51);
+        if(skewed){
+            std::mt19937 engine(52);
+            std::uniform_real_distribution<double> pick(0.0, 1.0);
+            for(auto& edge: edges){
+                double u = pick(engine);
+                edge.second = std::min(nvertices - 1, (int)(nvertices * u * u * u));
+            }
+        }
+        CSRGraph<int>* csr = csrFromEdges(nvertices, edges);
+        edges.clear();
+        edges.shrink_to_fit();
+        cout << "PageRank, " << nvertices << " vertices, " << csr->edgeCount() << " edges, "
+             << (skewed ? "skewed" : "uniform") << " targets (ms for " << iterations << " iterations)" << endl;
+        cout << fixed << setprecision(1);
+
+        vector<double> reference(nvertices), rank(nvertices), sequential(nvertices);
+        auto start = chrono::steady_clock::now();
+        pushPageRank(csr, reference.data(), 0.85, iterations);
+        double pushMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        cout << left << setw(26) << "push, sequential" << right << setw(12) << pushMs << endl;
+
+        GraphAnalytics<int> plain(csr);
+        start = chrono::steady_clock::now();
+        plain.pageRank(sequential.data(), 0.85, 0, iterations);
+        double pullMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        double error = 0;
+        for(int id=0; id < nvertices; id++) error += std::fabs(sequential[id] - reference[id]);
+        cout << left << setw(26) << "pull, no pool" << right << setw(12) << pullMs
+             << (error < 1e-9 ? "" : "   MISMATCH") << endl;
+
+        for(int nthreads: threadCounts){
+            ThreadPool pool(nthreads);
+            GraphAnalytics<int> analytics(csr, &pool);
+            start = chrono::steady_clock::now();
+            analytics.pageRank(rank.data(), 0.85, 0, iterations);
+            double ms = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+            string name = "pull, x" + to_string(nthreads);
+            cout << left << setw(26) << name << right << setw(12) << ms
+                 << (rank == sequential ? "" : "   MISMATCH") << endl;
+        }
+
+        ThreadPool pool(threadCounts.back());
+        GraphAnalytics<int> analytics(csr, &pool);
+        start = chrono::steady_clock::now();
+        int done = analytics.pageRank(rank.data(), 0.85, 1e-8, 200);
+        double convergeMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        int seeds[10];
+        for(int idx=0; idx < 10; idx++) seeds[idx] = idx * (nvertices / 10);
+        start = chrono::steady_clock::now();
+        int personalized = analytics.personalizedPageRank(seeds, 10, rank.data(), 0.85, 1e-8, 200);
+        double personalizedMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        int sources[32];
+        for(int idx=0; idx < 32; idx++) sources[idx] = idx * (nvertices / 32);
+        start = chrono::steady_clock::now();
+        analytics.closenessCentrality(rank.data(), sources, 32);
+        double closenessMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        cout << "x" << threadCounts.back() << ": PageRank to 1e-8 " << convergeMs << " ms (" << done
+             << " iterations), personalized " << personalizedMs << " ms (" << personalized
+             << " iterations), closeness of 32 sources " << closenessMs << " ms" << endl;
+        delete csr;
+    }
+}
+
+/*
+! writeEdgeFiles(edges, dir): the edge list as dir/edges.txt, dir/edges.csv and dir/edges.npy
+    * edges.npy is an (E, 2) int32 array, the format numpy.save writes.
+*/
+void writeEdgeFiles(vector<pair<int, int>>& edges, string dir){
+    ofstream text(dir + "/edges.txt"), csv(dir + "/edges.csv");
+    text << "# from to\n";
+    csv << "from,to\n";
+    string textLine, csvLine;
+    for(auto& edge: edges){
+        textLine = to_string(edge.first) + " " + to_string(edge.second) + "\n";
+        csvLine = to_string(edge.first) + "," + to_string(edge.second) + "\n";
+        text << textLine;
+        csv << csvLine;
+    }
+    string header = "{'descr': '<i4', 'fortran_order': False, 'shape': (" + to_string(edges.size()) + ", 2), }";
+    while((10 + header.size() + 1) % 64 != 0) header += ' ';
+    header += '\n';
+    ofstream npy(dir + "/edges.npy", ios::binary);
+    npy.write("\x93NUMPY\x01\x00", 8);
+    unsigned short length = (unsigned short)header.size();
+    char size[2] = {(char)(length & 0xff), (char)(length >> 8)};
+    npy.write(size, 2);
+    npy << header;
+    vector<int> rows;
+    rows.reserve(1 << 20);
+    for(size_t idx=0; idx < edges.size(); idx++){
+        rows.push_back(edges[idx].first);
+        rows.push_back(edges[idx].second);
+        if(rows.size() == (1 << 20) || idx + 1 == edges.size()){
+            npy.write((const char*)rows.data(), rows.size() * sizeof(int));
+            rows.clear();
+        }
+    }
+}
+
+/*
+! graphLoadBenchmark(nvertices, nedges, dir)
+? Functionality:
+    * A random digraph (nvertices, nedges) is written to dir as text, CSV and .npy, then
+      (without a vertexHash unless stated):
+        - GraphLoader::loadText / loadCSV / loadNpy (parse + O(V+E) counting-sort build);
+        - GraphFile::write, GraphFile::map (+ first full traversal, which faults the pages
+          in) and GraphFile::read of the binary file;
+        - GraphFile::map with a vertexHash, i.e. the optional id index (one xMap put
+          per vertex), which is what dominates when the hash is passed;
+        - DGraphModel::addAll of a modelEdges-edge prefix against per-edge connect()
+          (the model costs ~100 bytes per edge, so the prefix keeps it in memory).
+    * Every loaded CSR is checked against the first one (same offsets and targets).
+*/
+void graphLoadBenchmark(int nvertices=1000000, long long nedges=10000000, string dir="/tmp", long long modelEdges=1000000){
+    vector<pair<int, int>> edges = randomEdgeList(nvertices, nedges, 61);
+    edges.push_back(make_pair(nvertices - 1, nvertices - 1));   //pins the vertex count
+    writeEdgeFiles(edges, dir);
+    cout << "Graph loading, " << nvertices << " vertices, " << edges.size() << " edges (ms)" << endl;
+    cout << fixed << setprecision(1);
+
+    auto same = [nvertices](CSRGraph<int>* lhs, CSRGraph<int>* rhs){
+        if(lhs->size() != rhs->size() || lhs->edgeCount() != rhs->edgeCount()) return false;
+        for(int id=0; id <= nvertices; id++){
+            if(lhs->getOffsets()[id] != rhs->getOffsets()[id]) return false;
+        }
+        for(int edge=0; edge < lhs->edgeCount(); edge++){
+            if(lhs->getTargets()[edge] != rhs->getTargets()[edge]) return false;
+        }
+        return true;
+    };
+    auto report = [](string name, double ms, bool ok){
+        cout << left << setw(28) << name << right << setw(12) << ms << (ok ? "" : "   MISMATCH") << endl;
+    };
+
+    auto start = chrono::steady_clock::now();
+    CSRGraph<int>* reference = GraphLoader::loadText(dir + "/edges.txt", true, 1);
+    report("loadText", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), true);
+    const char* names[] = {"loadCSV", "loadNpy"};
+    for(int kind=0; kind < 2; kind++){
+        start = chrono::steady_clock::now();
+        CSRGraph<int>* csr = kind == 0 ? GraphLoader::loadCSV(dir + "/edges.csv", true, ',', 1)
+                                       : GraphLoader::loadNpy(dir + "/edges.npy", "", true, 1);
+        report(names[kind], chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), same(csr, reference));
+        delete csr;
+    }
+
+    string binary = dir + "/edges.csrg";
+    start = chrono::steady_clock::now();
+    GraphFile::write(reference, binary);
+    report("GraphFile::write", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), true);
+    start = chrono::steady_clock::now();
+    CSRGraph<int>* mapped = GraphFile::map(binary);
+    double mapMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    long long checksum = 0;
+    for(int id=0; id < mapped->size(); id++){
+        for(int edge=mapped->edgeBegin(id); edge < mapped->edgeEnd(id); edge++) checksum += mapped->target(edge);
+    }
+    double touchMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    report("GraphFile::map", mapMs, same(mapped, reference));
+    report("map + first traversal", touchMs, checksum >= 0);
+    delete mapped;
+    start = chrono::steady_clock::now();
+    CSRGraph<int>* loaded = GraphFile::read(binary);
+    report("GraphFile::read", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), same(loaded, reference));
+    delete loaded;
+    start = chrono::steady_clock::now();
+    mapped = GraphFile::map(binary, &intVertexHash);
+    report("map + vertex index (VertexIds)", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(),
+           mapped->indexOf(nvertices / 2) == nvertices / 2);
+    delete mapped;
+    delete reference;
+
+    edges.resize(std::min((long long)edges.size(), modelEdges));
+    EdgeListBuilder builder;
+    for(auto& edge: edges) builder.add(edge.first, edge.second, 1);
+    CSRGraph<int>* prefix = builder.build(-1, &intVertexHash);   //deduplicated, as addAll expects
+    int modelVertices = prefix->size();
+    start = chrono::steady_clock::now();
+    DGraphModel<int> bulk(&intVertexEQ, &intVertex2str, &intVertexHash);
+    bulk.addAll(prefix);
+    double bulkMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    DGraphModel<int> single(&intVertexEQ, &intVertex2str, &intVertexHash);
+    for(int id=0; id < modelVertices; id++) single.add(id);
+    for(auto& edge: edges) single.connect(edge.first, edge.second, 1);
+    double singleMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    bool ok = bulk.size() == single.size();
+    for(int id=0; ok && id < modelVertices; id += 997) ok = bulk.outDegree(id) == single.outDegree(id);
+    cout << "DGraphModel, " << prefix->edgeCount() << " edges:" << endl;
+    report("addAll", bulkMs, ok);
+    report("add + connect per edge", singleMs, true);
+    delete prefix;
+    const char* files[] = {"/edges.txt", "/edges.csv", "/edges.npy", "/edges.csrg"};
+    for(const char* file: files) remove((dir + file).c_str());
+}
+
+#endif /* GRAPHBENCHMARK_H */
@@ -112,8 +112,9 @@ void ugraphDemo3(){
     
     cout << "Minimum Spanning Tree:" << endl;
     UGraphAlgorithm<char> mst;
-    UGraphModel<char> tree = mst.minSpanningTree(&model);
-    tree.println();
+    UGraphModel<char> *tree = mst.minSpanningTree(&model);
+    tree->println();
+    delete tree;
 }
 
 
@@ -0,0 +1,114 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines a miss-heavy lookup benchmark: xMap against FilteredMap with cuckoo and Bloom filters
+*/
+
+#ifndef FILTERBENCHMARK_H
+#define FILTERBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include "hash/xMap.h"
+#include "hash/FilteredMap.h"
+using namespace std;
+
+/*
+! lookupNs<MapType>(map, probes, hits): ns per find() over probes; hits receives the number found
+*/
+template<class MapType>
+double lookupNs(MapType& map, vector<int>& probes, long long& hits){
+    hits = 0;
+    auto start = chrono::steady_clock::now();
+    for(int key: probes) hits += map.find(key) != 0 ? 1 : 0;
+    return chrono::duration<double, std::nano>(chrono::steady_clock::now() - start).count() / probes.size();
+}
+
+/*
+! missHeavyBenchmark(nkeys, nprobes, hitPercent, fpr)
+? Functionality:
+    * nkeys random int keys in an xMap and in FilteredMaps over a CuckooFilter and a
+      BlockedBloomFilter (target rate fpr), then nprobes lookups of which hitPercent%
+      are present: find() (pointer or null) on each map, containsKey() + get() on
+      the xMap (the common pattern), and get() with KeyNotFound caught on a tenth of
+      the probes (misses as exceptions).
+    * ns per lookup; then the size and measured false-positive rate of each filter.
+*/
+void missHeavyBenchmark(int nkeys=1000000, int nprobes=10000000, int hitPercent=5, double fpr=0.01){
+    std::mt19937 engine(50);
+    vector<int> keys(nkeys);
+    for(int& key: keys) key = (int)(engine() & 0x3FFFFFFF);        //present: [0, 2^30)
+    vector<int> probes(nprobes);
+    std::uniform_int_distribution<int> pick(0, nkeys - 1), percent(0, 99);
+    for(int& key: probes){
+        if(percent(engine) < hitPercent) key = keys[pick(engine)];
+        else key = (int)(engine() & 0x3FFFFFFF) | 0x40000000;      //absent: [2^30, 2^31)
+    }
+
+    xMap<int, int> plain(&xMap<int, int>::intKeyHash);
+    FilteredMap<int, int, CuckooFilter<int>> cuckoo(&xMap<int, int>::intKeyHash, nkeys, fpr);
+    FilteredMap<int, int, BlockedBloomFilter<int>> bloom(&xMap<int, int>::intKeyHash, nkeys, fpr);
+    for(int key: keys){
+        plain.put(key, key);
+        cuckoo.put(key, key);
+        bloom.put(key, key);
+    }
+
+    cout << "Lookups, " << nkeys << " keys, " << nprobes << " probes, " << hitPercent
+         << "% hits, filter target " << fpr << " (ns per lookup)" << endl;
+    cout << fixed << setprecision(1);
+    long long hits[3];
+    double times[3];
+    times[0] = lookupNs(plain, probes, hits[0]);
+    times[1] = lookupNs(cuckoo, probes, hits[1]);
+    times[2] = lookupNs(bloom, probes, hits[2]);
+    string names[] = {"xMap::find", "FilteredMap<Cuckoo>::find", "FilteredMap<Bloom>::find"};
+    for(int kind=0; kind < 3; kind++){
+        cout << left << setw(32) << names[kind] << right << setw(10) << times[kind]
+             << (hits[kind] == hits[0] ? "" : "   MISMATCH") << endl;
+    }
+
+    long long found = 0;
+    auto start = chrono::steady_clock::now();
+    for(int key: probes){
+        if(plain.containsKey(key)) found += plain.get(key) == key ? 1 : 0;
+    }
+    double containsNs = chrono::duration<double, std::nano>(chrono::steady_clock::now() - start).count() / nprobes;
+    cout << left << setw(32) << "xMap::containsKey + get" << right << setw(10) << containsNs
+         << (found == hits[0] ? "" : "   MISMATCH") << endl;
+
+    int nthrows = nprobes / 10;
+    found = 0;
+    start = chrono::steady_clock::now();
+    for(int idx=0; idx < nthrows; idx++){
+        try{
+            found += plain.get(probes[idx]) == probes[idx] ? 1 : 0;
+        }
+        catch(KeyNotFound& e){}
+    }
+    double throwNs = chrono::duration<double, std::nano>(chrono::steady_clock::now() - start).count() / nthrows;
+    cout << left << setw(32) << "xMap::get, KeyNotFound caught" << right << setw(10) << throwNs
+         << "   (" << nthrows << " probes)" << endl;
+
+    //false positives: probes the filter lets through that the map does not hold
+    long long passedCuckoo = 0, passedBloom = 0, misses = 0;
+    for(int key: probes){
+        if(plain.find(key) != 0) continue;
+        misses++;
+        passedCuckoo += cuckoo.getFilter().mayContain(key) ? 1 : 0;
+        passedBloom += bloom.getFilter().mayContain(key) ? 1 : 0;
+    }
+    cout << setprecision(4);
+    cout << "CuckooFilter: " << cuckoo.getFilter().fingerprintBits() << "-bit fingerprints, "
+         << (double)cuckoo.getFilter().memoryBytes() / nkeys << " bytes/key, false positives "
+         << (double)passedCuckoo / misses << endl;
+    cout << "BlockedBloomFilter: k = " << bloom.getFilter().hashCount() << ", "
+         << (double)bloom.getFilter().memoryBytes() / nkeys << " bytes/key, false positives "
+         << (double)passedBloom / misses << endl;
+}
+
+#endif /* FILTERBENCHMARK_H */
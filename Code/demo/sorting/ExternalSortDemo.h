@@ -0,0 +1,105 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines the demo and benchmark of ExternalSort
+*/
+
+#ifndef EXTERNALSORTDEMO_H
+#define EXTERNALSORTDEMO_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include "sorting/ExternalSort.h"
+#include "loader/RowStream.h"
+using namespace std;
+
+/*
+! externalSortDemo1: sort a small .npy table by its first column, dropping duplicate keys
+*/
+void externalSortDemo1(string dir="."){
+    string input = dir + "/extsort_demo.npy";
+    string output = dir + "/extsort_demo_sorted.npy";
+    {
+        NpyRowWriter<int> writer(input, 2);
+        int rows[][2] = {{5, 50}, {1, 10}, {4, 40}, {1, 11}, {3, 30}, {5, 51}, {2, 20}};
+        writer.write(&rows[0][0], 7);
+    }
+    ExternalSort<int> sorter(ExternalSort<int>::DEFAULT_MEMORY, 0, 0, true, dir);
+    long long n = sorter.sortNpyFile(input, output);
+
+    NpyRowReader<int> reader(output);
+    int row[2];
+    cout << n << " rows (key, value):";
+    while(reader.read(row, 1)) cout << " (" << row[0] << ", " << row[1] << ")";
+    cout << endl;
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+/*
+! externalSortBenchmarkDemo(totalMB, budgetMB, width, dir)
+? Functionality:
+    * Writes a binary file of random float rows ("width" columns, totalMB megabytes),
+      sorts it by column 0 with ExternalSort under a memory budget of budgetMB,
+      checks the output while streaming it back, and prints time and throughput.
+    * The same file is then sorted with a budget large enough to hold it (one run,
+      no spilling) as the in-memory reference.
+*/
+void externalSortBenchmarkDemo(long long totalMB=256, long long budgetMB=32, int width=4, string dir="."){
+    string input = dir + "/extsort_bench.bin";
+    string output = dir + "/extsort_bench_sorted.bin";
+    long long rowBytes = sizeof(float) * width;
+    long long nrows = (totalMB << 20) / rowBytes;
+    {
+        BinaryRowWriter<float> writer(input, width);
+        std::mt19937 engine(2024);
+        std::uniform_real_distribution<float> dist(0, 1);
+        vector<float> block(4096 * width);
+        for(long long done=0; done < nrows; ){
+            long long n = nrows - done < 4096 ? nrows - done : 4096;
+            for(long long idx=0; idx < n * width; idx++) block[idx] = dist(engine);
+            writer.write(block.data(), n);
+            done += n;
+        }
+    }
+    cout << "External sort of " << nrows << " rows x " << width << " floats ("
+         << totalMB << " MB) by column 0" << endl;
+    cout << left << setw(14) << "budget (MB)" << right << setw(8) << "runs" << setw(8) << "passes"
+         << setw(12) << "time (ms)" << setw(10) << "MB/s" << endl;
+
+    long long budgets[] = {budgetMB, totalMB * 2 + 1};
+    for(long long budget: budgets){
+        ExternalSort<float> sorter(budget << 20, 0, 0, false, dir);
+        auto start = chrono::steady_clock::now();
+        sorter.sortBinaryFile(input, output, width);
+        auto stop = chrono::steady_clock::now();
+        double ms = chrono::duration<double, std::milli>(stop - start).count();
+
+        //stream the result back and check the order
+        BinaryRowReader<float> reader(output, width);
+        vector<float> block(4096 * width);
+        float last = -1;
+        long long count = 0;
+        bool ok = true;
+        while(long long n = reader.read(block.data(), 4096)){
+            for(long long idx=0; idx < n; idx++){
+                ok = ok && block[idx * width] >= last;
+                last = block[idx * width];
+            }
+            count += n;
+        }
+        ok = ok && count == nrows;
+
+        cout << left << setw(14) << budget << right << setw(8) << sorter.getRunCount()
+             << setw(8) << sorter.getMergePasses() << setw(12) << fixed << setprecision(1) << ms
+             << setw(10) << setprecision(1) << totalMB * 1000.0 / ms << (ok ? "" : "  FAIL") << endl;
+    }
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+#endif /* EXTERNALSORTDEMO_H */
@@ -0,0 +1,332 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines the benchmark harness for ISort<T> implementations
+*/
+
+#ifndef SORTBENCHMARK_H
+#define SORTBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "sorting/ISort.h"
+#include "sorting/IntroSort.h"
+#include "sorting/ParallelSort.h"
+#include "sorting/DLinkedListSE.h"
+#include "sorting/RadixSort.h"
+#include "sorting/SortingNetwork.h"
+#include "util/Point.h"
+using namespace std;
+
+/*
+! SortBenchInput: the input distributions every algorithm is timed on
+*/
+enum SortBenchInput{
+    BENCH_RANDOM = 0,
+    BENCH_SORTED,
+    BENCH_REVERSED,
+    BENCH_DUPLICATES,
+    BENCH_NUM_INPUTS
+};
+
+string sortBenchInputName(int input){
+    switch(input){
+        case BENCH_RANDOM:     return "random";
+        case BENCH_SORTED:     return "sorted";
+        case BENCH_REVERSED:   return "reversed";
+        case BENCH_DUPLICATES: return "duplicates";
+    }
+    return "?";
+}
+
+/*
+! sortBenchFill: fill data with one of the distributions; uses a fixed seed so that
+* every algorithm sorts exactly the same sequence.
+*/
+template<class T>
+void sortBenchFill(T* data, int size, int input, unsigned seed=2024){
+    std::mt19937 engine(seed);
+    switch(input){
+        case BENCH_SORTED:
+            for(int idx=0; idx < size; idx++) data[idx] = (T)idx;
+            break;
+        case BENCH_REVERSED:
+            for(int idx=0; idx < size; idx++) data[idx] = (T)(size - idx);
+            break;
+        case BENCH_DUPLICATES:{
+            std::uniform_int_distribution<int> dist(0, 15);
+            for(int idx=0; idx < size; idx++) data[idx] = (T)dist(engine);
+            break;
+        }
+        default:{
+            std::uniform_int_distribution<int> dist(0, 1 << 30);
+            for(int idx=0; idx < size; idx++) data[idx] = (T)dist(engine);
+        }
+    }
+}
+
+template<class T>
+bool sortBenchIsSorted(T* data, int size){
+    for(int idx=1; idx < size; idx++)
+        if(data[idx] < data[idx - 1]) return false;
+    return true;
+}
+
+/*
+! sortBenchmark(algorithms, names, nalgorithms, size, repeat)
+? Functionality:
+    * Runs every ISort<T> in "algorithms" on random, sorted, reversed and
+      many-duplicate inputs of "size" elements; std::sort is timed as the reference.
+    * Prints the best-of-"repeat" time in milliseconds, and FAIL if an output is not sorted.
+*/
+template<class T>
+void sortBenchmark(ISort<T>** algorithms, string* names, int nalgorithms, int size, int repeat=3){
+    T* source = new T[size];
+    T* work = new T[size];
+
+    cout << "Sorting " << size << " elements (best of " << repeat << ", ms)" << endl;
+    cout << left << setw(22) << "algorithm";
+    for(int input=0; input < BENCH_NUM_INPUTS; input++)
+        cout << right << setw(12) << sortBenchInputName(input);
+    cout << endl;
+
+    for(int alg=-1; alg < nalgorithms; alg++){
+        cout << left << setw(22) << (alg < 0 ? string("std::sort") : names[alg]);
+        for(int input=0; input < BENCH_NUM_INPUTS; input++){
+            sortBenchFill(source, size, input);
+            double best = 1e30;
+            bool ok = true;
+            for(int run=0; run < repeat; run++){
+                std::copy(source, source + size, work);
+                auto start = chrono::steady_clock::now();
+                if(alg < 0) std::sort(work, work + size);
+                else algorithms[alg]->sort(work, size);
+                auto stop = chrono::steady_clock::now();
+                double ms = chrono::duration<double, std::milli>(stop - start).count();
+                if(ms < best) best = ms;
+                ok = ok && sortBenchIsSorted(work, size);
+            }
+            if(ok) cout << right << setw(12) << fixed << setprecision(2) << best;
+            else cout << right << setw(12) << "FAIL";
+        }
+        cout << endl;
+    }
+
+    delete []source;
+    delete []work;
+}
+
+void sortBenchmarkDemo1(int size=1000000){
+    IntroSort<int> introSort;
+    ISort<int>* algorithms[] = {&introSort};
+    string names[] = {"IntroSort"};
+    sortBenchmark<int>(algorithms, names, 1, size);
+}
+
+/*
+! parallelSortScalingDemo(size, maxThreads)
+? Functionality:
+    * Times ParallelMergeSort (array) and DLinkedListSE::parallelSort (list) on random
+      input with 1, 2, 4, ... maxThreads workers, and prints the speed-up over 1 thread.
+    * DLinkedListSE::sort (sequential, copying merge sort) is timed once as the list baseline.
+*/
+void parallelSortScalingDemo(int size=10000000, int maxThreads=0, int listSize=1000000){
+    if(maxThreads <= 0) maxThreads = ThreadPool::defaultThreads();
+    int* source = new int[size];
+    int* work = new int[size];
+    sortBenchFill(source, size, BENCH_RANDOM);
+
+    DLinkedListSE<int> list;
+    auto listStart = chrono::steady_clock::now();
+    for(int idx=0; idx < listSize; idx++) list.add(source[idx]);
+    list.sort();
+    auto listStop = chrono::steady_clock::now();
+    double listBase = chrono::duration<double, std::milli>(listStop - listStart).count();
+    cout << "DLinkedListSE::sort, " << listSize << " items (incl. build): "
+         << fixed << setprecision(2) << listBase << " ms" << endl;
+
+    cout << "Parallel sort scaling: array " << size << " / list " << listSize << " random ints (ms)" << endl;
+    cout << left << setw(10) << "threads"
+         << right << setw(12) << "array" << setw(10) << "speedup"
+         << setw(12) << "list" << setw(10) << "speedup" << endl;
+    double arrayOne = 0, listOne = 0;
+    for(int nthreads=1; ; nthreads *= 2){
+        if(nthreads > maxThreads) nthreads = maxThreads;
+        ThreadPool pool(nthreads);
+        ParallelMergeSort<int> sortAlg(&pool, 0, nthreads == 1 ? size + 1 : ParallelMergeSort<int>::MIN_PARALLEL_SIZE);
+
+        std::copy(source, source + size, work);
+        auto start = chrono::steady_clock::now();
+        sortAlg.sort(work, size);
+        auto stop = chrono::steady_clock::now();
+        double arrayMs = chrono::duration<double, std::milli>(stop - start).count();
+        bool ok = sortBenchIsSorted(work, size);
+
+        DLinkedListSE<int> plist;
+        for(int idx=0; idx < listSize; idx++) plist.add(source[idx]);
+        start = chrono::steady_clock::now();
+        plist.parallelSort(0, &pool);
+        stop = chrono::steady_clock::now();
+        double listMs = chrono::duration<double, std::milli>(stop - start).count();
+
+        if(nthreads == 1){
+            arrayOne = arrayMs;
+            listOne = listMs;
+        }
+        cout << left << setw(10) << nthreads << right << fixed << setprecision(2)
+             << setw(12) << arrayMs << setw(9) << arrayOne / arrayMs << "x"
+             << setw(12) << listMs << setw(9) << listOne / listMs << "x"
+             << (ok ? "" : "  FAIL") << endl;
+        if(nthreads == maxThreads) break;
+    }
+
+    delete []source;
+    delete []work;
+}
+
+/*
+! radixSortBenchmarkDemo(size)
+? Functionality:
+    * RadixSort against the comparison sorts on int, float and double keys (all four inputs),
+      on random strings, and on Point records keyed by x (radixSortByKey vs a comparator sort).
+*/
+int sortBenchPointX(Point& lhs, Point& rhs){
+    if(lhs.getX() < rhs.getX()) return -1;
+    else if(lhs.getX() > rhs.getX()) return +1;
+    else return 0;
+}
+
+void radixSortBenchmarkDemo(int size=1000000){
+    {
+        IntroSort<int> introSort; ParallelMergeSort<int> parallelSort; RadixSort<int> radixSort;
+        ISort<int>* algorithms[] = {&introSort, &parallelSort, &radixSort};
+        string names[] = {"IntroSort<int>", "ParallelMergeSort<int>", "RadixSort<int>"};
+        sortBenchmark<int>(algorithms, names, 3, size);
+    }
+    {
+        IntroSort<float> introSort; RadixSort<float> radixSort;
+        ISort<float>* algorithms[] = {&introSort, &radixSort};
+        string names[] = {"IntroSort<float>", "RadixSort<float>"};
+        sortBenchmark<float>(algorithms, names, 2, size);
+    }
+    {
+        IntroSort<double> introSort; RadixSort<double> radixSort;
+        ISort<double>* algorithms[] = {&introSort, &radixSort};
+        string names[] = {"IntroSort<double>", "RadixSort<double>"};
+        sortBenchmark<double>(algorithms, names, 2, size);
+    }
+
+    //strings: random lower-case words of length 4..16
+    {
+        std::mt19937 engine(2024);
+        std::uniform_int_distribution<int> length(4, 16), letter('a', 'z');
+        int nstrings = size / 4;
+        string* source = new string[nstrings];
+        string* work = new string[nstrings];
+        for(int idx=0; idx < nstrings; idx++){
+            int len = length(engine);
+            for(int c=0; c < len; c++) source[idx] += (char)letter(engine);
+        }
+        IntroSort<string> introSort; RadixSort<string> radixSort;
+        ISort<string>* algorithms[] = {&introSort, &radixSort};
+        string names[] = {"IntroSort<string>", "RadixSort<string>"};
+        cout << "Sorting " << nstrings << " random strings (ms)" << endl;
+        for(int alg=0; alg < 2; alg++){
+            std::copy(source, source + nstrings, work);
+            auto start = chrono::steady_clock::now();
+            algorithms[alg]->sort(work, nstrings);
+            auto stop = chrono::steady_clock::now();
+            cout << left << setw(22) << names[alg] << right << setw(12) << fixed << setprecision(2)
+                 << chrono::duration<double, std::milli>(stop - start).count()
+                 << (sortBenchIsSorted(work, nstrings) ? "" : "  FAIL") << endl;
+        }
+        delete []source;
+        delete []work;
+    }
+
+    //records: Point by x
+    {
+        Point* source = Point::genPoints(size, -1000, 1000);
+        Point* work = new Point[size];
+        cout << "Sorting " << size << " Point records by x (ms)" << endl;
+
+        std::copy(source, source + size, work);
+        auto start = chrono::steady_clock::now();
+        IntroSort<Point>().sort(work, size, &sortBenchPointX);
+        auto stop = chrono::steady_clock::now();
+        cout << left << setw(22) << "IntroSort(comparator)" << right << setw(12) << fixed << setprecision(2)
+             << chrono::duration<double, std::milli>(stop - start).count() << endl;
+
+        std::copy(source, source + size, work);
+        start = chrono::steady_clock::now();
+        radixSortByKey(work, size, [](Point& point){ return point.getX(); });
+        stop = chrono::steady_clock::now();
+        cout << left << setw(22) << "radixSortByKey" << right << setw(12) << fixed << setprecision(2)
+             << chrono::duration<double, std::milli>(stop - start).count() << endl;
+
+        delete []source;
+        delete []work;
+    }
+}
+
+/*
+! sortingNetworkBenchmark<T>(total)
+? Functionality:
+    * Cost per element (ns) of sorting many small arrays of 8, 16, 24, 32, 48 and 64 items,
+      "total" items in all: insertion sort against every SortingNetwork kernel the CPU runs.
+*/
+template<class T>
+void sortingNetworkBenchmark(string typeName, int total=1 << 20, int repeat=5){
+    T* source = new T[total];
+    T* work = new T[total];
+    sortBenchFill(source, total, BENCH_RANDOM);
+    int best = SortingNetwork<T>::kernel();
+    int sizes[] = {8, 16, 24, 32, 48, 64};
+
+    cout << "Small-array sort of " << typeName << " (ns per element, best of " << repeat << ")" << endl;
+    cout << left << setw(8) << "size" << right << setw(12) << "insertion";
+    for(int kernel=0; kernel <= best; kernel++) cout << setw(12) << SortingNetwork<T>::kernelName(kernel);
+    cout << endl;
+
+    for(int n: sizes){
+        cout << left << setw(8) << n;
+        for(int alg=-1; alg <= best; alg++){
+            double bestNs = 1e30;
+            bool ok = true;
+            for(int run=0; run < repeat; run++){
+                std::copy(source, source + total, work);
+                auto start = chrono::steady_clock::now();
+                for(int offset=0; offset + n <= total; offset += n){
+                    if(alg < 0){
+                        typename IntroSort<T>::OperatorLess less;
+                        IntroSort<T>::insertionSort(work + offset, work + offset + n, less);
+                    }
+                    else SortingNetwork<T>::sort(work + offset, n, alg);
+                }
+                auto stop = chrono::steady_clock::now();
+                double ns = chrono::duration<double, std::nano>(stop - start).count() / total;
+                if(ns < bestNs) bestNs = ns;
+                for(int offset=0; ok && offset + n <= total; offset += n)
+                    ok = sortBenchIsSorted(work + offset, n);
+            }
+            if(ok) cout << right << setw(12) << fixed << setprecision(2) << bestNs;
+            else cout << right << setw(12) << "FAIL";
+        }
+        cout << endl;
+    }
+
+    delete []source;
+    delete []work;
+}
+
+void sortingNetworkBenchmarkDemo(int total=1 << 20){
+    sortingNetworkBenchmark<int>("int", total);
+    sortingNetworkBenchmark<float>("float", total);
+    sortingNetworkBenchmark<double>("double", total);
+}
+
+#endif /* SORTBENCHMARK_H */
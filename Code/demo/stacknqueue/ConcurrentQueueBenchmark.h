@@ -0,0 +1,220 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines throughput and latency benchmarks of SPSCQueue and MPMCQueue
+*/
+
+#ifndef CONCURRENTQUEUEBENCHMARK_H
+#define CONCURRENTQUEUEBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include "stacknqueue/ArrayQueue.h"
+#include "stacknqueue/SPSCQueue.h"
+#include "stacknqueue/MPMCQueue.h"
+using namespace std;
+
+/*
+! LockedQueue<T>: the baseline, an ArrayQueue<T> behind one std::mutex,
+* with the same tryPush / tryPop / close surface as the lock-free queues
+*/
+template<class T>
+class LockedQueue{
+private:
+    ArrayQueue<T> queue;
+    std::mutex lock;
+    int limit;
+    std::atomic<bool> closed;
+public:
+    LockedQueue(int capacity=1024): queue(0, 0, capacity), limit(capacity), closed(false){}
+
+    bool tryPush(T item){
+        std::lock_guard<std::mutex> guard(lock);
+        if(queue.size() >= limit) return false;
+        queue.push(item);
+        return true;
+    }
+    bool tryPop(T& item){
+        std::lock_guard<std::mutex> guard(lock);
+        if(queue.empty()) return false;
+        item = queue.pop();
+        return true;
+    }
+    int tryPushN(const T* items, int n){
+        std::lock_guard<std::mutex> guard(lock);
+        int count = 0;
+        while(count < n && queue.size() < limit) queue.push(items[count++]);
+        return count;
+    }
+    int tryPopN(T* items, int n){
+        std::lock_guard<std::mutex> guard(lock);
+        int count = 0;
+        while(count < n && !queue.empty()) items[count++] = queue.pop();
+        return count;
+    }
+    void push(T item){
+        SpinWait spin;
+        while(!tryPush(item)) spin.wait();
+    }
+    bool pop(T& item){
+        SpinWait spin;
+        while(!tryPop(item)){
+            if(closed.load(std::memory_order_acquire)) return tryPop(item);
+            spin.wait();
+        }
+        return true;
+    }
+    void pushN(const T* items, int n){
+        SpinWait spin;
+        while(n > 0){
+            int count = tryPushN(items, n);
+            if(count == 0){
+                spin.wait();
+                continue;
+            }
+            spin.reset();
+            items += count;
+            n -= count;
+        }
+    }
+    int popN(T* items, int n){
+        SpinWait spin;
+        while(true){
+            int count = tryPopN(items, n);
+            if(count > 0) return count;
+            if(closed.load(std::memory_order_acquire)) return tryPopN(items, n);
+            spin.wait();
+        }
+    }
+    void close(){
+        closed.store(true, std::memory_order_release);
+    }
+};
+
+/*
+! queueThroughputRun<QueueType>(producers, consumers, nitems, batch)
+? Functionality:
+    * Each producer pushes its share of 0..nitems-1 (push, or pushN in blocks of
+      "batch"), consumers pop until the queue is closed and drained; the sum of
+      the popped items is checked.
+? Return:
+    * double: million items per second
+*/
+template<class QueueType>
+double queueThroughputRun(int producers, int consumers, int nitems, int batch, int capacity=1024){
+    QueueType queue(capacity);
+    std::atomic<long long> total(0);
+    std::atomic<int> running(producers);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+
+    for(int consumer=0; consumer < consumers; consumer++){
+        threads.emplace_back([&queue, &total, batch](){
+            long long sum = 0;
+            if(batch <= 1){
+                int item;
+                while(queue.pop(item)) sum += item;
+            }
+            else{
+                vector<int> items(batch);
+                int count;
+                while((count = queue.popN(items.data(), batch)) > 0)
+                    for(int idx=0; idx < count; idx++) sum += items[idx];
+            }
+            total += sum;
+        });
+    }
+    for(int producer=0; producer < producers; producer++){
+        threads.emplace_back([&queue, &running, producer, producers, nitems, batch](){
+            int first = (int)((long long)nitems * producer / producers);
+            int last = (int)((long long)nitems * (producer + 1) / producers);
+            if(batch <= 1){
+                for(int item=first; item < last; item++) queue.push(item);
+            }
+            else{
+                vector<int> items(batch);
+                for(int item=first; item < last; item += batch){
+                    int count = last - item < batch ? last - item : batch;
+                    for(int idx=0; idx < count; idx++) items[idx] = item + idx;
+                    queue.pushN(items.data(), count);
+                }
+            }
+            if(--running == 0) queue.close();
+        });
+    }
+    for(thread& worker: threads) worker.join();
+
+    auto stop = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(stop - start).count();
+    if(total.load() != (long long)nitems * (nitems - 1) / 2) cout << "  (checksum FAIL)";
+    return nitems / seconds / 1e6;
+}
+
+/*
+! queueLatencyRun<QueueType>(rounds)
+? Functionality:
+    * Ping-pong between two threads over a pair of queues: one round trip is
+      push on "ping", pop on the other side, push back on "pong", pop.
+? Return:
+    * double: mean round-trip time in nanoseconds
+*/
+template<class QueueType>
+double queueLatencyRun(int rounds){
+    QueueType ping(64), pong(64);
+    thread echo([&ping, &pong, rounds](){
+        int item;
+        for(int round=0; round < rounds; round++){
+            ping.pop(item);
+            pong.push(item);
+        }
+    });
+    auto start = chrono::steady_clock::now();
+    int item;
+    for(int round=0; round < rounds; round++){
+        ping.push(round);
+        pong.pop(item);
+    }
+    auto stop = chrono::steady_clock::now();
+    echo.join();
+    return chrono::duration<double, std::nano>(stop - start).count() / rounds;
+}
+
+void concurrentQueueThroughputDemo(int nitems=10000000){
+    cout << "Queue throughput, " << nitems << " items (million items/s), "
+         << thread::hardware_concurrency() << " hardware threads" << endl;
+    cout << left << setw(30) << "queue (producers x consumers)" << right
+         << setw(10) << "single" << setw(10) << "batch 32" << endl;
+    cout << fixed << setprecision(1);
+
+    cout << left << setw(30) << "LockedQueue 1x1" << right
+         << setw(10) << queueThroughputRun<LockedQueue<int>>(1, 1, nitems, 1)
+         << setw(10) << queueThroughputRun<LockedQueue<int>>(1, 1, nitems, 32) << endl;
+    cout << left << setw(30) << "SPSCQueue 1x1" << right
+         << setw(10) << queueThroughputRun<SPSCQueue<int>>(1, 1, nitems, 1)
+         << setw(10) << queueThroughputRun<SPSCQueue<int>>(1, 1, nitems, 32) << endl;
+    cout << left << setw(30) << "MPMCQueue 1x1" << right
+         << setw(10) << queueThroughputRun<MPMCQueue<int>>(1, 1, nitems, 1)
+         << setw(10) << queueThroughputRun<MPMCQueue<int>>(1, 1, nitems, 32) << endl;
+    cout << left << setw(30) << "LockedQueue 4x4" << right
+         << setw(10) << queueThroughputRun<LockedQueue<int>>(4, 4, nitems, 1)
+         << setw(10) << queueThroughputRun<LockedQueue<int>>(4, 4, nitems, 32) << endl;
+    cout << left << setw(30) << "MPMCQueue 4x4" << right
+         << setw(10) << queueThroughputRun<MPMCQueue<int>>(4, 4, nitems, 1)
+         << setw(10) << queueThroughputRun<MPMCQueue<int>>(4, 4, nitems, 32) << endl;
+}
+
+void concurrentQueueLatencyDemo(int rounds=200000){
+    cout << "Ping-pong round trip, " << rounds << " rounds (ns)" << endl;
+    cout << fixed << setprecision(0);
+    cout << left << setw(30) << "LockedQueue" << right << setw(10) << queueLatencyRun<LockedQueue<int>>(rounds) << endl;
+    cout << left << setw(30) << "SPSCQueue" << right << setw(10) << queueLatencyRun<SPSCQueue<int>>(rounds) << endl;
+    cout << left << setw(30) << "MPMCQueue" << right << setw(10) << queueLatencyRun<MPMCQueue<int>>(rounds) << endl;
+}
+
+#endif /* CONCURRENTQUEUEBENCHMARK_H */
@@ -0,0 +1,122 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines benchmarks of the IDeck<T> implementations (list- and array-backed)
+*/
+
+#ifndef DECKBENCHMARK_H
+#define DECKBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include "stacknqueue/Queue.h"
+#include "stacknqueue/Stack.h"
+#include "stacknqueue/ArrayQueue.h"
+#include "stacknqueue/ArrayStack.h"
+using namespace std;
+
+/*
+! deckRun(deck, nops, window): push/pop throughput of one IDeck<int>, in million ops/s
+* "window" items are kept in the deck: push window items, then alternate push/pop,
+* then drain; window = nops means push everything, then pop everything.
+*/
+double deckRun(IDeck<int>* deck, int nops, int window){
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    int pushed = 0;
+    for(; pushed < window && pushed < nops; pushed++) deck->push(pushed);
+    for(; pushed < nops; pushed++){
+        deck->push(pushed);
+        checksum += deck->pop();
+    }
+    while(!deck->empty()) checksum += deck->pop();
+    auto stop = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(stop - start).count();
+    if(checksum != (long long)nops * (nops - 1) / 2) cout << "  (checksum FAIL)";
+    return 2.0 * nops / seconds / 1e6;
+}
+
+void deckThroughputDemo(int nops=10000000){
+    int windows[] = {16, 1024, nops};
+    cout << "Push/pop throughput, " << nops << " pushes (million ops/s)" << endl;
+    cout << left << setw(16) << "window";
+    for(int window: windows) cout << right << setw(12) << window;
+    cout << endl;
+
+    string names[] = {"Queue", "ArrayQueue", "Stack", "ArrayStack"};
+    for(int kind=0; kind < 4; kind++){
+        cout << left << setw(16) << names[kind];
+        for(int window: windows){
+            IDeck<int>* deck;
+            if(kind == 0) deck = new Queue<int>();
+            else if(kind == 1) deck = new ArrayQueue<int>();
+            else if(kind == 2) deck = new Stack<int>();
+            else deck = new ArrayStack<int>();
+            cout << right << setw(12) << fixed << setprecision(1) << deckRun(deck, nops, window);
+            delete deck;
+        }
+        cout << endl;
+    }
+}
+
+/*
+! bfsQueueDemo(nvertices, nedges)
+? Functionality:
+    * Breadth-first search over a random directed graph with nedges edges (adjacency
+      in compressed arrays, so only the frontier queue differs between the runs),
+      with Queue<int> and with ArrayQueue<int> as the frontier.
+*/
+template<class QueueType>
+double bfsQueueRun(vector<long long>& offsets, vector<int>& targets, int source, int& visitedCount){
+    int nvertices = (int)offsets.size() - 1;
+    vector<char> visited(nvertices, 0);
+    auto start = chrono::steady_clock::now();
+    QueueType frontier;
+    frontier.push(source);
+    visited[source] = 1;
+    visitedCount = 1;
+    while(!frontier.empty()){
+        int vertex = frontier.pop();
+        for(long long edge=offsets[vertex]; edge < offsets[vertex + 1]; edge++){
+            int next = targets[edge];
+            if(!visited[next]){
+                visited[next] = 1;
+                visitedCount++;
+                frontier.push(next);
+            }
+        }
+    }
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void bfsQueueDemo(int nvertices=1000000, long long nedges=10000000){
+    std::mt19937 engine(2024);
+    std::uniform_int_distribution<int> pick(0, nvertices - 1);
+    vector<long long> offsets(nvertices + 1, 0);
+    vector<int> sources(nedges), targets(nedges);
+    for(long long edge=0; edge < nedges; edge++){
+        sources[edge] = pick(engine);
+        offsets[sources[edge] + 1]++;
+    }
+    for(int vertex=0; vertex < nvertices; vertex++) offsets[vertex + 1] += offsets[vertex];
+    vector<long long> next(offsets.begin(), offsets.end() - 1);
+    for(long long edge=0; edge < nedges; edge++) targets[next[sources[edge]]++] = pick(engine);
+    sources.clear();
+    sources.shrink_to_fit();
+
+    cout << "BFS on " << nvertices << " vertices / " << nedges << " edges (ms)" << endl;
+    int visitedList = 0, visitedArray = 0;
+    double listMs = bfsQueueRun<Queue<int>>(offsets, targets, 0, visitedList);
+    double arrayMs = bfsQueueRun<ArrayQueue<int>>(offsets, targets, 0, visitedArray);
+    cout << left << setw(16) << "Queue" << right << setw(12) << fixed << setprecision(1) << listMs
+         << "   visited " << visitedList << endl;
+    cout << left << setw(16) << "ArrayQueue" << right << setw(12) << fixed << setprecision(1) << arrayMs
+         << "   visited " << visitedArray << (visitedArray == visitedList ? "" : "  FAIL") << endl;
+}
+
+#endif /* DECKBENCHMARK_H */
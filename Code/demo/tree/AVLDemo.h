@@ -261,7 +261,7 @@ void AVLDemo8(){
     tree.println();
 }
 
-string pointEntry2Str(float& key, Point*& point){
+string pointEntry2Str(float& /*key*/, Point*& point){
     stringstream os;
     os << *point;
     return os.str();
@@ -0,0 +1,168 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines a multi-threaded benchmark of ConcurrentSkipList under mixed read/write workloads
+*/
+
+#ifndef CONCURRENTMAPBENCHMARK_H
+#define CONCURRENTMAPBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <shared_mutex>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include "tree/ConcurrentSkipList.h"
+using namespace std;
+
+/*
+! LockedMap<K, V>: the baseline, a std::map behind one std::shared_mutex
+* (searches and scans share the lock, add / remove take it exclusively),
+* with the add / remove / search / range-count surface used by mapMixRun
+*/
+template<class K, class V>
+class LockedMap{
+private:
+    std::map<K, V> map;
+    std::shared_mutex lock;
+public:
+    void add(K key, V value){
+        std::unique_lock<std::shared_mutex> guard(lock);
+        map[key] = value;
+    }
+    V remove(K key){
+        std::unique_lock<std::shared_mutex> guard(lock);
+        auto it = map.find(key);
+        if(it == map.end()) return V();
+        V value = it->second;
+        map.erase(it);
+        return value;
+    }
+    V search(K key, bool& found){
+        std::shared_lock<std::shared_mutex> guard(lock);
+        auto it = map.find(key);
+        found = it != map.end();
+        return found ? it->second : V();
+    }
+    long long scan(K lo, K hi){
+        std::shared_lock<std::shared_mutex> guard(lock);
+        long long sum = 0;
+        for(auto it = map.lower_bound(lo); it != map.end() && !(hi < it->first); ++it) sum += it->second;
+        return sum;
+    }
+};
+
+/*
+! SkipListMap<K, V>: ConcurrentSkipList with the same surface as LockedMap
+*/
+template<class K, class V>
+class SkipListMap{
+private:
+    ConcurrentSkipList<K, V> list;
+public:
+    void add(K key, V value){
+        list.add(key, value);
+    }
+    V remove(K key){
+        return list.remove(key);
+    }
+    V search(K key, bool& found){
+        return list.search(key, found);
+    }
+    long long scan(K lo, K hi){
+        long long sum = 0;
+        for(V value: list.range(lo, hi)) sum += value;
+        return sum;
+    }
+};
+
+/*
+! MapMix: percentages of each operation in a workload (they add up to 100)
+*/
+struct MapMix{
+    string name;
+    int search, add, remove, scan;
+};
+
+/*
+! mapMixRun<MapType>(mix, threads, keySpace, nops, width)
+? Functionality:
+    * The map is filled with the even keys of [0, keySpace), then "threads" threads
+      run nops operations between them: keys drawn uniformly from [0, keySpace),
+      operations drawn from mix; a scan sums the values of [key, key + width).
+      About half of the key space stays present, so searches hit half of the time.
+? Return:
+    * double: million operations per second (the prefill is not timed)
+*/
+template<class MapType>
+double mapMixRun(MapMix mix, int threads, int keySpace, int nops, int width){
+    MapType map;
+    for(int key=0; key < keySpace; key += 2) map.add(key, key);
+    std::atomic<long long> checksum(0);
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for(int worker=0; worker < threads; worker++){
+        int share = (int)((long long)nops * (worker + 1) / threads - (long long)nops * worker / threads);
+        workers.emplace_back([&map, &checksum, mix, share, keySpace, width, worker](){
+            std::mt19937 engine(1000 + worker);
+            std::uniform_int_distribution<int> pickKey(0, keySpace - 1), pickOp(0, 99);
+            long long sum = 0;
+            for(int op=0; op < share; op++){
+                int key = pickKey(engine);
+                int dice = pickOp(engine);
+                if(dice < mix.search){
+                    bool found;
+                    sum += map.search(key, found);
+                }
+                else if(dice < mix.search + mix.add) map.add(key, key);
+                else if(dice < mix.search + mix.add + mix.remove) sum += map.remove(key);
+                else sum += map.scan(key, key + width - 1);
+            }
+            checksum += sum;
+        });
+    }
+    for(thread& worker: workers) worker.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return nops / seconds / 1e6;
+}
+
+/*
+! concurrentMapBenchmark(keySpace, nops, width, threadCounts)
+? Functionality:
+    * ConcurrentSkipList against LockedMap (std::map + std::shared_mutex) for a
+      read-mostly mix (90% search, 9% add, 1% remove), a write-heavy mix
+      (50/25/25) and a scan mix (70% search, 10% add, 10% remove, 10% scans of
+      "width" keys), for each thread count. Throughput in million operations/s.
+? Notes:
+    * The lock-free list only pulls ahead when there are cores to run the threads
+      on; with fewer cores than threads both columns measure time slicing.
+*/
+void concurrentMapBenchmark(int keySpace=1000000, int nops=2000000, int width=100,
+                            vector<int> threadCounts={1, 2, 4, 8}){
+    vector<MapMix> mixes = {
+        {"90/9/1", 90, 9, 1, 0},
+        {"50/25/25", 50, 25, 25, 0},
+        {"70/10/10 +10 scan", 70, 10, 10, 10}
+    };
+    cout << "Concurrent ordered maps, " << keySpace << " keys (half present), " << nops
+         << " operations (million ops/s), " << thread::hardware_concurrency() << " hardware threads" << endl;
+    cout << left << setw(22) << "mix (search/add/rm)" << setw(10) << "threads" << right
+         << setw(14) << "skip list" << setw(14) << "locked map" << endl;
+    cout << fixed << setprecision(2);
+    for(MapMix& mix: mixes){
+        for(int threads: threadCounts){
+            double lockFree = mapMixRun<SkipListMap<int, long long>>(mix, threads, keySpace, nops, width);
+            double locked = mapMixRun<LockedMap<int, long long>>(mix, threads, keySpace, nops, width);
+            cout << left << setw(22) << mix.name << setw(10) << threads << right
+                 << setw(14) << lockFree << setw(14) << locked << endl;
+        }
+    }
+}
+
+#endif /* CONCURRENTMAPBENCHMARK_H */
@@ -0,0 +1,134 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines benchmarks of the string-keyed maps: RadixTree against xMap
+*/
+
+#ifndef STRINGMAPBENCHMARK_H
+#define STRINGMAPBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "hash/xMap.h"
+#include "tree/RadixTree.h"
+using namespace std;
+
+/*
+! fnvStringHash: FNV-1a, the xMap hash used by stringMapBenchmark
+* (xMap::stringKeyHash adds up the characters: names that differ only by their digits,
+* such as "layer_12.unit_34", land in a few hundred buckets, so it is not a fair baseline)
+*/
+int fnvStringHash(string& key, int capacity){
+    unsigned int hash = 2166136261u;
+    for(char c: key) hash = (hash ^ (unsigned char)c) * 16777619u;
+    return (int)(hash % (unsigned int)capacity);
+}
+
+/*
+! parameterNames(n): n distinct hierarchical names, "layer_<i>.unit_<j>.p<k>", shuffled
+* 1000 names per layer, 10 per unit.
+*/
+vector<string> parameterNames(int n){
+    vector<string> names(n);
+    for(int idx=0; idx < n; idx++){
+        names[idx] = "layer_" + to_string(idx / 1000) + ".unit_" + to_string(idx / 10 % 100) +
+                     ".p" + to_string(idx % 10);
+    }
+    std::mt19937 engine(48);
+    std::shuffle(names.begin(), names.end(), engine);
+    return names;
+}
+
+/*
+! stringMapBenchmark(nkeys, nprobes, nprefixes, xmapPrefixes)
+? Functionality:
+    * nkeys names (parameterNames) put into a RadixTree and an xMap (FNV-1a), then
+      nprobes get() of present names and nprobes find() of absent ones, then prefix
+      scans "layer_<i>." (1000 entries each) summing the values: RadixTree::withPrefix
+      against the only way xMap offers, keys() and a filter over all of them
+      (xmapPrefixes scans only: each one reads the whole map).
+    * Times in ms; prefix scans in microseconds per scan. The sums must agree.
+*/
+void stringMapBenchmark(int nkeys=1000000, int nprobes=1000000, int nprefixes=1000, int xmapPrefixes=10){
+    vector<string> names = parameterNames(nkeys);
+    std::mt19937 engine(49);
+    std::uniform_int_distribution<int> pick(0, nkeys - 1);
+    vector<string> hits(nprobes), misses(nprobes);
+    for(int idx=0; idx < nprobes; idx++){
+        hits[idx] = names[pick(engine)];
+        misses[idx] = hits[idx] + "x";
+    }
+    int layers = (nkeys + 999) / 1000;
+    vector<string> prefixes(nprefixes);
+    for(int idx=0; idx < nprefixes; idx++) prefixes[idx] = "layer_" + to_string(idx % layers) + ".";
+
+    RadixTree<int> tree;
+    xMap<string, int> map(&fnvStringHash);
+    double times[2][4];
+    long long checks[2][3];
+
+    auto start = chrono::steady_clock::now();
+    for(int idx=0; idx < nkeys; idx++) tree.put(names[idx], idx);
+    times[0][0] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for(int idx=0; idx < nkeys; idx++) map.put(names[idx], idx);
+    times[1][0] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+    checks[0][0] = checks[1][0] = 0;
+    start = chrono::steady_clock::now();
+    for(string& name: hits) checks[0][0] += tree.get(name);
+    times[0][1] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for(string& name: hits) checks[1][0] += map.get(name);
+    times[1][1] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+    checks[0][1] = checks[1][1] = 0;
+    start = chrono::steady_clock::now();
+    for(string& name: misses) checks[0][1] += tree.find(name) == 0 ? 1 : 0;
+    times[0][2] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for(string& name: misses) checks[1][1] += map.find(name) == 0 ? 1 : 0;
+    times[1][2] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+    //prefix scans: the first xmapPrefixes prefixes are checked against xMap
+    long long treeSum = 0;
+    checks[0][2] = checks[1][2] = 0;
+    start = chrono::steady_clock::now();
+    for(int idx=0; idx < nprefixes; idx++){
+        long long sum = 0;
+        for(int value: tree.withPrefix(prefixes[idx])) sum += value;
+        treeSum += sum;
+        if(idx < xmapPrefixes) checks[0][2] += sum;
+    }
+    times[0][3] = chrono::duration<double, std::micro>(chrono::steady_clock::now() - start).count() / nprefixes;
+    start = chrono::steady_clock::now();
+    int scans = xmapPrefixes < nprefixes ? xmapPrefixes : nprefixes;
+    for(int idx=0; idx < scans; idx++){
+        string& prefix = prefixes[idx];
+        DLinkedList<string> keys = map.keys();
+        for(string& key: keys){
+            if(key.compare(0, prefix.size(), prefix) == 0) checks[1][2] += map.get(key);
+        }
+    }
+    times[1][3] = scans == 0 ? 0 : chrono::duration<double, std::micro>(chrono::steady_clock::now() - start).count() / scans;
+
+    cout << "String maps, " << nkeys << " names: put, " << nprobes << " hits, " << nprobes
+         << " misses (ms); prefix scan of ~1000 entries (us per scan)" << endl;
+    cout << left << setw(18) << "map" << right << setw(12) << "put" << setw(12) << "get hit"
+         << setw(12) << "find miss" << setw(14) << "prefix scan" << endl;
+    cout << fixed << setprecision(1);
+    string labels[] = {"RadixTree", "xMap (FNV-1a)"};
+    for(int kind=0; kind < 2; kind++){
+        cout << left << setw(18) << labels[kind] << right << setw(12) << times[kind][0] << setw(12) << times[kind][1]
+             << setw(12) << times[kind][2] << setw(14) << times[kind][3] << endl;
+    }
+    bool agree = checks[0][0] == checks[1][0] && checks[0][1] == checks[1][1] && checks[0][2] == checks[1][2];
+    cout << "prefix sum over " << nprefixes << " scans: " << treeSum << (agree ? "" : "   MISMATCH") << endl;
+}
+
+#endif /* STRINGMAPBENCHMARK_H */
@@ -0,0 +1,469 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines benchmarks of the ordered maps behind IBST<K, V>
+*/
+
+#ifndef TREEBENCHMARK_H
+#define TREEBENCHMARK_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <numeric>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "tree/BPlusTree.h"
+#include "tree/AVL.h"
+#include "tree/TreeTraversal.h"
+using namespace std;
+
+/*
+! OrderedMapTimes: milliseconds of each phase of orderedMapRun
+*/
+struct OrderedMapTimes{
+    double randomInsert, ascendingInsert, search, rangeScan, erase;
+    long long checksum;
+};
+
+/*
+! orderedMapRun<Adapter>(keys, probes, ranges, width): one map type through every phase
+? Functionality:
+    * random insert of keys, search of the probes (all present), ranges.size() scans of
+      the keys in [lo, lo + width), removal of every other key, then a fresh map filled
+      in ascending order. Adapter wraps a BPlusTree or a std::map (see below).
+*/
+template<class Adapter>
+OrderedMapTimes orderedMapRun(vector<int>& keys, vector<int>& probes, vector<int>& ranges, int width){
+    OrderedMapTimes times;
+    times.checksum = 0;
+    int* marker = &width;
+    {
+        typename Adapter::Map map;
+        auto start = chrono::steady_clock::now();
+        for(int key: keys) Adapter::add(map, key, marker);
+        times.randomInsert = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for(int key: probes) times.checksum += Adapter::search(map, key) == marker;
+        times.search = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for(int lo: ranges) times.checksum += Adapter::scan(map, lo, lo + width - 1);
+        times.rangeScan = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for(size_t idx=0; idx < keys.size(); idx += 2) Adapter::remove(map, keys[idx]);
+        times.erase = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        times.checksum += Adapter::size(map);
+    }
+    typename Adapter::Map ascending;
+    auto start = chrono::steady_clock::now();
+    for(int key=0; key < (int)keys.size(); key++) Adapter::add(ascending, key, marker);
+    times.ascendingInsert = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    return times;
+}
+
+template<int NODE_BYTES>
+struct BPlusTreeAdapter{
+    typedef BPlusTree<int, int*, NODE_BYTES> Map;
+    static void add(Map& map, int key, int* value){
+        map.add(key, value);
+    }
+    static int* search(Map& map, int key){
+        bool found;
+        return map.search(key, found);
+    }
+    static long long scan(Map& map, int lo, int hi){
+        long long sum = 0;
+        for(auto it = map.lowerBound(lo); it != map.end() && !(hi < it.key()); it++) sum += it.key();
+        return sum;
+    }
+    static void remove(Map& map, int key){
+        map.remove(key);
+    }
+    static int size(Map& map){
+        return map.size();
+    }
+};
+
+struct AVLAdapter{
+    typedef AVL<int, int*> Map;
+    static void add(Map& map, int key, int* value){
+        map.add(key, value);
+    }
+    static int* search(Map& map, int key){
+        bool found;
+        return map.search(key, found);
+    }
+    static long long scan(Map& map, int lo, int hi){
+        long long sum = 0;
+        map.traverseRange(lo, hi, [&sum](int& key, int*& value){ sum += key; });
+        return sum;
+    }
+    static void remove(Map& map, int key){
+        map.remove(key);
+    }
+    static int size(Map& map){
+        return map.size();
+    }
+};
+
+struct StdMapAdapter{
+    typedef std::map<int, int*> Map;
+    static void add(Map& map, int key, int* value){
+        map[key] = value;
+    }
+    static int* search(Map& map, int key){
+        auto it = map.find(key);
+        return it == map.end() ? 0 : it->second;
+    }
+    static long long scan(Map& map, int lo, int hi){
+        long long sum = 0;
+        for(auto it = map.lower_bound(lo); it != map.end() && it->first <= hi; ++it) sum += it->first;
+        return sum;
+    }
+    static void remove(Map& map, int key){
+        map.erase(key);
+    }
+    static int size(Map& map){
+        return (int)map.size();
+    }
+};
+
+/*
+! orderedMapBenchmark(nkeys, nprobes, nranges, width)
+? Functionality:
+    * nkeys distinct keys (a permutation of 0..nkeys-1) in random order; every phase of
+      orderedMapRun for BPlusTree with 128, 256 and 512-byte nodes, for AVL and for
+      std::map (a red-black tree: like AVL, one heap node per key), then
+      BPlusTree::buildFromSorted against ascending add().
+    * The checksums must agree between the maps.
+*/
+void orderedMapBenchmark(int nkeys=1000000, int nprobes=1000000, int nranges=100000, int width=100){
+    std::mt19937 engine(43);
+    vector<int> keys(nkeys);
+    for(int idx=0; idx < nkeys; idx++) keys[idx] = idx;
+    std::shuffle(keys.begin(), keys.end(), engine);
+    vector<int> probes(nprobes), ranges(nranges);
+    std::uniform_int_distribution<int> pick(0, nkeys - 1);
+    for(int& key: probes) key = pick(engine);
+    for(int& lo: ranges) lo = pick(engine);
+
+    cout << "Ordered maps, " << nkeys << " int keys (ms): " << nprobes << " searches, "
+         << nranges << " range scans of " << width << " keys" << endl;
+    cout << left << setw(18) << "map" << right << setw(12) << "insert" << setw(12) << "ascending"
+         << setw(12) << "search" << setw(12) << "range scan" << setw(12) << "remove" << endl;
+    string names[] = {"BPlusTree<128>", "BPlusTree<256>", "BPlusTree<512>", "AVL", "std::map"};
+    OrderedMapTimes results[5];
+    results[0] = orderedMapRun<BPlusTreeAdapter<128>>(keys, probes, ranges, width);
+    results[1] = orderedMapRun<BPlusTreeAdapter<256>>(keys, probes, ranges, width);
+    results[2] = orderedMapRun<BPlusTreeAdapter<512>>(keys, probes, ranges, width);
+    results[3] = orderedMapRun<AVLAdapter>(keys, probes, ranges, width);
+    results[4] = orderedMapRun<StdMapAdapter>(keys, probes, ranges, width);
+    cout << fixed << setprecision(1);
+    for(int kind=0; kind < 5; kind++){
+        OrderedMapTimes& times = results[kind];
+        cout << left << setw(18) << names[kind] << right << setw(12) << times.randomInsert
+             << setw(12) << times.ascendingInsert << setw(12) << times.search << setw(12) << times.rangeScan
+             << setw(12) << times.erase << (times.checksum == results[4].checksum ? "" : "   MISMATCH") << endl;
+    }
+
+    vector<int> sorted(nkeys);
+    vector<int*> values(nkeys, (int*)0);
+    for(int idx=0; idx < nkeys; idx++) sorted[idx] = idx;
+    BPlusTree<int, int*> tree;
+    auto start = chrono::steady_clock::now();
+    tree.buildFromSorted(sorted.data(), values.data(), nkeys);
+    double buildMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << "BPlusTree<512>::buildFromSorted: " << buildMs << " ms, height " << tree.height() << endl;
+}
+
+/*
+! WalkNode: a plain binary tree node for traversalBenchmark
+*/
+struct WalkNode{
+    int key;
+    WalkNode* left;
+    WalkNode* right;
+};
+//links nodes[lo..hi] into a perfectly balanced tree, returns its root
+WalkNode* balancedWalkTree(vector<WalkNode>& nodes, int lo, int hi){
+    if(lo > hi) return 0;
+    int mid = lo + (hi - lo) / 2;
+    nodes[mid].left = balancedWalkTree(nodes, lo, mid - 1);
+    nodes[mid].right = balancedWalkTree(nodes, mid + 1, hi);
+    return &nodes[mid];
+}
+//the list-returning walk (recursive, as the ITreeWalker methods of a binary tree do it)
+void recursiveWalk(WalkNode* node, int order, DLinkedList<int>& list){
+    if(node == 0) return;
+    if(order == TreeOrder::NLR) list.add(node->key);
+    recursiveWalk(node->left, order, list);
+    if(order == TreeOrder::LNR) list.add(node->key);
+    recursiveWalk(node->right, order, list);
+    if(order == TreeOrder::LRN) list.add(node->key);
+}
+DLinkedList<int> levelOrderList(WalkNode* root){
+    DLinkedList<int> list;
+    ArrayQueue<WalkNode*> queue;
+    if(root != 0) queue.push(root);
+    while(!queue.empty()){
+        WalkNode* node = queue.pop();
+        list.add(node->key);
+        if(node->left != 0) queue.push(node->left);
+        if(node->right != 0) queue.push(node->right);
+    }
+    return list;
+}
+
+/*
+! traversalBenchmark(nkeys)
+? Functionality:
+    * Full walks of nkeys entries (ms), each summing the keys it visits:
+        - BPlusTree: ascendingList() against walk() (lazy iterators) and traverse() (visitor);
+        - a perfectly balanced binary tree, in every TreeOrder but RNL: a freshly built
+          DLinkedList (recursive, BFS with a queue) against BinaryTreeWalk iterators and forEach;
+        - a degenerate binary tree (a chain of nkeys right children), where the recursive
+          walk would need nkeys call frames: BinaryTreeWalk only.
+*/
+void traversalBenchmark(int nkeys=1000000){
+    long long expected = (long long)nkeys * (nkeys - 1) / 2;
+    cout << "Traversals of " << nkeys << " entries (ms)" << endl;
+    cout << fixed << setprecision(1);
+    auto report = [expected](string name, double ms, long long sum){
+        cout << left << setw(30) << name << right << setw(12) << ms << (sum == expected ? "" : "   MISMATCH") << endl;
+    };
+
+    vector<int> keys(nkeys);
+    for(int idx=0; idx < nkeys; idx++) keys[idx] = idx;
+    BPlusTree<int, int*> tree;
+    tree.buildFromSorted(keys.data(), 0, nkeys);
+    long long sum = 0;
+    auto start = chrono::steady_clock::now();
+    DLinkedList<int*> values = tree.ascendingList();    //the values are all null: count them
+    for(auto it = values.begin(); it != values.end(); it++) sum += (*it == 0);
+    double listMs = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+    cout << left << setw(30) << "BPlusTree ascendingList" << right << setw(12) << listMs
+         << (sum == nkeys ? "" : "   MISMATCH") << endl;
+    sum = 0;
+    start = chrono::steady_clock::now();
+    for(auto it = tree.begin(); it != tree.end(); it++) sum += it.key();
+    report("BPlusTree walk()", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), sum);
+    sum = 0;
+    start = chrono::steady_clock::now();
+    tree.traverse([&sum](int& key, int*& value){ sum += key; });
+    report("BPlusTree traverse()", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), sum);
+
+    vector<WalkNode> nodes(nkeys);
+    for(int idx=0; idx < nkeys; idx++) nodes[idx].key = idx;
+    WalkNode* root = balancedWalkTree(nodes, 0, nkeys - 1);
+    string orders[] = {"NLR", "LNR", "LRN", "RNL", "BFS"};
+    for(int order=TreeOrder::NLR; order <= TreeOrder::BFS; order++){
+        if(order == TreeOrder::RNL) continue;
+        sum = 0;
+        start = chrono::steady_clock::now();
+        DLinkedList<int> list;
+        if(order == TreeOrder::BFS) list = levelOrderList(root);
+        else recursiveWalk(root, order, list);
+        for(auto it = list.begin(); it != list.end(); it++) sum += *it;
+        report("balanced " + orders[order] + ", list", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), sum);
+        sum = 0;
+        start = chrono::steady_clock::now();
+        for(WalkNode* node: BinaryTreeWalk<WalkNode>(root, order)) sum += node->key;
+        report("balanced " + orders[order] + ", iterator", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), sum);
+        sum = 0;
+        start = chrono::steady_clock::now();
+        BinaryTreeWalk<WalkNode>(root, order).forEach([&sum](WalkNode* node){ sum += node->key; });
+        report("balanced " + orders[order] + ", forEach", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), sum);
+    }
+
+    for(int idx=0; idx < nkeys; idx++){
+        nodes[idx].left = 0;
+        nodes[idx].right = idx + 1 < nkeys ? &nodes[idx + 1] : 0;
+    }
+    for(int order=TreeOrder::NLR; order <= TreeOrder::BFS; order++){
+        sum = 0;
+        start = chrono::steady_clock::now();
+        for(WalkNode* node: BinaryTreeWalk<WalkNode>(&nodes[0], order)) sum += node->key;
+        report("chain " + orders[order] + ", iterator", chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count(), sum);
+    }
+}
+
+/*
+! LatencyTotal: AVLSum field adding up int keys (latencies in microseconds) as long long
+*/
+struct LatencyTotal{
+    typedef long long Type;
+    static long long get(int& latency, int*& value){
+        return latency;
+    }
+};
+
+/*
+! percentileBenchmark(nsamples, window, queryEvery)
+? Functionality:
+    * A stream of nsamples latencies (log-normal, median ~1.1 ms, in whole microseconds,
+      so values repeat) over a sliding window of the last "window" samples: each sample
+      is added and the one that leaves the window removed. Every queryEvery samples:
+      p50, p95, p99 and p99.9 (k-th smallest), the number of samples under a 2 ms SLA
+      (rank) and the mean of the samples at or below p99 (range count and sum).
+    * AVL<int, int*, AVLSum> as a multiset (every query O(log n)) against a sorted
+      vector (O(window) insert/erase, O(1) kth, O(window) sum) and std::multiset
+      (O(log n) updates, O(window) kth/rank/sum by walking). All three must agree.
+*/
+void percentileBenchmark(int nsamples=1000000, int window=100000, int queryEvery=1000){
+    std::mt19937 engine(45);
+    std::lognormal_distribution<double> latency(7.0, 0.8);
+    vector<int> stream(nsamples);
+    for(int& sample: stream) sample = 1 + (int)latency(engine);
+    const int SLA = 2000;
+    double quantiles[] = {0.5, 0.95, 0.99, 0.999};
+    //rank of quantile q among n samples (nearest-rank method)
+    auto rankOf = [](double q, int n){
+        int k = (int)std::ceil(q * n) - 1;
+        return k < 0 ? 0 : k;
+    };
+    cout << "Streaming percentiles, " << nsamples << " samples, window " << window
+         << ", queries every " << queryEvery << " samples (ms)" << endl;
+    cout << fixed << setprecision(1);
+    long long checksums[3];
+    double times[3];
+
+    {
+        AVL<int, int*, AVLSum<int, int*, LatencyTotal>> tree(true);
+        long long checksum = 0;
+        auto start = chrono::steady_clock::now();
+        for(int idx=0; idx < nsamples; idx++){
+            tree.add(stream[idx]);
+            if(idx >= window) tree.remove(stream[idx - window]);
+            if(idx % queryEvery != queryEvery - 1) continue;
+            int n = tree.size();
+            for(double q: quantiles) checksum += tree.kth(rankOf(q, n));
+            checksum += tree.rank(SLA);
+            int p99 = tree.kth(rankOf(0.99, n));
+            bool found;
+            long long total = tree.aggregate(0, p99, found);
+            checksum += total / tree.countRange(0, p99);
+        }
+        times[0] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        checksums[0] = checksum;
+    }
+    {
+        vector<int> sorted;
+        sorted.reserve(window + 1);
+        long long checksum = 0;
+        auto start = chrono::steady_clock::now();
+        for(int idx=0; idx < nsamples; idx++){
+            sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), stream[idx]), stream[idx]);
+            if(idx >= window) sorted.erase(std::lower_bound(sorted.begin(), sorted.end(), stream[idx - window]));
+            if(idx % queryEvery != queryEvery - 1) continue;
+            int n = (int)sorted.size();
+            for(double q: quantiles) checksum += sorted[rankOf(q, n)];
+            checksum += std::lower_bound(sorted.begin(), sorted.end(), SLA) - sorted.begin();
+            int p99 = sorted[rankOf(0.99, n)];
+            auto last = std::upper_bound(sorted.begin(), sorted.end(), p99);
+            long long total = std::accumulate(sorted.begin(), last, 0LL);
+            checksum += total / (last - sorted.begin());
+        }
+        times[1] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        checksums[1] = checksum;
+    }
+    {
+        std::multiset<int> samples;
+        long long checksum = 0;
+        auto start = chrono::steady_clock::now();
+        for(int idx=0; idx < nsamples; idx++){
+            samples.insert(stream[idx]);
+            if(idx >= window) samples.erase(samples.find(stream[idx - window]));
+            if(idx % queryEvery != queryEvery - 1) continue;
+            int n = (int)samples.size();
+            for(double q: quantiles) checksum += *std::next(samples.begin(), rankOf(q, n));
+            checksum += std::distance(samples.begin(), samples.lower_bound(SLA));
+            int p99 = *std::next(samples.begin(), rankOf(0.99, n));
+            auto last = samples.upper_bound(p99);
+            long long total = std::accumulate(samples.begin(), last, 0LL);
+            checksum += total / std::distance(samples.begin(), last);
+        }
+        times[2] = chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        checksums[2] = checksum;
+    }
+    string names[] = {"AVL (order statistics)", "sorted vector", "std::multiset"};
+    for(int kind=0; kind < 3; kind++){
+        cout << left << setw(26) << names[kind] << right << setw(12) << times[kind]
+             << (checksums[kind] == checksums[0] ? "" : "   MISMATCH") << endl;
+    }
+}
+
+/*
+! batchRebuildBenchmark(nkeys, batches)
+? Functionality:
+    * Each batch builds a map of nkeys ascending keys and clears it:
+      std::map (one new/delete per node), AVL::add (pooled nodes, O(n log n) with
+      rotations) and AVL::buildFromSorted (pooled, O(n)); the pool keeps its memory
+      between batches. Then two trees of nkeys / 2 interleaved keys are combined with
+      AVL::merge (O(n)) against adding the entries of one into the other.
+    * Mean milliseconds per batch; the checksums (sum of the keys) must agree.
+*/
+void batchRebuildBenchmark(int nkeys=1000000, int batches=5){
+    vector<int> keys(nkeys), evens, odds;
+    for(int idx=0; idx < nkeys; idx++){
+        keys[idx] = idx;
+        (idx % 2 == 0 ? evens : odds).push_back(idx);
+    }
+    auto keySum = [](AVL<int, int*>& tree){
+        long long sum = 0;
+        tree.traverse([&sum](int& key, int*& value){ sum += key; });
+        return sum;
+    };
+    long long expected = (long long)nkeys * (nkeys - 1) / 2;
+    double times[5] = {0, 0, 0, 0, 0};
+    bool agree = true;
+    AVL<int, int*> pooled;
+    for(int batch=0; batch < batches; batch++){
+        {
+            std::map<int, int*> map;
+            auto start = chrono::steady_clock::now();
+            for(int key: keys) map.emplace(key, (int*)0);
+            map.clear();
+            times[0] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        }
+        auto start = chrono::steady_clock::now();
+        for(int key: keys) pooled.add(key);
+        agree = agree && pooled.size() == nkeys;
+        pooled.clear();
+        times[1] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        pooled.buildFromSorted(keys.data(), 0, nkeys);
+        agree = agree && pooled.size() == nkeys;
+        pooled.clear();
+        times[2] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+
+        AVL<int, int*> left, right;
+        left.buildFromSorted(evens.data(), 0, (int)evens.size());
+        right.buildFromSorted(odds.data(), 0, (int)odds.size());
+        AVL<int, int*> copy(left);
+        start = chrono::steady_clock::now();
+        left.merge(right);
+        times[3] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        right.traverse([&copy](int& key, int*& value){ copy.add(key, value); });
+        times[4] += chrono::duration<double, std::milli>(chrono::steady_clock::now() - start).count();
+        agree = agree && keySum(left) == expected && keySum(copy) == expected;
+    }
+    cout << "Batch rebuild, " << nkeys << " keys, mean of " << batches << " batches (ms)" << endl;
+    string names[] = {"std::map insert + clear", "AVL add + clear", "AVL buildFromSorted + clear",
+                      "AVL merge (two halves)", "AVL add of the other half"};
+    cout << fixed << setprecision(1);
+    for(int kind=0; kind < 5; kind++)
+        cout << left << setw(30) << names[kind] << right << setw(12) << times[kind] / batches << endl;
+    if(!agree) cout << "MISMATCH" << endl;
+}
+
+#endif /* TREEBENCHMARK_H */
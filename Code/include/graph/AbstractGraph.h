@@ -14,8 +14,13 @@
 #ifndef ABSTRACTGRAPH_H
 #define ABSTRACTGRAPH_H
 #include "graph/IGraph.h"
+#include "graph/CSRGraph.h"
+#include "hash/xMap.h"
 #include <string>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 using namespace std;
 
 
@@ -30,13 +35,23 @@ private:
 protected:
     //Using the adjacent list technique, so need to store list of nodes (nodeList)
     DLinkedList<VertexNode*> nodeList; 
+    //vertex -> node index, kept in step with nodeList by add/remove/clear;
+    //nullptr when no vertexHash is given (getVertexNode falls back to a linear search)
+    xMap<T, VertexNode*>* nodeIndex;
     
     //Function pointers:
     bool (*vertexEQ)(T&, T&); //to compare two vertices
     string (*vertex2str)(T&); //to obtain string representation of vertices
+    int (*vertexHash)(T&, int); //vertexHash(vertex, capacity), as xMap's hashCode; optional
+    bool edgeIndexed;   //see setEdgeIndex
+    int nextSequence;   //VertexNode::sequence_ of the next added vertex
     
     
     VertexNode* getVertexNode(T& vertex){
+        if(nodeIndex != nullptr){
+            VertexNode** node = nodeIndex->find(vertex);
+            return node != nullptr ? *node : nullptr;
+        }
         typename DLinkedList<VertexNode*>::Iterator it = nodeList.begin();
         while(it != nodeList.end()){
             VertexNode* node = *it;
@@ -45,6 +60,23 @@ protected:
         }
         return 0;
     }
+    /*
+    ! removeVertexNode: remove every edge into node (reverse adjacency) and out of it,
+    * unlink node from nodeList (and nodeIndex), then free it; O(degree + V)
+    * used by remove() of the models
+    */
+    void removeVertexNode(VertexNode* node){
+        while(!node->inList.empty()){
+            Edge* edge = *node->inList.begin();
+            edge->from->removeTo(node);
+        }
+        while(!node->adList.empty()){
+            Edge* edge = *node->adList.begin();
+            node->removeTo(edge->to);
+        }
+        if(nodeIndex != nullptr) nodeIndex->remove(node->vertex, node);
+        nodeList.removeItem(node, &VertexNode::free);
+    }
     string vertex2Str(VertexNode& node){
         return vertex2str(node.vertex);
     }
@@ -61,23 +93,69 @@ protected:
 public:
     AbstractGraph(
             bool (*vertexEQ)(T&, T&)=0, 
-            string (*vertex2str)(T&)=0){
+            string (*vertex2str)(T&)=0,
+            int (*vertexHash)(T&, int)=0){
         
         this->vertexEQ = vertexEQ;
         this->vertex2str = vertex2str;
+        this->vertexHash = 0;
+        this->nodeIndex = nullptr;
+        this->edgeIndexed = false;
+        this->nextSequence = 0;
+        setVertexHash(vertexHash);
     }
     virtual ~AbstractGraph(){
         this->clear();
+        delete nodeIndex;
     }
+    //the vertices and the index are owned: no shallow copies
+    AbstractGraph(const AbstractGraph&) = delete;
+    AbstractGraph& operator=(const AbstractGraph&) = delete;
     
     typedef bool (*vertexEQFunc)(T&, T&);
     typedef string (*vertex2strFunc)(T&);
+    typedef int (*vertexHashFunc)(T&, int);
     vertexEQFunc getVertexEQ(){
         return this->vertexEQ;
     }
     vertex2strFunc getVertex2Str(){
         return this->vertex2str;
     }
+    vertexHashFunc getVertexHash(){
+        return this->vertexHash;
+    }
+
+    /*
+    ! setVertexHash(int (*vertexHash)(T&, int))
+    ? Functionality: 
+        * Turns the vertex -> node hash index on (vertexHash != 0) or off (0).
+        * With the index, every lookup by vertex (connect, weight, contains,
+        * connected, inDegree, ...) is O(1) on average instead of O(V);
+        * the hash has the same contract as TopoSorter's hash_code / xMap's hashCode.
+        * The index is rebuilt from the current vertices: O(V).
+    */
+    void setVertexHash(int (*vertexHash)(T&, int)){
+        delete nodeIndex;
+        nodeIndex = nullptr;
+        this->vertexHash = vertexHash;
+        if(vertexHash == 0) return;
+        nodeIndex = new xMap<T, VertexNode*>(vertexHash, 0.75f, 0, 0, vertexEQ);
+        for(auto node: nodeList) nodeIndex->put(node->vertex, node);
+    }
+
+    /*
+    ! setEdgeIndex(bool enabled)
+    ? Functionality: 
+        * Turns the per-vertex target -> edge hash index on or off.
+        * With it, a vertex with at least VertexNode::EDGE_INDEX_MIN_DEGREE
+        * out-edges finds an edge (connected, weight, connect of an existing edge)
+        * in O(1) instead of scanning its adjacency list; vertices with fewer
+        * edges keep scanning, which is faster at that size.
+    */
+    void setEdgeIndex(bool enabled){
+        edgeIndexed = enabled;
+        for(auto node: nodeList) node->setEdgeIndex(enabled);
+    }
 
     
 //////////////////////////////////////////////////////////////////////
@@ -137,17 +215,23 @@ public:
         }
         // If not, create a new VertexNode and add to nodeList
         VertexNode* newNode = new VertexNode(vertex, vertexEQ, vertex2str);
+        newNode->sequence_ = nextSequence++;
+        newNode->setEdgeIndex(edgeIndexed);
         nodeList.add(newNode);
+        if(nodeIndex != nullptr) nodeIndex->put(vertex, newNode);
     }
     
     virtual float weight(T from, T to){
-        if (!contains(from)) {
+        VertexNode* fromNode = getVertexNode(from);
+        if (fromNode == nullptr) {
             throw VertexNotFoundException(this->vertex2str(from));
         }
-        if (!contains(to)) {
+        VertexNode* toNode = getVertexNode(to);
+        if (toNode == nullptr) {
             throw VertexNotFoundException(this->vertex2str(to));
         }
-        if (!connected(from, to)) {
+        Edge* edge = fromNode->getEdge(toNode);
+        if (edge == nullptr) {
             stringstream edge_os;
             edge_os << "E("
                 << vertex2str(from)
@@ -156,7 +240,6 @@ public:
                 << ")";
             throw EdgeNotFoundException(edge_os.str());
         }
-        Edge* edge = getVertexNode(from)->getEdge(getVertexNode(to));
         return edge->weight;
     }
 
@@ -183,11 +266,17 @@ public:
         if (node == nullptr) {
             throw VertexNotFoundException(this->vertex2str(to));
         }
+        // sources from the reverse adjacency list, listed in vertex order (as vertices())
+        vector<VertexNode*> sources;
+        for (auto edge : node->inList) {
+            sources.push_back(edge->from);
+        }
+        sort(sources.begin(), sources.end(), [](VertexNode* lhs, VertexNode* rhs){
+            return lhs->sequence_ < rhs->sequence_;
+        });
         DLinkedList<T> inList;
-        for (auto vertex : nodeList) {
-            if (vertex->getEdge(node) != nullptr) {
-                inList.add(vertex->vertex);
-            }
+        for (auto source : sources) {
+            inList.add(source->vertex);
         }
         return inList;
     }
@@ -222,28 +311,13 @@ public:
         * None.
     */
     virtual void clear(){
-        typename DLinkedList<VertexNode*>::Iterator it = nodeList.begin();
-        typename DLinkedList<VertexNode*>::Iterator next_it;
-        while(it != nodeList.end()){
-            VertexNode* node = *it;
-            next_it = it;
-            next_it++;
-            while (next_it != nodeList.end()) {
-                VertexNode* nextNode = *next_it;
-                if (node->getEdge(nextNode) != nullptr) {
-                    node->removeTo(nextNode);
-                }
-                next_it++;
-            }
-            it++;
-        }
-        
-        it = nodeList.begin();
-        while (it != nodeList.end()) {
-            VertexNode* node = *it;
-            it.remove(VertexNode::free);
-            it++;
+        //every node owns its outward edges (adList frees them), and all nodes go:
+        //no need to unlink the edges pair by pair first
+        for (auto node : nodeList) {
+            VertexNode::free(node);
         }
+        nodeList.clear();
+        if (nodeIndex != nullptr) nodeIndex->clear();
     }
 
     /*
@@ -291,6 +365,98 @@ public:
         return vertices;
     }
 
+    /*
+    ! isDirected()
+    ? Functionality: 
+        * true for DGraphModel; UGraphModel stores each edge in both directions and returns false.
+    */
+    virtual bool isDirected(){
+        return true;
+    }
+
+    /*
+    ! freeze()
+    ? Functionality: 
+        * Builds an immutable CSRGraph<T> snapshot of the current vertices and edges:
+        * dense ids in vertex order, out-edges in adjacency order, with weights.
+        * The snapshot does not follow later changes to this graph.
+    ? Return:
+        * CSRGraph<T>*: allocated with new; the caller deletes it.
+    */
+    CSRGraph<T>* freeze(){
+        int nvertices = nodeList.size();
+        T* vertexData = new T[nvertices > 0 ? nvertices : 1];
+        int* offsets = new int[nvertices + 1];
+        int id = 0;
+        offsets[0] = 0;
+        for (auto node : nodeList) {
+            node->id_ = id;
+            vertexData[id] = node->vertex;
+            offsets[id + 1] = offsets[id] + node->adList.size();
+            id++;
+        }
+        int nedges = offsets[nvertices];
+        int* targets = new int[nedges > 0 ? nedges : 1];
+        float* weights = new float[nedges > 0 ? nedges : 1];
+        int edge = 0;
+        for (auto node : nodeList) {
+            for (auto adEdge : node->adList) {
+                targets[edge] = adEdge->to->id_;
+                weights[edge] = adEdge->weight;
+                edge++;
+            }
+        }
+        return new CSRGraph<T>(nvertices, vertexData, offsets, targets, weights,
+                               isDirected(), vertexEQ, vertex2str, vertexHash);
+    }
+
+    /*
+    ! addAll(CSRGraph<T>* csr)
+    ? Functionality:
+        * Bulk load: adds the vertices of csr (in id order) and its stored edges,
+        * e.g. a snapshot from freeze() or one built by a graph loader.
+        * The edges of a vertex that was not in the graph are appended directly
+        * (the out-edges of one id in a CSRGraph have distinct targets): loading
+        * into an empty graph costs O(V+E). Vertices already in the graph are
+        * looked up (O(1) with a vertexHash) and their edges go through connect().
+        * An undirected snapshot stores u-v as u->v and v->u, which is exactly
+        * how UGraphModel stores it: load it into a UGraphModel.
+    */
+    void addAll(CSRGraph<T>* csr){
+        int nvertices = csr->size();
+        vector<VertexNode*> nodes(nvertices);
+        vector<char> created(nvertices, 0);
+        bool fresh = nodeList.size() == 0;
+        for (int id = 0; id < nvertices; id++) {
+            T& vertex = csr->vertex(id);
+            VertexNode* node = fresh ? nullptr : getVertexNode(vertex);
+            if (node == nullptr) {
+                node = new VertexNode(vertex, vertexEQ, vertex2str);
+                node->sequence_ = nextSequence++;
+                nodeList.add(node);
+                if (nodeIndex != nullptr) nodeIndex->put(vertex, node);
+                created[id] = 1;
+            }
+            nodes[id] = node;
+        }
+        for (int from = 0; from < nvertices; from++) {
+            VertexNode* node = nodes[from];
+            for (int edge = csr->edgeBegin(from); edge < csr->edgeEnd(from); edge++) {
+                VertexNode* to = nodes[csr->target(edge)];
+                if (!created[from]) {
+                    node->connect(to, csr->weightAt(edge));
+                    continue;
+                }
+                Edge* newEdge = new Edge(node, to, csr->weightAt(edge));
+                node->adList.add(newEdge);
+                to->inList.add(newEdge);
+                to->inDegree_++;
+                node->outDegree_++;
+            }
+            if (created[from]) node->setEdgeIndex(edgeIndexed);
+        }
+    }
+
     void println(){
         cout << this->toString() << endl;
     }
@@ -357,7 +523,12 @@ public:
         friend class UGraphModel; //UPDATED: added
         T vertex;
         int inDegree_, outDegree_, cache_inDegree_;
+        int id_; //scratch: dense id assigned by AbstractGraph::freeze()
+        int sequence_; //insertion number: orders vertices as in nodeList
         DLinkedList<Edge*> adList; 
+        DLinkedList<Edge*> inList; //reverse adjacency: edges ending here (owned by their source's adList)
+        bool indexEdges;
+        xMap<VertexNode*, Edge*>* edgeIndex; //target -> edge, when indexEdges and the degree is large
         friend class Edge;
         friend class AbstractGraph;
         
@@ -365,19 +536,46 @@ public:
         string (*vertex2str)(T&);
         
     public:
-        VertexNode():adList(&DLinkedList<Edge*>::free, &Edge::edgeEQ){}
+        static const int EDGE_INDEX_MIN_DEGREE = 8;
+
+        VertexNode():adList(&DLinkedList<Edge*>::free, &Edge::edgeEQ){
+            this->outDegree_ = this->inDegree_ = 0;
+            this->sequence_ = 0;
+            this->indexEdges = false;
+            this->edgeIndex = nullptr;
+        }
         VertexNode(T vertex, bool (*vertexEQ)(T&, T&), string (*vertex2str)(T&))
             :adList(&DLinkedList<Edge*>::free, &Edge::edgeEQ){
             this->vertex = vertex;
             this->vertexEQ = vertexEQ;
             this->vertex2str = vertex2str;
             this->outDegree_ = this->inDegree_ = 0;
+            this->sequence_ = 0;
+            this->indexEdges = false;
+            this->edgeIndex = nullptr;
+        }
+        ~VertexNode(){
+            delete edgeIndex;
         }
 
         static void free(VertexNode* node){
             delete node;
         }
 
+        static int nodeHash(VertexNode*& node, int capacity){
+            return (int)(((uintptr_t)node >> 4) % (uintptr_t)capacity);
+        }
+
+        /*
+        ! setEdgeIndex(bool enabled): see AbstractGraph::setEdgeIndex
+        */
+        void setEdgeIndex(bool enabled){
+            this->indexEdges = enabled;
+            delete edgeIndex;
+            edgeIndex = nullptr;
+            if (enabled && adList.size() >= EDGE_INDEX_MIN_DEGREE) buildEdgeIndex();
+        }
+
         T& getVertex(){
             return vertex;
         }
@@ -407,16 +605,18 @@ public:
         */
         void connect(VertexNode* to, float weight=0){
             // Check if the edge already exists
-            for (auto edge : adList) {
-                if ((edge->to)->equals(to)) {
-                    edge->updateWeight(weight);
-                    return;
-                }
+            Edge* edge = getEdge(to);
+            if (edge != nullptr) {
+                edge->updateWeight(weight);
+                return;
             }
 
-            // Create a new edge and add it to the adjacency list
+            // Create a new edge and add it to the adjacency list (and to's reverse list)
             Edge* newEdge = new Edge(this, to, weight);
             adList.add(newEdge);
+            to->inList.add(newEdge);
+            if (edgeIndex != nullptr) edgeIndex->put(to, newEdge);
+            else if (indexEdges && adList.size() >= EDGE_INDEX_MIN_DEGREE) buildEdgeIndex();
 
             // Update the inDegree and outDegree of the vertices
             to->inDegree_++;
@@ -446,8 +646,13 @@ public:
         ? Exceptions: None
         */
         Edge* getEdge(VertexNode* to){
+            if (edgeIndex != nullptr) {
+                Edge** edge = edgeIndex->find(to);
+                return edge != nullptr ? *edge : nullptr;
+            }
+            // one node per vertex: comparing node addresses is comparing vertices
             for (auto edge : adList) {
-                if ((edge->to)->equals(to)) {
+                if (edge->to == to) {
                     return edge;
                 }
             }
@@ -463,15 +668,12 @@ public:
         */
         void removeTo(VertexNode* to){
             // Find the edge connecting this vertex to the specified vertex
-            typename DLinkedList<Edge*>::Iterator it = adList.begin();
-            while (it != adList.end()) {
-                Edge* edge = *it;
-                if ((edge->to)->equals(to)) {
-                    it.remove(Edge::free);
-                    break;
-                }
-                it++;
-            }
+            Edge* edge = getEdge(to);
+            if (edge == nullptr) return;
+
+            if (edgeIndex != nullptr) edgeIndex->remove(to, edge);
+            removeEdgeFrom(to->inList, edge, 0);
+            removeEdgeFrom(adList, edge, Edge::free);
 
             // Update the inDegree and outDegree of the vertices
             to->inDegree_--;
@@ -535,6 +737,26 @@ public:
             this->inDegree_ = this->cache_inDegree_;
         }
 
+    private:
+        void buildEdgeIndex(){
+            edgeIndex = new xMap<VertexNode*, Edge*>(&VertexNode::nodeHash);
+            for (auto edge : adList) edgeIndex->put(edge->to, edge);
+        }
+
+        //unlinks exactly this edge object (by address) from list
+        static void removeEdgeFrom(DLinkedList<Edge*>& list, Edge* edge, void (*removeEdge)(Edge*)){
+            typename DLinkedList<Edge*>::Iterator it = list.begin();
+            while (it != list.end()) {
+                if (*it == edge) {
+                    it.remove(removeEdge);
+                    return;
+                }
+                it++;
+            }
+        }
+
+    public:
+
         string getVertexStr(){
             stringstream os;
             if (vertex2str != 0) os << vertex2str(vertex);
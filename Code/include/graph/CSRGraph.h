@@ -0,0 +1,340 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines CSRGraph: an immutable compressed-sparse-row snapshot of a graph
+*/
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include "graph/IGraph.h"
+#include "graph/VertexIds.h"
+using namespace std;
+
+/*
+! CSRGraph<T>
+? Functionality:
+    * Read-only adjacency in three flat arrays, for analytics on a graph that no
+      longer changes (built by AbstractGraph<T>::freeze()):
+        - vertices are numbered 0..size()-1 (dense ids, in the order of the source graph),
+        - the out-edges of id u are targets[offsets[u] .. offsets[u+1]),
+          with weights[] parallel to targets[],
+        - the neighbour order is the source graph's adjacency order, so traversals on
+          the snapshot visit vertices in the same order as on the source graph.
+    * Walking the edges of a vertex touches contiguous memory; nothing is allocated.
+? Iteration:
+    * for(int to: csr.neighbors(id)) ...           //target ids
+    * for(int edge=csr.edgeBegin(id); edge < csr.edgeEnd(id); edge++)
+    *     use(csr.target(edge), csr.weightAt(edge));
+? Notes:
+    * Lookups by vertex value (indexOf, contains, weight(T, T)) use a VertexIds index
+      when the source graph had a vertexHash, a linear search otherwise.
+? Usage:
+    * CSRGraph<char>* csr = model.freeze();
+    * int id = csr->indexOf('A');
+    * for(int to: csr->neighbors(id)) cout << csr->vertex(to);
+    * delete csr;
+*/
+template<class T>
+class CSRGraph{
+public:
+    class NeighborRange; //forward declaration
+
+protected:
+    int nvertices;
+    int nedges;
+    bool directed;
+    T* vertexData;      //id -> vertex
+    int* offsets;       //nvertices + 1
+    int* targets;       //nedges
+    float* weights;     //nedges
+    int* inDegrees;     //nvertices
+    VertexIds<T>* idIndex;
+    void* storage;      //owner of borrowed arrays (e.g. a mapped file), else nullptr
+    void (*releaseStorage)(void*);
+
+    bool (*vertexEQ)(T&, T&);
+    string (*vertex2str)(T&);
+    int (*vertexHash)(T&, int);
+
+public:
+    /*
+    ! CSRGraph(...): takes ownership of vertexData, offsets, targets and weights
+    * (allocated with new[]); in-degrees are counted here.
+    */
+    CSRGraph(int nvertices, T* vertexData, int* offsets, int* targets, float* weights,
+             bool directed=true,
+             bool (*vertexEQ)(T&, T&)=0,
+             string (*vertex2str)(T&)=0,
+             int (*vertexHash)(T&, int)=0){
+        this->nvertices = nvertices;
+        this->nedges = offsets[nvertices];
+        this->directed = directed;
+        this->vertexData = vertexData;
+        this->offsets = offsets;
+        this->targets = targets;
+        this->weights = weights;
+        this->vertexEQ = vertexEQ;
+        this->vertex2str = vertex2str;
+        this->vertexHash = vertexHash;
+
+        this->storage = nullptr;
+        this->releaseStorage = 0;
+
+        this->inDegrees = new int[nvertices > 0 ? nvertices : 1]();
+        for(int edge=0; edge < nedges; edge++) inDegrees[targets[edge]]++;
+        buildIndex();
+    }
+    /*
+    ! CSRGraph(..., inDegrees, directed, storage, release, ...): borrows every array,
+    * in-degrees included (nothing is counted or copied); the destructor calls
+    * release(storage) instead of deleting them. Used to map a graph file: the
+    * arrays may be read-only.
+    */
+    CSRGraph(int nvertices, T* vertexData, int* offsets, int* targets, float* weights,
+             int* inDegrees, bool directed, void* storage, void (*release)(void*),
+             bool (*vertexEQ)(T&, T&)=0,
+             string (*vertex2str)(T&)=0,
+             int (*vertexHash)(T&, int)=0){
+        this->nvertices = nvertices;
+        this->nedges = offsets[nvertices];
+        this->directed = directed;
+        this->vertexData = vertexData;
+        this->offsets = offsets;
+        this->targets = targets;
+        this->weights = weights;
+        this->inDegrees = inDegrees;
+        this->vertexEQ = vertexEQ;
+        this->vertex2str = vertex2str;
+        this->vertexHash = vertexHash;
+        this->storage = storage;
+        this->releaseStorage = release;
+        buildIndex();
+    }
+    ~CSRGraph(){
+        if(releaseStorage != 0) releaseStorage(storage);
+        else{
+            delete []vertexData;
+            delete []offsets;
+            delete []targets;
+            delete []weights;
+            delete []inDegrees;
+        }
+        delete idIndex;
+    }
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+    int size(){
+        return nvertices;
+    }
+    bool empty(){
+        return nvertices == 0;
+    }
+    //number of stored (directed) edges; an undirected edge u-v is stored as u->v and v->u
+    int edgeCount(){
+        return nedges;
+    }
+    bool isDirected(){
+        return directed;
+    }
+
+    /*
+    ! vertex(id): the vertex with dense id, 0 <= id < size()
+    */
+    T& vertex(int id){
+        return vertexData[id];
+    }
+
+    //vertex as text: the source graph's vertex2str, operator<< without one
+    string vertexStr(T& vertex){
+        if(vertex2str != 0) return vertex2str(vertex);
+        stringstream os;
+        os << vertex;
+        return os.str();
+    }
+
+    /*
+    ! indexOf(T vertex): the dense id of vertex, or -1 if it is not in the graph
+    */
+    int indexOf(T vertex){
+        if(idIndex != nullptr) return idIndex->indexOf(vertex);
+        for(int id=0; id < nvertices; id++)
+            if(vertexEqual(vertexData[id], vertex)) return id;
+        return -1;
+    }
+    bool contains(T vertex){
+        return indexOf(vertex) != -1;
+    }
+
+    int outDegree(int id){
+        return offsets[id + 1] - offsets[id];
+    }
+    int inDegree(int id){
+        return inDegrees[id];
+    }
+
+    //edge positions of id: [edgeBegin(id), edgeEnd(id))
+    int edgeBegin(int id){
+        return offsets[id];
+    }
+    int edgeEnd(int id){
+        return offsets[id + 1];
+    }
+    int target(int edge){
+        return targets[edge];
+    }
+    float weightAt(int edge){
+        return weights[edge];
+    }
+    NeighborRange neighbors(int id){
+        return NeighborRange(targets + offsets[id], targets + offsets[id + 1]);
+    }
+
+    //raw arrays, for algorithms that stream over the whole graph
+    const int* getOffsets(){
+        return offsets;
+    }
+    const int* getTargets(){
+        return targets;
+    }
+    const float* getWeights(){
+        return weights;
+    }
+    const int* getInDegrees(){
+        return inDegrees;
+    }
+
+    /*
+    ! transpose(): a new snapshot with every edge reversed (same ids, same weights);
+    * the in-edges of u are then the out-edges of u in the result. Caller deletes it.
+    */
+    CSRGraph<T>* transpose(){
+        T* data = new T[nvertices > 0 ? nvertices : 1];
+        int* revOffsets = new int[nvertices + 1];
+        int* revTargets = new int[nedges > 0 ? nedges : 1];
+        float* revWeights = new float[nedges > 0 ? nedges : 1];
+        for(int id=0; id < nvertices; id++) data[id] = vertexData[id];
+        revOffsets[0] = 0;
+        for(int id=0; id < nvertices; id++) revOffsets[id + 1] = revOffsets[id] + inDegrees[id];
+        int* fill = new int[nvertices > 0 ? nvertices : 1];
+        for(int id=0; id < nvertices; id++) fill[id] = revOffsets[id];
+        for(int from=0; from < nvertices; from++){
+            for(int edge=offsets[from]; edge < offsets[from + 1]; edge++){
+                int slot = fill[targets[edge]]++;
+                revTargets[slot] = from;
+                revWeights[slot] = weights[edge];
+            }
+        }
+        delete []fill;
+        return new CSRGraph<T>(nvertices, data, revOffsets, revTargets, revWeights,
+                               directed, vertexEQ, vertex2str, vertexHash);
+    }
+
+    /*
+    ! findEdge(from, to): edge position of from->to (ids), or -1; O(outDegree(from))
+    */
+    int findEdge(int from, int to){
+        for(int edge=offsets[from]; edge < offsets[from + 1]; edge++)
+            if(targets[edge] == to) return edge;
+        return -1;
+    }
+    bool connected(int from, int to){
+        return findEdge(from, to) != -1;
+    }
+
+    /*
+    ! weight(T from, T to)
+    ? Exceptions:
+        * VertexNotFoundException, EdgeNotFoundException (as AbstractGraph::weight)
+    */
+    float weight(T from, T to){
+        int fromId = indexOf(from);
+        if(fromId == -1) throw VertexNotFoundException(vertexStr(from));
+        int toId = indexOf(to);
+        if(toId == -1) throw VertexNotFoundException(vertexStr(to));
+        int edge = findEdge(fromId, toId);
+        if(edge == -1){
+            stringstream edge_os;
+            edge_os << "E(" << vertexStr(from) << "," << vertexStr(to) << ")";
+            throw EdgeNotFoundException(edge_os.str());
+        }
+        return weights[edge];
+    }
+
+    /*
+    ! getOutwardEdges(T from): neighbours of from, as AbstractGraph::getOutwardEdges
+    */
+    DLinkedList<T> getOutwardEdges(T from){
+        int id = indexOf(from);
+        if(id == -1) throw VertexNotFoundException(vertexStr(from));
+        DLinkedList<T> outList;
+        for(int edge=offsets[id]; edge < offsets[id + 1]; edge++) outList.add(vertexData[targets[edge]]);
+        return outList;
+    }
+    DLinkedList<T> vertices(){
+        DLinkedList<T> list;
+        for(int id=0; id < nvertices; id++) list.add(vertexData[id]);
+        return list;
+    }
+
+    string toString(){
+        string mark(50, '=');
+        stringstream os;
+        os << mark << endl;
+        os << "CSR: " << nvertices << " vertices, " << nedges << " edges" << endl;
+        for(int id=0; id < nvertices; id++){
+            os << id << " " << vertexStr(vertexData[id]) << ":";
+            for(int edge=offsets[id]; edge < offsets[id + 1]; edge++)
+                os << " " << vertexStr(vertexData[targets[edge]]) << "(" << weights[edge] << ")";
+            os << endl;
+        }
+        os << mark << endl;
+        return os.str();
+    }
+    void println(){
+        cout << toString() << endl;
+    }
+
+protected:
+    void buildIndex(){
+        this->idIndex = nullptr;
+        if(vertexHash != 0){
+            idIndex = new VertexIds<T>(vertexHash, vertexEQ, nvertices);
+            for(int id=0; id < nvertices; id++) idIndex->intern(vertexData[id]);
+        }
+    }
+    bool vertexEqual(T& lhs, T& rhs){
+        if(vertexEQ != 0) return vertexEQ(lhs, rhs);
+        else return lhs == rhs;
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//NeighborRange: BEGIN, the target ids of one vertex, usable in a range-for
+    class NeighborRange{
+    private:
+        const int* first;
+        const int* last;
+    public:
+        NeighborRange(const int* first, const int* last): first(first), last(last){}
+        const int* begin(){
+            return first;
+        }
+        const int* end(){
+            return last;
+        }
+        int size(){
+            return (int)(last - first);
+        }
+    };
+//NeighborRange: END
+};
+
+#endif /* CSRGRAPH_H */
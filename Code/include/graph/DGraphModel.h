@@ -18,6 +18,10 @@
 #include "stacknqueue/Stack.h"
 #include "hash/xMap.h"
 #include "sorting/DLinkedListSE.h"
+#include "heap/IndexedHeap.h"
+#include "util/DynamicBitset.h"
+#include <limits>
+#include <stdexcept>
 
 
 //////////////////////////////////////////////////////////////////////
@@ -34,8 +38,9 @@ private:
 public:
     DGraphModel(
             bool (*vertexEQ)(T&, T&), 
-            string (*vertex2str)(T&) ): 
-        AbstractGraph<T>(vertexEQ, vertex2str){
+            string (*vertex2str)(T&),
+            int (*vertexHash)(T&, int)=0 ): 
+        AbstractGraph<T>(vertexEQ, vertex2str, vertexHash){
     }
     
     /*
@@ -116,21 +121,8 @@ public:
             throw VertexNotFoundException(this->vertex2str(vertex));
         }
 
-        // Iterate through the graph’s vertices, removing all edges connected to or from the vertex to be removed.
-        typename DLinkedList<VertexNode*>::Iterator it = this->nodeList.begin();
-        while (it != this->nodeList.end()) {
-            VertexNode* vertexNode = *it;
-            if (this->connected(vertexNode->getVertex(), vertex)) {
-                vertexNode->removeTo(node);
-            }
-            if (this->connected(vertex, vertexNode->getVertex())) {
-                node->removeTo(vertexNode);
-            }
-            it++;
-        }
-
-        // Remove the vertex from the graph’s vertex list.
-        this->nodeList.removeItem(node, &VertexNode::free);
+        // Remove the edges into and out of the vertex (reverse and forward adjacency), then the vertex.
+        this->removeVertexNode(node);
     }
     
     /*
@@ -143,9 +135,10 @@ public:
     static DGraphModel<T>* create(
             T* vertices, int nvertices, Edge<T>* edges, int nedges,
             bool (*vertexEQ)(T&, T&),
-            string (*vertex2str)(T&)){
+            string (*vertex2str)(T&),
+            int (*vertexHash)(T&, int)=0){
         // Create a new DGraphModel object
-        DGraphModel<T>* graph = new DGraphModel<T>(vertexEQ, vertex2str);
+        DGraphModel<T>* graph = new DGraphModel<T>(vertexEQ, vertex2str, vertexHash);
 
         // Add all vertices in vertices to the graph
         for (int i = 0; i < nvertices; i++) {
@@ -174,130 +167,458 @@ public:
     }
 };
 /*
+! DGraphAlgorithm<T>
+? Functionality:
+    * Shortest paths on a DGraphModel<T>. Every call takes a CSRGraph snapshot (freeze(),
+      O(V+E)) and runs an id-based engine on it; to answer many queries on a graph that
+      does not change, freeze once and call the static engines directly.
+        - dijkstra:               one-to-all, indexed 4-ary heap with decrease-key,
+        - shortestPath:           one-to-one Dijkstra that stops when "to" is settled,
+        - bidirectionalDijkstra:  one-to-one, searches from both ends (needs transpose()),
+        - aStar:                  one-to-one, guided by heuristic(vertex, goal),
+        - bellman_ford:           one-to-all with negative weights (SPFA: queue of the
+                                  vertices whose distance changed), detects negative cycles.
+? Notes:
+    * Dijkstra, bidirectional Dijkstra and A* need non-negative weights
+      (std::invalid_argument otherwise): the methods taking a DGraphModel check every
+      weight of the snapshot before searching; the static engines throw when the
+      search reaches a negative edge. A* is exact when the heuristic never
+      overestimates the remaining cost; a consistent heuristic settles each vertex once.
+    * The Path<T>* returned are owned by the caller (delete them);
+      one-to-one searches return nullptr when "to" is unreachable.
+? Exceptions:
+    * VertexNotFoundException: start/from/to is not in the graph.
+    * NegativeCycleException (bellman_ford): a negative cycle is reachable from start.
+? Complexity:
+    * dijkstra, aStar: O((V + E) log V); bellman_ford: O(V*E) worst case, ~O(E) on most graphs.
+*/
 template<class T>
 class DGraphAlgorithm {
-private:
-protected:
 public:
-    DLinkedList<Path<T>*> dijkstra(DGraphModel<T>* graph, T start_vertex) {
-        DLinkedList<Path<T>*> list;
-    //     xMap<T, float> distances;
-    //     xMap<T, T> previous;
-    //     PriorityQueue<T, float> pq;
-
-    //     // Initialize distances and priority queue
-    //     for (auto vertex : graph->vertices()) {
-    //         if (vertex == start_vertex) {
-    //             distances.put(vertex, 0);
-    //             pq.push(vertex, 0);
-    //         } else {
-    //             distances.put(vertex, numeric_limits<float>::infinity());
-    //             pq.push(vertex, numeric_limits<float>::infinity());
-    //         }
-    //         previous.put(vertex, T());
-    //     }
-
-    //     // Process the priority queue
-    //     while (!pq.empty()) {
-    //         T current = pq.pop();
-    //         float current_distance = distances.get(current);
-
-    //         for (auto neighbor : graph->getOutwardEdges(current)) {
-    //             float weight = graph->weight(current, neighbor);
-    //             float distance = current_distance + weight;
-
-    //             if (distance < distances.get(neighbor)) {
-    //                 distances.put(neighbor, distance);
-    //                 previous.put(neighbor, current);
-    //                 pq.update(neighbor, distance);
-    //             }
-    //         }
-    //     }
-
-    //     // Build the paths
-    //     for (auto vertex : graph->vertices()) {
-    //         if (vertex == start_vertex) continue;
-
-    //         Path<T>* path = new Path<T>();
-    //         path->setCost(distances.get(vertex));
-
-    //         T current = vertex;
-    //         while (current != T()) {
-    //             path->getPath().add(0, current);
-    //             current = previous.get(current);
-    //         }
-
-    //         if (!path->getPath().empty()) {
-    //             list.add(path);
-    //         } else {
-    //             delete path;
-    //         }
-    //     }
+    typedef float (*Heuristic)(T& vertex, T& goal);
 
+    DLinkedList<Path<T>*> dijkstra(DGraphModel<T>* graph, T start_vertex) {
+        CSRGraph<T>* csr = graph->freeze();
+        int source = sourceId(graph, csr, start_vertex);
+        requireNonNegative(csr, "Dijkstra: negative edge weight");
+        float* dist = new float[csr->size()];
+        int* parent = new int[csr->size()];
+        dijkstra(csr, source, dist, parent);
+        DLinkedList<Path<T>*> list = buildPaths(csr, source, dist, parent);
+        delete []dist;
+        delete []parent;
+        delete csr;
         return list;
     }
 
     DLinkedList<Path<T>*> bellman_ford(DGraphModel<T>* graph, T start_vertex) {
-        DLinkedList<Path<T>*> list;
-    //     xMap<T, float> distances;
-    //     xMap<T, T> previous;
-
-    //     // Initialize distances
-    //     for (auto vertex : graph->vertices()) {
-    //         if (vertex == start_vertex) {
-    //             distances.put(vertex, 0);
-    //         } else {
-    //             distances.put(vertex, numeric_limits<float>::infinity());
-    //         }
-    //         previous.put(vertex, T());
-    //     }
-
-    //     // Relax edges repeatedly
-    //     int V = graph->size();
-    //     for (int i = 1; i <= V - 1; i++) {
-    //         for (auto u : graph->vertices()) {
-    //             for (auto v : graph->getOutwardEdges(u)) {
-    //                 float weight = graph->weight(u, v);
-    //                 if (distances.get(u) + weight < distances.get(v)) {
-    //                     distances.put(v, distances.get(u) + weight);
-    //                     previous.put(v, u);
-    //                 }
-    //             }
-    //         }
-    //     }
-
-    //     // Check for negative-weight cycles
-    //     for (auto u : graph->vertices()) {
-    //         for (auto v : graph->getOutwardEdges(u)) {
-    //             float weight = graph->weight(u, v);
-    //             if (distances.get(u) + weight < distances.get(v)) {
-    //                 throw runtime_error("Graph contains a negative-weight cycle");
-    //             }
-    //         }
-    //     }
-
-    //     // Build the paths
-    //     for (auto vertex : graph->vertices()) {
-    //         if (vertex == start_vertex) continue;
-
-    //         Path<T>* path = new Path<T>();
-    //         path->setCost(distances.get(vertex));
-
-    //         T current = vertex;
-    //         while (current != T()) {
-    //             path->getPath().add(0, current);
-    //             current = previous.get(current);
-    //         }
-
-    //         if (!path->getPath().empty()) {
-    //             list.add(path);
-    //         } else {
-    //             delete path;
-    //         }
-    //     }
+        CSRGraph<T>* csr = graph->freeze();
+        int source = sourceId(graph, csr, start_vertex);
+        float* dist = new float[csr->size()];
+        int* parent = new int[csr->size()];
+        DLinkedList<int> cycle;
+        if(!bellmanFord(csr, source, dist, parent, &cycle)){
+            stringstream os;
+            bool first = true;
+            for(int id: cycle){
+                os << (first ? "" : " -> ") << vertexToString(graph, csr->vertex(id));
+                first = false;
+            }
+            delete []dist;
+            delete []parent;
+            delete csr;
+            throw NegativeCycleException(os.str());
+        }
+        DLinkedList<Path<T>*> list = buildPaths(csr, source, dist, parent);
+        delete []dist;
+        delete []parent;
+        delete csr;
+        return list;
+    }
+
+    Path<T>* shortestPath(DGraphModel<T>* graph, T from, T to) {
+        CSRGraph<T>* csr = graph->freeze();
+        int source = sourceId(graph, csr, from);
+        int target = sourceId(graph, csr, to);
+        requireNonNegative(csr, "Dijkstra: negative edge weight");
+        float* dist = new float[csr->size()];
+        int* parent = new int[csr->size()];
+        dijkstra(csr, source, dist, parent, target);
+        Path<T>* path = nullptr;
+        if(dist[target] != INF){
+            path = new Path<T>();
+            path->setCost(dist[target]);
+            for(int id=target; id != -1; id = parent[id]) path->getPath().add(0, csr->vertex(id));
+        }
+        delete []dist;
+        delete []parent;
+        delete csr;
+        return path;
+    }
+
+    Path<T>* bidirectionalDijkstra(DGraphModel<T>* graph, T from, T to) {
+        CSRGraph<T>* csr = graph->freeze();
+        int source = sourceId(graph, csr, from);
+        int target = sourceId(graph, csr, to);
+        requireNonNegative(csr, "Dijkstra: negative edge weight");
+        CSRGraph<T>* reverse = csr->transpose();
+        DLinkedList<int> route;
+        float cost = bidirectionalDijkstra(csr, reverse, source, target, &route);
+        Path<T>* path = routeToPath(csr, cost, route);
+        delete reverse;
+        delete csr;
+        return path;
+    }
+
+    Path<T>* aStar(DGraphModel<T>* graph, T from, T to, Heuristic heuristic) {
+        CSRGraph<T>* csr = graph->freeze();
+        int source = sourceId(graph, csr, from);
+        int target = sourceId(graph, csr, to);
+        requireNonNegative(csr, "A*: negative edge weight");
+        DLinkedList<int> route;
+        float cost = aStar(csr, source, target, heuristic, &route);
+        Path<T>* path = routeToPath(csr, cost, route);
+        delete csr;
+        return path;
+    }
+
+    //Engines on a snapshot: vertices are dense ids, dist/parent have csr->size() items.
+
+    /*
+    ! dijkstra(csr, source, dist, parent, target)
+    ? Functionality:
+        * dist[id]: cost from source (infinity if unreachable), parent[id]: previous id
+          on that path (-1 for source and unreachable ids).
+        * target != -1: stops as soon as target is settled (other distances are then
+          upper bounds only).
+    ? Return:
+        * int: number of settled vertices
+    */
+    static int dijkstra(CSRGraph<T>* csr, int source, float* dist, int* parent, int target=-1) {
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        const float* weights = csr->getWeights();
+        for(int id=0; id < nvertices; id++){
+            dist[id] = INF;
+            parent[id] = -1;
+        }
+        IndexedHeap<float> heap(nvertices);
+        dist[source] = 0;
+        heap.push(source, 0);
+        int settled = 0;
+        while(!heap.empty()){
+            int from = heap.pop();
+            settled++;
+            if(from == target) break;
+            float base = dist[from];
+            for(int edge=offsets[from]; edge < offsets[from + 1]; edge++){
+                float weight = weights[edge];
+                if(weight < 0) throw std::invalid_argument("Dijkstra: negative edge weight");
+                int to = targets[edge];
+                if(base + weight < dist[to]){
+                    dist[to] = base + weight;
+                    parent[to] = from;
+                    heap.pushOrDecrease(to, dist[to]);
+                }
+            }
+        }
+        return settled;
+    }
+
+    /*
+    ! bidirectionalDijkstra(csr, reverse, source, target, route, settled)
+    ? Functionality:
+        * Dijkstra from source on csr and from target on reverse (= csr->transpose()),
+          always expanding the side with the smaller frontier key; stops when the two
+          frontier keys add up to at least the best source-target cost found so far.
+        * route (optional): receives the ids of the path, source first.
+        * settled (optional): receives the number of vertices settled on both sides.
+    ? Return:
+        * float: cost of the shortest path, infinity if target is unreachable
+    */
+    static float bidirectionalDijkstra(CSRGraph<T>* csr, CSRGraph<T>* reverse, int source, int target,
+                                       DLinkedList<int>* route=0, int* settled=0) {
+        int nvertices = csr->size();
+        CSRGraph<T>* sides[2] = {csr, reverse};
+        float* dist[2] = {new float[nvertices], new float[nvertices]};
+        int* parent[2] = {new int[nvertices], new int[nvertices]};
+        for(int side=0; side < 2; side++){
+            for(int id=0; id < nvertices; id++){
+                dist[side][id] = INF;
+                parent[side][id] = -1;
+            }
+        }
+        IndexedHeap<float> forward(nvertices), backward(nvertices);
+        IndexedHeap<float>* heaps[2] = {&forward, &backward};
+        dist[0][source] = 0;
+        dist[1][target] = 0;
+        forward.push(source, 0);
+        backward.push(target, 0);
+
+        float best = source == target ? 0 : INF;
+        int meet = source == target ? source : -1;
+        int count = 0;
+        bool negative = false;
+        while(!negative && !forward.empty() && !backward.empty()){
+            if(forward.topKey() + backward.topKey() >= best) break;
+            int side = forward.topKey() <= backward.topKey() ? 0 : 1;
+            int other = 1 - side;
+            int from = heaps[side]->pop();
+            count++;
+            const int* offsets = sides[side]->getOffsets();
+            const int* targets = sides[side]->getTargets();
+            const float* weights = sides[side]->getWeights();
+            float base = dist[side][from];
+            for(int edge=offsets[from]; edge < offsets[from + 1]; edge++){
+                float weight = weights[edge];
+                if(weight < 0){
+                    negative = true;
+                    break;
+                }
+                int to = targets[edge];
+                if(base + weight < dist[side][to]){
+                    dist[side][to] = base + weight;
+                    parent[side][to] = from;
+                    heaps[side]->pushOrDecrease(to, dist[side][to]);
+                }
+                if(dist[other][to] != INF && dist[side][to] + dist[other][to] < best){
+                    best = dist[side][to] + dist[other][to];
+                    meet = to;
+                }
+            }
+        }
+        if(negative){
+            for(int side=0; side < 2; side++){
+                delete []dist[side];
+                delete []parent[side];
+            }
+            throw std::invalid_argument("Dijkstra: negative edge weight");
+        }
+
+        if(route != 0){
+            route->clear();
+            if(meet != -1){
+                for(int id=meet; id != -1; id = parent[0][id]) route->add(0, id);
+                for(int id=parent[1][meet]; id != -1; id = parent[1][id]) route->add(id);
+            }
+        }
+        if(settled != 0) *settled = count;
+        for(int side=0; side < 2; side++){
+            delete []dist[side];
+            delete []parent[side];
+        }
+        return best;
+    }
+
+    /*
+    ! aStar(csr, source, target, heuristic, route, settled)
+    ? Functionality:
+        * Best-first search on cost-so-far + heuristic(vertex, goal); a vertex reached
+          again with a lower cost is reopened, so an admissible but inconsistent
+          heuristic still gives the exact answer.
+        * route/settled: as bidirectionalDijkstra.
+    ? Return:
+        * float: cost of the path found, infinity if target is unreachable
+    */
+    static float aStar(CSRGraph<T>* csr, int source, int target, Heuristic heuristic,
+                       DLinkedList<int>* route=0, int* settled=0) {
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        const float* weights = csr->getWeights();
+        float* cost = new float[nvertices];
+        float* estimate = new float[nvertices]; //heuristic, computed once per vertex
+        int* parent = new int[nvertices];
+        for(int id=0; id < nvertices; id++){
+            cost[id] = INF;
+            estimate[id] = -1;
+            parent[id] = -1;
+        }
+        T& goal = csr->vertex(target);
+        IndexedHeap<float> heap(nvertices);
+        cost[source] = 0;
+        estimate[source] = heuristic(csr->vertex(source), goal);
+        heap.push(source, estimate[source]);
+        int count = 0;
+        bool negative = false;
+        while(!negative && !heap.empty()){
+            int from = heap.pop();
+            count++;
+            if(from == target) break;
+            float base = cost[from];
+            for(int edge=offsets[from]; edge < offsets[from + 1]; edge++){
+                float weight = weights[edge];
+                if(weight < 0){
+                    negative = true;
+                    break;
+                }
+                int to = targets[edge];
+                if(base + weight < cost[to]){
+                    cost[to] = base + weight;
+                    parent[to] = from;
+                    if(estimate[to] < 0) estimate[to] = heuristic(csr->vertex(to), goal);
+                    heap.pushOrDecrease(to, cost[to] + estimate[to]);
+                }
+            }
+        }
+
+        if(negative){
+            delete []cost;
+            delete []estimate;
+            delete []parent;
+            throw std::invalid_argument("A*: negative edge weight");
+        }
+
+        float best = cost[target];
+        if(route != 0){
+            route->clear();
+            if(best != INF)
+                for(int id=target; id != -1; id = parent[id]) route->add(0, id);
+        }
+        if(settled != 0) *settled = count;
+        delete []cost;
+        delete []estimate;
+        delete []parent;
+        return best;
+    }
+
+    /*
+    ! bellmanFord(csr, source, dist, parent, cycle)
+    ? Functionality:
+        * SPFA: a FIFO queue holds the vertices whose distance dropped since they were
+          last scanned; only their out-edges are relaxed again.
+        * A negative cycle is detected when a tentative path reaches V edges.
+        * dist/parent: as dijkstra; cycle (optional): receives the ids of one
+          negative cycle, first id repeated at the end.
+    ? Return:
+        * bool: false if a negative cycle is reachable from source
+    */
+    static bool bellmanFord(CSRGraph<T>* csr, int source, float* dist, int* parent,
+                            DLinkedList<int>* cycle=0) {
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        const float* weights = csr->getWeights();
+        for(int id=0; id < nvertices; id++){
+            dist[id] = INF;
+            parent[id] = -1;
+        }
+        int* length = new int[nvertices]();     //edges on the tentative path
+        DynamicBitset queued(nvertices);
+        int* queue = new int[nvertices + 1];    //ring: each id is queued at most once
+        int head = 0, tail = 0;
+        dist[source] = 0;
+        queue[tail++] = source;
+        queued.set(source);
+        int culprit = -1;
+        while(head != tail && culprit == -1){
+            int from = queue[head];
+            head = head == nvertices ? 0 : head + 1;
+            queued.reset(from);
+            float base = dist[from];
+            for(int edge=offsets[from]; edge < offsets[from + 1]; edge++){
+                int to = targets[edge];
+                if(base + weights[edge] < dist[to]){
+                    dist[to] = base + weights[edge];
+                    parent[to] = from;
+                    length[to] = length[from] + 1;
+                    if(length[to] >= nvertices){
+                        culprit = to;
+                        break;
+                    }
+                    if(!queued.testAndSet(to)){
+                        queue[tail] = to;
+                        tail = tail == nvertices ? 0 : tail + 1;
+                    }
+                }
+            }
+        }
+        delete []length;
+        delete []queue;
+        if(culprit == -1) return true;
+        if(cycle != 0) parentCycle(nvertices, parent, culprit, cycle);
+        return false;
+    }
 
+protected:
+    static constexpr float INF = std::numeric_limits<float>::infinity();
+
+    //dense id of vertex in csr; deletes csr and throws VertexNotFoundException if absent
+    static int sourceId(DGraphModel<T>* graph, CSRGraph<T>* csr, T& vertex) {
+        int id = csr->indexOf(vertex);
+        if(id == -1){
+            delete csr;
+            throw VertexNotFoundException(vertexToString(graph, vertex));
+        }
+        return id;
+    }
+    //deletes csr and throws std::invalid_argument(message) if an edge weight is negative
+    static void requireNonNegative(CSRGraph<T>* csr, const char* message) {
+        const float* weights = csr->getWeights();
+        for(int edge=0; edge < csr->edgeCount(); edge++){
+            if(weights[edge] < 0){
+                delete csr;
+                throw std::invalid_argument(message);
+            }
+        }
+    }
+    static string vertexToString(DGraphModel<T>* graph, T& vertex) {
+        if(graph->getVertex2Str() != 0) return graph->getVertex2Str()(vertex);
+        stringstream os;
+        os << vertex;
+        return os.str();
+    }
+
+    //one path per reachable vertex other than source, in vertex order
+    static DLinkedList<Path<T>*> buildPaths(CSRGraph<T>* csr, int source, float* dist, int* parent) {
+        DLinkedList<Path<T>*> list;
+        for(int id=0; id < csr->size(); id++){
+            if(id == source || dist[id] == INF) continue;
+            Path<T>* path = new Path<T>();
+            path->setCost(dist[id]);
+            for(int step=id; step != -1; step = parent[step]) path->getPath().add(0, csr->vertex(step));
+            list.add(path);
+        }
         return list;
     }
+    static Path<T>* routeToPath(CSRGraph<T>* csr, float cost, DLinkedList<int>& route) {
+        if(cost == INF) return nullptr;
+        Path<T>* path = new Path<T>();
+        path->setCost(cost);
+        for(int id: route) path->add(csr->vertex(id));
+        return path;
+    }
+
+    /*
+    ! parentCycle(nvertices, parent, start, cycle): a cycle of the parent pointers met
+    * when following them from start, or else anywhere in the parent graph.
+    */
+    static void parentCycle(int nvertices, int* parent, int start, DLinkedList<int>* cycle) {
+        cycle->clear();
+        int* mark = new int[nvertices];
+        for(int id=0; id < nvertices; id++) mark[id] = -1;
+        int found = -1;
+        for(int root=-1; root < nvertices && found == -1; root++){
+            int walk = root == -1 ? start : root;
+            if(mark[walk] != -1) continue;
+            int id = walk;
+            while(id != -1 && mark[id] == -1){
+                mark[id] = walk;
+                id = parent[id];
+            }
+            if(id != -1 && mark[id] == walk) found = id;
+        }
+        if(found != -1){
+            int id = found;
+            do{
+                cycle->add(0, id);
+                id = parent[id];
+            }while(id != found);
+            cycle->add(cycle->get(0));
+        }
+        delete []mark;
+    }
 };
-*/
+
 #endif /* DGRAPHMODEL_H */
\ No newline at end of file
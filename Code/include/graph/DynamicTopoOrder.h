@@ -0,0 +1,303 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines DynamicTopoOrder: a topological order kept up to date while edges are added
+*/
+
+#ifndef DYNAMICTOPOORDER_H
+#define DYNAMICTOPOORDER_H
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "graph/DGraphModel.h"
+#include "graph/TopoSorter.h"
+#include "graph/SCCFinder.h"
+#include "graph/VertexIds.h"
+#include "util/DynamicBitset.h"
+using namespace std;
+
+/*
+! DynamicTopoOrder<T>
+? Functionality:
+    * Keeps a topological order of a DGraphModel<T> (a DAG) while vertices and edges
+      are added through it, without sorting the whole graph again (Pearce & Kelly,
+      "A dynamic topological sort algorithm for directed acyclic graphs", 2006).
+    * connect(from, to) with from already before to: the order stays valid, O(1).
+      Otherwise only the affected region is visited:
+        - forward from "to" through the vertices placed before "from",
+        - backward from "from" through the vertices placed after "to",
+      and those vertices are moved inside their own positions (backward set
+      first): time proportional to the region and its edges, not to the graph.
+    * Reaching "from" in the forward search means the edge would close a cycle: the
+      edge is rejected and the graph is left unchanged.
+? Notes:
+    * The vertices get dense ids (VertexIds); edges are mirrored in id adjacency lists
+      (out and in), and the searches mark ids in a DynamicBitset.
+      Vertices and edges must be added through this object; after the graph was
+      changed directly, call rebuild(). Removing edges never invalidates the order.
+    * Needs a vertex hash (the constructor's, or else the graph's).
+? Exceptions:
+    * CycleException: connect() would close a cycle, or the graph given to
+      the constructor / rebuild() is not acyclic.
+    * VertexNotFoundException: connect() with an unknown vertex.
+? Usage:
+    * DynamicTopoOrder<int> topo(&graph);
+    * topo.connect(1, 2);
+    * if(!topo.tryConnect(2, 1)) ...   //would close a cycle
+    * DLinkedList<int> order = topo.order();
+*/
+template<class T>
+class DynamicTopoOrder{
+protected:
+    DGraphModel<T>* graph;
+    int (*hash)(T&, int);
+    VertexIds<T>* ids;          //vertex <-> dense id
+    vector<int> position;       //id -> position in the order
+    vector<int> atPosition;     //position -> id
+    vector<vector<int>> outEdges;
+    vector<vector<int>> inEdges;
+
+    //scratch of one insertion
+    DynamicBitset visited;
+    vector<int> forwardSet;
+    vector<int> backwardSet;
+    vector<int> stack;
+    vector<int> previous;
+
+    long long moved;            //vertices moved by all insertions so far
+
+public:
+    DynamicTopoOrder(DGraphModel<T>* graph, int (*hash)(T&, int)=0){
+        this->graph = graph;
+        this->hash = hash != 0 ? hash : graph->getVertexHash();
+        if(this->hash == 0) throw std::invalid_argument("DynamicTopoOrder: a vertex hash is required");
+        this->ids = nullptr;
+        this->moved = 0;
+        rebuild();
+    }
+    ~DynamicTopoOrder(){
+        delete ids;
+    }
+    DynamicTopoOrder(const DynamicTopoOrder&) = delete;
+    DynamicTopoOrder& operator=(const DynamicTopoOrder&) = delete;
+
+    /*
+    ! rebuild(): orders the graph again from scratch (Kahn's algorithm on a snapshot)
+    ? Exceptions:
+        * CycleException if the graph has a cycle
+    */
+    void rebuild(){
+        CSRGraph<T>* csr = graph->freeze();
+        int nvertices = csr->size();
+        vector<int> order(nvertices);
+        int count = TopoSorter<T>::parallelKahn(csr, 0, order.data());
+        if(count < nvertices){
+            DLinkedList<int> ids;
+            SCCFinder<T>::findCycle(csr, &ids);
+            stringstream os;
+            bool first = true;
+            for(int id: ids){
+                os << (first ? "" : " -> ") << csr->vertexStr(csr->vertex(id));
+                first = false;
+            }
+            delete csr;
+            throw CycleException(os.str());
+        }
+
+        delete ids;
+        ids = new VertexIds<T>(hash, graph->getVertexEQ(), nvertices);
+        outEdges.assign(nvertices, vector<int>());
+        inEdges.assign(nvertices, vector<int>());
+        for(int id=0; id < nvertices; id++){
+            ids->intern(csr->vertex(id));
+            for(int to: csr->neighbors(id)){
+                outEdges[id].push_back(to);
+                inEdges[to].push_back(id);
+            }
+        }
+        atPosition = order;
+        position.assign(nvertices, 0);
+        for(int idx=0; idx < nvertices; idx++) position[order[idx]] = idx;
+        visited = DynamicBitset(nvertices);
+        previous.assign(nvertices, -1);
+        delete csr;
+    }
+
+    int size(){
+        return ids->size();
+    }
+    //vertices moved by the insertions so far (the work done beyond the O(1) checks)
+    long long getMovedVertices(){
+        return moved;
+    }
+
+    /*
+    ! add(T vertex): adds vertex to the graph, at the end of the order
+    */
+    void add(T vertex){
+        if(ids->contains(vertex)) return;
+        graph->add(vertex);
+        int id = ids->intern(vertex);
+        outEdges.push_back(vector<int>());
+        inEdges.push_back(vector<int>());
+        position.push_back(id);
+        atPosition.push_back(id);
+        visited.pushBack(false);
+        previous.push_back(-1);
+    }
+
+    /*
+    ! connect(T from, T to, float weight=0): adds the edge to the graph and to the order
+    ? Exceptions:
+        * CycleException if the edge would close a cycle (graph unchanged)
+        * VertexNotFoundException if from or to was not added
+    */
+    void connect(T from, T to, float weight=0){
+        string cycle;
+        if(!insert(from, to, weight, &cycle)) throw CycleException(cycle);
+    }
+
+    /*
+    ! tryConnect(T from, T to, float weight=0)
+    ? Return:
+        * bool: false (and nothing changed) if the edge would close a cycle
+    */
+    bool tryConnect(T from, T to, float weight=0){
+        return insert(from, to, weight, 0);
+    }
+
+    //position of vertex in the current order (0 = first)
+    int positionOf(T vertex){
+        return position[idOf(vertex)];
+    }
+    bool precedes(T first, T second){
+        return positionOf(first) < positionOf(second);
+    }
+    DLinkedList<T> order(){
+        DLinkedList<T> list;
+        for(int id: atPosition) list.add(ids->vertex(id));
+        return list;
+    }
+
+protected:
+    int idOf(T& vertex){
+        int id = ids->indexOf(vertex);
+        if(id == -1) throw VertexNotFoundException(vertexStr(vertex));
+        return id;
+    }
+    string vertexStr(T& vertex){
+        if(graph->getVertex2Str() != 0) return graph->getVertex2Str()(vertex);
+        stringstream os;
+        os << vertex;
+        return os.str();
+    }
+
+    bool insert(T& fromVertex, T& toVertex, float weight, string* cycle){
+        int from = idOf(fromVertex);
+        int to = idOf(toVertex);
+        if(from == to){
+            if(cycle != 0) *cycle = vertexStr(fromVertex) + " -> " + vertexStr(fromVertex);
+            return false;
+        }
+        bool exists = graph->connected(fromVertex, toVertex);
+        if(!exists && position[to] < position[from]){
+            int lower = position[to], upper = position[from];
+            if(!searchForward(to, from, upper)){
+                if(cycle != 0) *cycle = cycleText(from, to);
+                clearVisited(forwardSet);
+                return false;
+            }
+            searchBackward(from, lower);
+            reorder();
+        }
+        graph->connect(fromVertex, toVertex, weight);
+        if(!exists){
+            outEdges[from].push_back(to);
+            inEdges[to].push_back(from);
+        }
+        return true;
+    }
+
+    //vertices reachable from start and placed at or before upper; false if target is one of them
+    bool searchForward(int start, int target, int upper){
+        forwardSet.clear();
+        stack.assign(1, start);
+        visited.set(start);
+        previous[start] = -1;
+        forwardSet.push_back(start);
+        while(!stack.empty()){
+            int id = stack.back();
+            stack.pop_back();
+            for(int next: outEdges[id]){
+                if(next == target){
+                    previous[next] = id;
+                    return false;
+                }
+                if(visited.test(next) || position[next] > upper) continue;
+                visited.set(next);
+                previous[next] = id;
+                forwardSet.push_back(next);
+                stack.push_back(next);
+            }
+        }
+        return true;
+    }
+    //vertices that reach start and are placed at or after lower
+    void searchBackward(int start, int lower){
+        backwardSet.clear();
+        stack.assign(1, start);
+        visited.set(start);
+        backwardSet.push_back(start);
+        while(!stack.empty()){
+            int id = stack.back();
+            stack.pop_back();
+            for(int next: inEdges[id]){
+                if(visited.test(next) || position[next] < lower) continue;
+                visited.set(next);
+                backwardSet.push_back(next);
+                stack.push_back(next);
+            }
+        }
+    }
+    /*
+    ! reorder(): the positions held by both sets are handed out again, in
+    * increasing order, to the backward set then the forward set (each keeps its
+    * internal order), so every vertex that reaches "from" comes before "to".
+    */
+    void reorder(){
+        auto byPosition = [this](int lhs, int rhs){ return position[lhs] < position[rhs]; };
+        std::sort(forwardSet.begin(), forwardSet.end(), byPosition);
+        std::sort(backwardSet.begin(), backwardSet.end(), byPosition);
+        vector<int> slots;
+        slots.reserve(forwardSet.size() + backwardSet.size());
+        for(int id: backwardSet) slots.push_back(position[id]);
+        for(int id: forwardSet) slots.push_back(position[id]);
+        std::sort(slots.begin(), slots.end());
+        int idx = 0;
+        for(int id: backwardSet) place(id, slots[idx++]);
+        for(int id: forwardSet) place(id, slots[idx++]);
+        moved += (long long)slots.size();
+        clearVisited(forwardSet);
+        clearVisited(backwardSet);
+    }
+    void place(int id, int slot){
+        position[id] = slot;
+        atPosition[slot] = id;
+    }
+    void clearVisited(vector<int>& set){
+        for(int id: set) visited.reset(id);
+    }
+
+    //"to -> ... -> from -> to" from the previous[] links of searchForward
+    string cycleText(int from, int to){
+        vector<int> path;
+        for(int id=from; id != -1; id = previous[id]) path.push_back(id);
+        std::reverse(path.begin(), path.end());
+        stringstream os;
+        for(int id: path) os << vertexStr(ids->vertex(id)) << " -> ";
+        os << vertexStr(ids->vertex(to));
+        return os.str();
+    }
+};
+
+#endif /* DYNAMICTOPOORDER_H */
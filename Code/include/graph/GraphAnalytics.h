@@ -0,0 +1,318 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines GraphAnalytics: PageRank and centralities on a CSRGraph snapshot
+*/
+
+#ifndef GRAPHANALYTICS_H
+#define GRAPHANALYTICS_H
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "graph/AbstractGraph.h"
+#include "graph/CSRGraph.h"
+#include "util/ThreadPool.h"
+using namespace std;
+
+/*
+! GraphAnalytics<T>
+? Functionality:
+    * Iterative scores of the vertices of a graph, computed like sparse matrix-vector
+      products over the flat arrays of a CSRGraph:
+        - pageRank:              stationary distribution of a random surfer who follows
+                                 an out-edge with probability "damping" and jumps to a
+                                 random vertex otherwise,
+        - personalizedPageRank:  the same, but every jump (and every dead end) goes back
+                                 to one of the seed vertices,
+        - degreeCentrality:      in-, out- or total degree divided by size() - 1,
+        - closenessCentrality:   how close a vertex is to the vertices it reaches
+                                 (BFS hop counts, Wasserman-Faust form for graphs that
+                                 are not strongly connected).
+? Notes:
+    * PageRank pulls: rank'[v] is the sum over the in-edges of v of rank[u] / outDegree(u),
+      read from the transpose built once in the constructor. Every vertex is written by
+      one worker only (no atomics, no locks), the in-edges of v are contiguous, and the
+      sum uses four independent accumulators so the adds do not wait on each other.
+    * Sums over all vertices (dangling mass, residual) are taken per fixed block of
+      "grain" vertices and added in block order: the scores are the same for any
+      number of threads.
+    * Edge weights are ignored (every out-edge is equally likely).
+    * pool == 0: everything runs on the calling thread.
+? Usage:
+    * ThreadPool pool(8);
+    * GraphAnalytics<int> analytics(&graph, &pool);        //or (csr, &pool)
+    * vector<double> rank(analytics.size());
+    * int iterations = analytics.pageRank(rank.data());
+    * DLinkedList<int> best = analytics.top(rank.data(), 10);
+*/
+template<class T>
+class GraphAnalytics{
+public:
+    static int IN;
+    static int OUT;
+    static int TOTAL;
+
+protected:
+    CSRGraph<T>* csr;
+    CSRGraph<T>* reverse;   //in-edges; == csr for an undirected snapshot
+    bool ownsSnapshot;      //csr was taken by freeze() in the constructor
+    ThreadPool* pool;
+    int grain;
+    double residual;        //L1 change of the last iteration of the last PageRank call
+
+public:
+    GraphAnalytics(CSRGraph<T>* csr, ThreadPool* pool=0, int grain=4096){
+        init(csr, false, pool, grain);
+    }
+    GraphAnalytics(AbstractGraph<T>* graph, ThreadPool* pool=0, int grain=4096){
+        init(graph->freeze(), true, pool, grain);
+    }
+    ~GraphAnalytics(){
+        if(reverse != csr) delete reverse;
+        if(ownsSnapshot) delete csr;
+    }
+    GraphAnalytics(const GraphAnalytics&) = delete;
+    GraphAnalytics& operator=(const GraphAnalytics&) = delete;
+
+    int size(){
+        return csr->size();
+    }
+    CSRGraph<T>* getSnapshot(){
+        return csr;
+    }
+    double getResidual(){
+        return residual;
+    }
+
+    /*
+    ! pageRank(rank, damping, tolerance, maxIterations)
+    ? Functionality:
+        * rank[id] (size() items): the PageRank of id; the ranks add up to 1.
+        * Iterates until the ranks change by less than tolerance in total (L1 norm),
+          or maxIterations times. The mass of vertices without out-edges is spread
+          over all vertices.
+    ? Return:
+        * int: number of iterations done
+    */
+    int pageRank(double* rank, double damping=0.85, double tolerance=1e-6, int maxIterations=100){
+        return iterate(rank, 0, damping, tolerance, maxIterations);
+    }
+
+    /*
+    ! personalizedPageRank(seeds, nseeds, rank, damping, tolerance, maxIterations)
+    ? Functionality:
+        * As pageRank, with every jump to one of the seed ids (equally likely): the ranks
+          measure proximity to the seeds.
+    ? Exceptions:
+        * std::invalid_argument if there are no seeds, std::out_of_range for an invalid id
+    */
+    int personalizedPageRank(const int* seeds, int nseeds, double* rank,
+                             double damping=0.85, double tolerance=1e-6, int maxIterations=100){
+        if(nseeds <= 0) throw std::invalid_argument("GraphAnalytics: no seed vertices");
+        int nvertices = csr->size();
+        vector<double> teleport(nvertices, 0.0);
+        for(int idx=0; idx < nseeds; idx++){
+            if(seeds[idx] < 0 || seeds[idx] >= nvertices) throw std::out_of_range("GraphAnalytics: seed id is out of range");
+            teleport[seeds[idx]] += 1.0 / nseeds;
+        }
+        return iterate(rank, teleport.data(), damping, tolerance, maxIterations);
+    }
+    //personalizedPageRank from seed vertices
+    int personalizedPageRank(DLinkedList<T>& seeds, double* rank,
+                             double damping=0.85, double tolerance=1e-6, int maxIterations=100){
+        vector<int> ids;
+        for(T& vertex: seeds){
+            int id = csr->indexOf(vertex);
+            if(id == -1) throw VertexNotFoundException(csr->vertexStr(vertex));
+            ids.push_back(id);
+        }
+        return personalizedPageRank(ids.data(), (int)ids.size(), rank, damping, tolerance, maxIterations);
+    }
+
+    /*
+    ! degreeCentrality(score, mode=TOTAL)
+    ? Functionality:
+        * score[id]: IN, OUT or TOTAL (in + out) degree of id over size() - 1.
+          On an undirected snapshot every mode gives the degree.
+    */
+    void degreeCentrality(double* score, int mode=2){
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* inDegrees = csr->getInDegrees();
+        bool directed = csr->isDirected();
+        double scale = nvertices > 1 ? 1.0 / (nvertices - 1) : 0.0;
+        forRange(0, nvertices, [&](long long lo, long long hi){
+            for(long long id=lo; id < hi; id++){
+                int out = offsets[id + 1] - offsets[id];
+                int degree = !directed || mode == OUT ? out : mode == IN ? inDegrees[id] : out + inDegrees[id];
+                score[id] = degree * scale;
+            }
+        });
+    }
+
+    /*
+    ! closenessCentrality(score, sources, nsources)
+    ? Functionality:
+        * score[id] for id in sources (every vertex if sources == 0): with r the number
+          of other vertices id reaches along out-edges and s the sum of their hop counts,
+          (r / (size() - 1)) * (r / s); 0 if id reaches nothing.
+        * One BFS per source, the sources split among the workers: O(nsources * (V + E)),
+          so on large graphs pass a sample of sources.
+    */
+    void closenessCentrality(double* score, const int* sources=0, int nsources=0){
+        int nvertices = csr->size();
+        if(sources == 0) nsources = nvertices;
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        forRange(0, nsources, [&](long long lo, long long hi){
+            vector<int> depth(nvertices, -1);
+            vector<int> queue(nvertices);
+            for(long long idx=lo; idx < hi; idx++){
+                int source = sources != 0 ? sources[idx] : (int)idx;
+                int head = 0, tail = 0;
+                long long total = 0;
+                depth[source] = 0;
+                queue[tail++] = source;
+                while(head < tail){
+                    int id = queue[head++];
+                    for(int edge=offsets[id]; edge < offsets[id + 1]; edge++){
+                        int to = targets[edge];
+                        if(depth[to] != -1) continue;
+                        depth[to] = depth[id] + 1;
+                        total += depth[to];
+                        queue[tail++] = to;
+                    }
+                }
+                double reached = tail - 1;
+                score[source] = total > 0 ? (reached / (nvertices - 1)) * (reached / total) : 0.0;
+                for(int pos=0; pos < tail; pos++) depth[queue[pos]] = -1;
+            }
+        }, 1);
+    }
+
+    /*
+    ! top(score, k)
+    ? Return:
+        * The k vertices with the highest score, best first (ties: lower id first).
+    */
+    DLinkedList<T> top(const double* score, int k){
+        int nvertices = csr->size();
+        if(k > nvertices) k = nvertices;
+        vector<int> ids(nvertices);
+        for(int id=0; id < nvertices; id++) ids[id] = id;
+        auto better = [score](int lhs, int rhs){
+            return score[lhs] > score[rhs] || (score[lhs] == score[rhs] && lhs < rhs);
+        };
+        std::partial_sort(ids.begin(), ids.begin() + (k > 0 ? k : 0), ids.end(), better);
+        DLinkedList<T> list;
+        for(int idx=0; idx < k; idx++) list.add(csr->vertex(ids[idx]));
+        return list;
+    }
+
+protected:
+    void init(CSRGraph<T>* csr, bool ownsSnapshot, ThreadPool* pool, int grain){
+        this->csr = csr;
+        this->reverse = csr->isDirected() ? csr->transpose() : csr;
+        this->ownsSnapshot = ownsSnapshot;
+        this->pool = pool;
+        this->grain = grain > 0 ? grain : 1;
+        this->residual = 0;
+    }
+
+    template<class F>
+    void forRange(long long begin, long long end, F fn, long long minBlock=-1){
+        if(minBlock < 0) minBlock = grain;
+        if(pool != 0) pool->parallelFor(begin, end, fn, minBlock);
+        else if(begin < end) fn(begin, end);
+    }
+
+    //fn(blockBegin, blockEnd) returns the sum over one block of "grain" ids;
+    //the block sums are added in block order, whatever the thread that computed them
+    template<class F>
+    double blockSum(int nvertices, vector<double>& partial, F fn){
+        long long nblocks = ((long long)nvertices + grain - 1) / grain;
+        partial.assign(nblocks, 0.0);
+        forRange(0, nblocks, [&](long long lo, long long hi){
+            for(long long block=lo; block < hi; block++){
+                long long begin = block * grain;
+                long long end = std::min<long long>(begin + grain, nvertices);
+                partial[block] = fn((int)begin, (int)end);
+            }
+        }, 1);
+        double sum = 0;
+        for(double value: partial) sum += value;
+        return sum;
+    }
+
+    //teleport == 0: uniform jumps
+    int iterate(double* rank, const double* teleport, double damping, double tolerance, int maxIterations){
+        int nvertices = csr->size();
+        residual = 0;
+        if(nvertices == 0) return 0;
+        const int* offsets = csr->getOffsets();
+        const int* revOffsets = reverse->getOffsets();
+        const int* sources = reverse->getTargets();
+        vector<double> contribution(nvertices);
+        vector<double> next(nvertices);
+        vector<double> partial;
+        double uniform = 1.0 / nvertices;
+        double* current = rank;     //the two buffers swap roles every iteration
+        double* updated = next.data();
+        forRange(0, nvertices, [&](long long lo, long long hi){
+            for(long long id=lo; id < hi; id++) current[id] = teleport != 0 ? teleport[id] : uniform;
+        });
+
+        int iteration = 0;
+        while(iteration < maxIterations){
+            iteration++;
+            //contribution[u] = rank[u] / outDegree(u); dead ends give their rank to the jumps
+            double dangling = blockSum(nvertices, partial, [&](int begin, int end){
+                double lost = 0;
+                for(int id=begin; id < end; id++){
+                    int out = offsets[id + 1] - offsets[id];
+                    contribution[id] = out > 0 ? current[id] / out : 0.0;
+                    if(out == 0) lost += current[id];
+                }
+                return lost;
+            });
+            double jump = (1.0 - damping) + damping * dangling;
+            const double* pull = contribution.data();
+            residual = blockSum(nvertices, partial, [&](int begin, int end){
+                double change = 0;
+                for(int id=begin; id < end; id++){
+                    int edge = revOffsets[id], last = revOffsets[id + 1];
+                    double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+                    for(; edge + 4 <= last; edge += 4){
+                        sum0 += pull[sources[edge]];
+                        sum1 += pull[sources[edge + 1]];
+                        sum2 += pull[sources[edge + 2]];
+                        sum3 += pull[sources[edge + 3]];
+                    }
+                    for(; edge < last; edge++) sum0 += pull[sources[edge]];
+                    double value = jump * (teleport != 0 ? teleport[id] : uniform)
+                                 + damping * ((sum0 + sum1) + (sum2 + sum3));
+                    change += std::fabs(value - current[id]);
+                    updated[id] = value;
+                }
+                return change;
+            });
+            std::swap(current, updated);
+            if(residual < tolerance) break;
+        }
+        if(current != rank){
+            forRange(0, nvertices, [&](long long lo, long long hi){
+                std::copy(current + lo, current + hi, rank + lo);
+            });
+        }
+        return iteration;
+    }
+};
+template<class T>
+int GraphAnalytics<T>::IN = 0;
+template<class T>
+int GraphAnalytics<T>::OUT = 1;
+template<class T>
+int GraphAnalytics<T>::TOTAL = 2;
+
+#endif /* GRAPHANALYTICS_H */
@@ -0,0 +1,610 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines bulk graph loading: edge lists (text, CSV, .npy) and a mappable binary graph file
+*/
+
+#ifndef GRAPHIO_H
+#define GRAPHIO_H
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include "graph/CSRGraph.h"
+#include "loader/RowStream.h"
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+/*
+! EdgeListBuilder
+? Functionality:
+    * Collects (from, to, weight) triples over integer vertex ids and turns them into a
+      CSRGraph<int> in O(V+E): counting sort by source (the edges of a source keep their
+      input order), then one pass that drops repeated edges.
+    * A repeated edge keeps its first position and the last weight, as connect() does.
+      Undirected: every edge u-v is stored as u->v and v->u (a self-loop once), like
+      UGraphModel; AbstractGraph::addAll can load the result into a model.
+    * The vertices are the ids 0..n-1, n = largest id + 1 (or more, see build()).
+? Usage:
+    * EdgeListBuilder builder;
+    * builder.add(0, 1, 2.5f);
+    * CSRGraph<int>* csr = builder.build();
+*/
+class EdgeListBuilder{
+protected:
+    bool directed;
+    int maxId;
+    vector<int> sources;
+    vector<int> targets;
+    vector<float> weights;
+
+public:
+    EdgeListBuilder(bool directed=true): directed(directed), maxId(-1){
+    }
+
+    void reserve(long long nedges){
+        sources.reserve(nedges);
+        targets.reserve(nedges);
+        weights.reserve(nedges);
+    }
+    bool isDirected(){
+        return directed;
+    }
+    //number of edges added (repeats included)
+    long long size(){
+        return (long long)sources.size();
+    }
+    //largest id seen + 1
+    int vertexCount(){
+        return maxId + 1;
+    }
+    void clear(){
+        sources.clear();
+        targets.clear();
+        weights.clear();
+        maxId = -1;
+    }
+
+    /*
+    ! add(from, to, weight)
+    ? Exceptions:
+        * std::out_of_range if an id is negative
+    */
+    void add(int from, int to, float weight=0){
+        if(from < 0 || to < 0) throw std::out_of_range("EdgeListBuilder: negative vertex id");
+        if(from > maxId) maxId = from;
+        if(to > maxId) maxId = to;
+        sources.push_back(from);
+        targets.push_back(to);
+        weights.push_back(weight);
+    }
+
+    /*
+    ! build(nvertices, vertexHash)
+    ? Functionality:
+        * nvertices: number of vertices, at least vertexCount(); -1: vertexCount().
+        * vertexHash (optional): gives the result an id index (see CSRGraph::indexOf).
+    ? Return:
+        * CSRGraph<int>*: vertex id has the value id; owned by the caller.
+    */
+    CSRGraph<int>* build(int nvertices=-1, int (*vertexHash)(int&, int)=0){
+        if(nvertices < 0) nvertices = vertexCount();
+        if(nvertices < vertexCount()) throw std::invalid_argument("EdgeListBuilder: nvertices is smaller than the largest id + 1");
+        long long nedges = (long long)sources.size();
+        long long stored = 0;
+        int* offsets = new int[nvertices + 1]();
+        for(long long idx=0; idx < nedges; idx++){
+            offsets[sources[idx] + 1]++;
+            stored++;
+            if(!directed && sources[idx] != targets[idx]){
+                offsets[targets[idx] + 1]++;
+                stored++;
+            }
+        }
+        if(stored > INT_MAX){
+            delete []offsets;
+            throw std::length_error("EdgeListBuilder: more than INT_MAX stored edges");
+        }
+        for(int id=0; id < nvertices; id++) offsets[id + 1] += offsets[id];
+
+        int* csrTargets = new int[stored > 0 ? stored : 1];
+        float* csrWeights = new float[stored > 0 ? stored : 1];
+        vector<int> fill(offsets, offsets + nvertices);
+        for(long long idx=0; idx < nedges; idx++){
+            int slot = fill[sources[idx]]++;
+            csrTargets[slot] = targets[idx];
+            csrWeights[slot] = weights[idx];
+            if(!directed && sources[idx] != targets[idx]){
+                slot = fill[targets[idx]]++;
+                csrTargets[slot] = sources[idx];
+                csrWeights[slot] = weights[idx];
+            }
+        }
+
+        //drop repeats in place: seenFrom[to] == from means from->to was already kept at keptAt[to]
+        vector<int> seenFrom(nvertices, -1), keptAt(nvertices);
+        int write = 0;
+        for(int from=0; from < nvertices; from++){
+            int begin = offsets[from], end = offsets[from + 1];
+            offsets[from] = write;
+            for(int edge=begin; edge < end; edge++){
+                int to = csrTargets[edge];
+                if(seenFrom[to] == from){
+                    csrWeights[keptAt[to]] = csrWeights[edge];
+                    continue;
+                }
+                seenFrom[to] = from;
+                keptAt[to] = write;
+                csrTargets[write] = to;
+                csrWeights[write] = csrWeights[edge];
+                write++;
+            }
+        }
+        offsets[nvertices] = write;
+
+        int* vertexData = new int[nvertices > 0 ? nvertices : 1];
+        for(int id=0; id < nvertices; id++) vertexData[id] = id;
+        return new CSRGraph<int>(nvertices, vertexData, offsets, csrTargets, csrWeights,
+                                 directed, 0, 0, vertexHash);
+    }
+};
+
+/*
+! GraphLoader
+? Functionality:
+    * Streams an edge list from a file into an EdgeListBuilder (fixed-size blocks, the
+      file is never held whole in memory), then builds the CSRGraph<int>:
+        - loadText: one edge per line, "from to [weight]" separated by blanks;
+                    lines starting with '#' or '%' are comments,
+        - loadCSV:  the same with a delimiter (',' by default); a first line that
+                    does not start with a number is a header and is skipped,
+        - loadNpy:  an (E, 2) integer array of edges (int32/int64/uint32/uint64), and
+                    optionally an (E,) float32/float64 array of weights.
+    * Without a weight column every edge gets defaultWeight.
+? Exceptions:
+    * std::runtime_error: the file cannot be read, or a line / array is malformed
+      (the message gives the file and line).
+? Usage:
+    * CSRGraph<int>* csr = GraphLoader::loadText("web.txt");
+    * DGraphModel<int> model(&eq, &str, &hash);
+    * model.addAll(csr);
+*/
+class GraphLoader{
+public:
+    static const int CHUNK = 1 << 20;   //bytes read at a time
+    static const int NPY_ROWS = 1 << 16;
+
+    static CSRGraph<int>* loadText(string path, bool directed=true, float defaultWeight=0,
+                                   int (*vertexHash)(int&, int)=0){
+        EdgeListBuilder builder(directed);
+        readText(path, builder, 0, defaultWeight);
+        return builder.build(-1, vertexHash);
+    }
+    static CSRGraph<int>* loadCSV(string path, bool directed=true, char delimiter=',', float defaultWeight=0,
+                                  int (*vertexHash)(int&, int)=0){
+        EdgeListBuilder builder(directed);
+        readText(path, builder, delimiter, defaultWeight);
+        return builder.build(-1, vertexHash);
+    }
+    static CSRGraph<int>* loadNpy(string edgesPath, string weightsPath="", bool directed=true, float defaultWeight=0,
+                                  int (*vertexHash)(int&, int)=0){
+        EdgeListBuilder builder(directed);
+        readNpy(edgesPath, weightsPath, builder, defaultWeight);
+        return builder.build(-1, vertexHash);
+    }
+
+    /*
+    ! readText(path, builder, delimiter, defaultWeight)
+    ? Functionality:
+        * Adds the edges of a text / CSV file to builder. delimiter == 0: blanks only;
+          otherwise the delimiter also separates fields, and a header line is allowed.
+    */
+    static void readText(string path, EdgeListBuilder& builder, char delimiter=0, float defaultWeight=0){
+        FILE* file = fopen(path.c_str(), "rb");
+        if(file == nullptr) throw std::runtime_error("GraphLoader: cannot open " + path);
+        vector<char> buffer(CHUNK + 1);
+        size_t kept = 0;
+        long long line = 1;
+        bool first = true;
+        try{
+            while(true){
+                size_t got = fread(buffer.data() + kept, 1, CHUNK - kept, file);
+                size_t end = kept + got;
+                bool atEnd = kept + got < (size_t)CHUNK;
+                if(atEnd && ferror(file)) throw std::runtime_error("GraphLoader: cannot read " + path);
+                if(end == 0) break;
+                //parse whole lines only: stop after the last newline (at the end of
+                //the file, a missing final newline is added)
+                size_t stop = end;
+                if(!atEnd){
+                    while(stop > 0 && buffer[stop - 1] != '\n') stop--;
+                    if(stop == 0) throw std::runtime_error("GraphLoader: " + path + ": line longer than the read block");
+                }
+                else if(buffer[end - 1] != '\n') buffer[stop++] = '\n';
+                parseLines(buffer.data(), buffer.data() + stop, builder, delimiter, defaultWeight, path, line, first);
+                if(atEnd) break;
+                kept = end - stop;
+                memmove(buffer.data(), buffer.data() + stop, kept);
+            }
+        }
+        catch(...){
+            fclose(file);
+            throw;
+        }
+        fclose(file);
+    }
+
+    /*
+    ! readNpy(edgesPath, weightsPath, builder, defaultWeight)
+    ? Functionality:
+        * Adds the edges of an (E, 2) .npy array to builder; weightsPath == "": no weights.
+    */
+    static void readNpy(string edgesPath, string weightsPath, EdgeListBuilder& builder, float defaultWeight=0){
+        string descr;
+        {
+            ifstream file(edgesPath, ios::binary);
+            if(!file) throw std::runtime_error("GraphLoader: cannot open " + edgesPath);
+            descr = NpyHeader::parse(file).descr;
+        }
+        if(descr.size() > 0 && descr[0] == '=') descr[0] = '<';
+        if(descr == NpyType<int32_t>::descr()) readNpyEdges<int32_t>(edgesPath, weightsPath, builder, defaultWeight);
+        else if(descr == NpyType<int64_t>::descr()) readNpyEdges<int64_t>(edgesPath, weightsPath, builder, defaultWeight);
+        else if(descr == NpyType<uint32_t>::descr()) readNpyEdges<uint32_t>(edgesPath, weightsPath, builder, defaultWeight);
+        else if(descr == NpyType<uint64_t>::descr()) readNpyEdges<uint64_t>(edgesPath, weightsPath, builder, defaultWeight);
+        else throw std::runtime_error("GraphLoader: " + edgesPath + " has dtype " + descr + ", expected an integer type");
+    }
+
+protected:
+    static std::runtime_error lineError(const string& path, long long line, const string& what){
+        return std::runtime_error("GraphLoader: " + path + ":" + to_string(line) + ": " + what);
+    }
+
+    //every line in [p, end) ends with '\n'
+    static void parseLines(const char* p, const char* end, EdgeListBuilder& builder, char delimiter,
+                           float defaultWeight, const string& path, long long& line, bool& first){
+        while(p < end){
+            p = skipBlanks(p, delimiter);
+            if(*p == '\n' || *p == '#' || *p == '%'){
+                while(*p != '\n') p++;
+                p++;
+                line++;
+                continue;
+            }
+            bool number = (*p >= '0' && *p <= '9') || *p == '-' || *p == '+';
+            if(first && delimiter != 0 && !number){
+                //header line
+                first = false;
+                while(*p != '\n') p++;
+                p++;
+                line++;
+                continue;
+            }
+            first = false;
+            int from, to;
+            if(!parseInt(p, from)) throw lineError(path, line, "expected a source vertex id");
+            p = skipBlanks(p, delimiter);
+            if(!parseInt(p, to)) throw lineError(path, line, "expected a target vertex id");
+            p = skipBlanks(p, delimiter);
+            float weight = defaultWeight;
+            if(*p != '\n' && *p != '#'){
+                double value;
+                if(!parseReal(p, value)) throw lineError(path, line, "expected a weight");
+                weight = (float)value;
+                p = skipBlanks(p, delimiter);
+            }
+            if(*p != '\n' && *p != '#') throw lineError(path, line, "unexpected text after the edge");
+            if(from < 0 || to < 0) throw lineError(path, line, "negative vertex id");
+            builder.add(from, to, weight);
+            while(*p != '\n') p++;
+            p++;
+            line++;
+        }
+    }
+    static const char* skipBlanks(const char* p, char delimiter){
+        while(*p == ' ' || *p == '\t' || *p == '\r' || (delimiter != 0 && *p == delimiter)) p++;
+        return p;
+    }
+    static bool parseInt(const char*& p, int& value){
+        bool negative = *p == '-';
+        if(*p == '-' || *p == '+') p++;
+        if(*p < '0' || *p > '9') return false;
+        long long result = 0;
+        while(*p >= '0' && *p <= '9'){
+            result = result * 10 + (*p++ - '0');
+            if(result > INT_MAX) return false;
+        }
+        value = (int)(negative ? -result : result);
+        return true;
+    }
+    //decimal number with optional fraction and exponent ("2", "-0.5", "1e-3")
+    static bool parseReal(const char*& p, double& value){
+        bool negative = *p == '-';
+        if(*p == '-' || *p == '+') p++;
+        unsigned long long mantissa = 0;
+        int exponent = 0, digits = 0;
+        for(; *p >= '0' && *p <= '9'; p++, digits++){
+            if(mantissa < 100000000000000000ULL) mantissa = mantissa * 10 + (*p - '0');
+            else exponent++;
+        }
+        if(*p == '.'){
+            for(p++; *p >= '0' && *p <= '9'; p++, digits++){
+                if(mantissa < 100000000000000000ULL){
+                    mantissa = mantissa * 10 + (*p - '0');
+                    exponent--;
+                }
+            }
+        }
+        if(digits == 0) return false;
+        if(*p == 'e' || *p == 'E'){
+            p++;
+            int power;
+            if(!parseInt(p, power)) return false;
+            exponent += power;
+        }
+        static const double exact[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                       1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        double result = (double)mantissa;
+        int magnitude = exponent < 0 ? -exponent : exponent;
+        double scale = magnitude <= 22 ? exact[magnitude] : std::pow(10.0, magnitude);
+        result = exponent < 0 ? result / scale : result * scale;
+        value = negative ? -result : result;
+        return true;
+    }
+
+    template<class I>
+    static void readNpyEdges(string edgesPath, string weightsPath, EdgeListBuilder& builder, float defaultWeight){
+        NpyRowReader<I> edges(edgesPath);
+        if(edges.getHeader().shape.size() != 2 || edges.width() != 2)
+            throw std::runtime_error("GraphLoader: " + edgesPath + " must have shape (E, 2)");
+        IRowReader<float>* floatWeights = nullptr;
+        IRowReader<double>* doubleWeights = nullptr;
+        if(weightsPath != ""){
+            NpyHeader header;
+            {
+                ifstream file(weightsPath, ios::binary);
+                if(!file) throw std::runtime_error("GraphLoader: cannot open " + weightsPath);
+                header = NpyHeader::parse(file);
+            }
+            if(header.rows() != edges.rows() || header.cols() != 1)
+                throw std::runtime_error("GraphLoader: " + weightsPath + " must have shape (E,) with E = " + to_string(edges.rows()));
+            if(header.descr.size() > 0 && header.descr.substr(1) == "f8") doubleWeights = new NpyRowReader<double>(weightsPath);
+            else floatWeights = new NpyRowReader<float>(weightsPath);
+        }
+        builder.reserve(builder.size() + edges.rows());
+        vector<I> block(2 * (size_t)NPY_ROWS);
+        vector<float> weightBlock(NPY_ROWS);
+        vector<double> doubleBlock(doubleWeights != nullptr ? NPY_ROWS : 0);
+        try{
+            long long row = 0;
+            while(long long n = edges.read(block.data(), NPY_ROWS)){
+                if(floatWeights != nullptr) floatWeights->read(weightBlock.data(), n);
+                else if(doubleWeights != nullptr){
+                    doubleWeights->read(doubleBlock.data(), n);
+                    for(long long idx=0; idx < n; idx++) weightBlock[idx] = (float)doubleBlock[idx];
+                }
+                for(long long idx=0; idx < n; idx++){
+                    I from = block[2 * idx], to = block[2 * idx + 1];
+                    if(from < 0 || to < 0 || (unsigned long long)from > (unsigned long long)INT_MAX
+                                          || (unsigned long long)to > (unsigned long long)INT_MAX)
+                        throw std::runtime_error("GraphLoader: " + edgesPath + ": row " + to_string(row + idx)
+                                                 + ": vertex id out of range");
+                    float weight = floatWeights != nullptr || doubleWeights != nullptr ? weightBlock[idx] : defaultWeight;
+                    builder.add((int)from, (int)to, weight);
+                }
+                row += n;
+            }
+        }
+        catch(...){
+            delete floatWeights;
+            delete doubleWeights;
+            throw;
+        }
+        delete floatWeights;
+        delete doubleWeights;
+    }
+};
+
+/*
+! GraphFile
+? Functionality:
+    * A CSRGraph<int> on disk in the layout it has in memory, so that opening it costs
+      no parsing and no copying:
+        - a 128-byte header: magic "DSACSRG1", byte-order mark, flags (bit 0: directed),
+          number of vertices and edges, and the byte offset of every section,
+        - the sections, each starting on a 64-byte boundary: vertex values (int32,
+          nvertices), offsets (int32, nvertices + 1), targets (int32, nedges),
+          weights (float32, nedges), in-degrees (int32, nvertices).
+    * write(csr, path) stores a snapshot; map(path) memory-maps the file and returns a
+      CSRGraph whose arrays point into the mapping (pages are read on first use, and
+      shared with every process mapping the same file); read(path) loads a private copy.
+? Notes:
+    * The file is native-endian; a file written on a machine of the other byte order
+      is rejected. The mapping is read-only: do not write through vertex().
+    * map() checks the header and the section bounds, not every target id: map only
+      files written by write().
+    * Without mmap (Windows), map() falls back to read().
+? Exceptions:
+    * std::runtime_error: the file cannot be opened / created, or is not a graph file.
+? Usage:
+    * GraphFile::write(csr, "graph.csrg");
+    * CSRGraph<int>* mapped = GraphFile::map("graph.csrg");
+    * delete mapped;        //unmaps the file
+*/
+class GraphFile{
+public:
+    struct Header{
+        char magic[8];
+        uint32_t byteOrder;
+        uint32_t flags;
+        int64_t nvertices;
+        int64_t nedges;
+        int64_t vertexPos;
+        int64_t offsetsPos;
+        int64_t targetsPos;
+        int64_t weightsPos;
+        int64_t inDegreesPos;
+        char reserved[56];
+    };
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+    static const int ALIGNMENT = 64;
+
+    static void write(CSRGraph<int>* csr, string path){
+        Header header = layout(csr->size(), csr->edgeCount(), csr->isDirected());
+        ofstream file(path, ios::binary | ios::trunc);
+        if(!file) throw std::runtime_error("GraphFile: cannot create " + path);
+        int nvertices = csr->size();
+        vector<int> values(nvertices);
+        for(int id=0; id < nvertices; id++) values[id] = csr->vertex(id);
+        long long at = 0;
+        section(file, at, 0, &header, sizeof(Header));
+        section(file, at, header.vertexPos, values.data(), sizeof(int) * (size_t)nvertices);
+        section(file, at, header.offsetsPos, csr->getOffsets(), sizeof(int) * ((size_t)nvertices + 1));
+        section(file, at, header.targetsPos, csr->getTargets(), sizeof(int) * (size_t)header.nedges);
+        section(file, at, header.weightsPos, csr->getWeights(), sizeof(float) * (size_t)header.nedges);
+        section(file, at, header.inDegreesPos, csr->getInDegrees(), sizeof(int) * (size_t)nvertices);
+        file.close();
+        if(!file) throw std::runtime_error("GraphFile: write failed on " + path);
+    }
+
+    /*
+    ! map(path, vertexHash): the graph in path, backed by a read-only memory mapping;
+    * deleting the result unmaps the file. vertexHash: see EdgeListBuilder::build.
+    */
+    static CSRGraph<int>* map(string path, int (*vertexHash)(int&, int)=0){
+#if defined(_WIN32)
+        return read(path, vertexHash);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0) throw std::runtime_error("GraphFile: cannot open " + path);
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header)){
+            close(fd);
+            throw std::runtime_error("GraphFile: " + path + " is not a graph file");
+        }
+        size_t length = (size_t)info.st_size;
+        void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(address == MAP_FAILED) throw std::runtime_error("GraphFile: cannot map " + path);
+        char* base = (char*)address;
+        Header header;
+        memcpy(&header, base, sizeof(Header));
+        string problem = check(header, (long long)length);
+        if(problem == "" && (((int*)(base + header.offsetsPos))[0] != 0
+                             || ((int*)(base + header.offsetsPos))[header.nvertices] != header.nedges))
+            problem = "offsets do not match the edge count";
+        if(problem != ""){
+            munmap(address, length);
+            throw std::runtime_error("GraphFile: " + path + ": " + problem);
+        }
+        Mapping* mapping = new Mapping();
+        mapping->address = address;
+        mapping->length = length;
+        return new CSRGraph<int>((int)header.nvertices, (int*)(base + header.vertexPos),
+                                 (int*)(base + header.offsetsPos), (int*)(base + header.targetsPos),
+                                 (float*)(base + header.weightsPos), (int*)(base + header.inDegreesPos),
+                                 (header.flags & 1) != 0, mapping, &GraphFile::unmap, 0, 0, vertexHash);
+#endif
+    }
+
+    /*
+    ! read(path, vertexHash): a private in-memory copy of the graph in path
+    */
+    static CSRGraph<int>* read(string path, int (*vertexHash)(int&, int)=0){
+        ifstream file(path, ios::binary | ios::ate);
+        if(!file) throw std::runtime_error("GraphFile: cannot open " + path);
+        long long length = (long long)file.tellg();
+        file.seekg(0);
+        Header header;
+        file.read((char*)&header, sizeof(Header));
+        string problem = file ? check(header, length) : "not a graph file";
+        if(problem != "") throw std::runtime_error("GraphFile: " + path + ": " + problem);
+        int nvertices = (int)header.nvertices;
+        int nedges = (int)header.nedges;
+        int* vertexData = new int[nvertices > 0 ? nvertices : 1];
+        int* offsets = new int[nvertices + 1];
+        int* targets = new int[nedges > 0 ? nedges : 1];
+        float* weights = new float[nedges > 0 ? nedges : 1];
+        file.seekg(header.vertexPos);
+        file.read((char*)vertexData, sizeof(int) * (size_t)nvertices);
+        file.seekg(header.offsetsPos);
+        file.read((char*)offsets, sizeof(int) * ((size_t)nvertices + 1));
+        file.seekg(header.targetsPos);
+        file.read((char*)targets, sizeof(int) * (size_t)nedges);
+        file.seekg(header.weightsPos);
+        file.read((char*)weights, sizeof(float) * (size_t)nedges);
+        if(!file || offsets[0] != 0 || offsets[nvertices] != nedges){
+            delete []vertexData;
+            delete []offsets;
+            delete []targets;
+            delete []weights;
+            throw std::runtime_error("GraphFile: " + path + ": truncated or inconsistent file");
+        }
+        return new CSRGraph<int>(nvertices, vertexData, offsets, targets, weights,
+                                 (header.flags & 1) != 0, 0, 0, vertexHash);
+    }
+
+protected:
+    struct Mapping{
+        void* address;
+        size_t length;
+    };
+    static void unmap(void* storage){
+#if !defined(_WIN32)
+        Mapping* mapping = (Mapping*)storage;
+        munmap(mapping->address, mapping->length);
+        delete mapping;
+#endif
+    }
+
+    static long long aligned(long long pos){
+        return (pos + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+    static Header layout(long long nvertices, long long nedges, bool directed){
+        Header header;
+        memset(&header, 0, sizeof(Header));
+        memcpy(header.magic, "DSACSRG1", 8);
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.flags = directed ? 1 : 0;
+        header.nvertices = nvertices;
+        header.nedges = nedges;
+        header.vertexPos = aligned(sizeof(Header));
+        header.offsetsPos = aligned(header.vertexPos + 4 * nvertices);
+        header.targetsPos = aligned(header.offsetsPos + 4 * (nvertices + 1));
+        header.weightsPos = aligned(header.targetsPos + 4 * nedges);
+        header.inDegreesPos = aligned(header.weightsPos + 4 * nedges);
+        return header;
+    }
+    //"" if header describes a file of length bytes laid out by layout()
+    static string check(Header& header, long long length){
+        if(memcmp(header.magic, "DSACSRG1", 8) != 0) return "not a graph file";
+        if(header.byteOrder != BYTE_ORDER_MARK) return "written with another byte order";
+        if(header.nvertices < 0 || header.nvertices >= INT_MAX || header.nedges < 0 || header.nedges > INT_MAX)
+            return "bad vertex or edge count";
+        Header expected = layout(header.nvertices, header.nedges, (header.flags & 1) != 0);
+        if(header.vertexPos != expected.vertexPos || header.offsetsPos != expected.offsetsPos
+           || header.targetsPos != expected.targetsPos || header.weightsPos != expected.weightsPos
+           || header.inDegreesPos != expected.inDegreesPos)
+            return "bad section offsets";
+        if(header.inDegreesPos + 4 * header.nvertices > length) return "truncated file";
+        return "";
+    }
+    //pads from "at" up to pos, then writes bytes
+    static void section(ofstream& file, long long& at, long long pos, const void* data, size_t bytes){
+        static const char zeros[ALIGNMENT] = {0};
+        if(pos > at) file.write(zeros, pos - at);
+        file.write((const char*)data, bytes);
+        at = pos + (long long)bytes;
+    }
+};
+
+#endif /* GRAPHIO_H */
@@ -49,6 +49,40 @@ public:
     }
 };
 
+class NegativeCycleException: public std::exception{
+private:
+    string cycle;
+    string message;
+public:
+    NegativeCycleException(string cycle){
+        this->cycle = cycle;
+        stringstream os;
+        os << "Negative-weight cycle (" << cycle << "): is reachable";
+        os << endl;
+        this->message = os.str();
+    }
+    const char * what () const throw (){
+        return message.c_str();
+    }
+};
+
+class CycleException: public std::exception{
+private:
+    string cycle;
+    string message;
+public:
+    CycleException(string cycle){
+        this->cycle = cycle;
+        stringstream os;
+        os << "Cycle (" << cycle << "): is not allowed";
+        os << endl;
+        this->message = os.str();
+    }
+    const char * what () const throw (){
+        return message.c_str();
+    }
+};
+
 template<class T>
 struct Edge{
     T from, to;
@@ -0,0 +1,224 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines ParallelBFS: a direction-optimizing, level-synchronous BFS on a CSRGraph
+*/
+
+#ifndef PARALLELBFS_H
+#define PARALLELBFS_H
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include "graph/CSRGraph.h"
+#include "util/ThreadPool.h"
+using namespace std;
+
+/*
+! ParallelBFS<T>
+? Functionality:
+    * Breadth-first search one level at a time, each level split among the workers
+      of a ThreadPool, switching per level between two kinds of step:
+        - top-down: every frontier vertex claims its unvisited out-neighbours
+          (compare-and-swap on depth[]); cheap while the frontier is small,
+        - bottom-up: every unvisited vertex looks for a parent in the frontier among
+          its in-neighbours and stops at the first one; cheap when the frontier is
+          large, because most edges are never examined.
+    * Top-down -> bottom-up when the frontier's out-edges exceed 1/alpha of the edges
+      of the unvisited vertices; back to top-down when the frontier holds fewer than
+      1/beta of the vertices (Beamer, Asanovic, Patterson, SC 2012).
+? Notes:
+    * The in-edges come from csr->transpose(), built once in the constructor
+      (not needed for an undirected snapshot).
+    * depth[] is the same as the one of a sequential BFS; parent[] is a valid BFS tree,
+      but which parent wins a tie depends on the scheduling.
+    * pool == 0: every step runs on the calling thread.
+? Usage:
+    * ThreadPool pool(8);
+    * ParallelBFS<int> bfs(csr, &pool);
+    * int reached = bfs.search(csr->indexOf(start), depth, parent);
+*/
+template<class T>
+class ParallelBFS{
+protected:
+    CSRGraph<T>* csr;
+    CSRGraph<T>* reverse;   //in-edges; == csr for an undirected snapshot
+    ThreadPool* pool;
+    int alpha;
+    int beta;
+    int grain;
+    int topDownSteps;
+    int bottomUpSteps;
+
+public:
+    ParallelBFS(CSRGraph<T>* csr, ThreadPool* pool=0, int alpha=15, int beta=18, int grain=2048){
+        this->csr = csr;
+        this->reverse = csr->isDirected() ? csr->transpose() : csr;
+        this->pool = pool;
+        this->alpha = alpha;
+        this->beta = beta;
+        this->grain = grain;
+        this->topDownSteps = 0;
+        this->bottomUpSteps = 0;
+    }
+    ~ParallelBFS(){
+        if(reverse != csr) delete reverse;
+    }
+    ParallelBFS(const ParallelBFS&) = delete;
+    ParallelBFS& operator=(const ParallelBFS&) = delete;
+
+    //number of levels expanded by each kind of step during the last search
+    int getTopDownSteps(){
+        return topDownSteps;
+    }
+    int getBottomUpSteps(){
+        return bottomUpSteps;
+    }
+
+    /*
+    ! search(source, depth, parent)
+    ? Functionality:
+        * depth[id] (size() items): number of edges from source, -1 if unreachable.
+        * parent[id] (optional): previous id on a shortest path, -1 for source and
+          unreachable ids.
+    ? Return:
+        * int: number of vertices reached (source included)
+    */
+    int search(int source, int* depth, int* parent=0){
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        std::atomic<int>* level = new std::atomic<int>[nvertices > 0 ? nvertices : 1];
+        int* frontier = new int[nvertices > 0 ? nvertices : 1];
+        int* next = new int[nvertices > 0 ? nvertices : 1];
+        char* inFrontier = new char[nvertices > 0 ? nvertices : 1];
+        char* inNext = new char[nvertices > 0 ? nvertices : 1];
+        forRange(0, nvertices, [&](long long lo, long long hi){
+            for(long long id=lo; id < hi; id++){
+                level[id].store(-1, std::memory_order_relaxed);
+                if(parent != 0) parent[id] = -1;
+            }
+        });
+        topDownSteps = bottomUpSteps = 0;
+
+        level[source].store(0, std::memory_order_relaxed);
+        frontier[0] = source;
+        int frontierSize = 1;
+        long long frontierEdges = csr->outDegree(source);
+        long long unvisitedEdges = (long long)csr->edgeCount() - frontierEdges;
+        int reached = 1;
+        bool bottomUp = false;
+
+        for(int depthNow=0; frontierSize > 0; depthNow++){
+            //choose the direction of this step
+            if(!bottomUp && frontierEdges > unvisitedEdges / alpha){
+                bottomUp = true;
+                toBitmap(frontier, frontierSize, inFrontier, nvertices);
+            }
+            else if(bottomUp && frontierSize < nvertices / beta){
+                bottomUp = false;
+                frontierSize = fromBitmap(inFrontier, frontier, nvertices);
+            }
+
+            std::atomic<int> nextSize(0);
+            std::atomic<long long> nextEdges(0);
+            if(!bottomUp){
+                topDownSteps++;
+                forRange(0, frontierSize, [&](long long lo, long long hi){
+                    vector<int> claimed;
+                    long long edges = 0;
+                    for(long long idx=lo; idx < hi; idx++){
+                        int from = frontier[idx];
+                        for(int to: csr->neighbors(from)){
+                            int unseen = -1;
+                            if(level[to].load(std::memory_order_relaxed) == -1 &&
+                               level[to].compare_exchange_strong(unseen, depthNow + 1, std::memory_order_relaxed)){
+                                if(parent != 0) parent[to] = from;
+                                claimed.push_back(to);
+                                edges += offsets[to + 1] - offsets[to];
+                            }
+                        }
+                    }
+                    int at = nextSize.fetch_add((int)claimed.size(), std::memory_order_relaxed);
+                    std::copy(claimed.begin(), claimed.end(), next + at);
+                    nextEdges.fetch_add(edges, std::memory_order_relaxed);
+                });
+                std::swap(frontier, next);
+            }
+            else{
+                bottomUpSteps++;
+                forRange(0, nvertices, [&](long long lo, long long hi){
+                    int count = 0;
+                    long long edges = 0;
+                    for(long long id=lo; id < hi; id++){
+                        inNext[id] = 0;
+                        if(level[id].load(std::memory_order_relaxed) != -1) continue;
+                        for(int from: reverse->neighbors((int)id)){
+                            if(!inFrontier[from]) continue;
+                            level[id].store(depthNow + 1, std::memory_order_relaxed);
+                            if(parent != 0) parent[id] = from;
+                            inNext[id] = 1;
+                            count++;
+                            edges += offsets[id + 1] - offsets[id];
+                            break;
+                        }
+                    }
+                    nextSize.fetch_add(count, std::memory_order_relaxed);
+                    nextEdges.fetch_add(edges, std::memory_order_relaxed);
+                });
+                std::swap(inFrontier, inNext);
+            }
+            frontierSize = nextSize.load();
+            frontierEdges = nextEdges.load();
+            unvisitedEdges -= frontierEdges;
+            reached += frontierSize;
+        }
+
+        forRange(0, nvertices, [&](long long lo, long long hi){
+            for(long long id=lo; id < hi; id++) depth[id] = level[id].load(std::memory_order_relaxed);
+        });
+        delete []level;
+        delete []frontier;
+        delete []next;
+        delete []inFrontier;
+        delete []inNext;
+        return reached;
+    }
+
+protected:
+    template<class F>
+    void forRange(long long begin, long long end, F fn){
+        if(pool != 0) pool->parallelFor(begin, end, fn, grain);
+        else if(begin < end) fn(begin, end);
+    }
+    void toBitmap(int* list, int size, char* bitmap, int nvertices){
+        forRange(0, nvertices, [&](long long lo, long long hi){
+            std::fill(bitmap + lo, bitmap + hi, 0);
+        });
+        forRange(0, size, [&](long long lo, long long hi){
+            for(long long idx=lo; idx < hi; idx++) bitmap[list[idx]] = 1;
+        });
+    }
+    //ids set in bitmap, in id order; returns their number
+    int fromBitmap(char* bitmap, int* list, int nvertices){
+        std::mutex order;
+        vector<pair<long long, vector<int>>> blocks;
+        forRange(0, nvertices, [&](long long lo, long long hi){
+            vector<int> ids;
+            for(long long id=lo; id < hi; id++) if(bitmap[id]) ids.push_back((int)id);
+            std::lock_guard<std::mutex> guard(order);
+            blocks.push_back(make_pair(lo, std::move(ids)));
+        });
+        std::sort(blocks.begin(), blocks.end(),
+                  [](const pair<long long, vector<int>>& lhs, const pair<long long, vector<int>>& rhs){
+                      return lhs.first < rhs.first;
+                  });
+        int size = 0;
+        for(auto& block: blocks){
+            std::copy(block.second.begin(), block.second.end(), list + size);
+            size += (int)block.second.size();
+        }
+        return size;
+    }
+};
+
+#endif /* PARALLELBFS_H */
@@ -0,0 +1,376 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines SCCFinder: strongly connected components, condensation and cycle detection
+*/
+
+#ifndef SCCFINDER_H
+#define SCCFINDER_H
+#include <vector>
+#include <algorithm>
+#include "graph/DGraphModel.h"
+#include "graph/CSRGraph.h"
+#include "list/DLinkedList.h"
+#include "util/DynamicBitset.h"
+using namespace std;
+
+/*
+! SCCFinder<T>
+? Functionality:
+    * Strongly connected components of a directed graph: the largest sets of vertices
+      in which every vertex reaches every other one.
+        - TARJAN (default): one depth-first search, lowlink values and a stack of
+          the vertices of the open components,
+        - KOSARAJU: a depth-first search for the finish order, then one on the
+          transposed graph in decreasing finish order (needs transpose()).
+    * condense(): the condensation, one vertex per component and an edge c1 -> c2 when
+      some edge goes from c1 to c2 (lightest weight kept); it is always a DAG.
+    * findCycle(): one directed cycle, or an empty list if the graph is acyclic
+      (what TopoSorter needs to report why it could not order every vertex).
+? Notes:
+    * Components are numbered in a topological order of the condensation: every edge
+      between two components goes from a lower number to a higher one. Both modes
+      give the same partition, but may number the components differently.
+    * Every search keeps its own stack of (vertex, next edge) on the heap: no recursion,
+      so paths of millions of vertices do not overflow the call stack.
+    * The calls on a DGraphModel take a CSRGraph snapshot (freeze(), O(V+E)) each;
+      freeze once and use the CSRGraph constructor or the static engines to ask
+      several questions about a graph that does not change.
+? Complexity:
+    * O(V+E) for every operation.
+? Usage:
+    * SCCFinder<int> finder(&graph);
+    * DLinkedList<DLinkedList<int>*> groups = finder.components();   //caller deletes the lists
+    * CSRGraph<int>* dag = finder.condense();                        //caller deletes it
+    * DLinkedList<int> cycle = finder.findCycle();                   //e.g. 1, 2, 3, 1
+*/
+template<class T>
+class SCCFinder{
+public:
+    static int TARJAN;
+    static int KOSARAJU;
+
+protected:
+    DGraphModel<T>* graph;
+    CSRGraph<T>* csr;   //set instead of graph to work on a frozen snapshot
+
+public:
+    SCCFinder(DGraphModel<T>* graph): graph(graph), csr(0){
+    }
+    SCCFinder(CSRGraph<T>* csr): graph(0), csr(csr){
+    }
+
+    /*
+    ! components(int mode=TARJAN)
+    ? Return:
+        * The components in topological order of the condensation, the vertices of each
+          in vertex order. The inner lists are owned by the caller (delete them).
+    */
+    DLinkedList<DLinkedList<T>*> components(int mode=0){
+        CSRGraph<T>* snapshot = csr != 0 ? csr : graph->freeze();
+        int nvertices = snapshot->size();
+        vector<int> component(nvertices);
+        int ncomponents = run(snapshot, component.data(), mode);
+        vector<DLinkedList<T>*> groups(ncomponents);
+        for(int idx=0; idx < ncomponents; idx++) groups[idx] = new DLinkedList<T>();
+        for(int id=0; id < nvertices; id++) groups[component[id]]->add(snapshot->vertex(id));
+        DLinkedList<DLinkedList<T>*> list;
+        for(DLinkedList<T>* group: groups) list.add(group);
+        if(snapshot != csr) delete snapshot;
+        return list;
+    }
+
+    //number of strongly connected components
+    int count(int mode=0){
+        CSRGraph<T>* snapshot = csr != 0 ? csr : graph->freeze();
+        vector<int> component(snapshot->size());
+        int ncomponents = run(snapshot, component.data(), mode);
+        if(snapshot != csr) delete snapshot;
+        return ncomponents;
+    }
+
+    /*
+    ! condense()
+    ? Return:
+        * CSRGraph<int>*: vertex c is component c of components(), owned by the caller.
+    */
+    CSRGraph<int>* condense(){
+        CSRGraph<T>* snapshot = csr != 0 ? csr : graph->freeze();
+        vector<int> component(snapshot->size());
+        int ncomponents = tarjan(snapshot, component.data());
+        CSRGraph<int>* dag = condense(snapshot, component.data(), ncomponents);
+        if(snapshot != csr) delete snapshot;
+        return dag;
+    }
+
+    bool hasCycle(){
+        return !findCycle().empty();
+    }
+
+    /*
+    ! findCycle()
+    ? Return:
+        * The vertices of one cycle in edge order, the first one repeated at the end
+          (a self-loop on A gives A, A); empty if the graph is acyclic.
+    */
+    DLinkedList<T> findCycle(){
+        CSRGraph<T>* snapshot = csr != 0 ? csr : graph->freeze();
+        DLinkedList<int> ids;
+        DLinkedList<T> cycle;
+        if(findCycle(snapshot, &ids))
+            for(int id: ids) cycle.add(snapshot->vertex(id));
+        if(snapshot != csr) delete snapshot;
+        return cycle;
+    }
+
+    /*
+    ! tarjan(csr, component)
+    ? Functionality:
+        * component[id] (size() items): number of the component of id, in topological
+          order of the condensation.
+    ? Return:
+        * int: number of components
+    */
+    static int tarjan(CSRGraph<T>* csr, int* component){
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        vector<int> index(nvertices, -1);       //discovery time
+        vector<int> low(nvertices);             //lowest discovery time reachable through the open components
+        DynamicBitset onStack(nvertices);
+        vector<int> stack(nvertices);           //depth-first path
+        vector<int> nextEdge(nvertices);
+        vector<int> open(nvertices);            //vertices of the components not yet closed
+        int counter = 0, ncomponents = 0, openTop = 0;
+
+        for(int root=0; root < nvertices; root++){
+            if(index[root] != -1) continue;
+            int top = 0;
+            stack[0] = root;
+            nextEdge[0] = offsets[root];
+            index[root] = low[root] = counter++;
+            open[openTop++] = root;
+            onStack.set(root);
+            while(top >= 0){
+                int id = stack[top];
+                if(nextEdge[top] < offsets[id + 1]){
+                    int to = targets[nextEdge[top]++];
+                    if(index[to] == -1){
+                        index[to] = low[to] = counter++;
+                        open[openTop++] = to;
+                        onStack.set(to);
+                        top++;
+                        stack[top] = to;
+                        nextEdge[top] = offsets[to];
+                    }
+                    else if(onStack.test(to) && index[to] < low[id]) low[id] = index[to];
+                    continue;
+                }
+                //id is finished: it closes a component if nothing below reaches higher up
+                if(low[id] == index[id]){
+                    int member;
+                    do{
+                        member = open[--openTop];
+                        onStack.reset(member);
+                        component[member] = ncomponents;
+                    }while(member != id);
+                    ncomponents++;
+                }
+                top--;
+                if(top >= 0 && low[id] < low[stack[top]]) low[stack[top]] = low[id];
+            }
+        }
+        //components close in reverse topological order: number them the other way round
+        for(int id=0; id < nvertices; id++) component[id] = ncomponents - 1 - component[id];
+        return ncomponents;
+    }
+
+    /*
+    ! kosaraju(csr, reverse, component)
+    ? Functionality:
+        * As tarjan(); reverse is csr->transpose().
+    ? Return:
+        * int: number of components
+    */
+    static int kosaraju(CSRGraph<T>* csr, CSRGraph<T>* reverse, int* component){
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        DynamicBitset visited(nvertices);
+        vector<int> stack(nvertices);
+        vector<int> nextEdge(nvertices);
+        vector<int> finished;
+        finished.reserve(nvertices);
+
+        //pass 1: finish order on csr
+        for(int root=visited.findNextClear(0); root != -1; root=visited.findNextClear(root + 1)){
+            int top = 0;
+            stack[0] = root;
+            nextEdge[0] = offsets[root];
+            visited.set(root);
+            while(top >= 0){
+                int id = stack[top];
+                if(nextEdge[top] < offsets[id + 1]){
+                    int to = targets[nextEdge[top]++];
+                    if(!visited.testAndSet(to)){
+                        top++;
+                        stack[top] = to;
+                        nextEdge[top] = offsets[to];
+                    }
+                }
+                else{
+                    finished.push_back(id);
+                    top--;
+                }
+            }
+        }
+
+        //pass 2: on the transpose, each search from the latest finished vertex left
+        //collects exactly one component (a source component of the condensation)
+        const int* revOffsets = reverse->getOffsets();
+        const int* revTargets = reverse->getTargets();
+        for(int id=0; id < nvertices; id++) component[id] = -1;
+        int ncomponents = 0;
+        for(int idx=nvertices - 1; idx >= 0; idx--){
+            int root = finished[idx];
+            if(component[root] != -1) continue;
+            int top = 0;
+            stack[0] = root;
+            component[root] = ncomponents;
+            while(top >= 0){
+                int id = stack[top--];
+                for(int edge=revOffsets[id]; edge < revOffsets[id + 1]; edge++){
+                    int to = revTargets[edge];
+                    if(component[to] != -1) continue;
+                    component[to] = ncomponents;
+                    stack[++top] = to;
+                }
+            }
+            ncomponents++;
+        }
+        return ncomponents;
+    }
+
+    /*
+    ! condense(csr, component, ncomponents)
+    ? Functionality:
+        * The condensation for a numbering given by tarjan() or kosaraju(): vertex c is
+          the int c, edges c1 -> c2 in order of c2 first reached from c1's vertices,
+          without duplicates (the lightest weight is kept) and without self-loops.
+    ? Return:
+        * CSRGraph<int>*: owned by the caller
+    */
+    static CSRGraph<int>* condense(CSRGraph<T>* csr, int* component, int ncomponents){
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        const float* weights = csr->getWeights();
+
+        //the vertices of each component, contiguous (counting sort by component)
+        vector<int> memberStart(ncomponents + 1, 0);
+        for(int id=0; id < nvertices; id++) memberStart[component[id] + 1]++;
+        for(int idx=0; idx < ncomponents; idx++) memberStart[idx + 1] += memberStart[idx];
+        vector<int> members(nvertices);
+        vector<int> fill(memberStart.begin(), memberStart.end() - 1);
+        for(int id=0; id < nvertices; id++) members[fill[component[id]]++] = id;
+
+        //slot[c2]: position of the edge c1 -> c2 already emitted for the current c1
+        vector<int> slot(ncomponents, -1);
+        vector<int> dagTargets;
+        vector<float> dagWeights;
+        int* dagOffsets = new int[ncomponents + 1];
+        dagOffsets[0] = 0;
+        for(int from=0; from < ncomponents; from++){
+            int begin = (int)dagTargets.size();
+            for(int idx=memberStart[from]; idx < memberStart[from + 1]; idx++){
+                int id = members[idx];
+                for(int edge=offsets[id]; edge < offsets[id + 1]; edge++){
+                    int to = component[targets[edge]];
+                    if(to == from) continue;
+                    if(slot[to] >= begin){
+                        if(weights[edge] < dagWeights[slot[to]]) dagWeights[slot[to]] = weights[edge];
+                        continue;
+                    }
+                    slot[to] = (int)dagTargets.size();
+                    dagTargets.push_back(to);
+                    dagWeights.push_back(weights[edge]);
+                }
+            }
+            dagOffsets[from + 1] = (int)dagTargets.size();
+        }
+
+        int nedges = (int)dagTargets.size();
+        int* data = new int[ncomponents > 0 ? ncomponents : 1];
+        int* targetArray = new int[nedges > 0 ? nedges : 1];
+        float* weightArray = new float[nedges > 0 ? nedges : 1];
+        for(int idx=0; idx < ncomponents; idx++) data[idx] = idx;
+        std::copy(dagTargets.begin(), dagTargets.end(), targetArray);
+        std::copy(dagWeights.begin(), dagWeights.end(), weightArray);
+        return new CSRGraph<int>(ncomponents, data, dagOffsets, targetArray, weightArray);
+    }
+
+    /*
+    ! findCycle(csr, cycle)
+    ? Functionality:
+        * Depth-first search that stops at the first edge back to a vertex still on the
+          search path; cycle (optional) receives that part of the path, the first id
+          repeated at the end.
+    ? Return:
+        * bool: true if a cycle was found
+    */
+    static bool findCycle(CSRGraph<T>* csr, DLinkedList<int>* cycle=0){
+        int nvertices = csr->size();
+        const int* offsets = csr->getOffsets();
+        const int* targets = csr->getTargets();
+        vector<int> depth(nvertices, -1);   //-1: unvisited, -2: finished, else position on the path
+        vector<int> stack(nvertices);
+        vector<int> nextEdge(nvertices);
+        if(cycle != 0) cycle->clear();
+
+        for(int root=0; root < nvertices; root++){
+            if(depth[root] != -1) continue;
+            int top = 0;
+            stack[0] = root;
+            nextEdge[0] = offsets[root];
+            depth[root] = 0;
+            while(top >= 0){
+                int id = stack[top];
+                if(nextEdge[top] == offsets[id + 1]){
+                    depth[id] = -2;
+                    top--;
+                    continue;
+                }
+                int to = targets[nextEdge[top]++];
+                if(depth[to] >= 0){
+                    if(cycle != 0){
+                        for(int idx=depth[to]; idx <= top; idx++) cycle->add(stack[idx]);
+                        cycle->add(to);
+                    }
+                    return true;
+                }
+                if(depth[to] == -1){
+                    top++;
+                    stack[top] = to;
+                    nextEdge[top] = offsets[to];
+                    depth[to] = top;
+                }
+            }
+        }
+        return false;
+    }
+
+protected:
+    static int run(CSRGraph<T>* snapshot, int* component, int mode){
+        if(mode != KOSARAJU) return tarjan(snapshot, component);
+        CSRGraph<T>* reverse = snapshot->transpose();
+        int ncomponents = kosaraju(snapshot, reverse, component);
+        delete reverse;
+        return ncomponents;
+    }
+};
+template<class T>
+int SCCFinder<T>::TARJAN = 0;
+template<class T>
+int SCCFinder<T>::KOSARAJU = 1;
+
+#endif /* SCCFINDER_H */
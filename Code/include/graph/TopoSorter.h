@@ -1,10 +1,17 @@
 #ifndef TOPOSORTER_H
 #define TOPOSORTER_H
 #include "graph/DGraphModel.h"
+#include "graph/SCCFinder.h"
 #include "list/DLinkedList.h"
 #include "sorting/DLinkedListSE.h"
 #include "stacknqueue/Queue.h"
+#include "stacknqueue/ArrayQueue.h"
 #include "stacknqueue/Stack.h"
+#include "util/ThreadPool.h"
+#include "util/DynamicBitset.h"
+#include <atomic>
+#include <vector>
+#include <algorithm>
 
 /*
 ! TopoSorter
@@ -14,10 +21,27 @@
     * DFS: Depth-first search - 0
     * BFS: Breadth-first search - 1
     * Default: DFS
+? Complexity:
+    * Both modes run on a CSRGraph<T>: the one given to the constructor, or a
+      snapshot taken by DGraphModel::freeze() for the call. They work on dense ids
+      and flat arrays (in-degrees in an int array, visited flags in a DynamicBitset),
+      without hashing or per-vertex lookups: O(V+E).
+    * The order is the one of the DGraphModel: roots and zero in-degree vertices in
+      vertex order, neighbours in adjacency order.
+    * DFS keeps its own stack of (vertex, next edge): no recursion, so chains of
+      millions of vertices do not overflow the call stack.
+    * On a graph with a cycle, sort() returns a partial order (BFS) or an order that
+      breaks some edges (DFS); strictSort() throws a CycleException naming a cycle.
+? Parallel:
+    * parallelBfsSort(pool): Kahn's algorithm one level (frontier) at a time; the
+      vertices of a level are split among the pool's workers, which decrement atomic
+      in-degree counters. Each level is emitted in vertex order, so the result is the
+      same for any number of threads (but not the FIFO order of bfsSort).
 ? Usage:
     * TopoSorter<int> sorter(graph);
     * DLinkedList<int> sortedList = sorter.sort(TopoSorter<int>::DFS);
     * DLinkedList<int> sortedList = sorter.sort(TopoSorter<int>::BFS);
+    * TopoSorter<int> csrSorter(csr);
 */
 template<class T>
 class TopoSorter{
@@ -27,11 +51,15 @@ public:
     
 protected:
     DGraphModel<T>* graph;
+    CSRGraph<T>* csr;   //set instead of graph when sorting a frozen snapshot
     int (*hash_code)(T&, int);
     
 public:
     TopoSorter(DGraphModel<T>* graph, int (*hash_code)(T&, int)=0)
-    :graph(graph), hash_code(hash_code){
+    :graph(graph), csr(0), hash_code(hash_code){
+    }  
+    TopoSorter(CSRGraph<T>* csr, int (*hash_code)(T&, int)=0)
+    :graph(0), csr(csr), hash_code(hash_code){
     }  
 
     /*
@@ -40,17 +68,43 @@ public:
         * Sorts the vertices of the graph in topological order.
     ? Parameters:
         * mode: DFS or BFS
-        * sorted: true if the input graph is already sorted
+        * sorted: ignored, kept for API compatibility (the order no longer depends
+          on a pre-sorted vertex list; see bfsSort / dfsSort)
         * Default: DFS
     ? Return:
         * A list of vertices in topological order.
     */
-    DLinkedList<T> sort(int mode=0, bool sorted=true){
+    DLinkedList<T> sort(int mode=0, bool /*sorted*/=true){
         if (mode == BFS) {
-            return bfsSort(sorted);
+            return bfsSort();
         } else {
-            return dfsSort(sorted);
+            return dfsSort();
+        }
+    }
+
+    /*
+    ! strictSort(int mode=0)
+    ? Functionality:
+        * As sort(), for a graph that must be acyclic.
+    ? Exceptions:
+        * CycleException: the graph has a cycle (found by SCCFinder::findCycle)
+    */
+    DLinkedList<T> strictSort(int mode=0){
+        CSRGraph<T>* snapshot = csr != 0 ? csr : graph->freeze();
+        DLinkedList<int> cycle;
+        if (SCCFinder<T>::findCycle(snapshot, &cycle)) {
+            stringstream os;
+            bool first = true;
+            for (int id : cycle) {
+                os << (first ? "" : " -> ") << snapshot->vertexStr(snapshot->vertex(id));
+                first = false;
+            }
+            if (snapshot != csr) delete snapshot;
+            throw CycleException(os.str());
         }
+        DLinkedList<T> result = mode == BFS ? csrBfsSort(snapshot) : csrDfsSort(snapshot);
+        if (snapshot != csr) delete snapshot;
+        return result;
     }
 
     /*
@@ -58,42 +112,18 @@ public:
     ? Functionality: 
         * Sorts the vertices of the graph in topological order using BFS.
     ? Parameters:
-        * sorted: true if the input graph is already sorted
-        * Default: true
+        * sorted: ignored, kept for API compatibility: zero in-degree vertices are
+          taken in the order the graph stores them
     ? Return:
         * A list of vertices in topological order.
     */
-    DLinkedList<T> bfsSort(bool sorted=true){ 
-        DLinkedList<T> result;
-        Queue<T> zeroInDegreeQueue;
-        xMap<T, int> inDegreeMap(*hash_code);
-
-        DLinkedList<T> vertices = graph->vertices();
-
-        // Initialize in-degree map
-        for (auto vertex : vertices) {
-            inDegreeMap.put(vertex, graph->inDegree(vertex));
-            if (graph->inDegree(vertex) == 0) {
-                zeroInDegreeQueue.push(vertex);
-            }
-        }
-
-        // Process vertices with zero in-degree
-        while (!zeroInDegreeQueue.empty()) {
-            T vertex = zeroInDegreeQueue.pop();
-            result.add(vertex);
-
-            DLinkedList<T> neighbors = graph->getOutwardEdges(vertex);
-
-            for (auto neighbor : neighbors) {
-                int inDegree = inDegreeMap.get(neighbor) - 1;
-                inDegreeMap.put(neighbor, inDegree);
-                if (inDegree == 0) {
-                    zeroInDegreeQueue.push(neighbor);
-                }
-            }
-        }
-
+    DLinkedList<T> bfsSort(bool /*sorted*/=true){
+        if (csr != 0) return csrBfsSort(csr);
+        // O(V+E): one pass over the adjacency lists builds the snapshot,
+        // then no per-vertex lookups (no hashing, no inDegree calls)
+        CSRGraph<T>* snapshot = graph->freeze();
+        DLinkedList<T> result = csrBfsSort(snapshot);
+        delete snapshot;
         return result;
     }
 
@@ -102,76 +132,158 @@ public:
     ? Functionality: 
         * Sorts the vertices of the graph in topological order using DFS.
     ? Parameters:
-        * sorted: true -> need to sort vertices before Topo sort
-        * Default: true
+        * sorted: ignored, kept for API compatibility: the search starts from the
+          vertices in the order the graph stores them
     ? Return:
         * A list of vertices in topological order.
     */
-    DLinkedList<T> dfsSort(bool sorted=true){
-        DLinkedList<T> result;
-        xMap<T, bool> visited(*hash_code);
+    DLinkedList<T> dfsSort(bool /*sorted*/=true){
+        if (csr != 0) return csrDfsSort(csr);
+        CSRGraph<T>* snapshot = graph->freeze();
+        DLinkedList<T> result = csrDfsSort(snapshot);
+        delete snapshot;
+        return result;
+    }
 
-        // Get vertices and sort them if needed
-        DLinkedList<T> vertices = graph->vertices();
+    /*
+    ! parallelBfsSort(pool)
+    ? Functionality:
+        * Topological order by levels: level 0 = zero in-degree vertices, level k+1 =
+          vertices whose last predecessor is in level k; vertex order inside a level.
+        * pool == 0: runs on the calling thread.
+    ? Return:
+        * A list of vertices in topological order (partial if the graph has a cycle).
+    */
+    DLinkedList<T> parallelBfsSort(ThreadPool* pool){
+        CSRGraph<T>* snapshot = csr != 0 ? csr : graph->freeze();
+        int nvertices = snapshot->size();
+        int* order = new int[nvertices > 0 ? nvertices : 1];
+        int count = parallelKahn(snapshot, pool, order);
+        DLinkedList<T> result;
+        for (int idx = 0; idx < count; idx++) result.add(snapshot->vertex(order[idx]));
+        delete []order;
+        if (snapshot != csr) delete snapshot;
+        return result;
+    }
 
-        // Initialize visited map
-        for (auto vertex : vertices) {
-            visited.put(vertex, false);
-        }
+    /*
+    ! parallelKahn(snapshot, pool, order, levelStart, nlevels, grain)
+    ? Functionality:
+        * Writes the ids of snapshot in topological order into order[0..size()).
+        * levelStart (optional, size()+1 items) and nlevels (optional): level k is
+          order[levelStart[k] .. levelStart[k+1]), for k < *nlevels.
+        * Levels with fewer than 2*grain vertices are processed on the calling thread.
+    ? Return:
+        * int: number of ids written; less than size() if the graph has a cycle
+    */
+    static int parallelKahn(CSRGraph<T>* snapshot, ThreadPool* pool, int* order,
+                            int* levelStart=0, int* nlevels=0, int grain=1024){
+        int nvertices = snapshot->size();
+        const int* offsets = snapshot->getOffsets();
+        const int* targets = snapshot->getTargets();
+        const int* inDegrees = snapshot->getInDegrees();
+        std::atomic<int>* remaining = new std::atomic<int>[nvertices > 0 ? nvertices : 1];
+        std::atomic<int> tail(0);
+        forRange(pool, 0, nvertices, [&](long long lo, long long hi){
+            for (long long id = lo; id < hi; id++) remaining[id].store(inDegrees[id], std::memory_order_relaxed);
+        }, grain);
+        for (int id = 0; id < nvertices; id++)
+            if (inDegrees[id] == 0) order[tail.fetch_add(1, std::memory_order_relaxed)] = id;
 
-        // Visit each vertex in order
-        for (auto vertex : vertices) {
-            if (!visited.get(vertex)) {
-                dfsVisit(vertex, visited, result, sorted);
-            }
+        int levelBegin = 0, level = 0;
+        while (levelBegin < tail.load()) {
+            int levelEnd = tail.load();
+            if (levelStart != 0) levelStart[level] = levelBegin;
+            level++;
+            forRange(pool, levelBegin, levelEnd, [&](long long lo, long long hi){
+                vector<int> ready;
+                for (long long idx = lo; idx < hi; idx++) {
+                    int id = order[idx];
+                    for (int edge = offsets[id]; edge < offsets[id + 1]; edge++) {
+                        if (remaining[targets[edge]].fetch_sub(1, std::memory_order_relaxed) == 1)
+                            ready.push_back(targets[edge]);
+                    }
+                }
+                int at = tail.fetch_add((int)ready.size(), std::memory_order_relaxed);
+                std::copy(ready.begin(), ready.end(), order + at);
+            }, grain);
+            //the workers append in any order: sort the new level to make the result deterministic
+            std::sort(order + levelEnd, order + tail.load());
+            levelBegin = levelEnd;
         }
-
-        return result;
+        if (levelStart != 0) levelStart[level] = tail.load();
+        if (nlevels != 0) *nlevels = level;
+        delete []remaining;
+        return tail.load();
     }
 
 protected:
-    void dfsVisit(T vertex, xMap<T, bool>& visited, DLinkedList<T>& result, bool sorted) {
-        visited.put(vertex, true);
-        
-        // Get and sort outward edges
-        DLinkedList<T> neighbors = graph->getOutwardEdges(vertex);
-        
-        // Visit unvisited neighbors in sorted order
-        for (auto neighbor : neighbors) {
-            if (!visited.get(neighbor)) {
-                dfsVisit(neighbor, visited, result, sorted);
-            }
-        }
-        
-        // Add current vertex to beginning of result
-        // This ensures topological order
-        result.add(0, vertex);
+    //pool->parallelFor, or the whole range on the calling thread without a pool
+    template<class F>
+    static void forRange(ThreadPool* pool, long long begin, long long end, F fn, long long grain){
+        if (pool != 0) pool->parallelFor(begin, end, fn, grain);
+        else if (begin < end) fn(begin, end);
     }
 
-    xMap<T, int> vertex2inDegree(int (*hash)(T&, int)){
-        xMap<T, int> inDegrees(*hash);
-        DLinkedList<T> vertices = graph->vertices();
-        for (auto vertex : vertices) {
-            inDegrees.put(vertex, graph->inDegree(vertex));
-        }
-        return inDegrees;
-    }
-    xMap<T, int> vertex2outDegree(int (*hash)(T&, int)){
-        xMap<T, int> outDegrees(*hash);
-        DLinkedList<T> vertices = graph->vertices();
-        for (auto vertex : vertices) {
-            outDegrees.put(vertex, graph->outDegree(vertex));
+    //Kahn's algorithm on a snapshot: in-degrees copied once, ids in a flat queue
+    DLinkedList<T> csrBfsSort(CSRGraph<T>* snapshot){
+        DLinkedList<T> result;
+        int nvertices = snapshot->size();
+        const int* offsets = snapshot->getOffsets();
+        const int* targets = snapshot->getTargets();
+        int* inDegree = new int[nvertices > 0 ? nvertices : 1];
+        int* queue = new int[nvertices > 0 ? nvertices : 1];
+        int head = 0, tail = 0;
+        std::copy(snapshot->getInDegrees(), snapshot->getInDegrees() + nvertices, inDegree);
+        for (int id = 0; id < nvertices; id++)
+            if (inDegree[id] == 0) queue[tail++] = id;
+        while (head < tail) {
+            int id = queue[head++];
+            result.add(snapshot->vertex(id));
+            for (int edge = offsets[id]; edge < offsets[id + 1]; edge++) {
+                if (--inDegree[targets[edge]] == 0) queue[tail++] = targets[edge];
+            }
         }
-        return outDegrees;
+        delete []inDegree;
+        delete []queue;
+        return result;
     }
-    DLinkedList<T> listOfZeroInDegrees() {
+
+    //recursive DFS order (roots in vertex order, neighbours in adjacency order,
+    //each vertex prepended when finished), with an explicit stack of (id, next edge);
+    //visited ids in a bitset, the next root found 64 ids at a time
+    DLinkedList<T> csrDfsSort(CSRGraph<T>* snapshot){
         DLinkedList<T> result;
-        xMap<T, int> inDegrees = vertex2inDegree(hash_code);
-        for (auto vertex : inDegrees.keys()) {
-            if (inDegrees.get(vertex) == 0) {
-                result.add(0, vertex);
+        int nvertices = snapshot->size();
+        const int* offsets = snapshot->getOffsets();
+        const int* targets = snapshot->getTargets();
+        DynamicBitset visited(nvertices);
+        int* stack = new int[nvertices > 0 ? nvertices : 1];
+        int* nextEdge = new int[nvertices > 0 ? nvertices : 1];
+        for (int root = visited.findNextClear(0); root != -1; root = visited.findNextClear(root + 1)) {
+            int top = 0;
+            stack[0] = root;
+            nextEdge[0] = offsets[root];
+            visited.set(root);
+            while (top >= 0) {
+                int id = stack[top];
+                if (nextEdge[top] < offsets[id + 1]) {
+                    int next = targets[nextEdge[top]++];
+                    if (!visited.testAndSet(next)) {
+                        top++;
+                        stack[top] = next;
+                        nextEdge[top] = offsets[next];
+                    }
+                }
+                else {
+                    // finished: add to beginning of result
+                    result.add(0, snapshot->vertex(id));
+                    top--;
+                }
             }
         }
+        delete []stack;
+        delete []nextEdge;
         return result;
     }
 
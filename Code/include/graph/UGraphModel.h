@@ -15,6 +15,13 @@
 #define UGRAPHMODEL_H
 
 #include "graph/AbstractGraph.h"
+#include "graph/UnionFind.h"
+#include "heap/IndexedHeap.h"
+#include "util/DynamicBitset.h"
+#include "util/ThreadPool.h"
+#include <atomic>
+#include <vector>
+#include <algorithm>
 
 //////////////////////////////////////////////////////////////////////
 ///////////// UGraphModel: Undirected Graph Model ////////////////////
@@ -34,10 +41,17 @@ public:
 
     UGraphModel(
         bool (*vertexEQ)(T &, T &),
-        string (*vertex2str)(T &)) : AbstractGraph<T>(vertexEQ, vertex2str)
+        string (*vertex2str)(T &),
+        int (*vertexHash)(T &, int) = 0) : AbstractGraph<T>(vertexEQ, vertex2str, vertexHash)
     {
     }
 
+    //each undirected edge is stored as two directed ones (one for a self-loop)
+    bool isDirected()
+    {
+        return false;
+    }
+
     /*
     ! void connect(T from, T to, float weight = 0)
     ? Functionality: 
@@ -144,24 +158,8 @@ public:
             throw VertexNotFoundException(this->vertex2str(vertex));
         }
 
-        // Iterate through the graph’s vertices, removing all edges connected to or from the vertex to be removed.
-        typename DLinkedList<VertexNode *>::Iterator it = this->nodeList.begin();
-        while (it != this->nodeList.end())
-        {
-            VertexNode *vertexNode = *it;
-            if (this->connected(vertexNode->getVertex(), vertex))
-            {
-                vertexNode->removeTo(node);
-            }
-            if (this->connected(vertex, vertexNode->getVertex()))
-            {
-                node->removeTo(vertexNode);
-            }
-            it++;
-        }
-
-        // Remove the vertex from the graph’s vertex list.
-        this->nodeList.removeItem(node, &VertexNode::free);       
+        // Remove the edges into and out of the vertex (reverse and forward adjacency), then the vertex.
+        this->removeVertexNode(node);       
     }
 
     /*
@@ -174,10 +172,11 @@ public:
     static UGraphModel<T> *create(
         T *vertices, int nvertices, Edge<T> *edges, int nedges,
         bool (*vertexEQ)(T &, T &),
-        string (*vertex2str)(T &))
+        string (*vertex2str)(T &),
+        int (*vertexHash)(T &, int) = 0)
     {
         // Create a new UGraphModel object
-        UGraphModel<T> *graph = new UGraphModel<T>(vertexEQ, vertex2str);
+        UGraphModel<T> *graph = new UGraphModel<T>(vertexEQ, vertex2str, vertexHash);
 
         // Add all vertices in vertices to the graph
         for (int i = 0; i < nvertices; i++)
@@ -196,14 +195,275 @@ public:
     }
 };
 
+/*
+! UGraphAlgorithm<T>
+? Functionality:
+    * Spanning trees and connectivity of a UGraphModel<T>. Every call takes a CSRGraph
+      snapshot (freeze(), O(V+E)) of the hash-indexed model and runs an id-based engine
+      on it; the static engines can be called on a snapshot directly.
+        - minSpanningTree / kruskal: edges by increasing weight, kept when they join
+          two trees of a UnionFind,
+        - prim: grows one tree per component from its first vertex, IndexedHeap keyed
+          by the lightest edge into the tree,
+        - connectedComponents: UnionFind over the edges, or parallel label
+          propagation (every vertex takes the smallest label around it, with pointer
+          jumping) on a ThreadPool.
+    * On a disconnected graph the spanning tree is a spanning forest.
+    * The trees are new graphs owned by the caller (delete them).
+? Notes:
+    * Equal weights are taken in (weight, smaller id, larger id) order by Kruskal;
+      Kruskal and Prim always give the same total weight, but may pick different
+      edges among equal weights.
+    * Component labels are the smallest id of each component for both engines, so the
+      components come out in vertex order, each in vertex order.
+? Complexity:
+    * kruskal: O(E log E); prim: O(E log V); components: O(E alpha(V)) or
+      O(E) per propagation round (a few rounds thanks to pointer jumping).
+*/
 template <class T>
-class UGraphAlgorithm {
-    private:
-    protected:
-    public:
-    UGraphModel<T> minSpanningTree(UGraphModel<T>* graph){
-        UGraphModel<T> mst(0, 0);
-        return mst;
+class UGraphAlgorithm
+{
+public:
+    UGraphModel<T> *minSpanningTree(UGraphModel<T> *graph)
+    {
+        return kruskal(graph);
+    }
+
+    UGraphModel<T> *kruskal(UGraphModel<T> *graph)
+    {
+        CSRGraph<T> *csr = graph->freeze();
+        int capacity = csr->size() > 0 ? csr->size() : 1;
+        int *from = new int[capacity], *to = new int[capacity];
+        float *weight = new float[capacity];
+        int nedges = kruskal(csr, from, to, weight);
+        UGraphModel<T> *tree = new UGraphModel<T>(graph->getVertexEQ(), graph->getVertex2Str(), graph->getVertexHash());
+        buildTree(*tree, csr, from, to, weight, nedges);
+        delete[] from;
+        delete[] to;
+        delete[] weight;
+        delete csr;
+        return tree;
+    }
+
+    UGraphModel<T> *prim(UGraphModel<T> *graph)
+    {
+        CSRGraph<T> *csr = graph->freeze();
+        int capacity = csr->size() > 0 ? csr->size() : 1;
+        int *from = new int[capacity], *to = new int[capacity];
+        float *weight = new float[capacity];
+        int nedges = prim(csr, from, to, weight);
+        UGraphModel<T> *tree = new UGraphModel<T>(graph->getVertexEQ(), graph->getVertex2Str(), graph->getVertexHash());
+        buildTree(*tree, csr, from, to, weight, nedges);
+        delete[] from;
+        delete[] to;
+        delete[] weight;
+        delete csr;
+        return tree;
+    }
+
+    /*
+    ! connectedComponents(graph, pool)
+    ? Functionality:
+        * The vertices of each component, components in the order of their first vertex.
+        * pool == 0: UnionFind; otherwise parallel label propagation on the pool.
+        * The lists are owned by the caller (delete them).
+    */
+    DLinkedList<DLinkedList<T> *> connectedComponents(UGraphModel<T> *graph, ThreadPool *pool = 0)
+    {
+        CSRGraph<T> *csr = graph->freeze();
+        int nvertices = csr->size();
+        int *label = new int[nvertices > 0 ? nvertices : 1];
+        int ncomponents = pool == 0 ? components(csr, label) : parallelComponents(csr, label, pool);
+        //labels are the smallest ids: number the components in that order
+        int *index = new int[nvertices > 0 ? nvertices : 1];
+        DLinkedList<DLinkedList<T> *> result;
+        DLinkedList<T> **groups = new DLinkedList<T> *[ncomponents > 0 ? ncomponents : 1];
+        int next = 0;
+        for (int id = 0; id < nvertices; id++)
+        {
+            if (label[id] == id)
+            {
+                index[id] = next;
+                groups[next] = new DLinkedList<T>();
+                result.add(groups[next++]);
+            }
+            groups[index[label[id]]]->add(csr->vertex(id));
+        }
+        delete[] groups;
+        delete[] index;
+        delete[] label;
+        delete csr;
+        return result;
+    }
+
+    //Engines on a snapshot (undirected: every edge stored both ways).
+    //from/to/weight receive the tree edges (at most size()-1); the count is returned.
+
+    static int kruskal(CSRGraph<T> *csr, int *from, int *to, float *weight)
+    {
+        int nvertices = csr->size();
+        const int *offsets = csr->getOffsets();
+        const int *targets = csr->getTargets();
+        const float *weights = csr->getWeights();
+        //each edge once (u < v), then sorted by (weight, u, v)
+        vector<TreeEdge> edges;
+        edges.reserve(csr->edgeCount() / 2);
+        for (int u = 0; u < nvertices; u++)
+            for (int edge = offsets[u]; edge < offsets[u + 1]; edge++)
+                if (u < targets[edge]) edges.push_back(TreeEdge{weights[edge], u, targets[edge]});
+        std::sort(edges.begin(), edges.end());
+
+        UnionFind sets(nvertices);
+        int count = 0;
+        for (TreeEdge &edge : edges)
+        {
+            if (!sets.unite(edge.from, edge.to)) continue;
+            from[count] = edge.from;
+            to[count] = edge.to;
+            weight[count] = edge.weight;
+            if (++count == nvertices - 1) break;
+        }
+        return count;
+    }
+
+    static int prim(CSRGraph<T> *csr, int *from, int *to, float *weight)
+    {
+        int nvertices = csr->size();
+        const int *offsets = csr->getOffsets();
+        const int *targets = csr->getTargets();
+        const float *weights = csr->getWeights();
+        int *link = new int[nvertices > 0 ? nvertices : 1];     //tree vertex of the lightest edge
+        float *best = new float[nvertices > 0 ? nvertices : 1];
+        DynamicBitset inTree(nvertices);
+        for (int id = 0; id < nvertices; id++) link[id] = -1;
+        IndexedHeap<float> heap(nvertices);
+        int count = 0;
+        for (int root = inTree.findNextClear(0); root != -1; root = inTree.findNextClear(root + 1))
+        {
+            heap.push(root, 0);
+            while (!heap.empty())
+            {
+                int u = heap.pop();
+                inTree.set(u);
+                if (link[u] != -1)
+                {
+                    from[count] = link[u] < u ? link[u] : u;
+                    to[count] = link[u] < u ? u : link[u];
+                    weight[count] = best[u];
+                    count++;
+                }
+                for (int edge = offsets[u]; edge < offsets[u + 1]; edge++)
+                {
+                    int v = targets[edge];
+                    if (inTree.test(v)) continue;
+                    if (heap.pushOrDecrease(v, weights[edge]))
+                    {
+                        link[v] = u;
+                        best[v] = weights[edge];
+                    }
+                }
+            }
+        }
+        delete[] link;
+        delete[] best;
+        return count;
+    }
+
+    /*
+    ! components(csr, label): label[id] = smallest id of its component (UnionFind)
+    ? Return:
+        * int: number of components
+    */
+    static int components(CSRGraph<T> *csr, int *label)
+    {
+        int nvertices = csr->size();
+        UnionFind sets(nvertices);
+        for (int u = 0; u < nvertices; u++)
+            for (int v : csr->neighbors(u))
+                if (u < v) sets.unite(u, v);
+        //the root of a set is any id: map each root to the first id that reaches it
+        int *smallest = new int[nvertices > 0 ? nvertices : 1];
+        for (int id = 0; id < nvertices; id++) smallest[id] = -1;
+        for (int id = 0; id < nvertices; id++)
+        {
+            int root = sets.find(id);
+            if (smallest[root] == -1) smallest[root] = id;
+            label[id] = smallest[root];
+        }
+        delete[] smallest;
+        return sets.count();
+    }
+
+    /*
+    ! parallelComponents(csr, label, pool, grain): same labels as components(), by
+    * rounds of min-label propagation split over the pool, until no label changes
+    */
+    static int parallelComponents(CSRGraph<T> *csr, int *label, ThreadPool *pool, int grain = 4096)
+    {
+        int nvertices = csr->size();
+        std::atomic<int> *labels = new std::atomic<int>[nvertices > 0 ? nvertices : 1];
+        pool->parallelFor(0, nvertices, [&](long long lo, long long hi) {
+            for (long long id = lo; id < hi; id++) labels[id].store((int)id, std::memory_order_relaxed);
+        }, grain);
+        std::atomic<bool> changed(true);
+        while (changed.load())
+        {
+            changed.store(false);
+            pool->parallelFor(0, nvertices, [&](long long lo, long long hi) {
+                bool local = false;
+                for (long long id = lo; id < hi; id++)
+                {
+                    int mine = labels[id].load(std::memory_order_relaxed);
+                    int low = mine;
+                    for (int v : csr->neighbors((int)id))
+                    {
+                        int other = labels[v].load(std::memory_order_relaxed);
+                        if (other < low) low = other;
+                    }
+                    //pointer jumping: the label of a label is in the same component
+                    int jump = labels[low].load(std::memory_order_relaxed);
+                    while (jump < low)
+                    {
+                        low = jump;
+                        jump = labels[low].load(std::memory_order_relaxed);
+                    }
+                    if (low < mine)
+                    {
+                        labels[id].store(low, std::memory_order_relaxed);
+                        local = true;
+                    }
+                }
+                if (local) changed.store(true, std::memory_order_relaxed);
+            }, grain);
+        }
+        int ncomponents = 0;
+        for (int id = 0; id < nvertices; id++)
+        {
+            label[id] = labels[id].load(std::memory_order_relaxed);
+            if (label[id] == id) ncomponents++;
+        }
+        delete[] labels;
+        return ncomponents;
+    }
+
+protected:
+    struct TreeEdge
+    {
+        float weight;
+        int from, to;
+        bool operator<(const TreeEdge &other) const
+        {
+            if (weight != other.weight) return weight < other.weight;
+            if (from != other.from) return from < other.from;
+            return to < other.to;
+        }
+    };
+
+    static void buildTree(UGraphModel<T> &tree, CSRGraph<T> *csr, int *from, int *to, float *weight, int nedges)
+    {
+        for (int id = 0; id < csr->size(); id++) tree.add(csr->vertex(id));
+        for (int idx = 0; idx < nedges; idx++)
+            tree.connect(csr->vertex(from[idx]), csr->vertex(to[idx]), weight[idx]);
     }
 };
 
@@ -0,0 +1,96 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines UnionFind: disjoint sets over 0..n-1 (union by rank, path compression)
+*/
+
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+#include <stdexcept>
+
+/*
+! UnionFind
+? Functionality:
+    * Partition of the ids 0..n-1 into disjoint sets, each named by a root id.
+    * unite(a, b) hangs the root of lower rank under the other (union by rank);
+      find(x) makes every id on the way point straight to the root (path compression).
+? Complexity:
+    * find, unite, connected: O(alpha(n)) amortized (alpha: inverse Ackermann, < 5).
+? Usage:
+    * UnionFind sets(n);
+    * if(sets.unite(u, v)) ...      //u and v were in different sets
+    * int groups = sets.count();
+*/
+class UnionFind{
+protected:
+    int n;
+    int nsets;
+    int* parent;
+    unsigned char* rank;    //upper bound of the height of the tree of a root (< 32)
+
+public:
+    UnionFind(int n){
+        if(n < 0) throw std::invalid_argument("UnionFind: negative size");
+        this->n = n;
+        this->nsets = n;
+        this->parent = new int[n > 0 ? n : 1];
+        this->rank = new unsigned char[n > 0 ? n : 1]();
+        for(int id=0; id < n; id++) parent[id] = id;
+    }
+    ~UnionFind(){
+        delete []parent;
+        delete []rank;
+    }
+    UnionFind(const UnionFind&) = delete;
+    UnionFind& operator=(const UnionFind&) = delete;
+
+    int size(){
+        return n;
+    }
+    //number of disjoint sets
+    int count(){
+        return nsets;
+    }
+
+    /*
+    ! find(x): the root of the set of x
+    ? Exceptions:
+        * std::out_of_range if x is not in 0..n-1
+    */
+    int find(int x){
+        if(x < 0 || x >= n) throw std::out_of_range("UnionFind: id is out of range");
+        int root = x;
+        while(parent[root] != root) root = parent[root];
+        while(parent[x] != root){
+            int next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    /*
+    ! unite(a, b): merges the sets of a and b
+    ? Return:
+        * bool: false if a and b were already in the same set
+    */
+    bool unite(int a, int b){
+        int rootA = find(a), rootB = find(b);
+        if(rootA == rootB) return false;
+        if(rank[rootA] < rank[rootB]){
+            int swap = rootA;
+            rootA = rootB;
+            rootB = swap;
+        }
+        parent[rootB] = rootA;
+        if(rank[rootA] == rank[rootB]) rank[rootA]++;
+        nsets--;
+        return true;
+    }
+
+    bool connected(int a, int b){
+        return find(a) == find(b);
+    }
+};
+
+#endif /* UNIONFIND_H */
@@ -0,0 +1,135 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines VertexIds: interning of vertices into dense int ids 0..size()-1
+*/
+
+#ifndef VERTEXIDS_H
+#define VERTEXIDS_H
+#include <vector>
+#include <climits>
+#include <stdexcept>
+using namespace std;
+
+/*
+! VertexIds<T>
+? Functionality:
+    * Numbers vertices in the order they are first seen: intern(vertex) returns the
+      id of vertex, giving it the next one if it is new; vertex(id) goes back. The
+      algorithms then keep their state (visited bits, in-degrees, distances) in
+      arrays indexed by id and hash a vertex only where it enters or leaves them.
+    * Open addressing instead of xMap's chains: one array of ids (-1: free) with
+      linear probing, at most half full, and the vertices themselves in a vector.
+      A lookup reads a run of adjacent ints and compares the vertices they point
+      to; nothing is allocated per vertex and a miss throws nothing.
+    * The hash has the graph's contract, hash(vertex, capacity) in [0, capacity). It is
+      called once with capacity INT_MAX and the result spread over the (power of two)
+      table by Fibonacci hashing, so "vertex % capacity" hashes of regular ids
+      (multiples of 8, ...) do not pile up in a few runs.
+? Complexity:
+    * intern, indexOf: O(1) expected; vertex(id): O(1).
+    * Memory: sizeof(T) + 8 to 16 bytes per vertex.
+? Notes:
+    * Ids are never removed: clear() forgets every vertex at once.
+? Usage:
+    * VertexIds<string> ids(&stringHash);
+    * int id = ids.intern("Paris");         //0, then 1 for the next new vertex, ...
+    * if(ids.indexOf(city) == -1) ...       //not seen
+*/
+template<class T>
+class VertexIds{
+public:
+    static const int MIN_SLOTS = 16;
+
+protected:
+    vector<T> values;       //id -> vertex
+    vector<int> slots;      //ids; -1: free
+    int mask;               //slots.size() - 1
+    int shift;              //32 - log2(slots.size())
+    int (*hash)(T&, int);
+    bool (*vertexEQ)(T&, T&);
+
+public:
+    /*
+    ! VertexIds(hash, vertexEQ, capacity)
+    ? Exceptions:
+        * std::invalid_argument if hash is null
+    */
+    VertexIds(int (*hash)(T&, int), bool (*vertexEQ)(T&, T&)=0, int capacity=0){
+        if(hash == 0) throw std::invalid_argument("VertexIds: a vertex hash is required");
+        this->hash = hash;
+        this->vertexEQ = vertexEQ;
+        this->mask = 0;
+        this->shift = 32;
+        reserve(capacity);
+    }
+
+    int size(){
+        return (int)values.size();
+    }
+    //room for capacity vertices without rehashing
+    void reserve(int capacity){
+        values.reserve(capacity > 0 ? capacity : 0);
+        int nslots = MIN_SLOTS;
+        while(nslots < 2 * capacity) nslots <<= 1;
+        if(nslots > (int)slots.size()) rehash(nslots);
+    }
+    void clear(){
+        values.clear();
+        slots.assign(slots.size(), -1);
+    }
+
+    /*
+    ! intern(T vertex): the id of vertex, the next free id if it was not seen yet
+    */
+    int intern(T vertex){
+        int slot = probe(vertex);
+        if(slots[slot] != -1) return slots[slot];
+        int id = size();
+        values.push_back(vertex);
+        slots[slot] = id;
+        if(2 * size() > (int)slots.size()) rehash(2 * (int)slots.size());
+        return id;
+    }
+    //the id of vertex; -1 if it was not interned
+    int indexOf(T vertex){
+        return slots[probe(vertex)];
+    }
+    bool contains(T vertex){
+        return indexOf(vertex) != -1;
+    }
+    T& vertex(int id){
+        return values[id];
+    }
+    T& operator[](int id){
+        return values[id];
+    }
+
+protected:
+    //slot holding the id of vertex, or the free slot where it goes
+    int probe(T& vertex){
+        int slot = home(vertex);
+        while(slots[slot] != -1 && !equal(values[slots[slot]], vertex)) slot = (slot + 1) & mask;
+        return slot;
+    }
+    void rehash(int nslots){
+        slots.assign(nslots, -1);
+        mask = nslots - 1;
+        for(shift=32; nslots > 1; nslots >>= 1) shift--;
+        for(int id=0; id < size(); id++){
+            int slot = home(values[id]);
+            while(slots[slot] != -1) slot = (slot + 1) & mask;
+            slots[slot] = id;
+        }
+    }
+    int home(T& vertex){
+        unsigned int code = (unsigned int)hash(vertex, INT_MAX);
+        return (int)((code * 2654435769u) >> shift) & mask;
+    }
+    bool equal(T& lhs, T& rhs){
+        if(vertexEQ != 0) return vertexEQ(lhs, rhs);
+        else return lhs == rhs;
+    }
+};
+
+#endif /* VERTEXIDS_H */
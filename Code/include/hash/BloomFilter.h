@@ -0,0 +1,174 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines BlockedBloomFilter: a cache-line blocked Bloom filter sized from a target false-positive rate
+*/
+
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "hash/FilterHash.h"
+using namespace std;
+
+/*
+! BlockedBloomFilter<K>
+? Functionality:
+    * Approximate set: mayContain(key) is always true for a key that was added and
+      false for most others (the false-positive rate). It answers "certainly absent"
+      from one cache line, before a slower exact lookup.
+    * Blocked layout (Putze, Sanders & Singler): the hash picks one 64-byte block
+      (BLOCK_BITS = 512 bits) and all k bits of the key are set inside it, so add and
+      mayContain touch a single cache line instead of k random ones; mayContain stops
+      at the first clear bit, which for most absent keys is the first or second one.
+    * The constructor sizes the filter from the expected number of keys and a target
+      false-positive rate. Blocking costs some accuracy, so bitsPerKey and k are the
+      smallest that meet the target by the exact formula for blocked filters, not the
+      classic 1.44 log2(1/fpr) bits per key.
+? Complexity:
+    * add, mayContain: O(k), one cache line. Memory: bitsPerKey() * capacity bits.
+? Notes:
+    * Keys cannot be removed (FilteredMap rebuilds the filter instead). Past capacity
+      keys, the false-positive rate grows (falsePositiveRate() tells by how much).
+? Usage:
+    * BlockedBloomFilter<string> seen(1000000, 0.01);
+    * if(!seen.mayContain(url)){ seen.add(url); fetch(url); }  //else: maybe seen, check exactly
+*/
+template<class K>
+class BlockedBloomFilter{
+public:
+    static const int BLOCK_BITS = 512;
+    static const int MAX_HASHES = 16;
+
+protected:
+    struct alignas(64) Block{
+        unsigned long long words[BLOCK_BITS / 64];
+    };
+
+    vector<Block> blocks;
+    int hashes;         //k: bits set per key
+    int capacity;       //expected number of keys
+    int count;          //keys added
+    double bits;        //bits per key at capacity
+    unsigned long long (*hash)(K&);
+
+public:
+    /*
+    ! BlockedBloomFilter(capacity, fpr, hash)
+    ? Exceptions:
+        * std::invalid_argument if capacity < 0 or fpr is not in (0, 1)
+    */
+    BlockedBloomFilter(int capacity, double fpr=0.01, unsigned long long (*hash)(K&)=&FilterHash<K>::of){
+        if(capacity < 0) throw std::invalid_argument("BlockedBloomFilter: negative capacity");
+        if(!(fpr > 0 && fpr < 1)) throw std::invalid_argument("BlockedBloomFilter: false-positive rate must be in (0, 1)");
+        this->hash = hash;
+        this->capacity = capacity;
+        this->count = 0;
+        choose(fpr, this->bits, this->hashes);
+        long long nblocks = (long long)std::ceil(bits * (capacity > 0 ? capacity : 1) / BLOCK_BITS);
+        blocks.assign(nblocks > 0 ? nblocks : 1, Block());
+    }
+
+    //always true: the filter never fills up, its false-positive rate grows instead
+    bool add(K key){
+        unsigned long long code = hash(key);
+        Block& block = blocks[blockOf(code)];
+        unsigned long long source = code;
+        for(int idx=0; idx < hashes; idx++){
+            unsigned int bit = bitAt(idx, code, source);
+            block.words[bit >> 6] |= 1ull << (bit & 63);
+        }
+        count++;
+        return true;
+    }
+    bool mayContain(K key){
+        unsigned long long code = hash(key);
+        const Block& block = blocks[blockOf(code)];
+        unsigned long long source = code;
+        for(int idx=0; idx < hashes; idx++){
+            unsigned int bit = bitAt(idx, code, source);
+            if((block.words[bit >> 6] & (1ull << (bit & 63))) == 0) return false;
+        }
+        return true;
+    }
+    void clear(){
+        blocks.assign(blocks.size(), Block());
+        count = 0;
+    }
+
+    //keys added (with repetitions)
+    int size(){
+        return count;
+    }
+    int getCapacity(){
+        return capacity;
+    }
+    int hashCount(){
+        return hashes;
+    }
+    double bitsPerKey(){
+        return bits;
+    }
+    long long memoryBytes(){
+        return (long long)blocks.size() * sizeof(Block);
+    }
+    //false-positive rate expected with the keys added so far
+    double falsePositiveRate(){
+        if(count == 0) return 0;
+        return expectedRate((double)blocks.size() * BLOCK_BITS / count, hashes);
+    }
+
+    /*
+    ! expectedRate(bitsPerKey, k): false-positive rate of a blocked filter
+    * The number of keys in the probed block is Poisson(BLOCK_BITS / bitsPerKey);
+    * with i keys, one of the k probed bits is set with probability 1 - (1 - 1/BLOCK_BITS)^(k i).
+    */
+    static double expectedRate(double bitsPerKey, int k){
+        double lambda = BLOCK_BITS / bitsPerKey;
+        double poisson = std::exp(-lambda);             //P(i keys in the block), i = 0
+        double clearOne = std::pow(1.0 - 1.0 / BLOCK_BITS, k);
+        double clearAll = 1.0;                          //clearOne^i
+        double rate = 0;
+        int last = (int)(4 * lambda) + 64;
+        for(int i=0; i <= last; i++){
+            if(i > 0){
+                poisson *= lambda / i;
+                clearAll *= clearOne;
+            }
+            rate += poisson * std::pow(1.0 - clearAll, k);
+        }
+        return rate;
+    }
+
+protected:
+    //the smallest bits per key (in steps of 1/4) and its best k that meet fpr
+    static void choose(double fpr, double& bits, int& k){
+        for(bits=1.0; bits < 64.0; bits += 0.25){
+            int center = (int)std::lround(bits * std::log(2.0));
+            for(k=center - 2 > 1 ? center - 2 : 1; k <= center + 2 && k <= MAX_HASHES; k++){
+                if(expectedRate(bits, k) <= fpr) return;
+            }
+        }
+        k = MAX_HASHES;
+    }
+    //the block: from the high 32 bits of the code
+    int blockOf(unsigned long long code){
+        return (int)(((code >> 32) * (unsigned long long)blocks.size()) >> 32);
+    }
+    /*
+    ! bitAt(idx, code, source): the idx-th bit of a key inside its block
+    * Bits 0-2 are 9-bit slices of the low 27 bits of code; the next ones are slices of
+    * code remixed (source keeps the current mix between calls, idx ascending). Double
+    * hashing inside a 512-bit block repeats bit patterns: twice the rate at 0.1%.
+    */
+    static unsigned int bitAt(int idx, unsigned long long code, unsigned long long& source){
+        if(idx < 3) return (unsigned int)(code >> (9 * idx)) & (BLOCK_BITS - 1);
+        int slice = (idx - 3) % 7;
+        if(slice == 0) source = FilterHash<K>::mix(source);
+        return (unsigned int)(source >> (9 * slice)) & (BLOCK_BITS - 1);
+    }
+};
+
+#endif /* BLOOMFILTER_H */
@@ -0,0 +1,216 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines CuckooFilter: an approximate set with deletion, sized from a target false-positive rate
+*/
+
+#ifndef CUCKOOFILTER_H
+#define CUCKOOFILTER_H
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "hash/FilterHash.h"
+using namespace std;
+
+/*
+! CuckooFilter<K>
+? Functionality:
+    * Approximate set like BlockedBloomFilter, but a key can also be removed
+      (Fan et al., CoNEXT 2014). Each key is stored as a short fingerprint in one of
+      two buckets of SLOTS (4) fingerprints: i1 = hash(key) and i2 = i1 ^ hash(fingerprint),
+      so either bucket is found from the other and the fingerprint alone. A key whose
+      buckets are full evicts a random fingerprint to that fingerprint's other bucket,
+      and so on, up to MAX_KICKS moves (cuckoo hashing).
+    * Sizing: the table has capacity / 0.95 slots (rounded up to a power of two buckets)
+      and fingerprints of f = ceil(log2(2 * SLOTS / fpr)) bits, between 4 and 16
+      (the lowest rate reachable is about 1.2e-4).
+    * add(key) returns false once the filter is full: after MAX_KICKS moves the last
+      evicted fingerprint is kept aside (the "victim"), so no key is ever lost, and
+      the next add fails until a remove makes room.
+? Complexity:
+    * mayContain, remove: O(1), two buckets; add: O(1) expected.
+    * Memory: 2 bytes per slot.
+? Notes:
+    * remove(key) must only be called for a key that was added: it removes one matching
+      fingerprint, which could belong to another key with the same fingerprint.
+    * Adding the same key twice stores it twice (up to 2 * SLOTS copies).
+? Usage:
+    * CuckooFilter<int> cache(100000, 0.001);
+    * cache.add(id); ... if(cache.mayContain(id)) ...; cache.remove(id);
+*/
+template<class K>
+class CuckooFilter{
+public:
+    static const int SLOTS = 4;
+    static const int MAX_KICKS = 500;
+
+protected:
+    vector<uint16_t> table;     //buckets * SLOTS fingerprints; 0: empty slot
+    int buckets;                //a power of two
+    int bits;                   //fingerprint bits
+    int capacity;
+    int count;
+    bool hasVictim;
+    int victimIndex;
+    uint16_t victimPrint;
+    unsigned long long state;   //xorshift for the evictions
+    unsigned long long (*hash)(K&);
+
+public:
+    /*
+    ! CuckooFilter(capacity, fpr, hash)
+    ? Exceptions:
+        * std::invalid_argument if capacity < 0 or fpr is not in (0, 1)
+    */
+    CuckooFilter(int capacity, double fpr=0.01, unsigned long long (*hash)(K&)=&FilterHash<K>::of){
+        if(capacity < 0) throw std::invalid_argument("CuckooFilter: negative capacity");
+        if(!(fpr > 0 && fpr < 1)) throw std::invalid_argument("CuckooFilter: false-positive rate must be in (0, 1)");
+        this->hash = hash;
+        this->capacity = capacity;
+        this->bits = (int)std::ceil(std::log2(2.0 * SLOTS / fpr));
+        if(bits < 4) bits = 4;
+        if(bits > 16) bits = 16;
+        long long needed = (long long)std::ceil(capacity / (0.95 * SLOTS));
+        this->buckets = 1;
+        while(buckets < needed) buckets <<= 1;
+        this->table.assign((size_t)buckets * SLOTS, 0);
+        this->count = 0;
+        this->hasVictim = false;
+        this->victimIndex = 0;
+        this->victimPrint = 0;
+        this->state = 0x2545F4914F6CDD1Dull;
+    }
+
+    /*
+    ! add(key): store key; false if the filter is full (key not stored)
+    */
+    bool add(K key){
+        if(hasVictim) return false;
+        int index;
+        uint16_t print;
+        locate(key, index, print);
+        count++;
+        place(index, print);
+        return true;
+    }
+    bool mayContain(K key){
+        int index;
+        uint16_t print;
+        locate(key, index, print);
+        int other = alternate(index, print);
+        if(inBucket(index, print) || inBucket(other, print)) return true;
+        return hasVictim && victimPrint == print && (victimIndex == index || victimIndex == other);
+    }
+    /*
+    ! remove(key): forget one copy of key; false if no fingerprint of key was found
+    */
+    bool remove(K key){
+        int index;
+        uint16_t print;
+        locate(key, index, print);
+        int other = alternate(index, print);
+        if(eraseFrom(index, print) || eraseFrom(other, print)){
+            count--;
+            if(hasVictim){
+                //room was made: put the victim back in the table
+                hasVictim = false;
+                place(victimIndex, victimPrint);
+            }
+            return true;
+        }
+        if(hasVictim && victimPrint == print && (victimIndex == index || victimIndex == other)){
+            hasVictim = false;
+            count--;
+            return true;
+        }
+        return false;
+    }
+    void clear(){
+        table.assign(table.size(), 0);
+        count = 0;
+        hasVictim = false;
+    }
+
+    int size(){
+        return count;
+    }
+    int getCapacity(){
+        return capacity;
+    }
+    int fingerprintBits(){
+        return bits;
+    }
+    long long memoryBytes(){
+        return (long long)table.size() * sizeof(uint16_t);
+    }
+    //fraction of the slots in use
+    double loadFactor(){
+        return (double)count / table.size();
+    }
+    //false-positive rate expected with the keys added so far: 2 buckets of fingerprints checked
+    double falsePositiveRate(){
+        double stored = 2.0 * SLOTS * loadFactor();
+        return 1.0 - std::pow(1.0 - 1.0 / ((1 << bits) - 1), stored);
+    }
+
+protected:
+    //first bucket (low bits of the hash) and fingerprint (high bits, never 0) of key
+    void locate(K& key, int& index, uint16_t& print){
+        unsigned long long code = hash(key);
+        index = (int)(code & (unsigned long long)(buckets - 1));
+        print = (uint16_t)((code >> 32) & ((1u << bits) - 1));
+        if(print == 0) print = 1;
+    }
+    int alternate(int index, uint16_t print){
+        return (int)((index ^ (unsigned int)(print * 0x5BD1E995u)) & (unsigned int)(buckets - 1));
+    }
+    bool inBucket(int index, uint16_t print){
+        const uint16_t* slot = &table[(size_t)index * SLOTS];
+        return slot[0] == print || slot[1] == print || slot[2] == print || slot[3] == print;
+    }
+    bool insertInto(int index, uint16_t print){
+        uint16_t* slot = &table[(size_t)index * SLOTS];
+        for(int idx=0; idx < SLOTS; idx++){
+            if(slot[idx] == 0){
+                slot[idx] = print;
+                return true;
+            }
+        }
+        return false;
+    }
+    bool eraseFrom(int index, uint16_t print){
+        uint16_t* slot = &table[(size_t)index * SLOTS];
+        for(int idx=0; idx < SLOTS; idx++){
+            if(slot[idx] == print){
+                slot[idx] = 0;
+                return true;
+            }
+        }
+        return false;
+    }
+    unsigned long long random(){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    //stores print in bucket index or its alternate, evicting if needed; the last evicted becomes the victim
+    void place(int index, uint16_t print){
+        if(insertInto(index, print) || insertInto(alternate(index, print), print)) return;
+        if(random() & 1) index = alternate(index, print);
+        for(int kick=0; kick < MAX_KICKS; kick++){
+            uint16_t& slot = table[(size_t)index * SLOTS + random() % SLOTS];
+            uint16_t evicted = slot;
+            slot = print;
+            print = evicted;
+            index = alternate(index, print);
+            if(insertInto(index, print)) return;
+        }
+        hasVictim = true;
+        victimIndex = index;
+        victimPrint = print;
+    }
+};
+
+#endif /* CUCKOOFILTER_H */
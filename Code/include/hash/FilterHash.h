@@ -0,0 +1,36 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines FilterHash: the default 64-bit key hash of the approximate membership filters
+*/
+
+#ifndef FILTERHASH_H
+#define FILTERHASH_H
+#include <functional>
+using namespace std;
+
+/*
+! FilterHash<K>
+? Functionality:
+    * of(key): std::hash<K> of key, passed through the splitmix64 finalizer. std::hash
+      of an integer is the integer itself; the filters take block, bucket and bit
+      positions from different parts of the 64-bit value, so every bit must depend on
+      every bit of the key.
+? Usage:
+    * BlockedBloomFilter<int> seen(1000000, 0.01);                 //FilterHash<int>::of
+    * CuckooFilter<Point> points(1000, 0.001, &myPointHash);      //any unsigned long long (*)(K&)
+*/
+template<class K>
+struct FilterHash{
+    static unsigned long long of(K& key){
+        return mix((unsigned long long)std::hash<K>()(key));
+    }
+    static unsigned long long mix(unsigned long long x){
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+};
+
+#endif /* FILTERHASH_H */
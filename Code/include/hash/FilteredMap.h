@@ -0,0 +1,199 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines FilteredMap: an xMap behind an approximate membership filter, for miss-heavy lookups
+*/
+
+#ifndef FILTEREDMAP_H
+#define FILTEREDMAP_H
+#include <string>
+#include "hash/IMap.h"
+#include "hash/xMap.h"
+#include "hash/BloomFilter.h"
+#include "hash/CuckooFilter.h"
+using namespace std;
+
+/*
+! FilteredMap<K, V, Filter>
+? Functionality:
+    * IMap<K, V> over an xMap<K, V> that asks a filter first: a key the filter rules
+      out is answered (containsKey false, find null, get/remove KeyNotFound) without
+      hashing into the table and walking a bucket chain. Only the false positives
+      (about the filter's rate) and the hits reach the xMap.
+    * Filter is CuckooFilter<K> (default) or BlockedBloomFilter<K>, built with
+      (capacity, fpr, filterHash). The filter is rebuilt from the keys of the map, with
+      twice the capacity, when the map outgrows it (or the cuckoo filter is full).
+    * A Bloom filter cannot forget a key: removed keys stay in it as false positives,
+      and the filter is rebuilt when they outnumber the keys in the map.
+? Complexity:
+    * Miss: one filter probe (one or two cache lines). Hit, put, remove: the filter,
+      then the xMap. Rebuilds are O(n) and amortized over as many puts / removes.
+? Notes:
+    * The xMap arguments (hashCode, loadFactor, valueEqual, deleteValues, keyEqual)
+      follow the filter's (capacity, fpr).
+? Usage:
+    * FilteredMap<string, Page*> cache(&fnvHash, 100000, 0.01);
+    * Page** page = cache.find(url);      //nullptr for a miss, usually without touching the table
+    * FilteredMap<int, int, BlockedBloomFilter<int>> seen(&xMap<int, int>::intKeyHash);
+*/
+template<class K, class V, class Filter=CuckooFilter<K>>
+class FilteredMap: public IMap<K, V>{
+protected:
+    xMap<K, V> map;
+    Filter* filter;
+    double fpr;
+    unsigned long long (*filterHash)(K&);
+    int stale;          //removed keys still in a filter that cannot forget them
+
+public:
+    FilteredMap(int (*hashCode)(K&, int), int capacity=1024, double fpr=0.01,
+                float loadFactor=0.75f,
+                bool (*valueEqual)(V&, V&)=0,
+                void (*deleteValues)(xMap<K, V>*)=0,
+                bool (*keyEqual)(K&, K&)=0,
+                unsigned long long (*filterHash)(K&)=&FilterHash<K>::of):
+        map(hashCode, loadFactor, valueEqual, deleteValues, keyEqual){
+        this->fpr = fpr;
+        this->filterHash = filterHash;
+        this->filter = new Filter(capacity, fpr, filterHash);
+        this->stale = 0;
+    }
+    FilteredMap(const FilteredMap<K, V, Filter>& other): map(other.map){
+        this->fpr = other.fpr;
+        this->filterHash = other.filterHash;
+        this->filter = new Filter(*other.filter);
+        this->stale = other.stale;
+    }
+    FilteredMap<K, V, Filter>& operator=(const FilteredMap<K, V, Filter>& other){
+        if(this == &other) return *this;
+        map = other.map;
+        delete filter;
+        fpr = other.fpr;
+        filterHash = other.filterHash;
+        filter = new Filter(*other.filter);
+        stale = other.stale;
+        return *this;
+    }
+    ~FilteredMap(){
+        delete filter;
+    }
+
+    //Inherit from IMap:BEGIN
+    V put(K key, V value){
+        V* slot = filter->mayContain(key) ? map.find(key) : 0;
+        if(slot != 0){
+            V old = *slot;
+            *slot = value;
+            return old;
+        }
+        if(map.size() + stale >= filter->getCapacity() || !filter->add(key)){
+            rebuild(2 * (map.size() + 1 > filter->getCapacity() ? map.size() + 1 : filter->getCapacity()));
+            while(!filter->add(key)) rebuild(2 * filter->getCapacity());
+        }
+        return map.put(key, value);
+    }
+    V& get(K key){
+        V* slot = find(key);
+        if(slot == 0) throw KeyNotFound(notFound(key));
+        return *slot;
+    }
+    V remove(K key, void (*deleteKeyInMap)(K)=0){
+        if(!filter->mayContain(key)) throw KeyNotFound(notFound(key));
+        V value = map.remove(key, deleteKeyInMap);
+        forget(key);
+        return value;
+    }
+    bool remove(K key, V value, void (*deleteKeyInMap)(K)=0, void (*deleteValueInMap)(V)=0){
+        if(!filter->mayContain(key)) return false;
+        if(!map.remove(key, value, deleteKeyInMap, deleteValueInMap)) return false;
+        forget(key);
+        return true;
+    }
+    bool containsKey(K key){
+        return filter->mayContain(key) && map.containsKey(key);
+    }
+    bool containsValue(V value){
+        return map.containsValue(value);
+    }
+    bool empty(){
+        return map.empty();
+    }
+    int size(){
+        return map.size();
+    }
+    void clear(){
+        map.clear();
+        filter->clear();
+        stale = 0;
+    }
+    string toString(string (*key2str)(K&)=0, string (*value2str)(V&)=0){
+        return map.toString(key2str, value2str);
+    }
+    DLinkedList<K> keys(){
+        return map.keys();
+    }
+    DLinkedList<V> values(){
+        return map.values();
+    }
+    DLinkedList<int> clashes(){
+        return map.clashes();
+    }
+    //Inherit from IMap:END
+
+    void println(string (*key2str)(K&)=0, string (*value2str)(V&)=0){
+        map.println(key2str, value2str);
+    }
+    /*
+    ! find(key): pointer to the value of key, or nullptr (no exception); the fast path for misses
+    */
+    V* find(K key){
+        return filter->mayContain(key) ? map.find(key) : 0;
+    }
+    Filter& getFilter(){
+        return *filter;
+    }
+
+    /*
+    ! rebuild(capacity): a fresh filter for at least capacity keys, filled with the keys of the map
+    * A filter that fills up before every key is in (cuckoo) is dropped for one twice as large.
+    */
+    void rebuild(int capacity){
+        if(capacity < map.size()) capacity = map.size();
+        DLinkedList<K> keys = map.keys();
+        Filter* fresh = 0;
+        while(fresh == 0){
+            fresh = new Filter(capacity, fpr, filterHash);
+            for(K& key: keys){
+                if(fresh->add(key)) continue;
+                delete fresh;
+                fresh = 0;
+                capacity *= 2;
+                break;
+            }
+        }
+        delete filter;
+        filter = fresh;
+        stale = 0;
+    }
+
+protected:
+    //drops a removed key from the filter, or counts it as stale if the filter cannot
+    void forget(K& key){
+        if(removeFromFilter(*filter, key)) return;
+        stale++;
+        if(stale > map.size()) rebuild(filter->getCapacity());
+    }
+    static bool removeFromFilter(CuckooFilter<K>& filter, K& key){
+        return filter.remove(key);
+    }
+    static bool removeFromFilter(BlockedBloomFilter<K>& /*filter*/, K& /*key*/){
+        return false;
+    }
+    static string notFound(K& key){
+        stringstream os;
+        os << "key (" << key << ") is not found";
+        return os.str();
+    }
+};
+
+#endif /* FILTEREDMAP_H */
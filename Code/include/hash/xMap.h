@@ -161,6 +161,17 @@ public:
     int getCapacity(){
         return capacity;
     }
+    /*
+     * find(K key): pointer to the value associated with key, or nullptr if key is not in the map;
+     *  one probe and no exception, for callers where a miss is expected (get + containsKey probe twice)
+     */
+    V* find(K key){
+        DLinkedList<Entry*>& list = table[hashCode(key, capacity)];
+        for(auto pEntry: list){
+            if(keyEQ(pEntry->key, key)) return &pEntry->value;
+        }
+        return nullptr;
+    }
     
     ///////////////////////////////////////////////////
     // STATIC METHODS: BEGIN
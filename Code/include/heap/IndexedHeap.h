@@ -0,0 +1,179 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines IndexedHeap: a d-ary min-heap of integer ids with decrease-key
+*/
+
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+#include <stdexcept>
+
+/*
+! IndexedHeap<K>
+? Functionality:
+    * Min-heap of ids 0..capacity-1, each with a key of type K (K needs operator <).
+    * pos[id] remembers where each id sits in the heap, so decreaseKey(id, key) and
+      contains(id) are O(1) to locate and O(log_d n) to restore the heap order,
+      which is what Dijkstra, A* and Prim need (no stale duplicate entries).
+    * arity d: 2 is the binary heap; 4 (default) makes the tree shallower and keeps
+      the children of a node in one cache line, which makes pop cheaper on large heaps.
+? Complexity:
+    * push, decreaseKey, pop: O(log_d n); top, contains, key: O(1).
+? Usage:
+    * IndexedHeap<float> heap(nvertices);
+    * heap.push(source, 0);
+    * while(!heap.empty()){ float d = heap.topKey(); int u = heap.pop(); ... heap.pushOrDecrease(v, d + w); }
+*/
+template<class K>
+class IndexedHeap{
+protected:
+    int capacity;
+    int arity;
+    int count;
+    int* heap;  //heap[i]: the id at position i
+    K* keys;    //keys[i]: the key of heap[i], kept next to it so sifting reads no ids
+    int* pos;   //pos[id]: position of id in heap[], -1 if not in the heap
+
+public:
+    IndexedHeap(int capacity, int arity=4){
+        if(capacity < 0) throw std::invalid_argument("IndexedHeap: negative capacity");
+        if(arity < 2) arity = 2;
+        this->capacity = capacity;
+        this->arity = arity;
+        this->count = 0;
+        this->heap = new int[capacity > 0 ? capacity : 1];
+        this->keys = new K[capacity > 0 ? capacity : 1];
+        this->pos = new int[capacity > 0 ? capacity : 1];
+        for(int id=0; id < capacity; id++) pos[id] = -1;
+    }
+    ~IndexedHeap(){
+        delete []heap;
+        delete []pos;
+        delete []keys;
+    }
+    IndexedHeap(const IndexedHeap&) = delete;
+    IndexedHeap& operator=(const IndexedHeap&) = delete;
+
+    int size(){
+        return count;
+    }
+    bool empty(){
+        return count == 0;
+    }
+    int getCapacity(){
+        return capacity;
+    }
+    bool contains(int id){
+        return pos[id] != -1;
+    }
+    //key of an id in the heap
+    K key(int id){
+        checkId(id);
+        if(pos[id] == -1) throw std::invalid_argument("IndexedHeap: id is not in the heap");
+        return keys[pos[id]];
+    }
+
+    /*
+    ! push(id, key): inserts id; id must be in 0..capacity-1 and not in the heap
+    ? Exceptions:
+        * std::out_of_range if id is invalid, std::invalid_argument if it is already in the heap
+    */
+    void push(int id, K key){
+        checkId(id);
+        if(pos[id] != -1) throw std::invalid_argument("IndexedHeap: id is already in the heap");
+        siftUp(count++, id, key);
+    }
+
+    /*
+    ! decreaseKey(id, key): lowers the key of an id in the heap; a larger key is ignored
+    */
+    void decreaseKey(int id, K key){
+        checkId(id);
+        if(pos[id] == -1) throw std::invalid_argument("IndexedHeap: id is not in the heap");
+        if(!(key < keys[pos[id]])) return;
+        siftUp(pos[id], id, key);
+    }
+
+    /*
+    ! pushOrDecrease(id, key): push if id is not in the heap, decreaseKey otherwise
+    ? Return:
+        * bool: true if id was pushed or its key lowered
+    */
+    bool pushOrDecrease(int id, K key){
+        checkId(id);
+        int idx = pos[id];
+        if(idx == -1) idx = count++;
+        else if(!(key < keys[idx])) return false;
+        siftUp(idx, id, key);
+        return true;
+    }
+
+    int top(){
+        if(count == 0) throw std::underflow_error("Calling to top with the empty heap.");
+        return heap[0];
+    }
+    K topKey(){
+        if(count == 0) throw std::underflow_error("Calling to topKey with the empty heap.");
+        return keys[0];
+    }
+
+    /*
+    ! pop(): removes and returns the id with the smallest key
+    ? Exceptions:
+        * std::underflow_error if the heap is empty
+    */
+    int pop(){
+        if(count == 0) throw std::underflow_error("Calling to pop with the empty heap.");
+        int id = heap[0];
+        pos[id] = -1;
+        count--;
+        if(count > 0) siftDown(0, heap[count], keys[count]);
+        return id;
+    }
+
+    //removes every id still in the heap: O(size())
+    void clear(){
+        for(int idx=0; idx < count; idx++) pos[heap[idx]] = -1;
+        count = 0;
+    }
+
+protected:
+    void checkId(int id){
+        if(id < 0 || id >= capacity) throw std::out_of_range("IndexedHeap: id is out of range");
+    }
+    //places (id, key) at idx or above: idx is free (a new slot, or id's own slot)
+    void siftUp(int idx, int id, K key){
+        while(idx > 0){
+            int parent = (idx - 1) / arity;
+            if(!(key < keys[parent])) break;
+            heap[idx] = heap[parent];
+            keys[idx] = keys[parent];
+            pos[heap[idx]] = idx;
+            idx = parent;
+        }
+        heap[idx] = id;
+        keys[idx] = key;
+        pos[id] = idx;
+    }
+    //places (id, key) at idx or below: idx is free
+    void siftDown(int idx, int id, K key){
+        while(true){
+            int first = idx * arity + 1;
+            if(first >= count) break;
+            int last = first + arity < count ? first + arity : count;
+            int best = first;
+            for(int child=first + 1; child < last; child++)
+                if(keys[child] < keys[best]) best = child;
+            if(!(keys[best] < key)) break;
+            heap[idx] = heap[best];
+            keys[idx] = keys[best];
+            pos[heap[idx]] = idx;
+            idx = best;
+        }
+        heap[idx] = id;
+        keys[idx] = key;
+        pos[id] = idx;
+    }
+};
+
+#endif /* INDEXEDHEAP_H */
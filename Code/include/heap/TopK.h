@@ -0,0 +1,75 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines topK: the k largest items of an array, selected with a Heap
+*/
+
+#ifndef TOPK_H
+#define TOPK_H
+#include <iostream>
+#include "heap/Heap.h"
+#include "sorting/ISort.h"
+#include "sorting/IntroSort.h"
+#include "sorting/SortingNetwork.h"
+#include <algorithm>
+#include <type_traits>
+
+/*
+! topK(array, size, k, out, comparator)
+? Functionality:
+    * Writes the k largest items of array[0..size) into out[0..k), largest first,
+      and returns the number of items written (min(k, size)).
+    * A min-heap (Heap<T>) keeps the k best items seen so far: O(size log k) time,
+      O(k) extra memory; array is not modified.
+    * The selected items are then sorted: with a SIMD sorting network when T is
+      int32, float or double in natural order and k <= SortingNetwork<T>::MAX_SIZE,
+      with IntroSort otherwise.
+? Comparator:
+    * Same contract as ISort<T>: comparator(lhs, rhs) < 0 means lhs is smaller;
+      comparator == 0 means T's operator <, >.
+? Usage:
+    * float best[10];
+    * int n = topK(scores, nscores, 10, best);
+*/
+template<class T>
+int topK(T* array, int size, int k, T* out, int (*comparator)(T&,T&) =0){
+    if(array == 0 || out == 0 || size <= 0 || k <= 0) return 0;
+    if(k > size) k = size;
+
+    //min-heap: the root is the smallest of the items kept
+    Heap<T> heap(comparator);
+    for(int idx=0; idx < k; idx++) heap.push(array[idx]);
+    for(int idx=k; idx < size; idx++){
+        T root = heap.peek();
+        bool better = comparator ? comparator(array[idx], root) > 0 : root < array[idx];
+        if(better){
+            heap.pop();
+            heap.push(array[idx]);
+        }
+    }
+
+    int count = 0;
+    for(typename Heap<T>::Iterator it = heap.begin(); it != heap.end(); it++) out[count++] = *it;
+
+    bool natural = comparator == 0 || comparator == &SortSimpleOrder<T>::compare4Ascending;
+    if constexpr (SortingNetwork<T>::supported){
+        if(natural && count <= SortingNetwork<T>::MAX_SIZE){
+            SortingNetwork<T>::sort(out, count);
+            std::reverse(out, out + count);
+            return count;
+        }
+    }
+    if(natural){
+        IntroSort<T>().sort(out, count, &SortSimpleOrder<T>::compare4Desending);
+    }
+    else{
+        struct Greater{
+            int (*comparator)(T&,T&);
+            bool operator()(T& lhs, T& rhs) const { return comparator(rhs, lhs) < 0; }
+        } greater = {comparator};
+        IntroSort<T>::sortRange(out, out + count, greater);
+    }
+    return count;
+}
+
+#endif /* TOPK_H */
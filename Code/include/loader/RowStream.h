@@ -0,0 +1,329 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines streaming row readers/writers for binary record files and .npy tables
+*/
+
+#ifndef ROWSTREAM_H
+#define ROWSTREAM_H
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+using namespace std;
+
+/*
+* A "row" is "width" consecutive values of type T (width = 1: a plain stream of T).
+* Readers and writers move whole rows in blocks, so a table never has to fit in memory.
+*/
+template<class T>
+class IRowReader{
+public:
+    virtual ~IRowReader(){}
+    /*
+    ! read(rows, maxRows): read up to maxRows rows into rows[0 .. maxRows*width);
+    * returns the number of rows read, 0 at the end of the stream.
+    * Exception: std::runtime_error if the stream ends inside a row.
+    */
+    virtual long long read(T* rows, long long maxRows)=0;
+    virtual int width()=0;
+};
+
+template<class T>
+class IRowWriter{
+public:
+    virtual ~IRowWriter(){}
+    virtual void write(const T* rows, long long nrows)=0;
+    virtual int width()=0;
+    /*
+    ! close(): flush the rows; called by the destructor if the user did not
+    */
+    virtual void close()=0;
+};
+
+/*
+! BinaryRowReader<T>, BinaryRowWriter<T>
+? Functionality:
+    * Raw native-endian rows, no header: what fwrite(rows, sizeof(T)*width, n) produces.
+*/
+template<class T>
+class BinaryRowReader: public IRowReader<T>{
+    static_assert(std::is_trivially_copyable<T>::value, "BinaryRowReader: T must be trivially copyable");
+protected:
+    istream* in;
+    ifstream file;
+    int rowWidth;
+
+public:
+    BinaryRowReader(istream& in, int width=1){
+        this->in = &in;
+        this->rowWidth = width;
+    }
+    BinaryRowReader(string path, int width=1): file(path, ios::binary){
+        if(!file) throw std::runtime_error("BinaryRowReader: cannot open " + path);
+        this->in = &file;
+        this->rowWidth = width;
+    }
+    long long read(T* rows, long long maxRows){
+        long long rowBytes = (long long)sizeof(T) * rowWidth;
+        in->read((char*)rows, maxRows * rowBytes);
+        long long got = in->gcount();
+        if(got % rowBytes != 0) throw std::runtime_error("BinaryRowReader: stream ends inside a row");
+        return got / rowBytes;
+    }
+    int width(){
+        return rowWidth;
+    }
+};
+
+template<class T>
+class BinaryRowWriter: public IRowWriter<T>{
+    static_assert(std::is_trivially_copyable<T>::value, "BinaryRowWriter: T must be trivially copyable");
+protected:
+    ostream* out;
+    ofstream file;
+    int rowWidth;
+
+public:
+    BinaryRowWriter(ostream& out, int width=1){
+        this->out = &out;
+        this->rowWidth = width;
+    }
+    BinaryRowWriter(string path, int width=1): file(path, ios::binary | ios::trunc){
+        if(!file) throw std::runtime_error("BinaryRowWriter: cannot create " + path);
+        this->out = &file;
+        this->rowWidth = width;
+    }
+    ~BinaryRowWriter(){
+        close();
+    }
+    void write(const T* rows, long long nrows){
+        out->write((const char*)rows, nrows * (long long)sizeof(T) * rowWidth);
+        if(!*out) throw std::runtime_error("BinaryRowWriter: write failed");
+    }
+    int width(){
+        return rowWidth;
+    }
+    void close(){
+        out->flush();
+        if(file.is_open()) file.close();
+    }
+};
+
+/*
+! NpyType<T>::descr(): the numpy dtype string of T ("<f4", "<i8", ...)
+*/
+template<class T>
+struct NpyType{
+    static string descr(){
+        char kind = std::is_floating_point<T>::value ? 'f' : (std::is_signed<T>::value ? 'i' : 'u');
+        if(std::is_same<T, bool>::value) kind = 'b';
+        return string(sizeof(T) == 1 ? "|" : "<") + kind + to_string(sizeof(T));
+    }
+};
+
+/*
+! NpyHeader
+? Functionality:
+    * The header of a .npy file: dtype, memory order and shape; dataOffset is where
+      the first row starts.
+    * parse(in) reads versions 1.0, 2.0 and 3.0; write(out) always writes version 1.0,
+      padded to HEADER_SIZE bytes so it can be rewritten in place with a different shape.
+*/
+class NpyHeader{
+public:
+    static const int HEADER_SIZE = 128;
+
+    string descr;
+    bool fortranOrder;
+    vector<long long> shape;
+    long long dataOffset;
+
+public:
+    NpyHeader(): fortranOrder(false), dataOffset(0){}
+
+    long long rows() const {
+        return shape.empty() ? 1 : shape[0];
+    }
+    //values per row: the product of every dimension after the first
+    long long cols() const {
+        long long n = 1;
+        for(size_t idx=1; idx < shape.size(); idx++) n *= shape[idx];
+        return n;
+    }
+
+    static NpyHeader parse(istream& in){
+        char magic[8];
+        in.read(magic, 8);
+        if(in.gcount() != 8 || memcmp(magic, "\x93NUMPY", 6) != 0)
+            throw std::runtime_error("NpyHeader: not a .npy file");
+        int major = (unsigned char)magic[6];
+        long long length;
+        if(major == 1){
+            unsigned char bytes[2];
+            in.read((char*)bytes, 2);
+            length = bytes[0] | (bytes[1] << 8);
+        }
+        else{
+            unsigned char bytes[4];
+            in.read((char*)bytes, 4);
+            length = (long long)bytes[0] | ((long long)bytes[1] << 8)
+                   | ((long long)bytes[2] << 16) | ((long long)bytes[3] << 24);
+        }
+        string text(length, ' ');
+        in.read(&text[0], length);
+        if(!in) throw std::runtime_error("NpyHeader: truncated header");
+
+        NpyHeader header;
+        header.dataOffset = (major == 1 ? 10 : 12) + length;
+        header.descr = field(text, "descr");
+        if(header.descr.size() >= 2 && (header.descr[0] == '\'' || header.descr[0] == '"'))
+            header.descr = header.descr.substr(1, header.descr.size() - 2);
+        header.fortranOrder = field(text, "fortran_order").compare(0, 4, "True") == 0;
+
+        string shape = field(text, "shape");
+        size_t pos = shape.find('(');
+        while(pos != string::npos && pos < shape.size()){
+            size_t digit = shape.find_first_of("0123456789", pos);
+            if(digit == string::npos) break;
+            size_t end = shape.find_first_not_of("0123456789", digit);
+            header.shape.push_back(stoll(shape.substr(digit, end - digit)));
+            pos = end;
+        }
+        return header;
+    }
+
+    void write(ostream& out) const {
+        stringstream dict;
+        dict << "{'descr': '" << descr << "', 'fortran_order': "
+             << (fortranOrder ? "True" : "False") << ", 'shape': (";
+        for(size_t idx=0; idx < shape.size(); idx++) dict << (idx ? ", " : "") << shape[idx];
+        dict << (shape.size() == 1 ? ",), }" : "), }");
+        string text = dict.str();
+        if((long long)text.size() + 11 > HEADER_SIZE)
+            throw std::runtime_error("NpyHeader: shape too long for the header");
+        text.append(HEADER_SIZE - 10 - 1 - text.size(), ' ');
+        text += '\n';
+
+        unsigned short length = (unsigned short)text.size();
+        out.write("\x93NUMPY\x01\x00", 8);
+        char bytes[2] = {(char)(length & 0xFF), (char)(length >> 8)};
+        out.write(bytes, 2);
+        out.write(text.data(), text.size());
+    }
+
+private:
+    //the raw text of "key": value in the header dict
+    static string field(const string& text, const string& key){
+        size_t pos = text.find("'" + key + "'");
+        if(pos == string::npos) pos = text.find("\"" + key + "\"");
+        if(pos == string::npos) throw std::runtime_error("NpyHeader: missing key " + key);
+        pos = text.find(':', pos) + 1;
+        while(pos < text.size() && text[pos] == ' ') pos++;
+        size_t end = text[pos] == '(' ? text.find(')', pos) + 1 : text.find_first_of(",}", pos);
+        return text.substr(pos, end - pos);
+    }
+};
+
+/*
+! NpyRowReader<T>
+? Functionality:
+    * Streams the rows of a C-order .npy file of dtype T (1-D: one value per row,
+      N-D: one row per index of the first axis) without loading the file.
+    * Exception: std::runtime_error if the dtype is not T's or the file is Fortran-ordered.
+? Usage:
+    * NpyRowReader<float> reader("train.npy");
+    * vector<float> block(1024 * reader.width());
+    * while(long long n = reader.read(block.data(), 1024)) process(block.data(), n);
+*/
+template<class T>
+class NpyRowReader: public IRowReader<T>{
+protected:
+    ifstream file;
+    NpyHeader header;
+    long long remaining;
+
+public:
+    NpyRowReader(string path): file(path, ios::binary){
+        if(!file) throw std::runtime_error("NpyRowReader: cannot open " + path);
+        header = NpyHeader::parse(file);
+        if(header.descr != NpyType<T>::descr() && !(header.descr[0] == '=' &&
+                header.descr.substr(1) == NpyType<T>::descr().substr(1)))
+            throw std::runtime_error("NpyRowReader: " + path + " has dtype " + header.descr
+                    + ", expected " + NpyType<T>::descr());
+        if(header.fortranOrder && header.shape.size() > 1)
+            throw std::runtime_error("NpyRowReader: Fortran-ordered tables are not supported");
+        remaining = header.rows();
+    }
+    const NpyHeader& getHeader(){
+        return header;
+    }
+    long long rows(){
+        return header.rows();
+    }
+    int width(){
+        return (int)header.cols();
+    }
+    long long read(T* rows, long long maxRows){
+        long long n = maxRows < remaining ? maxRows : remaining;
+        if(n <= 0) return 0;
+        file.read((char*)rows, n * (long long)sizeof(T) * width());
+        if(!file) throw std::runtime_error("NpyRowReader: file is shorter than its header says");
+        remaining -= n;
+        return n;
+    }
+};
+
+/*
+! NpyRowWriter<T>
+? Functionality:
+    * Writes rows of "width" values of T as a .npy table of shape (rows, width),
+      or (rows,) when oneDimension is true and width == 1.
+    * The row count need not be known in advance: close() rewrites the header
+      with the number of rows actually written.
+*/
+template<class T>
+class NpyRowWriter: public IRowWriter<T>{
+protected:
+    ofstream file;
+    NpyHeader header;
+    long long written;
+    bool closed;
+
+public:
+    NpyRowWriter(string path, int width=1, bool oneDimension=false): file(path, ios::binary | ios::trunc){
+        if(!file) throw std::runtime_error("NpyRowWriter: cannot create " + path);
+        header.descr = NpyType<T>::descr();
+        header.shape.push_back(0);
+        if(!(oneDimension && width == 1)) header.shape.push_back(width);
+        header.write(file);
+        written = 0;
+        closed = false;
+    }
+    ~NpyRowWriter(){
+        close();
+    }
+    void write(const T* rows, long long nrows){
+        file.write((const char*)rows, nrows * (long long)sizeof(T) * width());
+        if(!file) throw std::runtime_error("NpyRowWriter: write failed");
+        written += nrows;
+    }
+    int width(){
+        return (int)header.cols();
+    }
+    void close(){
+        if(closed) return;
+        closed = true;
+        header.shape[0] = written;
+        file.seekp(0);
+        header.write(file);
+        file.close();
+    }
+};
+
+#endif /* ROWSTREAM_H */
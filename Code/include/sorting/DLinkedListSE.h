@@ -15,6 +15,9 @@
 #define DLINKEDLISTSE_H
 #include "list/DLinkedList.h"
 #include "sorting/ISort.h"
+#include "util/ThreadPool.h"
+#include <vector>
+#include <memory>
 
 template<class T>
 class DLinkedListSE: public DLinkedList<T>{
@@ -85,8 +88,133 @@ public:
 
         this->merge(leftList, rightList, comparator);
     };
+
+    /*
+    ! parallelSort(comparator, pool)
+    ? Functionality:
+        * Stable merge sort, same order as sort(), but:
+            * nodes are relinked in place: no list/node is allocated or copied;
+            * the list is cut into one run per worker, the runs are sorted
+              concurrently, then merged pairwise (also concurrently) until one remains.
+        * Waits on its own task groups, so the pool may be shared and parallelSort
+          may be called from one of its tasks.
+        * If the comparator throws, the list is restored to its order before the
+          call (the sort relinks "next" only) and the exception is rethrown.
+    ? Parameters:
+        * pool: workers to use; if 0, a pool with one thread per core is created.
+    */
+    void parallelSort(int (*comparator)(T&,T&)=0, ThreadPool* pool=0){
+        if (this->count <= 1) return;
+        std::unique_ptr<ThreadPool> owned(pool != 0 ? 0 : new ThreadPool());
+        ThreadPool* workers = pool != 0 ? pool : owned.get();
+
+        int nruns = workers->size();
+        if (nruns > this->count) nruns = this->count;
+
+        // Cut the chain into runs (singly linked, null-terminated)
+        std::vector<Node*> runs(nruns);
+        std::vector<int> lengths(nruns);
+        Node* node = this->head->next;
+        for (int run = 0; run < nruns; run++) {
+            lengths[run] = this->count / nruns + (run < this->count % nruns ? 1 : 0);
+            runs[run] = node;
+            for (int idx = 0; idx < lengths[run]; idx++) node = node->next;
+        }
+
+        try {
+            sortRuns(runs, lengths, comparator, workers);
+        } catch (...) {
+            // prev pointers still hold the original order
+            for (node = this->tail; node != this->head; node = node->prev) node->prev->next = node;
+            throw;
+        }
+
+        // Restore prev pointers and the sentinels
+        Node* prev = this->head;
+        for (node = runs[0]; node != 0; node = node->next) {
+            prev->next = node;
+            node->prev = prev;
+            prev = node;
+        }
+        prev->next = this->tail;
+        this->tail->prev = prev;
+    }
     
 protected:
+    typedef typename DLinkedList<T>::Node Node;
+
+    /*
+    ! sortRuns: sorts the runs concurrently, then merges them until runs[0] holds the whole chain
+    */
+    static void sortRuns(std::vector<Node*>& runs, std::vector<int>& lengths, int (*comparator)(T&,T&), ThreadPool* workers) {
+        int nruns = (int)runs.size();
+        // Sort the runs concurrently
+        ThreadPool::TaskGroup sorts;
+        for (int run = 0; run < nruns; run++) {
+            workers->submit([&runs, &lengths, run, comparator](){
+                Node* first = runs[run];
+                runs[run] = sortNodes(first, lengths[run], comparator);
+            }, sorts);
+        }
+        workers->wait(sorts);
+
+        // Merge neighbouring runs until one is left
+        while (runs.size() > 1) {
+            ThreadPool::TaskGroup merges;
+            std::vector<Node*> merged((runs.size() + 1) / 2);
+            for (size_t run = 0; run < runs.size(); run += 2) {
+                if (run + 1 == runs.size()) {
+                    merged[run / 2] = runs[run];
+                    continue;
+                }
+                workers->submit([&runs, &merged, run, comparator](){
+                    merged[run / 2] = mergeNodes(runs[run], runs[run + 1], comparator);
+                }, merges);
+            }
+            workers->wait(merges);
+            runs.swap(merged);
+        }
+    }
+
+    /*
+    ! sortNodes(first, n, comparator)
+    ? Functionality:
+        * Merge-sorts the n nodes starting at "first" by relinking "next" only;
+        * advances "first" past them and returns the sorted, null-terminated chain.
+    */
+    static Node* sortNodes(Node*& first, int n, int (*comparator)(T&,T&)){
+        if (n == 1) {
+            Node* node = first;
+            first = first->next;
+            node->next = 0;
+            return node;
+        }
+        Node* left = sortNodes(first, n / 2, comparator);
+        Node* right = sortNodes(first, n - n / 2, comparator);
+        return mergeNodes(left, right, comparator);
+    }
+
+    /*
+    ! mergeNodes: stable merge of two null-terminated chains (ties from "left" first)
+    */
+    static Node* mergeNodes(Node* left, Node* right, int (*comparator)(T&,T&)){
+        Node* result = 0;
+        Node** last = &result;
+        while (left != 0 && right != 0) {
+            if (compare(left->data, right->data, comparator) <= 0) {
+                *last = left;
+                left = left->next;
+            } else {
+                *last = right;
+                right = right->next;
+            }
+            last = &((*last)->next);
+        }
+        *last = (left != 0) ? left : right;
+        return result;
+    }
+
+
     static int compare(T& lhs, T& rhs, int (*comparator)(T&,T&)=0){
         if(comparator != 0) return comparator(lhs, rhs);
         else{
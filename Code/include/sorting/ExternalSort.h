@@ -0,0 +1,402 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines ExternalSort: an out-of-core merge sort for row streams larger than RAM
+*/
+
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+#include <iostream>
+#include "sorting/ISort.h"
+#include "sorting/IntroSort.h"
+#include "heap/Heap.h"
+#include "loader/RowStream.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+using namespace std;
+
+/*
+! ExternalSort<T>
+? Functionality:
+    * Sorts a stream of rows (width values of T each) that may be far larger than memory:
+        1. run formation: read as many rows as fit in memoryBudget, sort them with
+           IntroSort, write the sorted run to a temporary file;
+        2. k-way merge: a Heap holds the current row of every run; each run is read
+           through its own buffer, the output through one more.
+          When there are more runs than buffers of MIN_BUFFER bytes fit in the
+          budget, runs are merged in groups first (multi-pass merge); every pass
+          keeps the runs in input order.
+    * The sort is stable: rows that compare equal keep their input order. Chunks
+      are sorted through (key, row index) pairs with the index as the last key
+      (plain values only for integers in natural order, where equal means
+      identical), and the merge gives ties to the earlier run.
+    * If the whole input fits in one run, nothing is spilled to disk.
+    * Works on any IRowReader/IRowWriter; sortBinaryFile and sortNpyFile wrap the
+      raw record and .npy formats of loader/RowStream.h.
+? Parameters:
+    * memoryBudget: bytes used for row buffers (run formation and merge).
+    * keyColumn:    column compared; ALL_COLUMNS compares rows lexicographically.
+    * comparator:   compares two values of a column; 0 means operator <.
+    * unique:       keep only the first (in input order) of rows that compare equal
+                    (like "sort -u").
+    * tempDir:      where the runs are written; they are removed when no longer needed.
+? Usage:
+    * ExternalSort<float> sorter(256LL << 20, 0);          //rows sorted by column 0
+    * sorter.sortNpyFile("train.npy", "train_sorted.npy");
+*/
+template<class T>
+class ExternalSort{
+    static_assert(std::is_trivially_copyable<T>::value, "ExternalSort: T must be trivially copyable");
+public:
+    static const long long DEFAULT_MEMORY = 64LL << 20;
+    static const long long MIN_BUFFER = 64LL << 10;
+    static const int ALL_COLUMNS = -1;
+
+protected:
+    long long memoryBudget;
+    int keyColumn;
+    int (*comparator)(T&,T&);
+    bool unique;
+    string tempDir;
+
+    int width;          //of the stream being sorted
+    vector<string> runs;
+    int tempCounter;
+    int runCount;       //statistics of the last sort
+    int mergePasses;
+
+public:
+    ExternalSort(long long memoryBudget=DEFAULT_MEMORY, int keyColumn=ALL_COLUMNS,
+            int (*comparator)(T&,T&)=0, bool unique=false, string tempDir="."){
+        this->memoryBudget = memoryBudget;
+        this->keyColumn = keyColumn;
+        this->comparator = comparator;
+        this->unique = unique;
+        this->tempDir = tempDir;
+        this->width = 1;
+        this->tempCounter = 0;
+        this->runCount = 0;
+        this->mergePasses = 0;
+    }
+    ~ExternalSort(){
+        removeRuns(0, runs.size());
+    }
+    ExternalSort(const ExternalSort&) = delete;
+    ExternalSort& operator=(const ExternalSort&) = delete;
+
+    /*
+    ! sort(reader, writer): sorts every row of reader into writer; returns the rows written
+    * Exception: std::runtime_error on I/O errors (temporary files are removed)
+    */
+    long long sort(IRowReader<T>& reader, IRowWriter<T>& writer){
+        width = reader.width();
+        if(writer.width() != width) throw std::runtime_error("ExternalSort: reader and writer widths differ");
+        if(keyColumn >= width) throw std::runtime_error("ExternalSort: key column out of range");
+        runCount = 0;
+        mergePasses = 0;
+        try{
+            long long written = makeRuns(reader, writer);
+            if(written >= 0) return written;
+
+            long long fanIn = memoryBudget / MIN_BUFFER - 1;
+            if(fanIn < 2) fanIn = 2;
+            //one pass merges runs[begin .. end) group by group into runs appended in the same order
+            size_t begin = 0;
+            while(runs.size() - begin > (size_t)fanIn){
+                size_t end = runs.size();
+                for(size_t first=begin; first < end; first += fanIn){
+                    size_t last = first + fanIn < end ? first + fanIn : end;
+                    if(last - first == 1){
+                        string carried = runs[first];
+                        runs[first].clear();
+                        runs.push_back(carried);
+                        continue;
+                    }
+                    string merged = newRunName();
+                    runs.push_back(merged);
+                    {
+                        BinaryRowWriter<T> out(merged, width);
+                        mergeRuns(first, last, out);
+                    }
+                    removeRuns(first, last);
+                }
+                begin = end;
+                mergePasses++;
+            }
+            written = mergeRuns(begin, runs.size(), writer);
+            mergePasses++;
+            removeRuns(begin, runs.size());
+            runs.clear();
+            return written;
+        }
+        catch(...){
+            removeRuns(0, runs.size());
+            runs.clear();
+            throw;
+        }
+    }
+
+    long long sortBinaryFile(string inPath, string outPath, int width=1){
+        BinaryRowReader<T> reader(inPath, width);
+        BinaryRowWriter<T> writer(outPath, width);
+        long long written = sort(reader, writer);
+        writer.close();
+        return written;
+    }
+
+    long long sortNpyFile(string inPath, string outPath){
+        NpyRowReader<T> reader(inPath);
+        NpyRowWriter<T> writer(outPath, reader.width(), reader.getHeader().shape.size() == 1);
+        long long written = sort(reader, writer);
+        writer.close();
+        return written;
+    }
+
+    int getRunCount(){
+        return runCount;
+    }
+    int getMergePasses(){
+        return mergePasses;
+    }
+
+    /*
+    ! compareRows(a, b): < 0 if row a goes first (key column, or all columns in order)
+    */
+    int compareRows(const T* a, const T* b) const {
+        int begin = keyColumn < 0 ? 0 : keyColumn;
+        int end = keyColumn < 0 ? width : keyColumn + 1;
+        for(int col=begin; col < end; col++){
+            T& x = const_cast<T&>(a[col]);
+            T& y = const_cast<T&>(b[col]);
+            int result = comparator ? comparator(x, y) : (x < y ? -1 : (y < x ? +1 : 0));
+            if(result != 0) return result;
+        }
+        return 0;
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+protected:
+    /*
+    ! RunReader: one sorted run, read through a buffer of "capacity" rows
+    */
+    class RunReader{
+    public:
+        BinaryRowReader<T> reader;
+        vector<T> buffer;
+        long long capacity, count, cursor;
+        int width;
+        RunReader(string path, int width, long long capacity):
+            reader(path, width), buffer(capacity * width), capacity(capacity), count(0), cursor(0), width(width){}
+        //the current row, or 0 when the run is exhausted
+        const T* current(){
+            if(cursor == count){
+                count = reader.read(buffer.data(), capacity);
+                cursor = 0;
+                if(count == 0) return 0;
+            }
+            return buffer.data() + cursor * width;
+        }
+        void advance(){
+            cursor++;
+        }
+    };
+
+    /*
+    ! BufferedWriter: groups rows into blocks before handing them to an IRowWriter
+    */
+    class BufferedWriter{
+    public:
+        IRowWriter<T>* writer;
+        vector<T> buffer;
+        long long capacity, count;
+        int width;
+        BufferedWriter(IRowWriter<T>* writer, int width, long long capacity):
+            writer(writer), buffer(capacity * width), capacity(capacity), count(0), width(width){}
+        void write(const T* row){
+            std::copy(row, row + width, buffer.data() + count * width);
+            if(++count == capacity) flush();
+        }
+        void flush(){
+            if(count > 0) writer->write(buffer.data(), count);
+            count = 0;
+        }
+    };
+
+    //heap entry: the current row of one run
+    struct MergeHead{
+        const T* row;
+        int run;
+        const ExternalSort<T>* owner;
+        //Heap<T> instantiates its operator-based fallbacks and toString, so provide them
+        bool operator<(const MergeHead& other) const { return compareHeads(*this, other) < 0; }
+        bool operator>(const MergeHead& other) const { return compareHeads(*this, other) > 0; }
+        bool operator==(const MergeHead& other) const { return row == other.row; }
+        friend ostream& operator<<(ostream& os, const MergeHead& head){ return os << "run " << head.run; }
+    };
+    //ties go to the earlier run, so equal rows keep the order of their runs
+    static int compareHeads(const MergeHead& a, const MergeHead& b){
+        int result = a.owner->compareRows(a.row, b.row);
+        return result != 0 ? result : a.run - b.run;
+    }
+
+    static int compareHeadsRef(MergeHead& a, MergeHead& b){
+        return compareHeads(a, b);
+    }
+
+    //rows sorted through (key, row index) pairs: they stay in cache, and the index breaks ties
+    struct KeyIndex{
+        T key;
+        int index;
+    };
+    struct KeyIndexLess{
+        const ExternalSort<T>* owner;
+        const T* rows;
+        bool operator()(KeyIndex& a, KeyIndex& b) const {
+            int result = owner->comparator ? owner->comparator(a.key, b.key)
+                                           : (a.key < b.key ? -1 : (b.key < a.key ? +1 : 0));
+            if(result == 0 && owner->keyColumn < 0 && owner->width > 1){
+                //lexicographic order: the first columns tie, look at the whole rows
+                long long w = owner->width;
+                result = owner->compareRows(rows + a.index * w, rows + b.index * w);
+            }
+            return result != 0 ? result < 0 : a.index < b.index;
+        }
+    };
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (protected) METHOD DEFNITION ////////////////
+//////////////////////////////////////////////////////////////////////
+    string newRunName(){
+        long long stamp = chrono::steady_clock::now().time_since_epoch().count();
+        return tempDir + "/extsort_" + to_string((uintptr_t)this) + "_" + to_string(stamp)
+                + "_" + to_string(tempCounter++) + ".run";
+    }
+
+    void removeRuns(size_t first, size_t last){
+        for(size_t idx=first; idx < last && idx < runs.size(); idx++)
+            if(!runs[idx].empty()){
+                std::remove(runs[idx].c_str());
+                runs[idx].clear();
+            }
+    }
+
+    /*
+    ! makeRuns: phase 1. Returns the number of rows written if the input fit in a
+    * single run (then it went straight to "writer"), -1 if runs were spilled.
+    */
+    long long makeRuns(IRowReader<T>& reader, IRowWriter<T>& writer){
+        //equal integers in natural order are identical: sorting the values directly is stable enough
+        bool indexed = width > 1 || comparator != 0 || !std::is_integral<T>::value;
+        long long rowBytes = (long long)sizeof(T) * width;
+        long long perRow = rowBytes + (indexed ? (long long)sizeof(KeyIndex) : 0);
+        long long chunkRows = memoryBudget / perRow;
+        if(chunkRows < 1) chunkRows = 1;
+        if(chunkRows > 0x7FFFFFFF) chunkRows = 0x7FFFFFFF;
+
+        vector<T> chunk(chunkRows * width);
+        vector<KeyIndex> order(indexed ? chunkRows : 0);
+        const KeyIndex* sorted = indexed ? order.data() : 0;
+        while(true){
+            long long n = 0, got;
+            while(n < chunkRows && (got = reader.read(chunk.data() + n * width, chunkRows - n)) > 0) n += got;
+            if(n == 0) break;
+            runCount++;
+
+            if(!indexed){
+                typename IntroSort<T>::OperatorLess less;
+                IntroSort<T>::sortRange(chunk.data(), chunk.data() + n, less);
+            }
+            else{
+                int key = keyColumn < 0 ? 0 : keyColumn;
+                for(int idx=0; idx < n; idx++) order[idx] = KeyIndex{chunk[(long long)idx * width + key], idx};
+                KeyIndexLess less = {this, chunk.data()};
+                IntroSort<KeyIndex>::sortRange(order.data(), order.data() + n, less);
+            }
+
+            bool last = n < chunkRows;
+            bool single = last && runs.empty();
+            if(single) return writeChunk(chunk.data(), sorted, n, writer);
+
+            runs.push_back(newRunName());
+            BinaryRowWriter<T> out(runs.back(), width);
+            writeChunk(chunk.data(), sorted, n, out);
+            out.close();
+            if(last) break;
+        }
+        if(runs.empty()) return 0;
+        return -1;
+    }
+
+    //writes a sorted chunk (through "order" unless it is null), dropping duplicates if unique
+    long long writeChunk(const T* chunk, const KeyIndex* order, long long n, IRowWriter<T>& writer){
+        long long blockRows = MIN_BUFFER / ((long long)sizeof(T) * width) + 1;
+        BufferedWriter out(&writer, width, blockRows);
+        const T* previous = 0;
+        long long written = 0;
+        for(long long idx=0; idx < n; idx++){
+            const T* row = chunk + (order != 0 ? (long long)order[idx].index : idx) * width;
+            if(unique && previous != 0 && compareRows(previous, row) == 0) continue;
+            out.write(row);
+            previous = row;
+            written++;
+        }
+        out.flush();
+        return written;
+    }
+
+    /*
+    ! mergeRuns(first, last, writer): phase 2 on runs[first .. last)
+    */
+    long long mergeRuns(size_t first, size_t last, IRowWriter<T>& writer){
+        long long nruns = last - first;
+        long long rowBytes = (long long)sizeof(T) * width;
+        long long bufferRows = memoryBudget / (nruns + 1) / rowBytes;
+        if(bufferRows < 1) bufferRows = 1;
+
+        vector<RunReader*> readers;
+        Heap<MergeHead> heap(&compareHeadsRef);
+        BufferedWriter out(&writer, width, bufferRows);
+        vector<T> previous(width);
+        bool hasPrevious = false;
+        long long written = 0;
+        try{
+            for(size_t idx=first; idx < last; idx++){
+                readers.push_back(new RunReader(runs[idx], width, bufferRows));
+                const T* row = readers.back()->current();
+                if(row != 0) heap.push(MergeHead{row, (int)readers.size() - 1, this});
+            }
+            while(!heap.empty()){
+                MergeHead head = heap.pop();
+                if(!(unique && hasPrevious && compareRows(previous.data(), head.row) == 0)){
+                    out.write(head.row);
+                    written++;
+                    if(unique){
+                        std::copy(head.row, head.row + width, previous.begin());
+                        hasPrevious = true;
+                    }
+                }
+                RunReader* reader = readers[head.run];
+                reader->advance();
+                const T* row = reader->current();
+                if(row != 0) heap.push(MergeHead{row, head.run, this});
+            }
+            out.flush();
+        }
+        catch(...){
+            for(RunReader* reader: readers) delete reader;
+            throw;
+        }
+        for(RunReader* reader: readers) delete reader;
+        return written;
+    }
+};
+
+#endif /* EXTERNALSORT_H */
@@ -0,0 +1,432 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines IntroSort: a pattern-defeating introsort over raw arrays
+*/
+
+#ifndef INTROSORT_H
+#define INTROSORT_H
+#include "sorting/ISort.h"
+#include "sorting/SortingNetwork.h"
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+/*
+! IntroSort<T>
+? Functionality:
+    * In-place, unstable, O(n log n) worst-case array sort implementing ISort<T>.
+    * Quicksort core (pattern-defeating variant):
+        * pivot: median-of-3, or Tukey's ninther for ranges larger than NINTHER_THRESHOLD
+        * partition: branchless block partitioning (BlockQuicksort), the comparison
+          result is used as an index increment instead of a branch
+        * equal keys: when the pivot equals the element before the range, equal keys are
+          swept to the left in one pass, so many-duplicate inputs run in O(n log k)
+        * sorted / reversed runs: detected after a balanced partition and finished
+          with a bounded insertion sort
+    * Ranges shorter than insertionThreshold (at least MIN_INSERTION_THRESHOLD) are
+      finished with insertion sort; for int32, float and double in natural order
+      (comparator 0 or compare4Ascending) ranges of up to SortingNetwork<T>::MAX_SIZE
+      items are finished with a SIMD sorting network instead.
+    * After log2(n) highly unbalanced partitions (adversarial input) the range falls
+      back to heap sort, which bounds the worst case.
+? Comparator:
+    * Same contract as every ISort<T>: comparator(lhs, rhs) < 0 means lhs goes first.
+    * comparator == 0: T must support operator <.
+? Usage:
+    * IntroSort<int> sortAlg;
+    * sortAlg.sort(values, n, &SortSimpleOrder<int>::compare4Ascending);
+*/
+template<class T>
+class IntroSort: public ISort<T>{
+public:
+    static const int INSERTION_SORT_THRESHOLD = 24;
+    static const int NINTHER_THRESHOLD = 128;
+    static const int PARTIAL_INSERTION_SORT_LIMIT = 8;
+    static const int BLOCK_SIZE = 64;
+    //pattern breaking swaps items size/4 apart: a range needs 4 items for a nonzero step
+    static const int MIN_INSERTION_THRESHOLD = 4;
+
+protected:
+    int insertionThreshold;
+
+public:
+    IntroSort(int insertionThreshold=INSERTION_SORT_THRESHOLD){
+        if(insertionThreshold < MIN_INSERTION_THRESHOLD) insertionThreshold = MIN_INSERTION_THRESHOLD;
+        this->insertionThreshold = insertionThreshold;
+    }
+
+    void sort(T array[], int size, int (*comparator)(T&,T&) =0){
+        if(array == 0 || size < 2) return;
+        if(comparator == 0 || comparator == &SortSimpleOrder<T>::compare4Ascending){
+            OperatorLess less;
+            sortRange(array, array + size, less, insertionThreshold);
+        }
+        else{
+            ComparatorLess less(comparator);
+            sortRange(array, array + size, less, insertionThreshold);
+        }
+    }
+
+    /*
+    ! sortRange(begin, end, less, insertionThreshold)
+    ? Functionality:
+        * Sorts [begin, end) with a "less" functor: bool less(T& lhs, T& rhs).
+        * Used by the other array sorts in this folder to sort their chunks/buckets
+          without going back through the comparator function pointer.
+    */
+    template<class Less>
+    static void sortRange(T* begin, T* end, Less& less,
+            int insertionThreshold=INSERTION_SORT_THRESHOLD){
+        if(end - begin < 2) return;
+        if(insertionThreshold < MIN_INSERTION_THRESHOLD) insertionThreshold = MIN_INSERTION_THRESHOLD;
+        introLoop(begin, end, less, log2(end - begin), true, insertionThreshold);
+    }
+
+    /*
+    ! heapSort(begin, end, less)
+    ? Functionality:
+        * The O(n log n) fallback for adversarial inputs; also usable on its own.
+    */
+    template<class Less>
+    static void heapSort(T* begin, T* end, Less& less){
+        ptrdiff_t n = end - begin;
+        for(ptrdiff_t idx = n/2 - 1; idx >= 0; idx--) siftDown(begin, idx, n, less);
+        for(ptrdiff_t last = n - 1; last > 0; last--){
+            std::swap(begin[0], begin[last]);
+            siftDown(begin, 0, last, less);
+        }
+    }
+
+    template<class Less>
+    static void insertionSort(T* begin, T* end, Less& less){
+        if(begin == end) return;
+        for(T* cur = begin + 1; cur != end; ++cur){
+            T* sift = cur;
+            T* sift_1 = cur - 1;
+            if(less(*sift, *sift_1)){
+                T tmp = std::move(*sift);
+                do { *sift-- = std::move(*sift_1); }
+                while(sift != begin && less(tmp, *--sift_1));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+public:
+    struct OperatorLess{
+        bool operator()(T& lhs, T& rhs) const { return lhs < rhs; }
+    };
+    struct ComparatorLess{
+        int (*comparator)(T&,T&);
+        ComparatorLess(int (*comparator)(T&,T&)): comparator(comparator){}
+        bool operator()(T& lhs, T& rhs) const { return comparator(lhs, rhs) < 0; }
+    };
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (protected) METHOD DEFNITION ////////////////
+//////////////////////////////////////////////////////////////////////
+protected:
+    //the network base case only knows the natural ascending order
+    template<class Less>
+    static constexpr bool useNetwork(){
+        return SortingNetwork<T>::supported && std::is_same<Less, OperatorLess>::value;
+    }
+
+    static int log2(ptrdiff_t n){
+        int log = 0;
+        while(n >>= 1) log++;
+        return log;
+    }
+
+    template<class Less>
+    static void siftDown(T* heap, ptrdiff_t position, ptrdiff_t count, Less& less){
+        T item = std::move(heap[position]);
+        ptrdiff_t child = 2*position + 1;
+        while(child < count){
+            if(child + 1 < count && less(heap[child], heap[child + 1])) child++;
+            if(!less(item, heap[child])) break;
+            heap[position] = std::move(heap[child]);
+            position = child;
+            child = 2*position + 1;
+        }
+        heap[position] = std::move(item);
+    }
+
+    /*
+    ! unguardedInsertionSort: *(begin - 1) must not be greater than any element in the range,
+    * so the inner loop needs no bound check.
+    */
+    template<class Less>
+    static void unguardedInsertionSort(T* begin, T* end, Less& less){
+        if(begin == end) return;
+        for(T* cur = begin + 1; cur != end; ++cur){
+            T* sift = cur;
+            T* sift_1 = cur - 1;
+            if(less(*sift, *sift_1)){
+                T tmp = std::move(*sift);
+                do { *sift-- = std::move(*sift_1); }
+                while(less(tmp, *--sift_1));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    /*
+    ! partialInsertionSort: insertion sort that gives up after PARTIAL_INSERTION_SORT_LIMIT moves;
+    * returns true if the range ended up sorted.
+    */
+    template<class Less>
+    static bool partialInsertionSort(T* begin, T* end, Less& less){
+        if(begin == end) return true;
+        ptrdiff_t limit = 0;
+        for(T* cur = begin + 1; cur != end; ++cur){
+            T* sift = cur;
+            T* sift_1 = cur - 1;
+            if(less(*sift, *sift_1)){
+                T tmp = std::move(*sift);
+                do { *sift-- = std::move(*sift_1); }
+                while(sift != begin && less(tmp, *--sift_1));
+                *sift = std::move(tmp);
+                limit += cur - sift;
+            }
+            if(limit > PARTIAL_INSERTION_SORT_LIMIT) return false;
+        }
+        return true;
+    }
+
+    template<class Less>
+    static void sort2(T* a, T* b, Less& less){
+        if(less(*b, *a)) std::swap(*a, *b);
+    }
+    template<class Less>
+    static void sort3(T* a, T* b, T* c, Less& less){
+        sort2(a, b, less);
+        sort2(b, c, less);
+        sort2(a, b, less);
+    }
+
+    /*
+    ! swapOffsets: exchange the misplaced elements recorded by the two offset blocks.
+    * useSwaps keeps descending inputs linear (plain swaps); otherwise a cyclic
+    * permutation saves one move per pair.
+    */
+    static void swapOffsets(T* first, T* last,
+            unsigned char* offsetsL, unsigned char* offsetsR,
+            size_t num, bool useSwaps){
+        if(useSwaps){
+            for(size_t idx = 0; idx < num; idx++)
+                std::swap(*(first + offsetsL[idx]), *(last - offsetsR[idx]));
+        }
+        else if(num > 0){
+            T* l = first + offsetsL[0];
+            T* r = last - offsetsR[0];
+            T tmp(std::move(*l));
+            *l = std::move(*r);
+            for(size_t idx = 1; idx < num; idx++){
+                l = first + offsetsL[idx]; *r = std::move(*l);
+                r = last - offsetsR[idx];  *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
+    }
+
+    /*
+    ! partitionRight: pivot is *begin; elements < pivot go left, elements >= pivot go right.
+    * Returns the final pivot position and whether the range was already partitioned.
+    */
+    template<class Less>
+    static std::pair<T*, bool> partitionRight(T* begin, T* end, Less& less){
+        T pivot(std::move(*begin));
+        T* first = begin;
+        T* last = end;
+
+        //median-of-3 guarantees an element >= pivot exists on the right
+        while(less(*++first, pivot));
+        if(first - 1 == begin) while(first < last && !less(*--last, pivot));
+        else                   while(!less(*--last, pivot));
+
+        bool alreadyPartitioned = first >= last;
+        if(!alreadyPartitioned){
+            std::swap(*first, *last);
+            ++first;
+
+            unsigned char offsetsL[BLOCK_SIZE];
+            unsigned char offsetsR[BLOCK_SIZE];
+            T* offsetsLBase = first;
+            T* offsetsRBase = last;
+            size_t numL = 0, numR = 0, startL = 0, startR = 0;
+
+            while(first < last){
+                size_t numUnknown = last - first;
+                size_t leftSplit = numL == 0 ? (numR == 0 ? numUnknown / 2 : numUnknown) : 0;
+                size_t rightSplit = numR == 0 ? (numUnknown - leftSplit) : 0;
+
+                //record (branch-free) the positions of elements on the wrong side
+                if(leftSplit >= (size_t)BLOCK_SIZE) leftSplit = BLOCK_SIZE;
+                for(size_t idx = 0; idx < leftSplit;){
+                    offsetsL[numL] = (unsigned char)idx++;
+                    numL += !less(*first, pivot);
+                    ++first;
+                }
+                if(rightSplit >= (size_t)BLOCK_SIZE) rightSplit = BLOCK_SIZE;
+                for(size_t idx = 0; idx < rightSplit;){
+                    offsetsR[numR] = (unsigned char)++idx;
+                    numR += less(*--last, pivot);
+                }
+
+                size_t num = numL < numR ? numL : numR;
+                swapOffsets(offsetsLBase, offsetsRBase,
+                        offsetsL + startL, offsetsR + startR, num, numL == numR);
+                numL -= num; numR -= num;
+                startL += num; startR += num;
+                if(numL == 0){
+                    startL = 0;
+                    offsetsLBase = first;
+                }
+                if(numR == 0){
+                    startR = 0;
+                    offsetsRBase = last;
+                }
+            }
+
+            //at most one block still holds misplaced elements: move them next to the boundary
+            if(numL){
+                unsigned char* offsets = offsetsL + startL;
+                while(numL--) std::swap(*(offsetsLBase + offsets[numL]), *--last);
+                first = last;
+            }
+            if(numR){
+                unsigned char* offsets = offsetsR + startR;
+                while(numR--){
+                    std::swap(*(offsetsRBase - offsets[numR]), *first);
+                    ++first;
+                }
+                last = first;
+            }
+        }
+
+        T* pivotPos = first - 1;
+        *begin = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return std::pair<T*, bool>(pivotPos, alreadyPartitioned);
+    }
+
+    /*
+    ! partitionLeft: elements <= pivot go left; used when the pivot equals *(begin - 1),
+    * i.e. the whole left part is a run of equal keys and is already in place.
+    */
+    template<class Less>
+    static T* partitionLeft(T* begin, T* end, Less& less){
+        T pivot(std::move(*begin));
+        T* first = begin;
+        T* last = end;
+
+        while(less(pivot, *--last));
+        if(last + 1 == end) while(first < last && !less(pivot, *++first));
+        else                while(!less(pivot, *++first));
+
+        while(first < last){
+            std::swap(*first, *last);
+            while(less(pivot, *--last));
+            while(!less(pivot, *++first));
+        }
+
+        T* pivotPos = last;
+        *begin = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return pivotPos;
+    }
+
+    /*
+    ! introLoop: recurse on the left partition, loop on the right one.
+    * badAllowed: number of highly unbalanced partitions tolerated before heap sort.
+    * leftmost:   false if *(begin - 1) is a valid sentinel (unguarded insertion sort).
+    */
+    template<class Less>
+    static void introLoop(T* begin, T* end, Less& less,
+            int badAllowed, bool leftmost, int insertionThreshold){
+        while(true){
+            ptrdiff_t size = end - begin;
+            if constexpr (useNetwork<Less>()){
+                if(size <= SortingNetwork<T>::MAX_SIZE){
+                    SortingNetwork<T>::sort(begin, (int)size);
+                    return;
+                }
+            }
+            if(size < insertionThreshold){
+                if(leftmost) insertionSort(begin, end, less);
+                else unguardedInsertionSort(begin, end, less);
+                return;
+            }
+
+            //pivot: median-of-3 or ninther, moved to *begin
+            ptrdiff_t s2 = size / 2;
+            if(size > NINTHER_THRESHOLD){
+                sort3(begin, begin + s2, end - 1, less);
+                sort3(begin + 1, begin + (s2 - 1), end - 2, less);
+                sort3(begin + 2, begin + (s2 + 1), end - 3, less);
+                sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), less);
+                std::swap(*begin, *(begin + s2));
+            }
+            else sort3(begin + s2, begin, end - 1, less);
+
+            //pivot equals the previous partition's pivot => sweep the equal run aside
+            if(!leftmost && !less(*(begin - 1), *begin)){
+                begin = partitionLeft(begin, end, less) + 1;
+                continue;
+            }
+
+            std::pair<T*, bool> part = partitionRight(begin, end, less);
+            T* pivotPos = part.first;
+            bool alreadyPartitioned = part.second;
+
+            ptrdiff_t lSize = pivotPos - begin;
+            ptrdiff_t rSize = end - (pivotPos + 1);
+            bool highlyUnbalanced = lSize < size / 8 || rSize < size / 8;
+
+            if(highlyUnbalanced){
+                if(--badAllowed == 0){
+                    heapSort(begin, end, less);
+                    return;
+                }
+                //break the pattern that produced the bad pivot
+                if(lSize >= insertionThreshold){
+                    std::swap(*begin, *(begin + lSize / 4));
+                    std::swap(*(pivotPos - 1), *(pivotPos - lSize / 4));
+                    if(lSize > NINTHER_THRESHOLD){
+                        std::swap(*(begin + 1), *(begin + (lSize / 4 + 1)));
+                        std::swap(*(begin + 2), *(begin + (lSize / 4 + 2)));
+                        std::swap(*(pivotPos - 2), *(pivotPos - (lSize / 4 + 1)));
+                        std::swap(*(pivotPos - 3), *(pivotPos - (lSize / 4 + 2)));
+                    }
+                }
+                if(rSize >= insertionThreshold){
+                    std::swap(*(pivotPos + 1), *(pivotPos + (1 + rSize / 4)));
+                    std::swap(*(end - 1), *(end - rSize / 4));
+                    if(rSize > NINTHER_THRESHOLD){
+                        std::swap(*(pivotPos + 2), *(pivotPos + (2 + rSize / 4)));
+                        std::swap(*(pivotPos + 3), *(pivotPos + (3 + rSize / 4)));
+                        std::swap(*(end - 2), *(end - (1 + rSize / 4)));
+                        std::swap(*(end - 3), *(end - (2 + rSize / 4)));
+                    }
+                }
+            }
+            else{
+                //balanced and nothing moved: probably (nearly) sorted already
+                if(alreadyPartitioned
+                        && partialInsertionSort(begin, pivotPos, less)
+                        && partialInsertionSort(pivotPos + 1, end, less)) return;
+            }
+
+            introLoop(begin, pivotPos, less, badAllowed, leftmost, insertionThreshold);
+            begin = pivotPos + 1;
+            leftmost = false;
+        }
+    }
+};
+
+#endif /* INTROSORT_H */
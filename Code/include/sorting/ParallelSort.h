@@ -0,0 +1,188 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines ParallelMergeSort: a multi-threaded array sort on a ThreadPool
+*/
+
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+#include "sorting/ISort.h"
+#include "sorting/IntroSort.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+! ParallelMergeSort<T>
+? Functionality:
+    * Implements ISort<T> on top of a ThreadPool:
+        1. the array is cut into one run per worker, each run is sorted by IntroSort;
+        2. runs are merged pairwise, log2(#runs) rounds, ping-ponging with one buffer.
+          Each pairwise merge is cut into equal slices with merge-path co-ranking,
+          so every worker stays busy in the last rounds as well.
+    * Arrays shorter than minParallelSize are sorted by IntroSort on the caller's thread.
+    * Each round waits on its own ThreadPool::TaskGroup, not on the whole pool: the
+      pool may be shared with other work, and sort() may be called from a pool task.
+    * An exception thrown by the comparator is rethrown by sort() once the round's
+      other tasks are finished; the array is then left in a valid but unspecified state.
+? Parameters:
+    * pool: workers to use; if 0, a private pool of "nthreads" threads is created.
+? Usage:
+    * ThreadPool pool(8);
+    * ParallelMergeSort<int> sortAlg(&pool);
+    * sortAlg.sort(values, n);
+*/
+template<class T>
+class ParallelMergeSort: public ISort<T>{
+public:
+    static const int MIN_PARALLEL_SIZE = 1 << 14;
+
+protected:
+    ThreadPool* pool;
+    bool ownPool;
+    int minParallelSize;
+
+public:
+    ParallelMergeSort(ThreadPool* pool=0, int nthreads=0, int minParallelSize=MIN_PARALLEL_SIZE){
+        this->ownPool = (pool == 0);
+        this->pool = ownPool ? new ThreadPool(nthreads) : pool;
+        this->minParallelSize = minParallelSize;
+    }
+    ~ParallelMergeSort(){
+        if(ownPool) delete pool;
+    }
+    ParallelMergeSort(const ParallelMergeSort&) = delete;
+    ParallelMergeSort& operator=(const ParallelMergeSort&) = delete;
+
+    ThreadPool* getPool(){
+        return pool;
+    }
+
+    void sort(T array[], int size, int (*comparator)(T&,T&) =0){
+        if(array == 0 || size < 2) return;
+        if(comparator == 0){
+            typename IntroSort<T>::OperatorLess less;
+            sortRange(array, size, less);
+        }
+        else{
+            typename IntroSort<T>::ComparatorLess less(comparator);
+            sortRange(array, size, less);
+        }
+    }
+
+    /*
+    ! sortRange(array, size, less): same as sort(), with a "less" functor
+    */
+    template<class Less>
+    void sortRange(T* array, long long size, Less& less){
+        int nruns = pool->size();
+        if(size < minParallelSize || nruns < 2){
+            IntroSort<T>::sortRange(array, array + size, less);
+            return;
+        }
+
+        //1. sort one run per worker
+        vector<long long> bounds(nruns + 1);
+        for(int run=0; run <= nruns; run++) bounds[run] = size * run / nruns;
+        ThreadPool::TaskGroup sorts;
+        for(int run=0; run < nruns; run++){
+            T* lo = array + bounds[run];
+            T* hi = array + bounds[run + 1];
+            pool->submit([lo, hi, &less](){ IntroSort<T>::sortRange(lo, hi, less); }, sorts);
+        }
+        pool->wait(sorts);
+
+        //2. merge rounds
+        std::unique_ptr<T[]> buffer(new T[size]);
+        T* src = array;
+        T* dst = buffer.get();
+        long long slice = size / pool->size() + 1;
+        while(bounds.size() > 2){
+            ThreadPool::TaskGroup round;
+            vector<long long> next;
+            for(size_t run=0; run + 1 < bounds.size(); run += 2){
+                long long lo = bounds[run];
+                if(run + 2 >= bounds.size()){
+                    //odd run out: copy it across
+                    long long hi = bounds[run + 1];
+                    submitCopy(src + lo, src + hi, dst + lo, slice, round);
+                    next.push_back(lo);
+                    continue;
+                }
+                long long mid = bounds[run + 1];
+                long long hi = bounds[run + 2];
+                submitMerge(src + lo, mid - lo, src + mid, hi - mid, dst + lo, slice, less, round);
+                next.push_back(lo);
+            }
+            next.push_back(size);
+            pool->wait(round);
+            bounds.swap(next);
+            std::swap(src, dst);
+        }
+        if(src != array){
+            ThreadPool::TaskGroup copies;
+            submitCopy(src, src + size, array, slice, copies);
+            pool->wait(copies);
+        }
+    }
+
+    /*
+    ! coRank(k, a, m, b, n, less)
+    ? Functionality:
+        * Returns i such that the first k elements of the stable merge of a[0..m) and
+          b[0..n) are a[0..i) and b[0..k-i) (ties are taken from a first).
+    */
+    template<class Less>
+    static long long coRank(long long k, T* a, long long m, T* b, long long n, Less& less){
+        long long lo = k > n ? k - n : 0;
+        long long hi = k < m ? k : m;
+        while(lo < hi){
+            long long mid = lo + (hi - lo) / 2;
+            long long j = k - mid;
+            if(j > 0 && !less(b[j - 1], a[mid])) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    /*
+    ! merge: sequential stable merge of a[0..m) and b[0..n) into out
+    */
+    template<class Less>
+    static void merge(T* a, long long m, T* b, long long n, T* out, Less& less){
+        T* aEnd = a + m;
+        T* bEnd = b + n;
+        while(a != aEnd && b != bEnd){
+            if(less(*b, *a)) *out++ = std::move(*b++);
+            else *out++ = std::move(*a++);
+        }
+        while(a != aEnd) *out++ = std::move(*a++);
+        while(b != bEnd) *out++ = std::move(*b++);
+    }
+
+protected:
+    template<class Less>
+    void submitMerge(T* a, long long m, T* b, long long n, T* out, long long slice, Less& less, ThreadPool::TaskGroup& group){
+        long long total = m + n;
+        for(long long k0=0; k0 < total; k0 += slice){
+            long long k1 = k0 + slice < total ? k0 + slice : total;
+            pool->submit([=, &less](){
+                long long i0 = coRank(k0, a, m, b, n, less);
+                long long i1 = coRank(k1, a, m, b, n, less);
+                merge(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), out + k0, less);
+            }, group);
+        }
+    }
+
+    void submitCopy(T* begin, T* end, T* out, long long slice, ThreadPool::TaskGroup& group){
+        for(T* lo=begin; lo < end; lo += slice){
+            T* hi = (end - lo) > slice ? lo + slice : end;
+            T* dst = out + (lo - begin);
+            pool->submit([lo, hi, dst](){ std::move(lo, hi, dst); }, group);
+        }
+    }
+};
+
+#endif /* PARALLELSORT_H */
@@ -0,0 +1,251 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines RadixSort: LSD radix sort for numeric keys, MSD radix sort for strings
+*/
+
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+#include "sorting/ISort.h"
+#include "sorting/IntroSort.h"
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+/*
+! RadixKey<T>
+? Functionality:
+    * Maps a numeric key to an unsigned integer whose unsigned order is the order of T:
+        * unsigned integers: unchanged
+        * signed integers:   sign bit flipped
+        * float, double:     negative => all bits flipped, positive => sign bit flipped
+          (so -inf < ... < -0.0 < +0.0 < ... < +inf; NaNs go to the two ends)
+    * Type is the unsigned integer type of the same width.
+    * Other types (long double included) are not supported: RadixSort::sort falls
+      back to IntroSort and radixSortByKey does not compile.
+*/
+template<class T, class Enable=void>
+struct RadixKey{
+    static const bool supported = false;
+};
+
+template<class T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type>{
+    static const bool supported = true;
+    typedef typename std::make_unsigned<T>::type Type;
+    static Type get(const T& value){
+        Type bits = (Type)value;
+        if(std::is_signed<T>::value) bits ^= (Type)1 << (sizeof(T)*8 - 1);
+        return bits;
+    }
+};
+
+template<class T>
+struct RadixKey<T, typename std::enable_if<std::is_same<T, float>::value || std::is_same<T, double>::value>::type>{
+    static const bool supported = true;
+    typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type Type;
+    static_assert(sizeof(T) == sizeof(Type), "RadixKey: float and double must be 32 and 64-bit IEEE types");
+    static Type get(const T& value){
+        Type bits;
+        memcpy(&bits, &value, sizeof(T));
+        Type sign = (Type)1 << (sizeof(T)*8 - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+    }
+};
+
+/*
+! RadixPasses
+? Functionality:
+    * The LSD passes shared by RadixSort<T> and radixSortByKey.
+*/
+struct RadixPasses{
+    /*
+    ! lsd: stable LSD radix sort of data[0..n) on the unsigned key digitsOf(item) (type U).
+    * buffer must hold n items; the result ends in "data".
+    */
+    template<class R, class U, class KeyFn>
+    static void lsd(R* data, R* buffer, long long n, KeyFn digitsOf){
+        const int passes = sizeof(U);
+        vector<long long> counts(passes * 256, 0);
+        for(long long idx=0; idx < n; idx++){
+            U bits = digitsOf(data[idx]);
+            for(int pass=0; pass < passes; pass++)
+                counts[pass*256 + ((bits >> (pass*8)) & 0xFF)]++;
+        }
+
+        R* src = data;
+        R* dst = buffer;
+        U firstBits = digitsOf(data[0]);
+        for(int pass=0; pass < passes; pass++){
+            long long* count = &counts[pass*256];
+            //every key has the same digit here: nothing to do
+            if(count[(firstBits >> (pass*8)) & 0xFF] == n) continue;
+
+            long long offset = 0;
+            for(int digit=0; digit < 256; digit++){
+                long long c = count[digit];
+                count[digit] = offset;
+                offset += c;
+            }
+            for(long long idx=0; idx < n; idx++){
+                int digit = (digitsOf(src[idx]) >> (pass*8)) & 0xFF;
+                dst[count[digit]++] = std::move(src[idx]);
+            }
+            std::swap(src, dst);
+        }
+        if(src != data) std::move(src, src + n, data);
+    }
+};
+
+/*
+! RadixSort<T>
+? Functionality:
+    * Implements ISort<T> without comparisons when T is a numeric type or std::string:
+        * integers, float, double: LSD radix sort, 8-bit digits, one histogram pass
+          for all digits, digits on which every key agrees are skipped;
+        * std::string: MSD radix sort on bytes (iterative, no recursion), buckets
+          smaller than MSD_CUTOFF are finished with IntroSort.
+    * The comparator selects the direction:
+        * 0 or SortSimpleOrder<T>::compare4Ascending  => ascending
+        * SortSimpleOrder<T>::compare4Desending        => descending
+        * any other comparator (or an unsupported T)   => falls back to IntroSort
+    * Records of any type are sorted by a numeric field with radixSortByKey (below).
+? Usage:
+    * RadixSort<float> sortAlg;
+    * sortAlg.sort(scores, n);
+*/
+template<class T>
+class RadixSort: public ISort<T>{
+public:
+    static const int SMALL_SIZE = 64;
+    static const int MSD_CUTOFF = 32;
+
+public:
+    void sort(T array[], int size, int (*comparator)(T&,T&) =0){
+        if(array == 0 || size < 2) return;
+        bool ascending = (comparator == 0 || comparator == &SortSimpleOrder<T>::compare4Ascending);
+        bool descending = (comparator == &SortSimpleOrder<T>::compare4Desending);
+        if(!ascending && !descending){
+            IntroSort<T>().sort(array, size, comparator);
+            return;
+        }
+        sortDispatch(array, size, descending);
+    }
+
+    /*
+    ! sortStrings(array, size, descending): MSD radix sort on std::string
+    */
+    static void sortStrings(string* array, long long size, bool descending=false){
+        if(size < 2) return;
+        string* buffer = new string[size];
+        msd(array, buffer, size);
+        delete []buffer;
+        if(descending) std::reverse(array, array + size);
+    }
+
+protected:
+    void sortDispatch(T* array, int size, bool descending){
+        if constexpr (RadixKey<T>::supported){
+            if(size < SMALL_SIZE){
+                IntroSort<T>().sort(array, size, descending ? &SortSimpleOrder<T>::compare4Desending : 0);
+                return;
+            }
+            typedef typename RadixKey<T>::Type U;
+            T* buffer = new T[size];
+            RadixPasses::lsd<T, U>(array, buffer, size, [descending](T& value){
+                U bits = RadixKey<T>::get(value);
+                return descending ? (U)~bits : bits;
+            });
+            delete []buffer;
+        }
+        else if constexpr (std::is_same<T, string>::value){
+            sortStrings(array, size, descending);
+        }
+        else{
+            IntroSort<T>().sort(array, size, descending ? &SortSimpleOrder<T>::compare4Desending : 0);
+        }
+    }
+
+    struct StringSuffixLess{
+        size_t depth;
+        StringSuffixLess(size_t depth): depth(depth){}
+        bool operator()(string& lhs, string& rhs) const {
+            return lhs.compare(depth, string::npos, rhs, depth, string::npos) < 0;
+        }
+    };
+
+    /*
+    ! msd: MSD radix sort on strings, with an explicit work stack instead of recursion.
+    * Bucket 0 holds the strings that end at the current depth; they are done.
+    */
+    static void msd(string* array, string* buffer, long long n){
+        struct Range{ long long begin, size; size_t depth; };
+        vector<Range> work;
+        work.push_back({0, n, 0});
+        vector<long long> count(257);
+
+        while(!work.empty()){
+            Range range = work.back();
+            work.pop_back();
+            string* a = array + range.begin;
+            size_t depth = range.depth;
+            if(range.size < MSD_CUTOFF){
+                StringSuffixLess less(depth);
+                IntroSort<string>::sortRange(a, a + range.size, less);
+                continue;
+            }
+
+            std::fill(count.begin(), count.end(), 0);
+            for(long long idx=0; idx < range.size; idx++) count[bucketOf(a[idx], depth)]++;
+
+            long long offset = 0;
+            vector<long long> start(257);
+            for(int bucket=0; bucket < 257; bucket++){
+                start[bucket] = offset;
+                offset += count[bucket];
+            }
+            vector<long long> next(start);
+            for(long long idx=0; idx < range.size; idx++)
+                buffer[next[bucketOf(a[idx], depth)]++] = std::move(a[idx]);
+            std::move(buffer, buffer + range.size, a);
+
+            for(int bucket=1; bucket < 257; bucket++)
+                if(count[bucket] > 1)
+                    work.push_back({range.begin + start[bucket], count[bucket], depth + 1});
+        }
+    }
+
+    static int bucketOf(const string& item, size_t depth){
+        return depth < item.size() ? (unsigned char)item[depth] + 1 : 0;
+    }
+};
+
+/*
+! radixSortByKey(records, size, key, descending)
+? Functionality:
+    * Stable LSD radix sort of records[0..size) of any type by key(record), e.g. Point
+      by x or (score, id) pairs by score;
+    * key must return an integral, float or double value.
+? Usage:
+    * radixSortByKey(points, n, [](Point& p){ return p.getX(); });
+*/
+template<class R, class KeyFn>
+void radixSortByKey(R* records, long long size, KeyFn key, bool descending=false){
+    typedef typename std::decay<decltype(key(records[0]))>::type K;
+    static_assert(RadixKey<K>::supported, "radixSortByKey: key must be integral, float or double");
+    typedef typename RadixKey<K>::Type U;
+    if(size < 2) return;
+    R* buffer = new R[size];
+    RadixPasses::lsd<R, U>(records, buffer, size, [&key, descending](R& record){
+        U bits = RadixKey<K>::get(key(record));
+        return descending ? (U)~bits : bits;
+    });
+    delete []buffer;
+}
+
+#endif /* RADIXSORT_H */
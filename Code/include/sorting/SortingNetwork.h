@@ -0,0 +1,351 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines SortingNetwork: branch-free bitonic networks for small arrays
+*/
+
+#ifndef SORTINGNETWORK_H
+#define SORTINGNETWORK_H
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORTNET_X86 1
+#include <immintrin.h>
+#define SORTNET_SSE41 __attribute__((target("sse4.1")))
+#define SORTNET_AVX2  __attribute__((target("avx2")))
+#endif
+
+/*
+! SortingNetwork<T>
+? Functionality:
+    * Sorts up to MAX_SIZE (64) int32, float or double values in ascending order with a
+      bitonic sorting network: a fixed sequence of compare-exchange stages, no data
+      dependent branches, so the cost does not depend on the input order.
+    * The array is padded to 8, 16, 32 or 64 items with +infinity (or the type's max).
+    * Three kernels, chosen once at run time from CPUID:
+        * KERNEL_AVX2:   8 x int32/float or 4 x double per register
+        * KERNEL_SSE41:  4 x int32/float or 2 x double per register
+        * KERNEL_SCALAR: portable fallback (min/max through conditional moves)
+      No -mavx2 flag is needed: the vector kernels carry their own target attribute.
+    * Stages that pair items at least one register apart are done with vertical min/max;
+      stages inside one register use a lane shuffle, min/max and a blend.
+? Notes:
+    * NaNs are moved to the end before the network runs; compare-exchanges also keep both
+      items of an unordered pair, so nothing is ever duplicated or lost.
+    * supported is false for every other T; sort() must not be called then.
+? Usage:
+    * if(n <= SortingNetwork<float>::MAX_SIZE) SortingNetwork<float>::sort(values, n);
+*/
+template<class T>
+class SortingNetwork{
+public:
+    static const int MAX_SIZE = 64;
+    static const int MIN_NETWORK = 8;
+    static const bool supported =
+            std::is_same<T, int32_t>::value || std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+    enum Kernel{
+        KERNEL_SCALAR = 0,
+        KERNEL_SSE41,
+        KERNEL_AVX2
+    };
+
+public:
+    /*
+    ! sort(data, n): ascending sort of data[0..n), n <= MAX_SIZE, with the best kernel
+    */
+    static void sort(T* data, int n){
+        sort(data, n, kernel());
+    }
+
+    /*
+    ! sort(data, n, kernel): same, with a given kernel (used by tests and benchmarks);
+    * a kernel the CPU does not support is replaced by the best available one.
+    */
+    static void sort(T* data, int n, int kernel){
+        static_assert(supported, "SortingNetwork: T must be int32_t, float or double");
+        if(n < 2) return;
+        if(kernel > SortingNetwork<T>::kernel()) kernel = SortingNetwork<T>::kernel();
+        if(std::is_floating_point<T>::value){
+            int valid = 0;
+            for(int idx=0; idx < n; idx++)
+                if(data[idx] == data[idx]) std::swap(data[valid++], data[idx]);
+            n = valid;
+            if(n < 2) return;
+        }
+
+        int size = MIN_NETWORK;
+        while(size < n) size <<= 1;
+        if(size == n){
+            run(data, size, kernel);
+            return;
+        }
+        T padded[MAX_SIZE];
+        std::copy(data, data + n, padded);
+        std::fill(padded + n, padded + size, sentinel());
+        run(padded, size, kernel);
+        std::copy(padded, padded + n, data);
+    }
+
+    /*
+    ! kernel(): the fastest kernel this CPU runs, detected once
+    */
+    static int kernel(){
+        static const int detected = detectKernel();
+        return detected;
+    }
+
+    static const char* kernelName(int kernel){
+        switch(kernel){
+            case KERNEL_SSE41: return "sse4.1";
+            case KERNEL_AVX2:  return "avx2";
+        }
+        return "scalar";
+    }
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (protected) METHOD DEFNITION ////////////////
+//////////////////////////////////////////////////////////////////////
+protected:
+    static T sentinel(){
+        if(std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+        return std::numeric_limits<T>::max();
+    }
+
+    static int detectKernel(){
+#ifdef SORTNET_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+        if(__builtin_cpu_supports("sse4.1")) return KERNEL_SSE41;
+#endif
+        return KERNEL_SCALAR;
+    }
+
+    //n is a power of two in [MIN_NETWORK, MAX_SIZE]
+    static void run(T* x, int n, int kernel);
+
+    /*
+    ! bitonicScalar: stage (k, j) compares x[i] with x[i + j] for every i with bit j clear;
+    * the pair is put in ascending order if bit k of i is clear, descending otherwise.
+    */
+    static void bitonicScalar(T* x, int n){
+        for(int k=2; k <= n; k <<= 1)
+            for(int j=k >> 1; j > 0; j >>= 1)
+                for(int block=0; block < n; block += 2*j){
+                    //k > j: the direction is the same for the whole block
+                    T* lo = x + block;
+                    T* hi = lo + j;
+                    if(block & k) std::swap(lo, hi);
+                    for(int i=0; i < j; i++){
+                        T a = lo[i], b = hi[i];
+                        //NaNs were moved out: plain min/max (minss/cmov) is safe here
+                        lo[i] = b < a ? b : a;
+                        hi[i] = a < b ? b : a;
+                    }
+                }
+    }
+
+#ifdef SORTNET_X86
+    /*
+    ! bitonicSSE41 / bitonicAVX2: the same schedule as bitonicScalar on V::LANES items at once.
+    * V is one of the register traits below; the two bodies differ only in their target.
+    */
+    template<class V>
+    SORTNET_SSE41 static void bitonicSSE41(T* x, int n){
+        for(int k=2; k <= n; k <<= 1)
+            for(int j=k >> 1; j > 0; j >>= 1){
+                if(j >= V::LANES){
+                    for(int block=0; block < n; block += 2*j)
+                        for(int i=block; i < block + j; i += V::LANES)
+                            V::exchange(x + i, x + i + j, (i & k) != 0);
+                }
+                else{
+                    for(int i=0; i < n; i += V::LANES) V::exchangeLanes(x + i, i, j, k);
+                }
+            }
+    }
+
+    template<class V>
+    SORTNET_AVX2 static void bitonicAVX2(T* x, int n){
+        for(int k=2; k <= n; k <<= 1)
+            for(int j=k >> 1; j > 0; j >>= 1){
+                if(j >= V::LANES){
+                    for(int block=0; block < n; block += 2*j)
+                        for(int i=block; i < block + j; i += V::LANES)
+                            V::exchange(x + i, x + i + j, (i & k) != 0);
+                }
+                else{
+                    for(int i=0; i < n; i += V::LANES) V::exchangeLanes(x + i, i, j, k);
+                }
+            }
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+    /*
+    * Register traits. Every trait provides:
+    *   exchange(lo, hi, descending):  vertical compare-exchange of two registers
+    *   exchangeLanes(p, base, j, k):  stage (k, j < LANES) inside the register at p,
+    *                                   p holds items base .. base + LANES - 1
+    * min(b, a) and max(a, b) both decide on the same test b < a, so unordered pairs stay intact.
+    * In exchangeLanes a lane keeps min(partner, self) when it is the low item of an
+    * ascending pair or the high item of a descending pair, max(partner, self) otherwise.
+    */
+    struct SSE41Int32{
+        enum{ LANES = 4 };
+        SORTNET_SSE41 static void exchange(int32_t* lo, int32_t* hi, bool descending){
+            __m128i a = _mm_loadu_si128((const __m128i*)lo);
+            __m128i b = _mm_loadu_si128((const __m128i*)hi);
+            __m128i mn = _mm_min_epi32(b, a), mx = _mm_max_epi32(a, b);
+            _mm_storeu_si128((__m128i*)lo, descending ? mx : mn);
+            _mm_storeu_si128((__m128i*)hi, descending ? mn : mx);
+        }
+        SORTNET_SSE41 static void exchangeLanes(int32_t* p, int base, int j, int k){
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            __m128i w = j == 2 ? _mm_shuffle_epi32(v, 0x4E) : _mm_shuffle_epi32(v, 0xB1);
+            __m128i keepMin = laneMask(base, j, k);
+            _mm_storeu_si128((__m128i*)p, _mm_blendv_epi8(_mm_max_epi32(w, v), _mm_min_epi32(w, v), keepMin));
+        }
+        SORTNET_SSE41 static __m128i laneMask(int base, int j, int k){
+            __m128i idx = _mm_add_epi32(_mm_set1_epi32(base), _mm_setr_epi32(0, 1, 2, 3));
+            __m128i zero = _mm_setzero_si128();
+            __m128i low = _mm_cmpeq_epi32(_mm_and_si128(idx, _mm_set1_epi32(j)), zero);
+            __m128i ascending = _mm_cmpeq_epi32(_mm_and_si128(idx, _mm_set1_epi32(k)), zero);
+            return _mm_cmpeq_epi32(low, ascending);
+        }
+    };
+
+    struct SSE41Float{
+        enum{ LANES = 4 };
+        SORTNET_SSE41 static void exchange(float* lo, float* hi, bool descending){
+            __m128 a = _mm_loadu_ps(lo), b = _mm_loadu_ps(hi);
+            __m128 mn = _mm_min_ps(b, a), mx = _mm_max_ps(a, b);
+            _mm_storeu_ps(lo, descending ? mx : mn);
+            _mm_storeu_ps(hi, descending ? mn : mx);
+        }
+        SORTNET_SSE41 static void exchangeLanes(float* p, int base, int j, int k){
+            __m128 v = _mm_loadu_ps(p);
+            __m128 w = j == 2 ? _mm_shuffle_ps(v, v, 0x4E) : _mm_shuffle_ps(v, v, 0xB1);
+            __m128 keepMin = _mm_castsi128_ps(SSE41Int32::laneMask(base, j, k));
+            _mm_storeu_ps(p, _mm_blendv_ps(_mm_max_ps(w, v), _mm_min_ps(w, v), keepMin));
+        }
+    };
+
+    struct SSE41Double{
+        enum{ LANES = 2 };
+        SORTNET_SSE41 static void exchange(double* lo, double* hi, bool descending){
+            __m128d a = _mm_loadu_pd(lo), b = _mm_loadu_pd(hi);
+            __m128d mn = _mm_min_pd(b, a), mx = _mm_max_pd(a, b);
+            _mm_storeu_pd(lo, descending ? mx : mn);
+            _mm_storeu_pd(hi, descending ? mn : mx);
+        }
+        //j == 1 only: the lane pair is the register itself
+        SORTNET_SSE41 static void exchangeLanes(double* p, int base, int j, int k){
+            __m128d v = _mm_loadu_pd(p);
+            __m128d w = _mm_shuffle_pd(v, v, 1);
+            __m128d mn = _mm_min_pd(w, v), mx = _mm_max_pd(w, v);
+            //lane 0 is the low item: it keeps the min unless the pair is descending
+            __m128d keepMin = (base & k) ? _mm_castsi128_pd(_mm_set_epi64x(-1, 0))
+                                         : _mm_castsi128_pd(_mm_set_epi64x(0, -1));
+            _mm_storeu_pd(p, _mm_blendv_pd(mx, mn, keepMin));
+            (void)j;
+        }
+    };
+
+    struct AVX2Int32{
+        enum{ LANES = 8 };
+        SORTNET_AVX2 static void exchange(int32_t* lo, int32_t* hi, bool descending){
+            __m256i a = _mm256_loadu_si256((const __m256i*)lo);
+            __m256i b = _mm256_loadu_si256((const __m256i*)hi);
+            __m256i mn = _mm256_min_epi32(b, a), mx = _mm256_max_epi32(a, b);
+            _mm256_storeu_si256((__m256i*)lo, descending ? mx : mn);
+            _mm256_storeu_si256((__m256i*)hi, descending ? mn : mx);
+        }
+        SORTNET_AVX2 static __m256i partner(__m256i v, int j){
+            if(j == 4) return _mm256_permute2x128_si256(v, v, 0x01);
+            if(j == 2) return _mm256_shuffle_epi32(v, 0x4E);
+            return _mm256_shuffle_epi32(v, 0xB1);
+        }
+        SORTNET_AVX2 static __m256i laneMask(int base, int j, int k){
+            __m256i idx = _mm256_add_epi32(_mm256_set1_epi32(base), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i zero = _mm256_setzero_si256();
+            __m256i low = _mm256_cmpeq_epi32(_mm256_and_si256(idx, _mm256_set1_epi32(j)), zero);
+            __m256i ascending = _mm256_cmpeq_epi32(_mm256_and_si256(idx, _mm256_set1_epi32(k)), zero);
+            return _mm256_cmpeq_epi32(low, ascending);
+        }
+        SORTNET_AVX2 static void exchangeLanes(int32_t* p, int base, int j, int k){
+            __m256i v = _mm256_loadu_si256((const __m256i*)p);
+            __m256i w = partner(v, j);
+            __m256i keepMin = laneMask(base, j, k);
+            _mm256_storeu_si256((__m256i*)p,
+                    _mm256_blendv_epi8(_mm256_max_epi32(w, v), _mm256_min_epi32(w, v), keepMin));
+        }
+    };
+
+    struct AVX2Float{
+        enum{ LANES = 8 };
+        SORTNET_AVX2 static void exchange(float* lo, float* hi, bool descending){
+            __m256 a = _mm256_loadu_ps(lo), b = _mm256_loadu_ps(hi);
+            __m256 mn = _mm256_min_ps(b, a), mx = _mm256_max_ps(a, b);
+            _mm256_storeu_ps(lo, descending ? mx : mn);
+            _mm256_storeu_ps(hi, descending ? mn : mx);
+        }
+        SORTNET_AVX2 static void exchangeLanes(float* p, int base, int j, int k){
+            __m256 v = _mm256_loadu_ps(p);
+            __m256 w;
+            if(j == 4) w = _mm256_permute2f128_ps(v, v, 0x01);
+            else if(j == 2) w = _mm256_permute_ps(v, 0x4E);
+            else w = _mm256_permute_ps(v, 0xB1);
+            __m256 keepMin = _mm256_castsi256_ps(AVX2Int32::laneMask(base, j, k));
+            _mm256_storeu_ps(p, _mm256_blendv_ps(_mm256_max_ps(w, v), _mm256_min_ps(w, v), keepMin));
+        }
+    };
+
+    struct AVX2Double{
+        enum{ LANES = 4 };
+        SORTNET_AVX2 static void exchange(double* lo, double* hi, bool descending){
+            __m256d a = _mm256_loadu_pd(lo), b = _mm256_loadu_pd(hi);
+            __m256d mn = _mm256_min_pd(b, a), mx = _mm256_max_pd(a, b);
+            _mm256_storeu_pd(lo, descending ? mx : mn);
+            _mm256_storeu_pd(hi, descending ? mn : mx);
+        }
+        SORTNET_AVX2 static void exchangeLanes(double* p, int base, int j, int k){
+            __m256d v = _mm256_loadu_pd(p);
+            __m256d w = j == 2 ? _mm256_permute4x64_pd(v, 0x4E) : _mm256_permute_pd(v, 0x5);
+            __m256i idx = _mm256_add_epi64(_mm256_set1_epi64x(base), _mm256_setr_epi64x(0, 1, 2, 3));
+            __m256i zero = _mm256_setzero_si256();
+            __m256i low = _mm256_cmpeq_epi64(_mm256_and_si256(idx, _mm256_set1_epi64x(j)), zero);
+            __m256i ascending = _mm256_cmpeq_epi64(_mm256_and_si256(idx, _mm256_set1_epi64x(k)), zero);
+            __m256d keepMin = _mm256_castsi256_pd(_mm256_cmpeq_epi64(low, ascending));
+            _mm256_storeu_pd(p, _mm256_blendv_pd(_mm256_max_pd(w, v), _mm256_min_pd(w, v), keepMin));
+        }
+    };
+#endif
+};
+
+template<class T>
+void SortingNetwork<T>::run(T* x, int n, int kernel){
+#ifdef SORTNET_X86
+    if constexpr (std::is_same<T, int32_t>::value){
+        if(kernel == KERNEL_AVX2) return bitonicAVX2<AVX2Int32>(x, n);
+        if(kernel == KERNEL_SSE41) return bitonicSSE41<SSE41Int32>(x, n);
+    }
+    else if constexpr (std::is_same<T, float>::value){
+        if(kernel == KERNEL_AVX2) return bitonicAVX2<AVX2Float>(x, n);
+        if(kernel == KERNEL_SSE41) return bitonicSSE41<SSE41Float>(x, n);
+    }
+    else if constexpr (std::is_same<T, double>::value){
+        if(kernel == KERNEL_AVX2) return bitonicAVX2<AVX2Double>(x, n);
+        if(kernel == KERNEL_SSE41) return bitonicSSE41<SSE41Double>(x, n);
+    }
+#endif
+    (void)kernel;
+    bitonicScalar(x, n);
+}
+
+#endif /* SORTINGNETWORK_H */
@@ -0,0 +1,281 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines ArrayQueue: a FIFO queue on a power-of-two ring buffer
+*/
+
+#ifndef ARRAYQUEUE_H
+#define ARRAYQUEUE_H
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include "stacknqueue/IDeck.h"
+using namespace std;
+
+/*
+! ArrayQueue<T>
+? Functionality:
+    * Same IDeck<T> interface as Queue<T>, without a node allocation per push:
+      items live in one ring buffer whose capacity is a power of two, so the
+      wrap-around is a mask instead of a modulo.
+    * When the buffer is full its capacity doubles (amortized O(1) push);
+      reserve(n) pre-sizes it.
+? Notes:
+    * deleteUserData: pass &ArrayQueue<T>::free when T is a pointer type and the
+      queue owns the pointed-to objects (called by clear() and the destructor).
+? Usage:
+    * ArrayQueue<int> queue;
+    * queue.push(1); queue.push(2);
+    * int front = queue.pop(); //1
+*/
+template<class T>
+class ArrayQueue: public IDeck<T>{
+public:
+    class Iterator; //forward declaration
+    static const int DEFAULT_CAPACITY = 16;
+
+protected:
+    T* data;
+    int capacity;   //power of two
+    int head;       //index of the front item
+    int count;
+    void (*deleteUserData)(ArrayQueue<T>*);
+    bool (*itemEqual)(T& lhs, T& rhs);
+
+public:
+    ArrayQueue(
+            void (*deleteUserData)(ArrayQueue<T>*)=0,
+            bool (*itemEqual)(T&, T&)=0,
+            int capacity=DEFAULT_CAPACITY){
+        this->deleteUserData = deleteUserData;
+        this->itemEqual = itemEqual;
+        this->capacity = roundUp(capacity);
+        this->data = new T[this->capacity];
+        this->head = 0;
+        this->count = 0;
+    }
+    ArrayQueue(const ArrayQueue<T>& queue){
+        this->data = 0;
+        copyFrom(queue);
+    }
+    ArrayQueue<T>& operator=(const ArrayQueue<T>& queue){
+        if(this == &queue) return *this;
+        removeInternalData();
+        copyFrom(queue);
+        return *this;
+    }
+    ~ArrayQueue(){
+        removeInternalData();
+    }
+
+    /*
+    ! push(T item): add item to the rear of the queue
+    */
+    void push(T item){
+        if(count == capacity) grow(capacity * 2);
+        data[(head + count) & (capacity - 1)] = std::move(item);
+        count++;
+    }
+
+    /*
+    ! pop(): remove and return the front item
+    * Exception: Underflow if the queue is empty
+    */
+    T pop(){
+        if(count == 0) throw Underflow("Queue");
+        T item = std::move(data[head]);
+        head = (head + 1) & (capacity - 1);
+        count--;
+        return item;
+    }
+
+    /*
+    ! peek(): the front item
+    * Exception: Underflow if the queue is empty
+    */
+    T& peek(){
+        if(count == 0) throw Underflow("Queue");
+        return data[head];
+    }
+
+    bool empty(){
+        return count == 0;
+    }
+    int size(){
+        return count;
+    }
+
+    /*
+    ! clear(): remove all items (and the user's data, if deleteUserData was given)
+    */
+    void clear(){
+        if(deleteUserData != 0) deleteUserData(this);
+        head = 0;
+        count = 0;
+    }
+
+    /*
+    ! remove(T item): remove the first occurrence of item (from the front); O(n)
+    ? Return:
+        * bool: true if the item was found and removed
+    */
+    bool remove(T item){
+        for(int idx=0; idx < count; idx++)
+            if(equals(at(idx), item, itemEqual)){
+                removeAt(idx);
+                return true;
+            }
+        return false;
+    }
+
+    bool contains(T item){
+        for(int idx=0; idx < count; idx++)
+            if(equals(at(idx), item, itemEqual)) return true;
+        return false;
+    }
+
+    /*
+    ! reserve(n): make room for n items without further growth
+    */
+    void reserve(int n){
+        if(n > capacity) grow(roundUp(n));
+    }
+
+    /*
+    ! get(index): the index-th item from the front, 0 <= index < size()
+    * Exception: std::out_of_range
+    */
+    T& get(int index){
+        if(index < 0 || index >= count) throw std::out_of_range("ArrayQueue: index is out of range!");
+        return at(index);
+    }
+
+    string toString(string (*item2str)(T&)=0 ){
+        stringstream os;
+        os << "FRONT-TO-REAR: [";
+        for(int idx=0; idx < count; idx++){
+            if(item2str != 0) os << item2str(at(idx));
+            else os << at(idx);
+            if(idx < count - 1) os << ", ";
+        }
+        os << "]";
+        return os.str();
+    }
+    void println(string (*item2str)(T&)=0 ){
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator front(){
+        return Iterator(this, true);
+    }
+    Iterator rear(){
+        return Iterator(this, false);
+    }
+
+    static void free(ArrayQueue<T>* queue){
+        for(int idx=0; idx < queue->count; idx++) delete queue->at(idx);
+    }
+
+protected:
+    T& at(int index){
+        return data[(head + index) & (capacity - 1)];
+    }
+
+    static int roundUp(int n){
+        int size = 1;
+        while(size < n) size <<= 1;
+        return size;
+    }
+
+    //copies the items to a new buffer of newCapacity (a power of two), front at index 0
+    void grow(int newCapacity){
+        T* items = new T[newCapacity];
+        for(int idx=0; idx < count; idx++) items[idx] = std::move(at(idx));
+        delete []data;
+        data = items;
+        capacity = newCapacity;
+        head = 0;
+    }
+
+    //shifts the shorter side over the removed slot
+    void removeAt(int index){
+        if(index < count / 2){
+            for(int idx=index; idx > 0; idx--) at(idx) = std::move(at(idx - 1));
+            head = (head + 1) & (capacity - 1);
+        }
+        else{
+            for(int idx=index; idx < count - 1; idx++) at(idx) = std::move(at(idx + 1));
+        }
+        count--;
+    }
+
+    void removeInternalData(){
+        if(data == 0) return;
+        if(deleteUserData != 0) deleteUserData(this);
+        delete []data;
+        data = 0;
+        count = 0;
+    }
+
+    //the user's data is not shared: deleteUserData is not copied (as in DLinkedList)
+    void copyFrom(const ArrayQueue<T>& queue){
+        this->deleteUserData = 0;
+        this->itemEqual = queue.itemEqual;
+        this->capacity = queue.capacity;
+        this->data = new T[capacity];
+        this->head = 0;
+        this->count = queue.count;
+        for(int idx=0; idx < count; idx++)
+            data[idx] = queue.data[(queue.head + idx) & (capacity - 1)];
+    }
+
+private:
+    static bool equals(T& lhs, T& rhs, bool (*itemEqual)(T&, T& )){
+        if(itemEqual == 0) return lhs == rhs;
+        else return itemEqual(lhs, rhs);
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//Iterator: BEGIN
+    class Iterator{
+    private:
+        ArrayQueue<T>* queue;
+        int cursor;
+    public:
+        Iterator(ArrayQueue<T>* queue=0, bool begin=true){
+            this->queue = queue;
+            this->cursor = (begin || queue == 0) ? 0 : queue->count;
+        }
+        T& operator*(){
+            return queue->at(cursor);
+        }
+        bool operator!=(const Iterator& iterator){
+            return this->cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator& operator++(){
+            cursor++;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+        //removes the current item; the next ++ moves to the item that followed it
+        void remove(void (*removeItem)(T)=0){
+            if(removeItem != 0) removeItem(queue->at(cursor));
+            queue->removeAt(cursor);
+            cursor--;
+        }
+    };
+    //Iterator: END
+};
+
+#endif /* ARRAYQUEUE_H */
@@ -0,0 +1,241 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines ArrayStack: a LIFO stack on a contiguous, growable array
+*/
+
+#ifndef ARRAYSTACK_H
+#define ARRAYSTACK_H
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include "stacknqueue/IDeck.h"
+using namespace std;
+
+/*
+! ArrayStack<T>
+? Functionality:
+    * Same IDeck<T> interface as Stack<T>, on one array: the top is the last item,
+      so push and pop touch a single slot and never allocate, except when the
+      array is full and its capacity doubles.
+? Notes:
+    * deleteUserData: pass &ArrayStack<T>::free when T is a pointer type and the
+      stack owns the pointed-to objects (called by clear() and the destructor).
+? Usage:
+    * ArrayStack<int> stack;
+    * stack.push(1); stack.push(2);
+    * int top = stack.pop(); //2
+*/
+template<class T>
+class ArrayStack: public IDeck<T>{
+public:
+    class Iterator; //forward declaration
+    static const int DEFAULT_CAPACITY = 16;
+
+protected:
+    T* data;        //data[count - 1] is the top
+    int capacity;
+    int count;
+    void (*deleteUserData)(ArrayStack<T>*);
+    bool (*itemEqual)(T& lhs, T& rhs);
+
+public:
+    ArrayStack(
+            void (*deleteUserData)(ArrayStack<T>*)=0,
+            bool (*itemEqual)(T&, T&)=0,
+            int capacity=DEFAULT_CAPACITY){
+        this->deleteUserData = deleteUserData;
+        this->itemEqual = itemEqual;
+        this->capacity = capacity > 0 ? capacity : 1;
+        this->data = new T[this->capacity];
+        this->count = 0;
+    }
+    ArrayStack(const ArrayStack<T>& stack){
+        this->data = 0;
+        copyFrom(stack);
+    }
+    ArrayStack<T>& operator=(const ArrayStack<T>& stack){
+        if(this == &stack) return *this;
+        removeInternalData();
+        copyFrom(stack);
+        return *this;
+    }
+    ~ArrayStack(){
+        removeInternalData();
+    }
+
+    /*
+    ! push(T item): add item on top of the stack
+    */
+    void push(T item){
+        if(count == capacity) grow(capacity * 2);
+        data[count++] = std::move(item);
+    }
+
+    /*
+    ! pop(): remove and return the top item
+    * Exception: Underflow if the stack is empty
+    */
+    T pop(){
+        if(count == 0) throw Underflow("Stack");
+        return std::move(data[--count]);
+    }
+
+    /*
+    ! peek(): the top item
+    * Exception: Underflow if the stack is empty
+    */
+    T& peek(){
+        if(count == 0) throw Underflow("Stack");
+        return data[count - 1];
+    }
+
+    bool empty(){
+        return count == 0;
+    }
+    int size(){
+        return count;
+    }
+
+    /*
+    ! clear(): remove all items (and the user's data, if deleteUserData was given)
+    */
+    void clear(){
+        if(deleteUserData != 0) deleteUserData(this);
+        count = 0;
+    }
+
+    /*
+    ! remove(T item): remove the occurrence of item nearest to the top; O(n)
+    ? Return:
+        * bool: true if the item was found and removed
+    */
+    bool remove(T item){
+        for(int idx=count - 1; idx >= 0; idx--)
+            if(equals(data[idx], item, itemEqual)){
+                removeAt(idx);
+                return true;
+            }
+        return false;
+    }
+
+    bool contains(T item){
+        for(int idx=count - 1; idx >= 0; idx--)
+            if(equals(data[idx], item, itemEqual)) return true;
+        return false;
+    }
+
+    /*
+    ! reserve(n): make room for n items without further growth
+    */
+    void reserve(int n){
+        if(n > capacity) grow(n);
+    }
+
+    string toString(string (*item2str)(T&)=0 ){
+        stringstream os;
+        os << "FROM TOP: [";
+        for(int idx=count - 1; idx >= 0; idx--){
+            if(item2str != 0) os << item2str(data[idx]);
+            else os << data[idx];
+            if(idx > 0) os << ", ";
+        }
+        os << "]";
+        return os.str();
+    }
+    void println(string (*item2str)(T&)=0 ){
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator top(){
+        return Iterator(this, true);
+    }
+    Iterator bottom(){
+        return Iterator(this, false);
+    }
+
+    static void free(ArrayStack<T>* stack){
+        for(int idx=0; idx < stack->count; idx++) delete stack->data[idx];
+    }
+
+protected:
+    void grow(int newCapacity){
+        T* items = new T[newCapacity];
+        for(int idx=0; idx < count; idx++) items[idx] = std::move(data[idx]);
+        delete []data;
+        data = items;
+        capacity = newCapacity;
+    }
+
+    void removeAt(int index){
+        for(int idx=index; idx < count - 1; idx++) data[idx] = std::move(data[idx + 1]);
+        count--;
+    }
+
+    void removeInternalData(){
+        if(data == 0) return;
+        if(deleteUserData != 0) deleteUserData(this);
+        delete []data;
+        data = 0;
+        count = 0;
+    }
+
+    //the user's data is not shared: deleteUserData is not copied (as in DLinkedList)
+    void copyFrom(const ArrayStack<T>& stack){
+        this->deleteUserData = 0;
+        this->itemEqual = stack.itemEqual;
+        this->capacity = stack.capacity;
+        this->data = new T[capacity];
+        this->count = stack.count;
+        for(int idx=0; idx < count; idx++) data[idx] = stack.data[idx];
+    }
+
+private:
+    static bool equals(T& lhs, T& rhs, bool (*itemEqual)(T&, T& )){
+        if(itemEqual == 0) return lhs == rhs;
+        else return itemEqual(lhs, rhs);
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//Iterator: BEGIN, visits the items from the top down
+    class Iterator{
+    private:
+        ArrayStack<T>* stack;
+        int cursor;     //index into data; -1 is bottom()
+    public:
+        Iterator(ArrayStack<T>* stack=0, bool begin=true){
+            this->stack = stack;
+            this->cursor = (begin && stack != 0) ? stack->count - 1 : -1;
+        }
+        T& operator*(){
+            return stack->data[cursor];
+        }
+        bool operator!=(const Iterator& iterator){
+            return this->cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator& operator++(){
+            cursor--;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+        //removes the current item; the next ++ moves to the item below it
+        void remove(void (*removeItem)(T)=0){
+            if(removeItem != 0) removeItem(stack->data[cursor]);
+            stack->removeAt(cursor);
+        }
+    };
+    //Iterator: END
+};
+
+#endif /* ARRAYSTACK_H */
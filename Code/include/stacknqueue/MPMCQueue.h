@@ -0,0 +1,242 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines MPMCQueue: a bounded lock-free multi-producer/multi-consumer queue
+*/
+
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "util/SpinWait.h"
+
+/*
+! MPMCQueue<T>
+? Functionality:
+    * Bounded FIFO for any number of producer and consumer threads (D. Vyukov's
+      bounded queue): every cell carries a sequence number that says whose turn
+      it is. A cell at position p is free for the producer of p when
+      sequence == p, and holds an item for the consumer of p when sequence == p + 1;
+      the consumer hands it back to the producer of p + capacity.
+    * A thread claims a position with one CAS on enqueuePos / dequeuePos (kept on
+      separate cache lines), then fills or empties its cell without further
+      synchronization; producers never touch dequeuePos and consumers never touch
+      enqueuePos.
+    * Batches (tryPushN / tryPopN) claim k consecutive ready cells with a single
+      CAS, so the contended line is touched once per batch instead of once per item.
+    * Non-blocking: tryPush, tryPop, tryPushN, tryPopN.
+      Blocking (SpinWait): push, pop, pushN, popN.
+    * close(): all producers are done; blocking pops return false / 0 once the
+      queue is closed and drained.
+? Notes:
+    * capacity is rounded up to a power of two (at least 2).
+    * FIFO holds per producer; items of different producers interleave.
+? Usage:
+    * MPMCQueue<Task> tasks(4096);
+    * producers: tasks.push(task);  ...  (last one) tasks.close();
+    * workers:   Task task; while(tasks.pop(task)) run(task);
+*/
+template<class T>
+class MPMCQueue{
+protected:
+    struct Cell{
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePos;
+    alignas(CACHE_LINE) std::atomic<bool> closed;
+    Cell* cells;
+    size_t mask;
+
+public:
+    MPMCQueue(int capacity=1024){
+        size_t size = 2;
+        while(size < (size_t)capacity) size <<= 1;
+        this->cells = new Cell[size];
+        this->mask = size - 1;
+        for(size_t idx=0; idx < size; idx++) cells[idx].sequence.store(idx, std::memory_order_relaxed);
+        this->enqueuePos.store(0, std::memory_order_relaxed);
+        this->dequeuePos.store(0, std::memory_order_relaxed);
+        this->closed.store(false, std::memory_order_relaxed);
+    }
+    ~MPMCQueue(){
+        delete []cells;
+    }
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    int capacity(){
+        return (int)(mask + 1);
+    }
+    //a snapshot: other threads may change the queue before the caller looks at it
+    int sizeApprox(){
+        size_t dequeued = dequeuePos.load(std::memory_order_acquire);
+        size_t enqueued = enqueuePos.load(std::memory_order_acquire);
+        return enqueued > dequeued ? (int)(enqueued - dequeued) : 0;
+    }
+
+    /*
+    ! tryPush(item): false if the queue is full
+    */
+    bool tryPush(T item){
+        size_t position = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while(true){
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+            if(diff == 0){
+                if(enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0) return false;     //the cell still holds the item of position - capacity
+            else position = enqueuePos.load(std::memory_order_relaxed);
+        }
+        cell->data = std::move(item);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    ! push(item): waits while the queue is full
+    */
+    void push(T item){
+        SpinWait spin;
+        while(!tryPush(item)) spin.wait();
+    }
+
+    /*
+    ! tryPop(item): false if the queue is empty
+    */
+    bool tryPop(T& item){
+        size_t position = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while(true){
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(position + 1);
+            if(diff == 0){
+                if(dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0) return false;     //the producer of position has not finished
+            else position = dequeuePos.load(std::memory_order_relaxed);
+        }
+        item = std::move(cell->data);
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    ! pop(item): waits for an item; returns false once the queue is closed and empty
+    */
+    bool pop(T& item){
+        SpinWait spin;
+        while(!tryPop(item)){
+            if(closed.load(std::memory_order_acquire)) return tryPop(item);
+            spin.wait();
+        }
+        return true;
+    }
+
+    /*
+    ! tryPushN(items, n): pushes a prefix of items[0..n) that fits; returns its length
+    * The prefix is stored in consecutive positions (no other producer interleaves).
+    */
+    int tryPushN(const T* items, int n){
+        if(n <= 0) return 0;
+        size_t position = enqueuePos.load(std::memory_order_relaxed);
+        int count;
+        while(true){
+            //a free cell stays free until its position is claimed, so counting then CAS is safe
+            count = 0;
+            while(count < n && cells[(position + count) & mask].sequence.load(std::memory_order_acquire) == position + count)
+                count++;
+            if(count == 0){
+                size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+                if((intptr_t)sequence - (intptr_t)position < 0) return 0;
+                position = enqueuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(enqueuePos.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) break;
+        }
+        for(int idx=0; idx < count; idx++){
+            Cell& cell = cells[(position + idx) & mask];
+            cell.data = items[idx];
+            cell.sequence.store(position + idx + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /*
+    ! pushN(items, n): pushes all of items[0..n), waiting for room as needed
+    */
+    void pushN(const T* items, int n){
+        SpinWait spin;
+        while(n > 0){
+            int count = tryPushN(items, n);
+            if(count == 0){
+                spin.wait();
+                continue;
+            }
+            spin.reset();
+            items += count;
+            n -= count;
+        }
+    }
+
+    /*
+    ! tryPopN(items, n): pops up to n consecutive items into items[]; returns how many
+    */
+    int tryPopN(T* items, int n){
+        if(n <= 0) return 0;
+        size_t position = dequeuePos.load(std::memory_order_relaxed);
+        int count;
+        while(true){
+            count = 0;
+            while(count < n && cells[(position + count) & mask].sequence.load(std::memory_order_acquire) == position + count + 1)
+                count++;
+            if(count == 0){
+                size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+                if((intptr_t)sequence - (intptr_t)(position + 1) < 0) return 0;
+                position = dequeuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(dequeuePos.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) break;
+        }
+        for(int idx=0; idx < count; idx++){
+            Cell& cell = cells[(position + idx) & mask];
+            items[idx] = std::move(cell.data);
+            cell.sequence.store(position + idx + mask + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /*
+    ! popN(items, n): waits for at least one item, then pops up to n;
+    * returns 0 once the queue is closed and empty
+    */
+    int popN(T* items, int n){
+        SpinWait spin;
+        while(true){
+            int count = tryPopN(items, n);
+            if(count > 0) return count;
+            if(closed.load(std::memory_order_acquire)) return tryPopN(items, n);
+            spin.wait();
+        }
+    }
+
+    /*
+    ! close(): no more pushes will come; call after every producer has finished
+    */
+    void close(){
+        closed.store(true, std::memory_order_release);
+    }
+    bool isClosed(){
+        return closed.load(std::memory_order_acquire);
+    }
+};
+
+#endif /* MPMCQUEUE_H */
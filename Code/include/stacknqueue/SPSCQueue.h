@@ -0,0 +1,206 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines SPSCQueue: a bounded lock-free single-producer/single-consumer queue
+*/
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include "util/SpinWait.h"
+
+/*
+! SPSCQueue<T>
+? Functionality:
+    * Bounded FIFO between exactly one producer thread and one consumer thread,
+      without locks: a power-of-two ring buffer, the producer owns "tail", the
+      consumer owns "head"; each publishes its index with a release store.
+    * head and tail sit on separate cache lines, and each side keeps a private copy
+      of the other side's index, re-read only when the queue looks full (producer)
+      or empty (consumer): in steady state the two cores do not share a line per item.
+    * Non-blocking: tryPush, tryPop, tryPushN, tryPopN.
+      Blocking (SpinWait): push, pop, pushN, popN.
+    * close(): the producer is done; blocking pops return false / 0 once the queue
+      is closed and drained, which ends a pipeline stage.
+? Notes:
+    * capacity is rounded up to a power of two.
+    * Only one thread may push and only one may pop at a time; use MPMCQueue otherwise.
+? Usage:
+    * SPSCQueue<Batch*> stage(1024);
+    * producer: stage.push(batch); ... stage.close();
+    * consumer: Batch* batch; while(stage.pop(batch)) forward(batch);
+*/
+template<class T>
+class SPSCQueue{
+protected:
+    //producer side
+    alignas(CACHE_LINE) std::atomic<size_t> tail;
+    size_t headCache;
+    //consumer side
+    alignas(CACHE_LINE) std::atomic<size_t> head;
+    size_t tailCache;
+    //shared, read-mostly
+    alignas(CACHE_LINE) std::atomic<bool> closed;
+    T* slots;
+    size_t mask;
+
+public:
+    SPSCQueue(int capacity=1024){
+        size_t size = 2;
+        while(size < (size_t)capacity) size <<= 1;
+        this->slots = new T[size];
+        this->mask = size - 1;
+        this->tail.store(0, std::memory_order_relaxed);
+        this->head.store(0, std::memory_order_relaxed);
+        this->headCache = 0;
+        this->tailCache = 0;
+        this->closed.store(false, std::memory_order_relaxed);
+    }
+    ~SPSCQueue(){
+        delete []slots;
+    }
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    int capacity(){
+        return (int)(mask + 1);
+    }
+    //exact when called by the producer or the consumer while the other side is idle
+    int sizeApprox(){
+        return (int)(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+    }
+
+    /*
+    ! tryPush(item): false if the queue is full (producer only)
+    */
+    bool tryPush(T item){
+        size_t position = tail.load(std::memory_order_relaxed);
+        if(position - headCache > mask){
+            headCache = head.load(std::memory_order_acquire);
+            if(position - headCache > mask) return false;
+        }
+        slots[position & mask] = std::move(item);
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    ! push(item): waits while the queue is full (producer only)
+    */
+    void push(T item){
+        SpinWait spin;
+        size_t position = tail.load(std::memory_order_relaxed);
+        while(position - headCache > mask){
+            headCache = head.load(std::memory_order_acquire);
+            if(position - headCache > mask) spin.wait();
+        }
+        slots[position & mask] = std::move(item);
+        tail.store(position + 1, std::memory_order_release);
+    }
+
+    /*
+    ! tryPop(item): false if the queue is empty (consumer only)
+    */
+    bool tryPop(T& item){
+        size_t position = head.load(std::memory_order_relaxed);
+        if(position == tailCache){
+            tailCache = tail.load(std::memory_order_acquire);
+            if(position == tailCache) return false;
+        }
+        item = std::move(slots[position & mask]);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+    ! pop(item): waits for an item; returns false once the queue is closed and empty
+    */
+    bool pop(T& item){
+        SpinWait spin;
+        while(!tryPop(item)){
+            if(closed.load(std::memory_order_acquire)){
+                //items pushed before close() are visible now
+                return tryPop(item);
+            }
+            spin.wait();
+        }
+        return true;
+    }
+
+    /*
+    ! tryPushN(items, n): pushes as many of items[0..n) as fit; returns how many
+    */
+    int tryPushN(const T* items, int n){
+        size_t position = tail.load(std::memory_order_relaxed);
+        size_t room = mask + 1 - (position - headCache);
+        if(room < (size_t)n){
+            headCache = head.load(std::memory_order_acquire);
+            room = mask + 1 - (position - headCache);
+        }
+        int count = room < (size_t)n ? (int)room : n;
+        for(int idx=0; idx < count; idx++) slots[(position + idx) & mask] = items[idx];
+        if(count > 0) tail.store(position + count, std::memory_order_release);
+        return count;
+    }
+
+    /*
+    ! pushN(items, n): pushes all of items[0..n), waiting for room as needed
+    */
+    void pushN(const T* items, int n){
+        SpinWait spin;
+        while(n > 0){
+            int count = tryPushN(items, n);
+            if(count == 0){
+                spin.wait();
+                continue;
+            }
+            spin.reset();
+            items += count;
+            n -= count;
+        }
+    }
+
+    /*
+    ! tryPopN(items, n): pops up to n items into items[]; returns how many
+    */
+    int tryPopN(T* items, int n){
+        size_t position = head.load(std::memory_order_relaxed);
+        size_t available = tailCache - position;
+        if(available < (size_t)n){
+            tailCache = tail.load(std::memory_order_acquire);
+            available = tailCache - position;
+        }
+        int count = available < (size_t)n ? (int)available : n;
+        for(int idx=0; idx < count; idx++) items[idx] = std::move(slots[(position + idx) & mask]);
+        if(count > 0) head.store(position + count, std::memory_order_release);
+        return count;
+    }
+
+    /*
+    ! popN(items, n): waits for at least one item, then pops up to n;
+    * returns 0 once the queue is closed and empty
+    */
+    int popN(T* items, int n){
+        SpinWait spin;
+        while(true){
+            int count = tryPopN(items, n);
+            if(count > 0) return count;
+            if(closed.load(std::memory_order_acquire)) return tryPopN(items, n);
+            spin.wait();
+        }
+    }
+
+    /*
+    ! close(): no more pushes will come (producer side)
+    */
+    void close(){
+        closed.store(true, std::memory_order_release);
+    }
+    bool isClosed(){
+        return closed.load(std::memory_order_acquire);
+    }
+};
+
+#endif /* SPSCQUEUE_H */
@@ -0,0 +1,634 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines AVL: a height-balanced BST with order statistics (select, rank) and range summaries
+*/
+
+#ifndef AVL_H
+#define AVL_H
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <type_traits>
+#include "tree/IBST.h"
+#include "tree/ITreeWalker.h"
+#include "tree/TreeTraversal.h"
+#include "stacknqueue/ArrayQueue.h"
+#include "util/NodePool.h"
+using namespace std;
+
+/*
+! Summary policies: what AVL<K, V, Augment> keeps about every subtree (besides its size)
+? Functionality:
+    * A policy has a Summary type and two static functions:
+        - Summary of(K& key, V& value): the summary of one entry;
+        - Summary combine(const Summary& left, const Summary& right): the summary of two
+          adjacent key ranges, left before right (must be associative).
+    * AVLNoSummary keeps nothing; AVLSum, AVLMin and AVLMax fold the keys (or, with a
+      Field such as the one below, any number derived from an entry).
+? Usage:
+    * struct Latency{ typedef double Type; static double get(long& time, Sample*& s){ return s->ms; } };
+    * AVL<long, Sample*, AVLMax<long, Sample*, Latency>> log;  //log.aggregate(t1, t2, found): worst latency
+*/
+template<class K, class V>
+struct AVLKey{
+    typedef K Type;
+    static K get(K& key, V& /*value*/){
+        return key;
+    }
+};
+template<class K, class V>
+struct AVLNoSummary{
+    struct Summary{};
+    static Summary of(K& /*key*/, V& /*value*/){
+        return Summary();
+    }
+    static Summary combine(const Summary& /*left*/, const Summary& /*right*/){
+        return Summary();
+    }
+};
+template<class K, class V, class Field=AVLKey<K, V>>
+struct AVLSum{
+    typedef typename Field::Type Summary;
+    static Summary of(K& key, V& value){
+        return Field::get(key, value);
+    }
+    static Summary combine(const Summary& left, const Summary& right){
+        return left + right;
+    }
+};
+template<class K, class V, class Field=AVLKey<K, V>>
+struct AVLMin{
+    typedef typename Field::Type Summary;
+    static Summary of(K& key, V& value){
+        return Field::get(key, value);
+    }
+    static Summary combine(const Summary& left, const Summary& right){
+        return right < left ? right : left;
+    }
+};
+template<class K, class V, class Field=AVLKey<K, V>>
+struct AVLMax{
+    typedef typename Field::Type Summary;
+    static Summary of(K& key, V& value){
+        return Field::get(key, value);
+    }
+    static Summary combine(const Summary& left, const Summary& right){
+        return left < right ? right : left;
+    }
+};
+
+/*
+! AVL<K, V, Augment>
+? Functionality:
+    * Binary search tree behind IBST<K, V>, rebalanced by rotations so that the heights
+      of the two subtrees of any node differ by at most one (height <= 1.44 log2(n)).
+    * Every node also stores the size of its subtree, which gives order statistics:
+        - kth(k): the key of rank k (0-based, ascending); k-th largest: kth(size() - 1 - k)
+        - rank(key): how many keys are smaller than key
+        - countRange(lo, hi): how many keys lie in [lo, hi]
+    * Augment (a summary policy, see above) adds one more field per subtree;
+      aggregate(lo, hi, found) combines it over the keys in [lo, hi];
+      select(lo, hi) lists the values with keys in [lo, hi].
+    * multiset=true (constructor) keeps equal keys as separate entries (a sample of
+      scores, latencies...): add() inserts after the equal ones and remove() takes one.
+      Otherwise add() of a key that is present replaces its value.
+    * buildFromSorted(keys, values, n) replaces the content with a perfectly balanced
+      tree of sorted entries; merge(tree) adds the entries of another tree.
+    * The nodes come from a NodePool owned by the tree: add() takes a slot instead of
+      calling new, and clear() drops every node at once and keeps the memory for the
+      next batch (it is freed with the tree).
+? Complexity:
+    * add, remove, search, kth, rank, countRange, aggregate: O(log n).
+    * buildFromSorted: O(n), no rotation; merge: O(n + m).
+    * walk(order) / traverse(visit, order): O(n) for a full walk, without recursion;
+      traverseRange(lo, hi, visit): O(log n + number of entries in [lo, hi]).
+? Notes:
+    * K needs operator< (the only comparison used); V is usually a pointer type (see IBST.h).
+? Usage:
+    * AVL<double, int*> scores(true);
+    * scores.add(12.5); scores.add(3.0); scores.add(12.5);
+    * double median = scores.kth(scores.size() / 2);
+    * int below = scores.rank(10.0);
+*/
+//balance factors (bfactor(), toString(..., true)); sEMPTY marks a missing child
+const string sLH = "LH", sEH = "EH", sRH = "RH", sEMPTY = ".";
+
+template<class K, class V, class Augment=AVLNoSummary<K, V>>
+class AVL: public IBST<K, V>, public ITreeWalker<K, V>{
+public:
+    class Iterator; //forward declaration
+    class Range;    //forward declaration
+    typedef typename Augment::Summary Summary;
+
+protected:
+    struct Node{
+        K key;
+        V value;
+        Node* left;
+        Node* right;
+        int size;           //number of entries in this subtree
+        int height;         //1 for a leaf
+        Summary summary;    //Augment's summary of this subtree
+    };
+
+    Node* root;
+    bool multiset;
+    NodePool<Node> pool;
+
+public:
+    AVL(bool multiset=false){
+        this->root = 0;
+        this->multiset = multiset;
+    }
+    AVL(const AVL<K, V, Augment>& tree){
+        this->root = copyNode(tree.root);
+        this->multiset = tree.multiset;
+    }
+    AVL<K, V, Augment>& operator=(const AVL<K, V, Augment>& tree){
+        if(this == &tree) return *this;
+        clear();
+        this->root = copyNode(tree.root);
+        this->multiset = tree.multiset;
+        return *this;
+    }
+    ~AVL(){
+        clear();
+    }
+
+    /*
+    ! add(key, value): insert key (or replace its value, unless the tree is a multiset)
+    */
+    void add(K key, V value=0){
+        root = insert(root, key, value);
+    }
+
+    /*
+    ! remove(key, success): remove key (one entry of it in a multiset)
+    ? Return:
+        * V: the value stored with key (V() if key was not found; *success tells which)
+    */
+    V remove(K key, bool* success=0){
+        V value = V();
+        bool found = false;
+        root = erase(root, key, value, found);
+        if(success != 0) *success = found;
+        return value;
+    }
+
+    /*
+    ! search(key, found): the value stored with key (V() and found=false if absent)
+    */
+    V search(K key, bool& found){
+        Node* node = root;
+        while(node != 0){
+            if(key < node->key) node = node->left;
+            else if(node->key < key) node = node->right;
+            else{
+                found = true;
+                return node->value;
+            }
+        }
+        found = false;
+        return V();
+    }
+
+    int size(){
+        return sizeOf(root);
+    }
+    int height(){
+        return heightOf(root);
+    }
+    bool empty(){
+        return root == 0;
+    }
+    void clear(){
+        if(!std::is_trivially_destructible<Node>::value) removeNode(root);
+        pool.reset();
+        root = 0;
+    }
+
+    /*
+    ! buildFromSorted(keys, values, n): replace the content with n entries in O(n)
+    ? Functionality:
+        * keys must be strictly ascending (non-descending for a multiset); values may be
+          null (every value is then V()).
+        * The middle entry becomes the root and each half is built the same way, so the
+          tree is perfectly balanced (height ceil(log2(n + 1))) without any rotation.
+    ? Exceptions:
+        * std::invalid_argument if n < 0 or the keys are out of order (the tree is left unchanged)
+    */
+    void buildFromSorted(const K* keys, const V* values, int n){
+        if(n < 0) throw std::invalid_argument("AVL: negative number of keys");
+        for(int idx=1; idx < n; idx++){
+            if(multiset ? keys[idx] < keys[idx - 1] : !(keys[idx - 1] < keys[idx]))
+                throw std::invalid_argument("AVL: buildFromSorted needs ascending keys");
+        }
+        clear();
+        root = buildBalanced(keys, values, 0, n - 1);
+    }
+
+    /*
+    ! merge(tree): add every entry of tree in O(n + m)
+    * The two in-order sequences are merged and the tree is rebuilt (see buildFromSorted).
+    * On equal keys the value from tree replaces this one, as add() would; a multiset keeps
+      both, the one from tree after. tree itself is not modified (it may be *this).
+    */
+    void merge(AVL<K, V, Augment>& tree){
+        vector<K> keys;
+        vector<V> values;
+        keys.reserve(size() + tree.size());
+        values.reserve(size() + tree.size());
+        Range mine = walk(), theirs = tree.walk();
+        Iterator left = mine.begin(), right = theirs.begin();
+        Iterator leftEnd = mine.end(), rightEnd = theirs.end();
+        while(left != leftEnd || right != rightEnd){
+            bool takeLeft = right == rightEnd || (left != leftEnd && !(right.key() < left.key()));
+            Iterator& from = takeLeft ? left : right;
+            if(!multiset && !keys.empty() && !(keys.back() < from.key())) values.back() = from.value();
+            else{
+                keys.push_back(from.key());
+                values.push_back(from.value());
+            }
+            ++from;
+        }
+        clear();
+        root = buildBalanced(keys.data(), values.data(), 0, (int)keys.size() - 1);
+    }
+
+    /*
+    ! kth(k): the key of rank k, i.e. the (k+1)-th smallest
+    ? Exceptions:
+        * std::out_of_range if k is not in 0..size()-1
+    */
+    K kth(int k){
+        if(k < 0 || k >= sizeOf(root)) throw std::out_of_range("AVL: rank is out of range");
+        Node* node = root;
+        while(true){
+            int leftSize = sizeOf(node->left);
+            if(k < leftSize) node = node->left;
+            else if(k == leftSize) return node->key;
+            else{
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+    }
+    //number of keys < key
+    int rank(K key){
+        return countBelow(key, false);
+    }
+    //number of keys in [lo, hi]
+    int countRange(K lo, K hi){
+        if(hi < lo) return 0;
+        return countBelow(hi, true) - countBelow(lo, false);
+    }
+
+    /*
+    ! aggregate(lo, hi, found): Augment's summary of the entries with lo <= key <= hi
+    * found is false (and the result a default Summary) if there is no such entry.
+    */
+    Summary aggregate(K lo, K hi, bool& found){
+        Summary result = Summary();
+        found = false;
+        if(!(hi < lo)) fold(root, lo, hi, false, false, result, found);
+        return result;
+    }
+
+    /*
+    ! walk(order), traverse(visit, order): the entries in a TreeOrder, without building a list
+    ? Functionality:
+        * walk: a lazy range of Iterators (a BinaryTreeWalk over the nodes).
+        * traverse: calls visit(key, value) for every entry (visit: function or lambda).
+    ? Exceptions:
+        * std::invalid_argument if order is not a TreeOrder
+    */
+    Range walk(int order=TreeOrder::LNR){
+        BinaryTreeWalk<Node> nodes(root, order);
+        return Range(Iterator(nodes.begin()), Iterator(nodes.end()));
+    }
+    template<class Visitor>
+    void traverse(Visitor visit, int order=TreeOrder::LNR){
+        BinaryTreeWalk<Node>(root, order).forEach([&visit](Node* node){ visit(node->key, node->value); });
+    }
+
+    /*
+    ! traverseRange(lo, hi, visit): visit(key, value) for the entries with lo <= key <= hi, ascending
+    * Iterative (explicit stack): O(log n + number of entries visited).
+    */
+    template<class Visitor>
+    void traverseRange(K lo, K hi, Visitor visit){
+        ArrayStack<Node*> path;
+        for(Node* node=root; node != 0; node = node->key < lo ? node->right : node->left){
+            if(!(node->key < lo)) path.push(node);
+        }
+        while(!path.empty()){
+            Node* node = path.pop();
+            if(hi < node->key) return;
+            visit(node->key, node->value);
+            for(Node* next=node->right; next != 0; next = next->left) path.push(next);
+        }
+    }
+    //values of the entries with lo <= key <= hi, ascending
+    DLinkedList<V> select(K lo, K hi){
+        DLinkedList<V> list;
+        traverseRange(lo, hi, [&list](K& /*key*/, V& value){ list.add(value); });
+        return list;
+    }
+
+    DLinkedList<V> ascendingList(){
+        return valueList(TreeOrder::LNR);
+    }
+    DLinkedList<V> descendingList(){
+        return valueList(TreeOrder::RNL);
+    }
+    DLinkedList<V> dfs(){
+        return valueList(TreeOrder::NLR);
+    }
+    DLinkedList<V> bfs(){
+        return valueList(TreeOrder::BFS);
+    }
+    DLinkedList<K> bfsKey(){
+        DLinkedList<K> list;
+        traverse([&list](K& key, V& /*value*/){ list.add(key); }, TreeOrder::BFS);
+        return list;
+    }
+    DLinkedList<V> nlr(){
+        return valueList(TreeOrder::NLR);
+    }
+    DLinkedList<V> lrn(){
+        return valueList(TreeOrder::LRN);
+    }
+    DLinkedList<V> lnr(){
+        return valueList(TreeOrder::LNR);
+    }
+    //balance factors in level order: "LH" (left higher), "EH" (equal), "RH" (right higher)
+    DLinkedList<string> bfactor(){
+        DLinkedList<string> list;
+        for(Node* node: BinaryTreeWalk<Node>(root, TreeOrder::BFS)) list.add(factorOf(node));
+        return list;
+    }
+
+    /*
+    ! toString(entry2str, avl)
+    ? Format:
+        * (entry left right) for a node with children, [entry] for a leaf, [.] for no child
+        * entry: entry2str(key, value) if given, the key otherwise; avl appends ":LH", ":EH" or ":RH"
+        * Example: (40:EH (30:LH [20:EH] [.]) (50:EH [45:EH] [60:EH]))
+    */
+    string toString(string (*entry2str)(K&, V&)=0, bool avl=false){
+        stringstream os;
+        if(root == 0) os << "[" << sEMPTY << "]";
+        else nodeString(root, os, entry2str, avl);
+        return os.str();
+    }
+    void println(string (*entry2str)(K&, V&)=0, bool avl=true){
+        cout << toString(entry2str, avl) << endl;
+    }
+
+protected:
+    static int sizeOf(Node* node){
+        return node == 0 ? 0 : node->size;
+    }
+    static int heightOf(Node* node){
+        return node == 0 ? 0 : node->height;
+    }
+    static string factorOf(Node* node){
+        int factor = heightOf(node->left) - heightOf(node->right);
+        return factor > 0 ? sLH : (factor < 0 ? sRH : sEH);
+    }
+
+    Node* newNode(K& key, V& value){
+        Node* node = pool.create();
+        node->key = key;
+        node->value = value;
+        node->left = node->right = 0;
+        update(node);
+        return node;
+    }
+    //recomputes size, height and summary of node from its children
+    static void update(Node* node){
+        int leftHeight = heightOf(node->left), rightHeight = heightOf(node->right);
+        node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        Summary summary = Augment::of(node->key, node->value);
+        if(node->left != 0) summary = Augment::combine(node->left->summary, summary);
+        if(node->right != 0) summary = Augment::combine(summary, node->right->summary);
+        node->summary = summary;
+    }
+    static Node* rotateRight(Node* node){
+        Node* top = node->left;
+        node->left = top->right;
+        top->right = node;
+        update(node);
+        update(top);
+        return top;
+    }
+    static Node* rotateLeft(Node* node){
+        Node* top = node->right;
+        node->right = top->left;
+        top->left = node;
+        update(node);
+        update(top);
+        return top;
+    }
+    //updates node and restores the AVL condition at it; returns the root of the subtree
+    static Node* balance(Node* node){
+        update(node);
+        int factor = heightOf(node->left) - heightOf(node->right);
+        if(factor > 1){
+            if(heightOf(node->left->left) < heightOf(node->left->right)) node->left = rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if(factor < -1){
+            if(heightOf(node->right->right) < heightOf(node->right->left)) node->right = rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    Node* insert(Node* node, K& key, V& value){
+        if(node == 0) return newNode(key, value);
+        if(key < node->key) node->left = insert(node->left, key, value);
+        else if(multiset || node->key < key) node->right = insert(node->right, key, value);
+        else node->value = value;
+        return balance(node);
+    }
+    Node* erase(Node* node, K& key, V& value, bool& found){
+        if(node == 0) return 0;
+        if(key < node->key) node->left = erase(node->left, key, value, found);
+        else if(node->key < key) node->right = erase(node->right, key, value, found);
+        else{
+            found = true;
+            value = node->value;
+            Node* replacement;
+            if(node->left == 0 || node->right == 0) replacement = node->left != 0 ? node->left : node->right;
+            else{
+                //the in-order successor takes the place of node
+                Node* successor;
+                Node* right = detachMin(node->right, successor);
+                successor->left = node->left;
+                successor->right = right;
+                replacement = successor;
+            }
+            pool.destroy(node);
+            return replacement == 0 ? 0 : balance(replacement);
+        }
+        return balance(node);
+    }
+    //removes the smallest node of the subtree (handed back in min); returns the new subtree
+    static Node* detachMin(Node* node, Node*& min){
+        if(node->left == 0){
+            min = node;
+            return node->right;
+        }
+        node->left = detachMin(node->left, min);
+        return balance(node);
+    }
+
+    //number of keys < key (inclusive: <= key)
+    int countBelow(K& key, bool inclusive){
+        int count = 0;
+        Node* node = root;
+        while(node != 0){
+            bool below = inclusive ? !(key < node->key) : node->key < key;
+            if(below){
+                count += sizeOf(node->left) + 1;
+                node = node->right;
+            }
+            else node = node->left;
+        }
+        return count;
+    }
+    //folds the summaries of the keys in [lo, hi] under node into result, in key order;
+    //loOpen / hiOpen: every key of the subtree is known to be >= lo / <= hi
+    void fold(Node* node, K& lo, K& hi, bool loOpen, bool hiOpen, Summary& result, bool& found){
+        while(node != 0){
+            if(loOpen && hiOpen){
+                append(node->summary, result, found);
+                return;
+            }
+            if(!loOpen && node->key < lo) node = node->right;
+            else if(!hiOpen && hi < node->key) node = node->left;
+            else{
+                fold(node->left, lo, hi, loOpen, true, result, found);
+                append(Augment::of(node->key, node->value), result, found);
+                node = node->right;
+                loOpen = true;
+            }
+        }
+    }
+    static void append(const Summary& summary, Summary& result, bool& found){
+        result = found ? Augment::combine(result, summary) : summary;
+        found = true;
+    }
+
+    DLinkedList<V> valueList(int order){
+        DLinkedList<V> list;
+        traverse([&list](K& /*key*/, V& value){ list.add(value); }, order);
+        return list;
+    }
+    Node* copyNode(Node* node){
+        if(node == 0) return 0;
+        Node* copy = pool.create(*node);
+        copy->left = copyNode(node->left);
+        copy->right = copyNode(node->right);
+        return copy;
+    }
+    void removeNode(Node* node){
+        if(node == 0) return;
+        removeNode(node->left);
+        removeNode(node->right);
+        pool.destroy(node);
+    }
+    //perfectly balanced subtree of the sorted entries lo..hi
+    Node* buildBalanced(const K* keys, const V* values, int lo, int hi){
+        if(lo > hi) return 0;
+        int mid = lo + (hi - lo) / 2;
+        Node* node = pool.create();
+        node->key = keys[mid];
+        node->value = values != 0 ? values[mid] : V();
+        node->left = buildBalanced(keys, values, lo, mid - 1);
+        node->right = buildBalanced(keys, values, mid + 1, hi);
+        update(node);
+        return node;
+    }
+    void nodeString(Node* node, stringstream& os, string (*entry2str)(K&, V&), bool avl){
+        bool leaf = node->left == 0 && node->right == 0;
+        os << (leaf ? "[" : "(");
+        if(entry2str != 0) os << entry2str(node->key, node->value);
+        else os << node->key;
+        if(avl) os << ":" << factorOf(node);
+        if(leaf){
+            os << "]";
+            return;
+        }
+        os << " ";
+        if(node->left != 0) nodeString(node->left, os, entry2str, avl);
+        else os << "[" << sEMPTY << "]";
+        os << " ";
+        if(node->right != 0) nodeString(node->right, os, entry2str, avl);
+        else os << "[" << sEMPTY << "]";
+        os << ")";
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//Iterator: BEGIN, an entry of a walk
+    class Iterator{
+    private:
+        typename BinaryTreeWalk<Node>::Iterator nodes;
+    public:
+        Iterator(typename BinaryTreeWalk<Node>::Iterator nodes): nodes(nodes){}
+        K& key(){
+            return (*nodes)->key;
+        }
+        V& value(){
+            return (*nodes)->value;
+        }
+        V& operator*(){
+            return (*nodes)->value;
+        }
+        bool operator!=(const Iterator& iterator) const{
+            return nodes != iterator.nodes;
+        }
+        bool operator==(const Iterator& iterator) const{
+            return nodes == iterator.nodes;
+        }
+        //Prefix ++ overload
+        Iterator& operator++(){
+            ++nodes;
+            return *this;
+        }
+        //Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            ++nodes;
+            return iterator;
+        }
+    };
+//Iterator: END
+
+//Range: BEGIN, [first, last) of a walk, usable in a range-for
+    class Range{
+    private:
+        Iterator first;
+        Iterator last;
+    public:
+        Range(Iterator first, Iterator last): first(first), last(last){}
+        Iterator begin(){
+            return first;
+        }
+        Iterator end(){
+            return last;
+        }
+    };
+//Range: END
+};
+
+#endif /* AVL_H */
@@ -0,0 +1,766 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines BPlusTree: an in-memory B+-tree with cache-line sized nodes and linked leaves
+*/
+
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include "tree/IBST.h"
+#include "tree/ITreeWalker.h"
+#include "tree/TreeTraversal.h"
+#include "stacknqueue/ArrayQueue.h"
+using namespace std;
+
+/*
+! BPlusTree<K, V, NODE_BYTES>
+? Functionality:
+    * Ordered map behind the IBST<K, V> interface. The entries are kept sorted in the
+      leaves and the leaves are chained (prev/next), so a range scan walks contiguous
+      arrays instead of chasing one pointer per key. Inner nodes only hold separators.
+    * Every node is one block of about NODE_BYTES bytes (a few cache lines), aligned
+      to 64: LEAF_CAPACITY entries per leaf and INNER_CAPACITY keys per inner node are
+      derived from sizeof(K) and sizeof(V). With int keys, pointer values and the
+      default 512 bytes, a leaf holds 40 entries and an inner node 41 keys: a lookup
+      in 10^6 keys reads 4 nodes, where a binary tree reads about 20.
+    * add() of a key that is already present replaces its value.
+    * Appending after the largest key splits the last leaf unevenly (full / 1 entry),
+      so ascending insertion leaves the leaves full instead of half full.
+? Complexity:
+    * add, remove, search, lowerBound, upperBound: O(log n).
+    * range(lo, hi): O(log n + number of entries in [lo, hi]).
+    * buildFromSorted: O(n).
+? Notes:
+    * K needs operator< (the only comparison used), a default constructor and
+      assignment; V is usually a pointer type (see IBST.h).
+    * Iterators are invalidated by add, remove, clear and buildFromSorted.
+    * The values only live in the leaves, so every value order (dfs, bfs, nlr, lnr,
+      lrn, and TreeOrder::NLR, LNR, LRN, BFS in walk/traverse) is the ascending order
+      and TreeOrder::RNL the descending one; bfsKey lists the separator keys level by
+      level, followed by the keys of the leaves.
+? Usage:
+    * BPlusTree<int, Point*> tree;
+    * tree.add(5, p5); tree.add(1, p1);
+    * for(auto it = tree.lowerBound(3); it != tree.end(); it++) cout << it.key();
+    * for(Point*& point: tree.range(10, 20)) ...    //keys in [10, 20]
+    * tree.traverse([&](int& key, Point*& point){ ... }, TreeOrder::RNL);
+*/
+template<class K, class V, int NODE_BYTES=512>
+class BPlusTree: public IBST<K, V>, public ITreeWalker<K, V>{
+public:
+    class Iterator; //forward declaration
+    class Range;    //forward declaration
+
+    static const int INNER_CAPACITY = (NODE_BYTES - 16) / (int)(sizeof(K) + sizeof(void*)) > 3 ?
+                                      (NODE_BYTES - 16) / (int)(sizeof(K) + sizeof(void*)) : 3;
+    static const int LEAF_CAPACITY = (NODE_BYTES - 24) / (int)(sizeof(K) + sizeof(V)) > 3 ?
+                                     (NODE_BYTES - 24) / (int)(sizeof(K) + sizeof(V)) : 3;
+    //a node (other than the root) with fewer keys than this is refilled after a removal
+    static const int INNER_MIN = INNER_CAPACITY / 2;
+    static const int LEAF_MIN = LEAF_CAPACITY / 2;
+
+protected:
+    struct Node{
+        int count;      //number of keys
+        bool isLeaf;
+    };
+    //children[idx] holds the keys in [keys[idx - 1], keys[idx])
+    struct alignas(64) Inner: Node{
+        K keys[INNER_CAPACITY];
+        Node* children[INNER_CAPACITY + 1];
+    };
+    struct alignas(64) Leaf: Node{
+        Leaf* prev;
+        Leaf* next;
+        K keys[LEAF_CAPACITY];
+        V values[LEAF_CAPACITY];
+    };
+
+    Node* root;
+    Leaf* head;     //leftmost leaf
+    Leaf* tail;     //rightmost leaf
+    int count;
+    int levels;
+
+public:
+    BPlusTree(){
+        this->root = 0;
+        this->head = this->tail = 0;
+        this->count = 0;
+        this->levels = 0;
+    }
+    BPlusTree(const BPlusTree<K, V, NODE_BYTES>& tree): BPlusTree(){
+        copyFrom(tree);
+    }
+    BPlusTree<K, V, NODE_BYTES>& operator=(const BPlusTree<K, V, NODE_BYTES>& tree){
+        if(this == &tree) return *this;
+        copyFrom(tree);
+        return *this;
+    }
+    ~BPlusTree(){
+        clear();
+    }
+
+    /*
+    ! add(key, value): insert key, or replace its value if key is already present
+    */
+    void add(K key, V value=0){
+        if(root == 0){
+            Leaf* leaf = newLeaf();
+            root = head = tail = leaf;
+            levels = 1;
+        }
+        K separator;
+        Node* sibling;
+        if(insert(root, key, value, separator, sibling)) count++;
+        if(sibling != 0){
+            Inner* top = newInner();
+            top->count = 1;
+            top->keys[0] = separator;
+            top->children[0] = root;
+            top->children[1] = sibling;
+            root = top;
+            levels++;
+        }
+    }
+
+    /*
+    ! remove(key, success): remove key
+    ? Return:
+        * V: the value stored with key (V() if key was not found; *success tells which)
+    */
+    V remove(K key, bool* success=0){
+        V value = V();
+        bool found = root != 0 && erase(root, key, value);
+        if(found){
+            count--;
+            if(root->isLeaf && root->count == 0){
+                delete (Leaf*)root;
+                root = head = tail = 0;
+                levels = 0;
+            }
+            else if(!root->isLeaf && root->count == 0){
+                Inner* top = (Inner*)root;
+                root = top->children[0];
+                delete top;
+                levels--;
+            }
+        }
+        if(success != 0) *success = found;
+        return value;
+    }
+
+    /*
+    ! search(key, found): the value stored with key (V() and found=false if absent)
+    */
+    V search(K key, bool& found){
+        found = false;
+        if(root == 0) return V();
+        Leaf* leaf = findLeaf(key);
+        int pos = lowerIndex(leaf->keys, leaf->count, key);
+        if(pos == leaf->count || key < leaf->keys[pos]) return V();
+        found = true;
+        return leaf->values[pos];
+    }
+
+    int size(){
+        return count;
+    }
+    //number of levels: 0 if empty, 1 if the root is a leaf
+    int height(){
+        return levels;
+    }
+    bool empty(){
+        return count == 0;
+    }
+    void clear(){
+        if(root != 0) removeNode(root);
+        root = head = tail = 0;
+        count = 0;
+        levels = 0;
+    }
+
+    /*
+    ! buildFromSorted(keys, values, n): replace the content with n entries in O(n)
+    ? Functionality:
+        * keys must be strictly ascending; values may be null (every value is then V()).
+        * The leaves are packed (n spread evenly over ceil(n / LEAF_CAPACITY) leaves)
+          and each inner level is built from the one below, without any split.
+    ? Exceptions:
+        * std::invalid_argument if n < 0 or the keys are not strictly ascending
+          (the tree is left unchanged)
+    */
+    void buildFromSorted(const K* keys, const V* values, int n){
+        if(n < 0) throw std::invalid_argument("BPlusTree: negative number of keys");
+        for(int idx=1; idx < n; idx++){
+            if(!(keys[idx - 1] < keys[idx]))
+                throw std::invalid_argument("BPlusTree: buildFromSorted needs strictly ascending keys");
+        }
+        clear();
+        if(n == 0) return;
+
+        int nleaves = (n + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+        vector<Node*> level(nleaves);
+        vector<K> lowest(nleaves);    //smallest key under each node of the level
+        Leaf* previous = 0;
+        for(int idx=0, from=0; idx < nleaves; idx++){
+            int take = n / nleaves + (idx < n % nleaves ? 1 : 0);
+            Leaf* leaf = newLeaf();
+            for(int pos=0; pos < take; pos++){
+                leaf->keys[pos] = keys[from + pos];
+                leaf->values[pos] = values != 0 ? values[from + pos] : V();
+            }
+            leaf->count = take;
+            leaf->prev = previous;
+            if(previous != 0) previous->next = leaf;
+            else head = leaf;
+            level[idx] = leaf;
+            lowest[idx] = keys[from];
+            previous = leaf;
+            from += take;
+        }
+        tail = previous;
+        levels = 1;
+
+        while(level.size() > 1){
+            int nchildren = (int)level.size();
+            int nnodes = (nchildren + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+            vector<Node*> upper(nnodes);
+            vector<K> upperLowest(nnodes);
+            for(int idx=0, from=0; idx < nnodes; idx++){
+                int take = nchildren / nnodes + (idx < nchildren % nnodes ? 1 : 0);
+                Inner* inner = newInner();
+                for(int child=0; child < take; child++){
+                    inner->children[child] = level[from + child];
+                    if(child > 0) inner->keys[child - 1] = lowest[from + child];
+                }
+                inner->count = take - 1;
+                upper[idx] = inner;
+                upperLowest[idx] = lowest[from];
+                from += take;
+            }
+            level.swap(upper);
+            lowest.swap(upperLowest);
+            levels++;
+        }
+        root = level[0];
+        count = n;
+    }
+
+    /*
+    ! begin(), end(), lowerBound(key), upperBound(key), range(lo, hi)
+    ? Functionality:
+        * Iterators along the leaf chain, in ascending key order.
+        * lowerBound: first entry with key >= given key; upperBound: first with key > given key.
+        * range(lo, hi): the entries with lo <= key <= hi, usable in a range-for.
+    */
+    Iterator begin(){
+        return Iterator(head, 0);
+    }
+    Iterator end(){
+        return Iterator(0, 0);
+    }
+    Iterator lowerBound(K key){
+        if(root == 0) return end();
+        Leaf* leaf = findLeaf(key);
+        return Iterator(leaf, lowerIndex(leaf->keys, leaf->count, key));
+    }
+    Iterator upperBound(K key){
+        if(root == 0) return end();
+        Leaf* leaf = findLeaf(key);
+        return Iterator(leaf, upperIndex(leaf->keys, leaf->count, key));
+    }
+    Range range(K lo, K hi){
+        if(hi < lo) return Range(end(), end());
+        return Range(lowerBound(lo), upperBound(hi));
+    }
+
+    /*
+    ! walk(order), traverse(visit, order): the entries in a TreeOrder, without building a list
+    ? Functionality:
+        * walk: a lazy range of Iterators along the leaf chain (backwards for RNL).
+        * traverse: calls visit(key, value) for every entry (visit: function or lambda).
+    ? Exceptions:
+        * std::invalid_argument if order is not a TreeOrder
+    */
+    Range walk(int order=TreeOrder::LNR){
+        checkOrder(order);
+        if(order == TreeOrder::RNL) return Range(Iterator(tail, tail != 0 ? tail->count - 1 : 0, true), end());
+        return Range(begin(), end());
+    }
+    template<class Visitor>
+    void traverse(Visitor visit, int order=TreeOrder::LNR){
+        checkOrder(order);
+        if(order == TreeOrder::RNL){
+            for(Leaf* leaf=tail; leaf != 0; leaf = leaf->prev){
+                for(int pos=leaf->count - 1; pos >= 0; pos--) visit(leaf->keys[pos], leaf->values[pos]);
+            }
+            return;
+        }
+        for(Leaf* leaf=head; leaf != 0; leaf = leaf->next){
+            for(int pos=0; pos < leaf->count; pos++) visit(leaf->keys[pos], leaf->values[pos]);
+        }
+    }
+
+    DLinkedList<V> ascendingList(){
+        DLinkedList<V> list;
+        traverse([&list](K& /*key*/, V& value){ list.add(value); });
+        return list;
+    }
+    DLinkedList<V> descendingList(){
+        DLinkedList<V> list;
+        traverse([&list](K& /*key*/, V& value){ list.add(value); }, TreeOrder::RNL);
+        return list;
+    }
+
+    //values are only stored in the leaves: every walk below yields them in ascending order
+    DLinkedList<V> dfs(){
+        return ascendingList();
+    }
+    DLinkedList<V> bfs(){
+        return ascendingList();
+    }
+    DLinkedList<V> nlr(){
+        return ascendingList();
+    }
+    DLinkedList<V> lrn(){
+        return ascendingList();
+    }
+    DLinkedList<V> lnr(){
+        return ascendingList();
+    }
+    /*
+    ! bfsKey(): the keys of the nodes in level order (separators first, then the leaf keys)
+    */
+    DLinkedList<K> bfsKey(){
+        DLinkedList<K> list;
+        if(root == 0) return list;
+        ArrayQueue<Node*> queue;
+        queue.push(root);
+        while(!queue.empty()){
+            Node* node = queue.pop();
+            if(node->isLeaf){
+                Leaf* leaf = (Leaf*)node;
+                for(int pos=0; pos < leaf->count; pos++) list.add(leaf->keys[pos]);
+                continue;
+            }
+            Inner* inner = (Inner*)node;
+            for(int pos=0; pos < inner->count; pos++) list.add(inner->keys[pos]);
+            for(int child=0; child <= inner->count; child++) queue.push(inner->children[child]);
+        }
+        return list;
+    }
+
+    /*
+    ! toString(entry2str, avl)
+    ? Format:
+        * leaf: [e1, e2, ...]; inner node: (<k1, k2, ...> child0 child1 ...)
+        * e: entry2str(key, value) if given, the key otherwise; avl is ignored.
+        * Example: (<10, 20> [1, 5] [10, 12] [20, 25])
+    */
+    string toString(string (*entry2str)(K&, V&)=0, bool /*avl*/=false){
+        stringstream os;
+        if(root == 0) os << "[]";
+        else nodeString(root, os, entry2str);
+        return os.str();
+    }
+    void println(string (*entry2str)(K&, V&)=0){
+        cout << toString(entry2str) << endl;
+    }
+
+protected:
+    Leaf* newLeaf(){
+        Leaf* leaf = new Leaf;
+        leaf->count = 0;
+        leaf->isLeaf = true;
+        leaf->prev = leaf->next = 0;
+        return leaf;
+    }
+    Inner* newInner(){
+        Inner* inner = new Inner;
+        inner->count = 0;
+        inner->isLeaf = false;
+        return inner;
+    }
+    void removeNode(Node* node){
+        if(node->isLeaf){
+            delete (Leaf*)node;
+            return;
+        }
+        Inner* inner = (Inner*)node;
+        for(int child=0; child <= inner->count; child++) removeNode(inner->children[child]);
+        delete inner;
+    }
+    void copyFrom(const BPlusTree<K, V, NODE_BYTES>& tree){
+        vector<K> keys;
+        vector<V> values;
+        keys.reserve(tree.count);
+        values.reserve(tree.count);
+        for(Leaf* leaf=tree.head; leaf != 0; leaf = leaf->next){
+            for(int pos=0; pos < leaf->count; pos++){
+                keys.push_back(leaf->keys[pos]);
+                values.push_back(leaf->values[pos]);
+            }
+        }
+        buildFromSorted(keys.data(), values.data(), (int)keys.size());
+    }
+
+    static void checkOrder(int order){
+        if(order < TreeOrder::NLR || order > TreeOrder::BFS)
+            throw std::invalid_argument("BPlusTree: unknown traversal order");
+    }
+
+    //first position whose key is not less than key
+    static int lowerIndex(const K* keys, int count, const K& key){
+        int low = 0;
+        while(count > 0){
+            int half = count >> 1;
+            if(keys[low + half] < key){
+                low += half + 1;
+                count -= half + 1;
+            }
+            else count = half;
+        }
+        return low;
+    }
+    //first position whose key is greater than key
+    static int upperIndex(const K* keys, int count, const K& key){
+        int low = 0;
+        while(count > 0){
+            int half = count >> 1;
+            if(!(key < keys[low + half])){
+                low += half + 1;
+                count -= half + 1;
+            }
+            else count = half;
+        }
+        return low;
+    }
+
+    Leaf* findLeaf(const K& key){
+        Node* node = root;
+        while(!node->isLeaf){
+            Inner* inner = (Inner*)node;
+            node = inner->children[upperIndex(inner->keys, inner->count, key)];
+        }
+        return (Leaf*)node;
+    }
+
+    static void insertEntry(Leaf* leaf, int pos, K key, V value){
+        for(int idx=leaf->count; idx > pos; idx--){
+            leaf->keys[idx] = std::move(leaf->keys[idx - 1]);
+            leaf->values[idx] = std::move(leaf->values[idx - 1]);
+        }
+        leaf->keys[pos] = std::move(key);
+        leaf->values[pos] = std::move(value);
+        leaf->count++;
+    }
+    static void eraseEntry(Leaf* leaf, int pos){
+        for(int idx=pos; idx + 1 < leaf->count; idx++){
+            leaf->keys[idx] = std::move(leaf->keys[idx + 1]);
+            leaf->values[idx] = std::move(leaf->values[idx + 1]);
+        }
+        leaf->count--;
+    }
+
+    /*
+    ! insert(node, key, value, separator, sibling): add into the subtree of node
+    ? Return:
+        * bool: true if key was new
+        * sibling: the new right half if node was split (0 otherwise), its lowest key in separator
+    */
+    bool insert(Node* node, K& key, V& value, K& separator, Node*& sibling){
+        sibling = 0;
+        if(node->isLeaf) return insertLeaf((Leaf*)node, key, value, separator, sibling);
+        Inner* inner = (Inner*)node;
+        int slot = upperIndex(inner->keys, inner->count, key);
+        K childSeparator;
+        Node* childSibling;
+        bool added = insert(inner->children[slot], key, value, childSeparator, childSibling);
+        if(childSibling != 0) insertChild(inner, slot, childSeparator, childSibling, separator, sibling);
+        return added;
+    }
+    bool insertLeaf(Leaf* leaf, K& key, V& value, K& separator, Node*& sibling){
+        int pos = lowerIndex(leaf->keys, leaf->count, key);
+        if(pos < leaf->count && !(key < leaf->keys[pos])){
+            leaf->values[pos] = value;
+            return false;
+        }
+        if(leaf->count < LEAF_CAPACITY){
+            insertEntry(leaf, pos, key, value);
+            return true;
+        }
+        //split: the first "keep" of the LEAF_CAPACITY + 1 entries stay here
+        int keep = (leaf->next == 0 && pos == leaf->count) ? LEAF_CAPACITY : (LEAF_CAPACITY + 1) / 2;
+        Leaf* right = newLeaf();
+        int moveFrom = pos < keep ? keep - 1 : keep;
+        for(int idx=moveFrom; idx < LEAF_CAPACITY; idx++){
+            right->keys[idx - moveFrom] = std::move(leaf->keys[idx]);
+            right->values[idx - moveFrom] = std::move(leaf->values[idx]);
+        }
+        right->count = LEAF_CAPACITY - moveFrom;
+        leaf->count = moveFrom;
+        if(pos < keep) insertEntry(leaf, pos, key, value);
+        else insertEntry(right, pos - keep, key, value);
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if(leaf->next != 0) leaf->next->prev = right;
+        else tail = right;
+        leaf->next = right;
+        separator = right->keys[0];
+        sibling = right;
+        return true;
+    }
+    //puts (key, child) at keys[slot] / children[slot + 1] of inner, splitting inner if it is full
+    void insertChild(Inner* inner, int slot, K& key, Node* child, K& separator, Node*& sibling){
+        if(inner->count < INNER_CAPACITY){
+            for(int idx=inner->count; idx > slot; idx--){
+                inner->keys[idx] = std::move(inner->keys[idx - 1]);
+                inner->children[idx + 1] = inner->children[idx];
+            }
+            inner->keys[slot] = key;
+            inner->children[slot + 1] = child;
+            inner->count++;
+            return;
+        }
+        K keys[INNER_CAPACITY + 1];
+        Node* children[INNER_CAPACITY + 2];
+        for(int idx=0; idx < slot; idx++) keys[idx] = std::move(inner->keys[idx]);
+        keys[slot] = key;
+        for(int idx=slot; idx < INNER_CAPACITY; idx++) keys[idx + 1] = std::move(inner->keys[idx]);
+        for(int idx=0; idx <= slot; idx++) children[idx] = inner->children[idx];
+        children[slot + 1] = child;
+        for(int idx=slot + 1; idx <= INNER_CAPACITY; idx++) children[idx + 1] = inner->children[idx];
+
+        //keys[half] moves up; the keys after it go to the new right node
+        int half = INNER_CAPACITY / 2;
+        Inner* right = newInner();
+        for(int idx=0; idx < half; idx++) inner->keys[idx] = std::move(keys[idx]);
+        for(int idx=0; idx <= half; idx++) inner->children[idx] = children[idx];
+        inner->count = half;
+        for(int idx=half + 1; idx <= INNER_CAPACITY; idx++) right->keys[idx - half - 1] = std::move(keys[idx]);
+        for(int idx=half + 1; idx <= INNER_CAPACITY + 1; idx++) right->children[idx - half - 1] = children[idx];
+        right->count = INNER_CAPACITY - half;
+        separator = std::move(keys[half]);
+        sibling = right;
+    }
+
+    /*
+    ! erase(node, key, value): remove key from the subtree of node
+    * Children that fall below their minimum are refilled from a sibling or merged.
+    */
+    bool erase(Node* node, K& key, V& value){
+        if(node->isLeaf){
+            Leaf* leaf = (Leaf*)node;
+            int pos = lowerIndex(leaf->keys, leaf->count, key);
+            if(pos == leaf->count || key < leaf->keys[pos]) return false;
+            value = leaf->values[pos];
+            eraseEntry(leaf, pos);
+            return true;
+        }
+        Inner* inner = (Inner*)node;
+        int slot = upperIndex(inner->keys, inner->count, key);
+        if(!erase(inner->children[slot], key, value)) return false;
+        Node* child = inner->children[slot];
+        if(child->count < (child->isLeaf ? LEAF_MIN : INNER_MIN)) rebalance(inner, slot);
+        return true;
+    }
+    void rebalance(Inner* parent, int slot){
+        Node* child = parent->children[slot];
+        Node* left = slot > 0 ? parent->children[slot - 1] : 0;
+        Node* right = slot < parent->count ? parent->children[slot + 1] : 0;
+        int minimum = child->isLeaf ? LEAF_MIN : INNER_MIN;
+        if(left != 0 && left->count > minimum) borrowLeft(parent, slot);
+        else if(right != 0 && right->count > minimum) borrowRight(parent, slot);
+        else if(left != 0) merge(parent, slot - 1);
+        else merge(parent, slot);
+    }
+    //moves the last entry (or child) of children[slot - 1] to the front of children[slot]
+    void borrowLeft(Inner* parent, int slot){
+        if(parent->children[slot]->isLeaf){
+            Leaf* leaf = (Leaf*)parent->children[slot];
+            Leaf* from = (Leaf*)parent->children[slot - 1];
+            insertEntry(leaf, 0, from->keys[from->count - 1], from->values[from->count - 1]);
+            from->count--;
+            parent->keys[slot - 1] = leaf->keys[0];
+            return;
+        }
+        Inner* inner = (Inner*)parent->children[slot];
+        Inner* from = (Inner*)parent->children[slot - 1];
+        inner->children[inner->count + 1] = inner->children[inner->count];
+        for(int idx=inner->count; idx > 0; idx--){
+            inner->keys[idx] = std::move(inner->keys[idx - 1]);
+            inner->children[idx] = inner->children[idx - 1];
+        }
+        inner->keys[0] = std::move(parent->keys[slot - 1]);
+        inner->children[0] = from->children[from->count];
+        inner->count++;
+        parent->keys[slot - 1] = std::move(from->keys[from->count - 1]);
+        from->count--;
+    }
+    //moves the first entry (or child) of children[slot + 1] to the end of children[slot]
+    void borrowRight(Inner* parent, int slot){
+        if(parent->children[slot]->isLeaf){
+            Leaf* leaf = (Leaf*)parent->children[slot];
+            Leaf* from = (Leaf*)parent->children[slot + 1];
+            insertEntry(leaf, leaf->count, from->keys[0], from->values[0]);
+            eraseEntry(from, 0);
+            parent->keys[slot] = from->keys[0];
+            return;
+        }
+        Inner* inner = (Inner*)parent->children[slot];
+        Inner* from = (Inner*)parent->children[slot + 1];
+        inner->keys[inner->count] = std::move(parent->keys[slot]);
+        inner->children[inner->count + 1] = from->children[0];
+        inner->count++;
+        parent->keys[slot] = std::move(from->keys[0]);
+        for(int idx=0; idx + 1 < from->count; idx++) from->keys[idx] = std::move(from->keys[idx + 1]);
+        for(int idx=0; idx < from->count; idx++) from->children[idx] = from->children[idx + 1];
+        from->count--;
+    }
+    //appends children[slot + 1] to children[slot] and drops it (with keys[slot]) from parent
+    void merge(Inner* parent, int slot){
+        Node* left = parent->children[slot];
+        Node* right = parent->children[slot + 1];
+        if(left->isLeaf){
+            Leaf* into = (Leaf*)left;
+            Leaf* from = (Leaf*)right;
+            for(int pos=0; pos < from->count; pos++){
+                into->keys[into->count + pos] = std::move(from->keys[pos]);
+                into->values[into->count + pos] = std::move(from->values[pos]);
+            }
+            into->count += from->count;
+            into->next = from->next;
+            if(from->next != 0) from->next->prev = into;
+            else tail = into;
+            delete from;
+        }
+        else{
+            Inner* into = (Inner*)left;
+            Inner* from = (Inner*)right;
+            into->keys[into->count] = std::move(parent->keys[slot]);
+            for(int pos=0; pos < from->count; pos++) into->keys[into->count + 1 + pos] = std::move(from->keys[pos]);
+            for(int pos=0; pos <= from->count; pos++) into->children[into->count + 1 + pos] = from->children[pos];
+            into->count += 1 + from->count;
+            delete from;
+        }
+        for(int idx=slot; idx + 1 < parent->count; idx++) parent->keys[idx] = std::move(parent->keys[idx + 1]);
+        for(int idx=slot + 1; idx < parent->count; idx++) parent->children[idx] = parent->children[idx + 1];
+        parent->count--;
+    }
+
+    void nodeString(Node* node, stringstream& os, string (*entry2str)(K&, V&)){
+        if(node->isLeaf){
+            Leaf* leaf = (Leaf*)node;
+            os << "[";
+            for(int pos=0; pos < leaf->count; pos++){
+                if(pos > 0) os << ", ";
+                if(entry2str != 0) os << entry2str(leaf->keys[pos], leaf->values[pos]);
+                else os << leaf->keys[pos];
+            }
+            os << "]";
+            return;
+        }
+        Inner* inner = (Inner*)node;
+        os << "(<";
+        for(int pos=0; pos < inner->count; pos++){
+            if(pos > 0) os << ", ";
+            os << inner->keys[pos];
+        }
+        os << ">";
+        for(int child=0; child <= inner->count; child++){
+            os << " ";
+            nodeString(inner->children[child], os, entry2str);
+        }
+        os << ")";
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//Iterator: BEGIN, a position in the leaf chain (end: leaf == 0); backward ones go to smaller keys
+    class Iterator{
+    private:
+        Leaf* leaf;
+        int index;
+        bool backward;
+    public:
+        Iterator(Leaf* leaf=0, int index=0, bool backward=false){
+            //a position past the last entry of a leaf is the first entry of the next one
+            while(leaf != 0 && !backward && index >= leaf->count){
+                leaf = leaf->next;
+                index = 0;
+            }
+            while(leaf != 0 && backward && index < 0){
+                leaf = leaf->prev;
+                index = leaf != 0 ? leaf->count - 1 : 0;
+            }
+            this->leaf = leaf;
+            this->index = leaf != 0 ? index : 0;
+            this->backward = backward;
+        }
+        K& key(){
+            return leaf->keys[index];
+        }
+        V& value(){
+            return leaf->values[index];
+        }
+        V& operator*(){
+            return leaf->values[index];
+        }
+        bool operator!=(const Iterator& iterator) const{
+            return leaf != iterator.leaf || index != iterator.index;
+        }
+        bool operator==(const Iterator& iterator) const{
+            return !(*this != iterator);
+        }
+        //Prefix ++ overload
+        Iterator& operator++(){
+            if(backward){
+                if(--index < 0){
+                    leaf = leaf->prev;
+                    index = leaf != 0 ? leaf->count - 1 : 0;
+                }
+            }
+            else if(++index == leaf->count){
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        //Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+//Iterator: END
+
+//Range: BEGIN, [first, last) of the leaf chain, usable in a range-for
+    class Range{
+    private:
+        Iterator first;
+        Iterator last;
+    public:
+        Range(Iterator first, Iterator last): first(first), last(last){}
+        Iterator begin(){
+            return first;
+        }
+        Iterator end(){
+            return last;
+        }
+    };
+//Range: END
+};
+
+#endif /* BPLUSTREE_H */
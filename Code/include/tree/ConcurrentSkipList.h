@@ -0,0 +1,494 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines ConcurrentSkipList: a lock-free ordered map (skip list) implementing IBST
+*/
+
+#ifndef CONCURRENTSKIPLIST_H
+#define CONCURRENTSKIPLIST_H
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tree/IBST.h"
+#include "tree/TreeTraversal.h"
+#include "util/SpinWait.h"
+using namespace std;
+
+/*
+! ConcurrentSkipList<K, V>
+? Functionality:
+    * Ordered map behind IBST<K, V> that any number of threads may use at once
+      (Herlihy & Shavit's lock-free skip list). Level 0 links every entry in key
+      order; each entry is also linked on levels 1..height-1, height drawn at
+      random with P(height > h) = 2^-h, so a search skips about half of the
+      remaining entries per level: O(log n) expected.
+    * add: lock-free. The entry is published by one CAS on level 0 (the
+      linearization point), then linked on the upper levels; add() of a key that
+      is present replaces its value (atomically).
+    * remove: logical deletion. The low bit of each next pointer of the entry is
+      set (top level first); the thread whose CAS marks level 0 owns the removal.
+      Marked entries are unlinked by later searches (find) on the way.
+    * search: wait-free; it never writes and skips marked entries.
+    * begin()/end(), lowerBound(key), range(lo, hi): weakly consistent iterators
+      along level 0. They never fail and never return an entry twice; entries added
+      or removed during the walk may or may not be seen.
+    * walk(order) / traverse(visit, order) take a TreeOrder, as the other trees: LNR
+      is the key order, RNL the descending one.
+? Notes:
+    * A skip list has no parent/child shape: every entry sits on level 0 and the
+      upper levels only hold shortcuts. So, as for BPlusTree, NLR, LRN and BFS give
+      the ascending order too. RNL first copies the level-0 node pointers (O(n) extra
+      memory, no links going back) and then walks them backwards.
+    * V must be trivially copyable (a pointer or a number): it is a std::atomic<V>.
+    * Removed entries cannot be freed while another thread may still be reading them:
+      they are kept on a retired stack until collect(), clear() or the destructor,
+      which must run while no other thread uses the list.
+    * size() is exact when no operation is in flight.
+? Usage:
+    * ConcurrentSkipList<long, Event*> log;
+    * (any thread) log.add(time, event); log.remove(time); log.search(time, found);
+    * for(auto it = log.range(t1, t2).begin(); ...) it.key(), it.value()
+*/
+template<class K, class V>
+class ConcurrentSkipList: public IBST<K, V>{
+public:
+    class Iterator; //forward declaration
+    class Range;    //forward declaration
+    static const int MAX_LEVEL = 24;
+
+protected:
+    struct Node{
+        K key;
+        std::atomic<V> value;
+        int height;
+        Node* retired;                  //link on the retired stack
+        std::atomic<uintptr_t>* next;   //height links; bit 0 set: this node is removed at that level
+
+        Node(const K& key, V value, int height): key(key), value(value), height(height), retired(0), next(0){}
+    };
+
+    Node* head;     //sentinel with MAX_LEVEL links; the end of a level is a null link
+    alignas(CACHE_LINE) std::atomic<int> count;
+    std::atomic<int> levels;            //highest height in use
+    std::atomic<Node*> retired;
+
+public:
+    ConcurrentSkipList(){
+        this->head = newNode(K(), V(), MAX_LEVEL);
+        this->count.store(0, std::memory_order_relaxed);
+        this->levels.store(0, std::memory_order_relaxed);
+        this->retired.store(0, std::memory_order_relaxed);
+    }
+    ~ConcurrentSkipList(){
+        clear();
+        deleteNode(head);
+    }
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    /*
+    ! add(key, value): insert key, or replace its value if key is present (lock-free)
+    */
+    void add(K key, V value=0){
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        int height = randomHeight();
+        Node* node = 0;
+        while(true){
+            if(find(key, preds, succs)){
+                succs[0]->value.store(value, std::memory_order_release);
+                if(node != 0) deleteNode(node);
+                return;
+            }
+            if(node == 0) node = newNode(key, value, height);
+            for(int level=0; level < height; level++)
+                node->next[level].store((uintptr_t)succs[level], std::memory_order_relaxed);
+            uintptr_t expected = (uintptr_t)succs[0];
+            if(preds[0]->next[0].compare_exchange_strong(expected, (uintptr_t)node,
+                    std::memory_order_release, std::memory_order_relaxed)) break;
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+        int top = levels.load(std::memory_order_relaxed);
+        while(top < height && !levels.compare_exchange_weak(top, height, std::memory_order_relaxed)){}
+
+        for(int level=1; level < height; level++){
+            while(true){
+                uintptr_t link = node->next[level].load(std::memory_order_acquire);
+                if(marked(link)) return;    //already being removed: no need to link it higher
+                if(pointer(link) != succs[level] &&
+                   !node->next[level].compare_exchange_strong(link, (uintptr_t)succs[level],
+                        std::memory_order_acq_rel, std::memory_order_acquire)) continue;
+                uintptr_t expected = (uintptr_t)succs[level];
+                if(preds[level]->next[level].compare_exchange_strong(expected, (uintptr_t)node,
+                        std::memory_order_release, std::memory_order_relaxed)) break;
+                find(key, preds, succs);
+                if(succs[0] != node) return;    //removed meanwhile
+            }
+        }
+    }
+
+    /*
+    ! remove(key, success): remove key (lock-free, logical deletion)
+    ? Return:
+        * V: the value stored with key (V() if key was not found; *success tells which)
+    */
+    V remove(K key, bool* success=0){
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        V value = V();
+        bool removed = false;
+        if(find(key, preds, succs)){
+            Node* node = succs[0];
+            for(int level=node->height - 1; level > 0; level--){
+                uintptr_t link = node->next[level].load(std::memory_order_acquire);
+                while(!marked(link) && !node->next[level].compare_exchange_weak(link, link | 1,
+                        std::memory_order_acq_rel, std::memory_order_acquire)){}
+            }
+            uintptr_t link = node->next[0].load(std::memory_order_acquire);
+            while(!marked(link)){
+                if(node->next[0].compare_exchange_weak(link, link | 1,
+                        std::memory_order_acq_rel, std::memory_order_acquire)){
+                    removed = true;
+                    value = node->value.load(std::memory_order_acquire);
+                    count.fetch_sub(1, std::memory_order_relaxed);
+                    find(key, preds, succs);    //unlinks node
+                    retire(node);
+                    break;
+                }
+            }
+        }
+        if(success != 0) *success = removed;
+        return value;
+    }
+
+    /*
+    ! search(key, found): the value stored with key (V() and found=false if absent); wait-free
+    */
+    V search(K key, bool& found){
+        Node* node = lowerNode(key);
+        found = node != 0 && !(key < node->key);
+        return found ? node->value.load(std::memory_order_acquire) : V();
+    }
+
+    int size(){
+        return count.load(std::memory_order_relaxed);
+    }
+    //number of levels in use
+    int height(){
+        return levels.load(std::memory_order_relaxed);
+    }
+    bool empty(){
+        return size() == 0;
+    }
+
+    /*
+    ! clear(): remove every entry and free all nodes (no other thread may use the list)
+    */
+    void clear(){
+        collect();
+        Node* node = pointer(head->next[0].load(std::memory_order_acquire));
+        while(node != 0){
+            Node* next = pointer(node->next[0].load(std::memory_order_relaxed));
+            deleteNode(node);
+            node = next;
+        }
+        for(int level=0; level < MAX_LEVEL; level++) head->next[level].store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        levels.store(0, std::memory_order_relaxed);
+    }
+
+    /*
+    ! collect(): free the removed entries (no other thread may use the list)
+    * Unlinks the marked entries that are still linked on some level, then frees the retired stack.
+    */
+    void collect(){
+        for(int level=0; level < MAX_LEVEL; level++){
+            Node* pred = head;
+            uintptr_t link = pred->next[level].load(std::memory_order_acquire);
+            while(pointer(link) != 0){
+                Node* node = pointer(link);
+                uintptr_t next = node->next[level].load(std::memory_order_acquire);
+                if(marked(next)) pred->next[level].store(next & ~(uintptr_t)1, std::memory_order_relaxed);
+                else pred = node;
+                link = pred->next[level].load(std::memory_order_relaxed);
+            }
+        }
+        Node* node = retired.exchange(0, std::memory_order_acq_rel);
+        while(node != 0){
+            Node* next = node->retired;
+            deleteNode(node);
+            node = next;
+        }
+    }
+
+    /*
+    ! begin(), end(), lowerBound(key), range(lo, hi): weakly consistent iterators on level 0
+    * range(lo, hi): the entries with lo <= key <= hi, usable in a range-for.
+    */
+    Iterator begin(){
+        return Iterator(pointer(head->next[0].load(std::memory_order_acquire)));
+    }
+    Iterator end(){
+        return Iterator(0);
+    }
+    Iterator lowerBound(K key){
+        return Iterator(lowerNode(key));
+    }
+    Range range(K lo, K hi){
+        if(hi < lo) return Range(end(), end());
+        return Range(Iterator(lowerNode(lo), hi), end());
+    }
+
+    /*
+    ! walk(order), traverse(visit, order): the entries in a TreeOrder, weakly consistent
+    ? Functionality:
+        * walk: a range of Iterators; lazy along level 0, except RNL (see Notes above).
+        * traverse: calls visit(key, value) for every entry (visit: function or lambda).
+    ? Exceptions:
+        * std::invalid_argument if order is not a TreeOrder
+    */
+    Range walk(int order=TreeOrder::LNR){
+        checkOrder(order);
+        if(order != TreeOrder::RNL) return Range(begin(), end());
+        std::shared_ptr<vector<Node*>> nodes = std::make_shared<vector<Node*>>();
+        for(Node* node=pointer(head->next[0].load(std::memory_order_acquire)); node != 0;
+            node = pointer(node->next[0].load(std::memory_order_acquire))) nodes->push_back(node);
+        return Range(Iterator(nodes, (int)nodes->size() - 1), end());
+    }
+    template<class Visitor>
+    void traverse(Visitor visit, int order=TreeOrder::LNR){
+        Range entries = walk(order);
+        for(Iterator it = entries.begin(); it != entries.end(); ++it){
+            V value = it.value();
+            visit(it.key(), value);
+        }
+    }
+
+    DLinkedList<V> ascendingList(){
+        DLinkedList<V> list;
+        traverse([&list](K& /*key*/, V& value){ list.add(value); });
+        return list;
+    }
+    DLinkedList<V> descendingList(){
+        DLinkedList<V> list;
+        traverse([&list](K& /*key*/, V& value){ list.add(value); }, TreeOrder::RNL);
+        return list;
+    }
+
+    /*
+    ! toString(entry2str, avl): [e1, e2, ...] in ascending order; avl is ignored
+    * e: entry2str(key, value) if given, the key otherwise
+    */
+    string toString(string (*entry2str)(K&, V&)=0, bool /*avl*/=false){
+        stringstream os;
+        os << "[";
+        bool first = true;
+        traverse([&](K& key, V& value){
+            if(!first) os << ", ";
+            first = false;
+            if(entry2str != 0) os << entry2str(key, value);
+            else os << key;
+        });
+        os << "]";
+        return os.str();
+    }
+    void println(string (*entry2str)(K&, V&)=0){
+        cout << toString(entry2str) << endl;
+    }
+
+protected:
+    static Node* pointer(uintptr_t link){
+        return (Node*)(link & ~(uintptr_t)1);
+    }
+    static bool marked(uintptr_t link){
+        return (link & 1) != 0;
+    }
+    static void checkOrder(int order){
+        if(order < TreeOrder::NLR || order > TreeOrder::BFS)
+            throw std::invalid_argument("ConcurrentSkipList: unknown traversal order");
+    }
+    //one block: the node, then its height links
+    static Node* newNode(const K& key, V value, int height){
+        void* block = ::operator new(sizeof(Node) + height * sizeof(std::atomic<uintptr_t>));
+        Node* node = new(block) Node(key, value, height);
+        node->next = (std::atomic<uintptr_t>*)((char*)block + sizeof(Node));
+        for(int level=0; level < height; level++) new(&node->next[level]) std::atomic<uintptr_t>(0);
+        return node;
+    }
+    static void deleteNode(Node* node){
+        node->~Node();
+        ::operator delete((void*)node);
+    }
+    void retire(Node* node){
+        Node* top = retired.load(std::memory_order_relaxed);
+        do{
+            node->retired = top;
+        } while(!retired.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+    static int randomHeight(){
+        static thread_local unsigned long long state =
+            0x9E3779B97F4A7C15ull ^ (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        unsigned long long bits = state;
+        int height = 1;
+        while((bits & 1) != 0 && height < MAX_LEVEL){
+            height++;
+            bits >>= 1;
+        }
+        return height;
+    }
+
+    /*
+    ! find(key, preds, succs): on every level, the last node before key and the first one not before it
+    * Unlinks the marked nodes it meets (restarting from the head if a CAS fails).
+    ? Return:
+        * bool: true if succs[0] holds key
+    */
+    bool find(const K& key, Node** preds, Node** succs){
+        while(true){
+            bool restart = false;
+            Node* pred = head;
+            Node* curr = 0;
+            for(int level=MAX_LEVEL - 1; level >= 0 && !restart; level--){
+                curr = pointer(pred->next[level].load(std::memory_order_acquire));
+                while(curr != 0){
+                    uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+                    if(marked(succ)){
+                        uintptr_t expected = (uintptr_t)curr;
+                        if(!pred->next[level].compare_exchange_strong(expected, succ & ~(uintptr_t)1,
+                                std::memory_order_acq_rel, std::memory_order_acquire)){
+                            restart = true;
+                            break;
+                        }
+                        curr = pointer(succ);
+                        continue;
+                    }
+                    if(!(curr->key < key)) break;
+                    pred = curr;
+                    curr = pointer(succ);
+                }
+                preds[level] = pred;
+                succs[level] = curr;
+            }
+            if(!restart) return curr != 0 && !(key < curr->key);
+        }
+    }
+    //first unmarked node whose key is not less than key (read-only)
+    Node* lowerNode(const K& key){
+        Node* pred = head;
+        Node* curr = 0;
+        int top = levels.load(std::memory_order_relaxed);  //a stale value only starts lower
+        for(int level=(top > 0 ? top : 1) - 1; level >= 0; level--){
+            curr = pointer(pred->next[level].load(std::memory_order_acquire));
+            while(curr != 0){
+                uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+                if(marked(succ)){
+                    curr = pointer(succ);
+                    continue;
+                }
+                if(!(curr->key < key)) break;
+                pred = curr;
+                curr = pointer(succ);
+            }
+        }
+        return curr;
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//Iterator: BEGIN, an entry on level 0 (end: node == 0); with an upper bound, it ends after hi.
+//A backward iterator (walk(RNL)) steps down a copy of the level-0 node pointers instead.
+    class Iterator{
+    private:
+        Node* node;
+        K hi;
+        bool bounded;
+        std::shared_ptr<vector<Node*>> nodes;
+        int index;
+
+        //moves to the first unmarked node from node on, or to the end past hi
+        void settle(){
+            if(nodes){
+                while(index >= 0 && marked((*nodes)[index]->next[0].load(std::memory_order_acquire))) index--;
+                node = index >= 0 ? (*nodes)[index] : 0;
+                return;
+            }
+            while(node != 0){
+                uintptr_t link = node->next[0].load(std::memory_order_acquire);
+                if(!marked(link)) break;
+                node = pointer(link);   //the links of a removed node never change
+            }
+            if(node != 0 && bounded && hi < node->key) node = 0;
+        }
+    public:
+        Iterator(Node* node): node(node), hi(), bounded(false), index(0){
+            settle();
+        }
+        Iterator(Node* node, K hi): node(node), hi(hi), bounded(true), index(0){
+            settle();
+        }
+        Iterator(std::shared_ptr<vector<Node*>> nodes, int index): node(0), hi(), bounded(false), nodes(nodes), index(index){
+            settle();
+        }
+        K& key(){
+            return node->key;
+        }
+        V value(){
+            return node->value.load(std::memory_order_acquire);
+        }
+        V operator*(){
+            return value();
+        }
+        bool operator!=(const Iterator& iterator) const{
+            return node != iterator.node;
+        }
+        bool operator==(const Iterator& iterator) const{
+            return node == iterator.node;
+        }
+        //Prefix ++ overload
+        Iterator& operator++(){
+            if(nodes) index--;
+            else node = pointer(node->next[0].load(std::memory_order_acquire));
+            settle();
+            return *this;
+        }
+        //Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+//Iterator: END
+
+//Range: BEGIN, [first, last) of level 0, usable in a range-for
+    class Range{
+    private:
+        Iterator first;
+        Iterator last;
+    public:
+        Range(Iterator first, Iterator last): first(first), last(last){}
+        Iterator begin(){
+            return first;
+        }
+        Iterator end(){
+            return last;
+        }
+    };
+//Range: END
+};
+
+#endif /* CONCURRENTSKIPLIST_H */
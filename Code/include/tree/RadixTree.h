@@ -0,0 +1,843 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines RadixTree: an adaptive radix tree (ART) mapping strings to values, with prefix queries
+*/
+
+#ifndef RADIXTREE_H
+#define RADIXTREE_H
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "hash/IMap.h"
+#include "list/DLinkedList.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+/*
+! RadixTree<V>
+? Functionality:
+    * Map from string keys to V behind IMap<string, V>, stored as an adaptive radix
+      tree (Leis et al., ICDE 2013): one level per byte of the key, and
+        - each inner node has the smallest of four layouts that fits its children:
+          Node4 and Node16 (sorted key bytes + child pointers), Node48 (256-entry byte
+          index into 48 children) and Node256 (one pointer per byte); nodes grow and
+          shrink between them on put / remove;
+        - path compression: a chain of single-child nodes is folded into the "prefix"
+          string of the node below it;
+        - a key that ends at an inner node (a prefix of longer keys, "FC_3" beside
+          "FC_3.weight") is kept in that node's "terminal" leaf.
+    * Keys are ordered byte by byte (as std::string::compare), so besides the IMap
+      operations the tree answers:
+        - withPrefix(prefix): the entries whose key starts with prefix, in key order;
+        - longestPrefixMatch(key, found): the entry with the longest key that is a
+          prefix of key (routing tables, "most specific config section").
+    * begin()/end() walk every entry in key order.
+? Complexity:
+    * put, get, find, remove, containsKey, longestPrefixMatch: O(k), k the key length,
+      independent of the number of entries; no hashing.
+    * withPrefix(prefix): O(|prefix|) to find the subtree, then O(1) amortized per entry.
+? Notes:
+    * clashes() (from IMap) is empty: there are no hash buckets.
+    * Iterators are invalidated by put of a new key, remove and clear.
+? Usage:
+    * RadixTree<Tensor*> params;
+    * params.put("FC_3.weight", w); params.put("FC_3.bias", b);
+    * for(auto it = params.withPrefix("FC_3.").begin(); ...) it.key(), it.value()
+    * bool found; params.longestPrefixMatch("FC_3.weight.grad", found);   //w
+*/
+template<class V>
+class RadixTree: public IMap<string, V>{
+public:
+    class Iterator; //forward declaration
+    class Range;    //forward declaration
+
+protected:
+    static const uint8_t LEAF = 0;
+    static const uint8_t NODE4 = 1;
+    static const uint8_t NODE16 = 2;
+    static const uint8_t NODE48 = 3;
+    static const uint8_t NODE256 = 4;
+
+    struct Node{
+        uint8_t type;
+    };
+    struct Leaf: Node{
+        string key;
+        V value;
+        Leaf(const string& key, V value): key(key), value(value){
+            this->type = LEAF;
+        }
+    };
+    struct Inner: Node{
+        int count;          //number of children
+        string prefix;      //bytes shared by every key below, after the edge into this node
+        Leaf* terminal;     //the key that ends right after prefix, if any
+    };
+    struct Node4: Inner{
+        uint8_t keys[4];    //sorted
+        Node* children[4];
+    };
+    struct Node16: Inner{
+        uint8_t keys[16];   //sorted
+        Node* children[16];
+    };
+    struct Node48: Inner{
+        uint8_t index[256]; //slot + 1 of the child for a byte; 0: no child
+        Node* children[48];
+    };
+    struct Node256: Inner{
+        Node* children[256];
+    };
+
+    Node* root;
+    int count;
+    bool (*valueEqual)(V&, V&);
+
+public:
+    RadixTree(bool (*valueEqual)(V&, V&)=0){
+        this->root = 0;
+        this->count = 0;
+        this->valueEqual = valueEqual;
+    }
+    RadixTree(const RadixTree<V>& tree){
+        this->root = copyNode(tree.root);
+        this->count = tree.count;
+        this->valueEqual = tree.valueEqual;
+    }
+    RadixTree<V>& operator=(const RadixTree<V>& tree){
+        if(this == &tree) return *this;
+        clear();
+        this->root = copyNode(tree.root);
+        this->count = tree.count;
+        this->valueEqual = tree.valueEqual;
+        return *this;
+    }
+    ~RadixTree(){
+        clear();
+    }
+
+    //Inherit from IMap:BEGIN
+
+    /*
+    ! put(key, value): map key to value; returns the old value if key was present, value otherwise
+    */
+    V put(string key, V value){
+        Node** ref = &root;
+        size_t depth = 0;
+        while(true){
+            Node* node = *ref;
+            if(node == 0){
+                *ref = new Leaf(key, value);
+                count++;
+                return value;
+            }
+            if(node->type == LEAF){
+                Leaf* leaf = (Leaf*)node;
+                if(leaf->key == key){
+                    V old = leaf->value;
+                    leaf->value = value;
+                    return old;
+                }
+                //two keys share key[depth..split): a new node holds both
+                size_t split = depth;
+                while(split < key.size() && split < leaf->key.size() && key[split] == leaf->key[split]) split++;
+                Node* top = newInner(key.substr(depth, split - depth));
+                attach(&top, leaf, split);
+                attach(&top, new Leaf(key, value), split);
+                *ref = top;
+                count++;
+                return value;
+            }
+            Inner* inner = (Inner*)node;
+            size_t matched = 0;
+            while(matched < inner->prefix.size() && depth + matched < key.size() &&
+                  inner->prefix[matched] == key[depth + matched]) matched++;
+            if(matched < inner->prefix.size()){
+                //key leaves the compressed path inside the prefix: split it there
+                Node* top = newInner(inner->prefix.substr(0, matched));
+                uint8_t edge = (uint8_t)inner->prefix[matched];
+                inner->prefix.erase(0, matched + 1);
+                addChild(&top, edge, inner);
+                attach(&top, new Leaf(key, value), depth + matched);
+                *ref = top;
+                count++;
+                return value;
+            }
+            depth += matched;
+            if(depth == key.size()){
+                if(inner->terminal != 0){
+                    V old = inner->terminal->value;
+                    inner->terminal->value = value;
+                    return old;
+                }
+                inner->terminal = new Leaf(key, value);
+                count++;
+                return value;
+            }
+            Node** child = findChild(inner, (uint8_t)key[depth]);
+            if(child == 0){
+                addChild(ref, (uint8_t)key[depth], new Leaf(key, value));
+                count++;
+                return value;
+            }
+            ref = child;
+            depth++;
+        }
+    }
+
+    /*
+    ! get(key): the value of key; KeyNotFound if key is not in the map
+    */
+    V& get(string key){
+        Leaf* leaf = findLeaf(key);
+        if(leaf == 0) throw KeyNotFound("key (" + key + ") is not found");
+        return leaf->value;
+    }
+
+    /*
+    ! remove(key): remove key and return its value; KeyNotFound if key is not in the map
+    */
+    V remove(string key, void (*deleteKeyInMap)(string)=0){
+        Leaf* leaf = detach(key);
+        if(leaf == 0) throw KeyNotFound("key (" + key + ") is not found");
+        V value = leaf->value;
+        if(deleteKeyInMap != 0) deleteKeyInMap(leaf->key);
+        delete leaf;
+        count--;
+        return value;
+    }
+
+    /*
+    ! remove(key, value): remove the mapping key->value if present (returns whether it was)
+    */
+    bool remove(string key, V value, void (*deleteKeyInMap)(string)=0, void (*deleteValueInMap)(V)=0){
+        Leaf* leaf = findLeaf(key);
+        if(leaf == 0 || !valueEQ(leaf->value, value)) return false;
+        detach(key);
+        if(deleteKeyInMap != 0) deleteKeyInMap(leaf->key);
+        if(deleteValueInMap != 0) deleteValueInMap(leaf->value);
+        delete leaf;
+        count--;
+        return true;
+    }
+
+    bool containsKey(string key){
+        return findLeaf(key) != 0;
+    }
+    bool containsValue(V value){
+        for(Iterator it = begin(); it != end(); ++it){
+            if(valueEQ(it.value(), value)) return true;
+        }
+        return false;
+    }
+    bool empty(){
+        return count == 0;
+    }
+    int size(){
+        return count;
+    }
+    void clear(){
+        removeNode(root);
+        root = 0;
+        count = 0;
+    }
+
+    /*
+    ! toString(key2str, value2str): {(key,value); (key,value); ...} in key order
+    */
+    string toString(string (*key2str)(string&)=0, string (*value2str)(V&)=0){
+        stringstream os;
+        os << "{";
+        bool first = true;
+        for(Iterator it = begin(); it != end(); ++it){
+            os << (first ? "(" : "; (");
+            first = false;
+            string key = it.key();
+            if(key2str != 0) os << key2str(key);
+            else os << key;
+            os << ",";
+            if(value2str != 0) os << value2str(it.value());
+            else os << it.value();
+            os << ")";
+        }
+        os << "}";
+        return os.str();
+    }
+    //keys in ascending order
+    DLinkedList<string> keys(){
+        DLinkedList<string> list;
+        for(Iterator it = begin(); it != end(); ++it) list.add(it.key());
+        return list;
+    }
+    //values in the order of their keys
+    DLinkedList<V> values(){
+        DLinkedList<V> list;
+        for(Iterator it = begin(); it != end(); ++it) list.add(it.value());
+        return list;
+    }
+    DLinkedList<int> clashes(){
+        return DLinkedList<int>();
+    }
+    //Inherit from IMap:END
+
+    void println(string (*key2str)(string&)=0, string (*value2str)(V&)=0){
+        cout << toString(key2str, value2str) << endl;
+    }
+    /*
+    ! find(key): pointer to the value of key, or nullptr if key is not in the map (no exception)
+    */
+    V* find(string key){
+        Leaf* leaf = findLeaf(key);
+        return leaf == 0 ? 0 : &leaf->value;
+    }
+
+    /*
+    ! withPrefix(prefix): the entries whose key starts with prefix, in key order (a range-for works)
+    */
+    Range withPrefix(string prefix){
+        return Range(Iterator(prefixRoot(prefix)), Iterator(0));
+    }
+    //keys starting with prefix, ascending
+    DLinkedList<string> keysWithPrefix(string prefix){
+        DLinkedList<string> list;
+        Range range = withPrefix(prefix);
+        for(Iterator it = range.begin(); it != range.end(); ++it) list.add(it.key());
+        return list;
+    }
+
+    /*
+    ! longestPrefixMatch(key, found, match): the value of the longest stored key that is a prefix of key
+    * found is false (and the result V()) if no stored key is a prefix of key;
+    * match (optional) receives that stored key.
+    */
+    V longestPrefixMatch(string key, bool& found, string* match=0){
+        Leaf* best = 0;
+        Node* node = root;
+        size_t depth = 0;
+        while(node != 0){
+            if(node->type == LEAF){
+                Leaf* leaf = (Leaf*)node;
+                if(leaf->key.size() <= key.size() && key.compare(0, leaf->key.size(), leaf->key) == 0) best = leaf;
+                break;
+            }
+            Inner* inner = (Inner*)node;
+            if(!prefixMatches(inner, key, depth)) break;
+            depth += inner->prefix.size();
+            if(inner->terminal != 0) best = inner->terminal;
+            if(depth == key.size()) break;
+            Node** child = findChild(inner, (uint8_t)key[depth]);
+            if(child == 0) break;
+            node = *child;
+            depth++;
+        }
+        found = best != 0;
+        if(best == 0) return V();
+        if(match != 0) *match = best->key;
+        return best->value;
+    }
+
+    Iterator begin(){
+        return Iterator(root);
+    }
+    Iterator end(){
+        return Iterator(0);
+    }
+
+protected:
+    bool valueEQ(V& lhs, V& rhs){
+        if(valueEqual == 0) return lhs == rhs;
+        return valueEqual(lhs, rhs);
+    }
+
+    static Node* newInner(const string& prefix){
+        Node4* node = new Node4();
+        node->type = NODE4;
+        node->prefix = prefix;
+        return node;
+    }
+    //hangs leaf under the new node *ref whose keys all share their first "depth" bytes
+    void attach(Node** ref, Leaf* leaf, size_t depth){
+        if(leaf->key.size() == depth) ((Inner*)*ref)->terminal = leaf;
+        else addChild(ref, (uint8_t)leaf->key[depth], leaf);
+    }
+    //true if key continues with the prefix of node at depth
+    static bool prefixMatches(Inner* node, const string& key, size_t depth){
+        size_t length = node->prefix.size();
+        return key.size() - depth >= length && key.compare(depth, length, node->prefix) == 0;
+    }
+
+    Leaf* findLeaf(const string& key){
+        Node* node = root;
+        size_t depth = 0;
+        while(node != 0){
+            if(node->type == LEAF){
+                Leaf* leaf = (Leaf*)node;
+                return leaf->key == key ? leaf : 0;
+            }
+            Inner* inner = (Inner*)node;
+            if(!prefixMatches(inner, key, depth)) return 0;
+            depth += inner->prefix.size();
+            if(depth == key.size()) return inner->terminal;
+            Node** child = findChild(inner, (uint8_t)key[depth]);
+            if(child == 0) return 0;
+            node = *child;
+            depth++;
+        }
+        return 0;
+    }
+    //the subtree holding exactly the keys that start with prefix (0 if none)
+    Node* prefixRoot(const string& prefix){
+        Node* node = root;
+        size_t depth = 0;
+        while(node != 0){
+            if(node->type == LEAF){
+                Leaf* leaf = (Leaf*)node;
+                return leaf->key.compare(0, prefix.size(), prefix) == 0 ? node : 0;
+            }
+            Inner* inner = (Inner*)node;
+            size_t rest = prefix.size() - depth;
+            size_t length = rest < inner->prefix.size() ? rest : inner->prefix.size();
+            if(prefix.compare(depth, length, inner->prefix, 0, length) != 0) return 0;
+            if(rest <= inner->prefix.size()) return node;   //prefix ends within this node's path
+            depth += inner->prefix.size();
+            Node** child = findChild(inner, (uint8_t)prefix[depth]);
+            if(child == 0) return 0;
+            node = *child;
+            depth++;
+        }
+        return 0;
+    }
+
+    //unlinks the leaf of key (0 if absent) and shrinks / merges the nodes it leaves behind
+    Leaf* detach(const string& key){
+        Node** ref = &root;
+        Node** parent = 0;
+        uint8_t edge = 0;
+        size_t depth = 0;
+        while(*ref != 0){
+            Node* node = *ref;
+            if(node->type == LEAF){
+                Leaf* leaf = (Leaf*)node;
+                if(leaf->key != key) return 0;
+                if(parent == 0) root = 0;
+                else removeChild(parent, edge);
+                return leaf;
+            }
+            Inner* inner = (Inner*)node;
+            if(!prefixMatches(inner, key, depth)) return 0;
+            depth += inner->prefix.size();
+            if(depth == key.size()){
+                Leaf* leaf = inner->terminal;
+                if(leaf == 0) return 0;
+                inner->terminal = 0;
+                shrink(ref);
+                return leaf;
+            }
+            Node** child = findChild(inner, (uint8_t)key[depth]);
+            if(child == 0) return 0;
+            parent = ref;
+            edge = (uint8_t)key[depth];
+            ref = child;
+            depth++;
+        }
+        return 0;
+    }
+
+    /*
+    ! findChild(node, byte): the slot of the child of node along byte, 0 if none
+    * Node16 compares the 16 key bytes at once with SSE2 where available.
+    */
+    static Node** findChild(Inner* node, uint8_t byte){
+        switch(node->type){
+        case NODE4:{
+            Node4* small = (Node4*)node;
+            for(int idx=0; idx < small->count; idx++){
+                if(small->keys[idx] == byte) return &small->children[idx];
+            }
+            return 0;
+        }
+        case NODE16:{
+            Node16* medium = (Node16*)node;
+#if defined(__SSE2__)
+            __m128i equal = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte),
+                                           _mm_loadu_si128((const __m128i*)medium->keys));
+            int mask = _mm_movemask_epi8(equal) & ((1 << medium->count) - 1);
+            return mask == 0 ? 0 : &medium->children[__builtin_ctz(mask)];
+#else
+            for(int idx=0; idx < medium->count; idx++){
+                if(medium->keys[idx] == byte) return &medium->children[idx];
+            }
+            return 0;
+#endif
+        }
+        case NODE48:{
+            Node48* large = (Node48*)node;
+            int slot = large->index[byte];
+            return slot == 0 ? 0 : &large->children[slot - 1];
+        }
+        default:{
+            Node256* full = (Node256*)node;
+            return full->children[byte] == 0 ? 0 : &full->children[byte];
+        }
+        }
+    }
+    //the child with the smallest byte >= from (byte receives it), 0 if none
+    static Node* nextChild(Inner* node, int from, int& byte){
+        switch(node->type){
+        case NODE4:
+        case NODE16:{
+            uint8_t* keys = node->type == NODE4 ? ((Node4*)node)->keys : ((Node16*)node)->keys;
+            Node** children = node->type == NODE4 ? ((Node4*)node)->children : ((Node16*)node)->children;
+            for(int idx=0; idx < node->count; idx++){
+                if(keys[idx] >= from){
+                    byte = keys[idx];
+                    return children[idx];
+                }
+            }
+            return 0;
+        }
+        case NODE48:{
+            Node48* large = (Node48*)node;
+            for(int key=from; key < 256; key++){
+                if(large->index[key] != 0){
+                    byte = key;
+                    return large->children[large->index[key] - 1];
+                }
+            }
+            return 0;
+        }
+        default:{
+            Node256* full = (Node256*)node;
+            for(int key=from; key < 256; key++){
+                if(full->children[key] != 0){
+                    byte = key;
+                    return full->children[key];
+                }
+            }
+            return 0;
+        }
+        }
+    }
+
+    //copies count, prefix and terminal of from into to (a node of another layout)
+    static void moveHeader(Inner* from, Inner* to){
+        to->count = from->count;
+        to->prefix.swap(from->prefix);
+        to->terminal = from->terminal;
+    }
+    //inserts into sorted keys[0..n) / children
+    static void insertSorted(uint8_t* keys, Node** children, int n, uint8_t byte, Node* child){
+        int pos = n;
+        while(pos > 0 && keys[pos - 1] > byte){
+            keys[pos] = keys[pos - 1];
+            children[pos] = children[pos - 1];
+            pos--;
+        }
+        keys[pos] = byte;
+        children[pos] = child;
+    }
+
+    /*
+    ! addChild(ref, byte, child): adds child along byte to the node *ref (no child there yet)
+    * A full node is replaced in *ref by the next larger layout.
+    */
+    static void addChild(Node** ref, uint8_t byte, Node* child){
+        Inner* node = (Inner*)*ref;
+        switch(node->type){
+        case NODE4:{
+            Node4* small = (Node4*)node;
+            if(small->count < 4){
+                insertSorted(small->keys, small->children, small->count, byte, child);
+                small->count++;
+                return;
+            }
+            Node16* grown = new Node16();
+            grown->type = NODE16;
+            moveHeader(small, grown);
+            for(int idx=0; idx < 4; idx++){
+                grown->keys[idx] = small->keys[idx];
+                grown->children[idx] = small->children[idx];
+            }
+            delete small;
+            *ref = grown;
+            addChild(ref, byte, child);
+            return;
+        }
+        case NODE16:{
+            Node16* medium = (Node16*)node;
+            if(medium->count < 16){
+                insertSorted(medium->keys, medium->children, medium->count, byte, child);
+                medium->count++;
+                return;
+            }
+            Node48* grown = new Node48();
+            grown->type = NODE48;
+            moveHeader(medium, grown);
+            for(int idx=0; idx < 16; idx++){
+                grown->index[medium->keys[idx]] = (uint8_t)(idx + 1);
+                grown->children[idx] = medium->children[idx];
+            }
+            delete medium;
+            *ref = grown;
+            addChild(ref, byte, child);
+            return;
+        }
+        case NODE48:{
+            Node48* large = (Node48*)node;
+            if(large->count < 48){
+                int slot = 0;
+                while(large->children[slot] != 0) slot++;
+                large->children[slot] = child;
+                large->index[byte] = (uint8_t)(slot + 1);
+                large->count++;
+                return;
+            }
+            Node256* grown = new Node256();
+            grown->type = NODE256;
+            moveHeader(large, grown);
+            for(int key=0; key < 256; key++){
+                if(large->index[key] != 0) grown->children[key] = large->children[large->index[key] - 1];
+            }
+            delete large;
+            *ref = grown;
+            addChild(ref, byte, child);
+            return;
+        }
+        default:{
+            Node256* full = (Node256*)node;
+            full->children[byte] = child;
+            full->count++;
+        }
+        }
+    }
+
+    //removes the child along byte from the node *ref, then shrinks it
+    static void removeChild(Node** ref, uint8_t byte){
+        Inner* node = (Inner*)*ref;
+        if(node->type == NODE4 || node->type == NODE16){
+            uint8_t* keys = node->type == NODE4 ? ((Node4*)node)->keys : ((Node16*)node)->keys;
+            Node** children = node->type == NODE4 ? ((Node4*)node)->children : ((Node16*)node)->children;
+            int pos = 0;
+            while(keys[pos] != byte) pos++;
+            for(; pos + 1 < node->count; pos++){
+                keys[pos] = keys[pos + 1];
+                children[pos] = children[pos + 1];
+            }
+        }
+        else if(node->type == NODE48){
+            Node48* large = (Node48*)node;
+            large->children[large->index[byte] - 1] = 0;
+            large->index[byte] = 0;
+        }
+        else ((Node256*)node)->children[byte] = 0;
+        node->count--;
+        shrink(ref);
+    }
+
+    /*
+    ! shrink(ref): after a removal, moves the node *ref to a smaller layout once its children
+    * fit with room to spare (256 -> 48 below 37, 48 -> 16 below 13, 16 -> 4 below 4), so
+    * that alternating put / remove at a boundary does not convert back and forth; a Node4
+    * left with a single child and no terminal is merged into that child (path compression),
+    * one left with no child is replaced by its terminal.
+    */
+    static void shrink(Node** ref){
+        Inner* node = (Inner*)*ref;
+        if(node->type == NODE256 && node->count < 37){
+            Node256* full = (Node256*)node;
+            Node48* small = new Node48();
+            small->type = NODE48;
+            moveHeader(full, small);
+            int slot = 0;
+            for(int key=0; key < 256; key++){
+                if(full->children[key] == 0) continue;
+                small->children[slot] = full->children[key];
+                small->index[key] = (uint8_t)(++slot);
+            }
+            delete full;
+            *ref = small;
+        }
+        else if(node->type == NODE48 && node->count < 13){
+            Node48* large = (Node48*)node;
+            Node16* small = new Node16();
+            small->type = NODE16;
+            moveHeader(large, small);
+            int pos = 0;
+            for(int key=0; key < 256; key++){
+                if(large->index[key] == 0) continue;
+                small->keys[pos] = (uint8_t)key;
+                small->children[pos++] = large->children[large->index[key] - 1];
+            }
+            delete large;
+            *ref = small;
+        }
+        else if(node->type == NODE16 && node->count < 4){
+            Node16* medium = (Node16*)node;
+            Node4* small = new Node4();
+            small->type = NODE4;
+            moveHeader(medium, small);
+            for(int idx=0; idx < medium->count; idx++){
+                small->keys[idx] = medium->keys[idx];
+                small->children[idx] = medium->children[idx];
+            }
+            delete medium;
+            *ref = small;
+        }
+        else if(node->type == NODE4 && node->count <= 1){
+            Node4* small = (Node4*)node;
+            if(small->count == 0) *ref = small->terminal;
+            else if(small->terminal == 0){
+                Node* child = small->children[0];
+                if(child->type != LEAF){
+                    Inner* inner = (Inner*)child;
+                    inner->prefix = small->prefix + (char)small->keys[0] + inner->prefix;
+                }
+                *ref = child;
+            }
+            else return;
+            delete small;
+        }
+    }
+
+    static void deleteNode(Node* node){
+        switch(node->type){
+        case LEAF: delete (Leaf*)node; break;
+        case NODE4: delete (Node4*)node; break;
+        case NODE16: delete (Node16*)node; break;
+        case NODE48: delete (Node48*)node; break;
+        default: delete (Node256*)node;
+        }
+    }
+    void removeNode(Node* node){
+        if(node == 0) return;
+        if(node->type != LEAF){
+            Inner* inner = (Inner*)node;
+            int byte = 0;
+            for(Node* child = nextChild(inner, 0, byte); child != 0; child = nextChild(inner, byte + 1, byte))
+                removeNode(child);
+            if(inner->terminal != 0) delete inner->terminal;
+        }
+        deleteNode(node);
+    }
+    Node* copyNode(Node* node){
+        if(node == 0) return 0;
+        Node* copy;
+        switch(node->type){
+        case LEAF: return new Leaf(*(Leaf*)node);
+        case NODE4: copy = new Node4(*(Node4*)node); break;
+        case NODE16: copy = new Node16(*(Node16*)node); break;
+        case NODE48: copy = new Node48(*(Node48*)node); break;
+        default: copy = new Node256(*(Node256*)node);
+        }
+        Inner* inner = (Inner*)copy;
+        if(inner->terminal != 0) inner->terminal = new Leaf(*inner->terminal);
+        int byte = 0;
+        for(Node* child = nextChild(inner, 0, byte); child != 0; child = nextChild(inner, byte + 1, byte))
+            *findChild(inner, (uint8_t)byte) = copyNode(child);
+        return copy;
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+public:
+//Iterator: BEGIN, the entries of a subtree in key order (end: leaf == 0)
+    class Iterator{
+    private:
+        struct Frame{
+            Inner* node;
+            int next;       //-1: terminal not visited yet; otherwise the next byte to look at
+        };
+        vector<Frame> path;
+        Leaf* leaf;
+
+        //moves to the next leaf in key order
+        void advance(){
+            leaf = 0;
+            while(!path.empty()){
+                Frame& top = path.back();
+                if(top.next < 0){
+                    top.next = 0;
+                    if(top.node->terminal != 0){
+                        leaf = top.node->terminal;
+                        return;
+                    }
+                }
+                int byte = 0;
+                Node* child = top.next < 256 ? nextChild(top.node, top.next, byte) : 0;
+                if(child == 0){
+                    path.pop_back();
+                    continue;
+                }
+                top.next = byte + 1;
+                if(child->type == LEAF){
+                    leaf = (Leaf*)child;
+                    return;
+                }
+                path.push_back(Frame{(Inner*)child, -1});
+            }
+        }
+    public:
+        Iterator(Node* start){
+            leaf = 0;
+            if(start == 0) return;
+            if(start->type == LEAF){
+                leaf = (Leaf*)start;
+                return;
+            }
+            path.push_back(Frame{(Inner*)start, -1});
+            advance();
+        }
+        string& key(){
+            return leaf->key;
+        }
+        V& value(){
+            return leaf->value;
+        }
+        V& operator*(){
+            return leaf->value;
+        }
+        bool operator!=(const Iterator& iterator) const{
+            return leaf != iterator.leaf;
+        }
+        bool operator==(const Iterator& iterator) const{
+            return leaf == iterator.leaf;
+        }
+        //Prefix ++ overload
+        Iterator& operator++(){
+            advance();
+            return *this;
+        }
+        //Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            advance();
+            return iterator;
+        }
+    };
+//Iterator: END
+
+//Range: BEGIN, [first, last) of a walk, usable in a range-for
+    class Range{
+    private:
+        Iterator first;
+        Iterator last;
+    public:
+        Range(Iterator first, Iterator last): first(first), last(last){}
+        Iterator begin(){
+            return first;
+        }
+        Iterator end(){
+            return last;
+        }
+    };
+//Range: END
+};
+
+#endif /* RADIXTREE_H */
@@ -0,0 +1,171 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines TreeOrder and BinaryTreeWalk: lazy, iterative traversals of binary trees
+*/
+
+#ifndef TREETRAVERSAL_H
+#define TREETRAVERSAL_H
+#include <stdexcept>
+#include "stacknqueue/ArrayStack.h"
+#include "stacknqueue/ArrayQueue.h"
+using namespace std;
+
+/*
+! TreeOrder: the orders accepted by walk(order) and traverse(visit, order) of the trees
+    * NLR: pre-order; LNR: in-order (ascending keys); LRN: post-order;
+    * RNL: reverse in-order (descending keys); BFS: level order.
+*/
+class TreeOrder{
+public:
+    static const int NLR = 0;
+    static const int LNR = 1;
+    static const int LRN = 2;
+    static const int RNL = 3;
+    static const int BFS = 4;
+};
+
+/*
+! BinaryTreeWalk<Node>
+? Functionality:
+    * Walks the nodes under root in one TreeOrder, one node per ++, with an explicit
+      stack (a queue for BFS) instead of recursion: nothing is built up front, and a
+      degenerate tree (a chain of n nodes) costs O(n) heap, not n call frames.
+    * Node is any binary node type with "Node* left" and "Node* right" members; the
+      tree wraps the Node* into its own key/value view.
+? Complexity:
+    * A full walk: O(n) time; extra space O(height) (O(width) for BFS).
+? Notes:
+    * Invalidated by any change to the tree.
+? Usage:
+    * for(Node* node: BinaryTreeWalk<Node>(root, TreeOrder::LRN)) ...
+    * BinaryTreeWalk<Node>(root).forEach([&](Node* node){ sum += node->key; });
+*/
+template<class Node>
+class BinaryTreeWalk{
+public:
+    class Iterator; //forward declaration
+
+protected:
+    Node* root;
+    int order;
+
+public:
+    BinaryTreeWalk(Node* root, int order=TreeOrder::LNR){
+        if(order < TreeOrder::NLR || order > TreeOrder::BFS)
+            throw std::invalid_argument("BinaryTreeWalk: unknown traversal order");
+        this->root = root;
+        this->order = order;
+    }
+    Iterator begin(){
+        return Iterator(root, order);
+    }
+    Iterator end(){
+        return Iterator();
+    }
+    //calls visit(node) for every node, in order
+    template<class Visitor>
+    void forEach(Visitor visit){
+        Iterator last = end();
+        for(Iterator it = begin(); it != last; ++it) visit(*it);
+    }
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  INNER CLASSES DEFNITION ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Iterator: BEGIN, current is the node being visited (0 once the walk is over)
+    class Iterator{
+    private:
+        Node* current;
+        int order;
+        ArrayStack<Node*> stack;    //NLR: nodes still to visit; LNR, RNL, LRN: the path
+        ArrayQueue<Node*> queue;    //BFS: the frontier
+
+    public:
+        Iterator(){
+            this->current = 0;
+            this->order = TreeOrder::LNR;
+        }
+        Iterator(Node* root, int order){
+            this->current = 0;
+            this->order = order;
+            if(root == 0) return;
+            if(order == TreeOrder::NLR || order == TreeOrder::BFS) current = root;
+            else if(order == TreeOrder::LRN) descendLRN(root);
+            else descend(root);
+            if(order == TreeOrder::NLR) pushChildren(current);
+            else if(order == TreeOrder::BFS) enqueueChildren(current);
+            else current = stack.pop();
+        }
+
+        Node* operator*(){
+            return current;
+        }
+        bool operator!=(const Iterator& iterator) const{
+            return current != iterator.current;
+        }
+        bool operator==(const Iterator& iterator) const{
+            return current == iterator.current;
+        }
+        //Prefix ++ overload
+        Iterator& operator++(){
+            if(order == TreeOrder::NLR){
+                current = stack.empty() ? 0 : stack.pop();
+                if(current != 0) pushChildren(current);
+            }
+            else if(order == TreeOrder::BFS){
+                current = queue.empty() ? 0 : queue.pop();
+                if(current != 0) enqueueChildren(current);
+            }
+            else if(order == TreeOrder::LRN){
+                //current was the last node of a subtree: its parent (top of the path) comes
+                //next, unless current is a left child whose parent has a right subtree
+                if(stack.empty()) current = 0;
+                else{
+                    Node* parent = stack.peek();
+                    if(parent->left == current && parent->right != 0) descendLRN(parent->right);
+                    current = stack.pop();
+                }
+            }
+            else{
+                descend(order == TreeOrder::LNR ? current->right : current->left);
+                current = stack.empty() ? 0 : stack.pop();
+            }
+            return *this;
+        }
+        //Postfix ++ overload
+        Iterator operator++(int){
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+
+    private:
+        //LNR (RNL): pushes node and its chain of left (right) children
+        void descend(Node* node){
+            while(node != 0){
+                stack.push(node);
+                node = order == TreeOrder::LNR ? node->left : node->right;
+            }
+        }
+        //LRN: pushes the path from node to the first node of its subtree in post-order
+        void descendLRN(Node* node){
+            while(node != 0){
+                stack.push(node);
+                node = node->left != 0 ? node->left : node->right;
+            }
+        }
+        void pushChildren(Node* node){
+            if(node->right != 0) stack.push(node->right);
+            if(node->left != 0) stack.push(node->left);
+        }
+        void enqueueChildren(Node* node){
+            if(node->left != 0) queue.push(node->left);
+            if(node->right != 0) queue.push(node->right);
+        }
+    };
+//Iterator: END
+};
+
+#endif /* TREETRAVERSAL_H */
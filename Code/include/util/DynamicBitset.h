@@ -0,0 +1,214 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines DynamicBitset: a resizable array of bits in 64-bit words, for per-vertex flags
+*/
+
+#ifndef DYNAMICBITSET_H
+#define DYNAMICBITSET_H
+#include <cstring>
+#include <vector>
+using namespace std;
+
+/*
+! DynamicBitset
+? Functionality:
+    * size() bits, all false at first, packed 64 to a word: the visited / queued /
+      in-tree flags of a graph algorithm over dense ids take n/8 bytes instead of n
+      (bool, char) or a hash table entry per vertex, so a million flags fit in
+      128 KB of cache.
+    * test, set, reset, testAndSet: one word each. testAndSet(id) returns the old
+      bit, the usual "if not visited, mark it" in one call.
+    * Whole-set operations walk the words in plain loops the compiler vectorizes:
+      count() (popcount), reset() / fill(), |=, &=, andNot().
+    * findNext(from) / findNextClear(from): the first set / clear bit at or after
+      from, -1 if none, 64 bits per step (count trailing zeros).
+? Complexity:
+    * test, set, reset, testAndSet, pushBack: O(1); count, fill, |=, &=: O(n / 64).
+? Notes:
+    * The bits past size() in the last word are always 0, so count() and the
+      operators need no masking. |=, &= and andNot() need bitsets of the same size.
+? Usage:
+    * DynamicBitset visited(csr->size());
+    * if(!visited.testAndSet(next)) stack.push(next);
+    * for(int id=marked.findNext(0); id != -1; id=marked.findNext(id + 1)) ...
+*/
+class DynamicBitset{
+public:
+    typedef unsigned long long Word;
+    static const int WORD_BITS = 64;
+
+protected:
+    vector<Word> words;
+    int nbits;
+
+public:
+    DynamicBitset(int nbits=0, bool value=false): nbits(0){
+        resize(nbits, value);
+    }
+
+    int size() const{
+        return nbits;
+    }
+    bool empty() const{
+        return nbits == 0;
+    }
+    //grows with value or shrinks; the bits kept are unchanged
+    void resize(int nbits, bool value=false){
+        int old = this->nbits;
+        words.resize(wordCount(nbits), 0);
+        this->nbits = nbits;
+        if(value && nbits > old){
+            for(int id=old; id < nbits && (id & (WORD_BITS - 1)) != 0; id++) set(id);
+            int first = (old + WORD_BITS - 1) / WORD_BITS;
+            for(int idx=first; idx < (int)words.size(); idx++) words[idx] = ~0ull;
+        }
+        trim();
+    }
+    void pushBack(bool value){
+        if((nbits & (WORD_BITS - 1)) == 0) words.push_back(0);
+        nbits++;
+        if(value) set(nbits - 1);
+    }
+
+    bool test(int id) const{
+        return (words[id >> 6] >> (id & 63)) & 1;
+    }
+    bool operator[](int id) const{
+        return test(id);
+    }
+    void set(int id){
+        words[id >> 6] |= 1ull << (id & 63);
+    }
+    void reset(int id){
+        words[id >> 6] &= ~(1ull << (id & 63));
+    }
+    //sets the bit; returns its old value
+    bool testAndSet(int id){
+        Word& word = words[id >> 6];
+        Word mask = 1ull << (id & 63);
+        bool old = (word & mask) != 0;
+        word |= mask;
+        return old;
+    }
+
+    //every bit to false (size kept)
+    void reset(){
+        if(!words.empty()) std::memset(words.data(), 0, words.size() * sizeof(Word));
+    }
+    void fill(bool value){
+        if(!value){
+            reset();
+            return;
+        }
+        for(Word& word: words) word = ~0ull;
+        trim();
+    }
+
+    //number of bits set
+    int count() const{
+        int total = 0;
+        for(Word word: words) total += popcount(word);
+        return total;
+    }
+    bool any() const{
+        for(Word word: words)
+            if(word != 0) return true;
+        return false;
+    }
+
+    //first set bit at or after from; -1 if none
+    int findNext(int from) const{
+        if(from < 0) from = 0;
+        if(from >= nbits) return -1;
+        int idx = from >> 6;
+        Word word = words[idx] & (~0ull << (from & 63));
+        while(word == 0){
+            if(++idx == (int)words.size()) return -1;
+            word = words[idx];
+        }
+        return idx * WORD_BITS + trailingZeros(word);
+    }
+    //first clear bit at or after from; -1 if none
+    int findNextClear(int from) const{
+        if(from < 0) from = 0;
+        if(from >= nbits) return -1;
+        int idx = from >> 6;
+        Word word = ~words[idx] & (~0ull << (from & 63));
+        while(word == 0){
+            if(++idx == (int)words.size()) return -1;
+            word = ~words[idx];
+        }
+        int id = idx * WORD_BITS + trailingZeros(word);
+        return id < nbits ? id : -1;
+    }
+
+    DynamicBitset& operator|=(const DynamicBitset& other){
+        Word* lhs = words.data();
+        const Word* rhs = other.words.data();
+        for(int idx=0, n=(int)words.size(); idx < n; idx++) lhs[idx] |= rhs[idx];
+        return *this;
+    }
+    DynamicBitset& operator&=(const DynamicBitset& other){
+        Word* lhs = words.data();
+        const Word* rhs = other.words.data();
+        for(int idx=0, n=(int)words.size(); idx < n; idx++) lhs[idx] &= rhs[idx];
+        return *this;
+    }
+    //clears the bits set in other
+    DynamicBitset& andNot(const DynamicBitset& other){
+        Word* lhs = words.data();
+        const Word* rhs = other.words.data();
+        for(int idx=0, n=(int)words.size(); idx < n; idx++) lhs[idx] &= ~rhs[idx];
+        return *this;
+    }
+    bool operator==(const DynamicBitset& other) const{
+        return nbits == other.nbits && words == other.words;
+    }
+
+    //raw words, (size() + 63) / 64 of them
+    Word* data(){
+        return words.data();
+    }
+    const Word* data() const{
+        return words.data();
+    }
+    int wordCount() const{
+        return (int)words.size();
+    }
+    long long memoryBytes() const{
+        return (long long)words.capacity() * sizeof(Word);
+    }
+
+    static int popcount(Word word){
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int total = 0;
+        for(; word != 0; word &= word - 1) total++;
+        return total;
+#endif
+    }
+    //index of the lowest set bit; word != 0
+    static int trailingZeros(Word word){
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int count = 0;
+        for(; (word & 1) == 0; word >>= 1) count++;
+        return count;
+#endif
+    }
+
+protected:
+    static int wordCount(int nbits){
+        return nbits > 0 ? (nbits + WORD_BITS - 1) / WORD_BITS : 0;
+    }
+    //clears the bits past size() in the last word
+    void trim(){
+        int tail = nbits & (WORD_BITS - 1);
+        if(tail != 0) words.back() &= (1ull << tail) - 1;
+    }
+};
+
+#endif /* DYNAMICBITSET_H */
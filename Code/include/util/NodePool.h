@@ -0,0 +1,127 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines NodePool: an arena of fixed-size slots for the nodes of a tree
+*/
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+#include <new>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/*
+! NodePool<T>
+? Functionality:
+    * Hands out slots for T from a few large blocks instead of one heap allocation
+      per node: create(args...) constructs a T in a slot, destroy(node) destroys it and
+      puts the slot on a free list, which create() uses first.
+    * Blocks grow geometrically (FIRST_BLOCK slots, then twice as many, up to MAX_BLOCK),
+      so a pool of n nodes holds O(log n) blocks and neighbours in creation order are
+      neighbours in memory.
+    * reset(): forgets every node at once and keeps the blocks for the next batch;
+      release(): frees the blocks. Neither runs the destructors of live nodes: the
+      owner does that first when T is not trivially destructible.
+? Complexity:
+    * create, destroy: O(1); reset: O(number of blocks).
+? Notes:
+    * Not thread-safe; one pool per tree. Slots are not given back to the system
+      before release() or the destructor.
+? Usage:
+    * NodePool<Node> pool;
+    * Node* node = pool.create(); ... pool.destroy(node);
+    * pool.reset();     //the tree is cleared, its memory kept
+*/
+template<class T>
+class NodePool{
+public:
+    static const int FIRST_BLOCK = 64;
+    static const int MAX_BLOCK = 65536;
+
+protected:
+    union Slot{
+        Slot* next;                                 //while on the free list
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    struct Block{
+        Slot* slots;
+        int capacity;
+    };
+
+    vector<Block> blocks;
+    int current;        //block being carved, blocks.size() if none
+    int used;           //slots carved from blocks[current]
+    Slot* freeList;
+    int live;
+
+public:
+    NodePool(): current(0), used(0), freeList(0), live(0){}
+    ~NodePool(){
+        release();
+    }
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template<class... Args>
+    T* create(Args&&... args){
+        Slot* slot = freeList;
+        if(slot != 0) freeList = slot->next;
+        else slot = carve();
+        T* node = new(slot->storage) T(std::forward<Args>(args)...);
+        live++;
+        return node;
+    }
+    void destroy(T* node){
+        node->~T();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = freeList;
+        freeList = slot;
+        live--;
+    }
+
+    //forgets every node (without destroying them) and keeps the blocks
+    void reset(){
+        current = 0;
+        used = 0;
+        freeList = 0;
+        live = 0;
+    }
+    //forgets every node (without destroying them) and frees the blocks
+    void release(){
+        for(Block& block: blocks) ::operator delete((void*)block.slots);
+        blocks.clear();
+        reset();
+    }
+
+    //number of nodes created and not destroyed since the last reset
+    int size() const{
+        return live;
+    }
+    //number of slots in the blocks
+    long long capacity() const{
+        long long total = 0;
+        for(const Block& block: blocks) total += block.capacity;
+        return total;
+    }
+
+protected:
+    Slot* carve(){
+        while(current < (int)blocks.size() && used == blocks[current].capacity){
+            current++;
+            used = 0;
+        }
+        if(current == (int)blocks.size()){
+            int size = blocks.empty() ? FIRST_BLOCK : blocks.back().capacity * 2;
+            if(size > MAX_BLOCK) size = MAX_BLOCK;
+            Block block;
+            block.slots = static_cast<Slot*>(::operator new(sizeof(Slot) * size));
+            block.capacity = size;
+            blocks.push_back(block);
+            used = 0;
+        }
+        return &blocks[current].slots[used++];
+    }
+};
+
+#endif /* NODEPOOL_H */
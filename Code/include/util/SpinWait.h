@@ -0,0 +1,58 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines SpinWait: the back-off used by the lock-free containers
+*/
+
+#ifndef SPINWAIT_H
+#define SPINWAIT_H
+#include <thread>
+
+/*
+* CACHE_LINE: size used to keep independently written indices on separate lines
+*/
+#ifndef CACHE_LINE
+#define CACHE_LINE 64
+#endif
+
+/*
+! SpinWait
+? Functionality:
+    * wait(): the first SPIN_LIMIT calls execute a CPU pause hint (cheap, keeps the
+      core), later calls give the time slice away with std::this_thread::yield(),
+      so a waiting thread cannot starve the thread it waits for on a busy machine.
+? Usage:
+    * SpinWait spin;
+    * while(!queue.tryPop(item)) spin.wait();
+*/
+class SpinWait{
+public:
+    static const int SPIN_LIMIT = 64;
+
+private:
+    int count;
+
+public:
+    SpinWait(): count(0){}
+
+    void wait(){
+        if(count < SPIN_LIMIT){
+            cpuRelax();
+            count++;
+        }
+        else std::this_thread::yield();
+    }
+    void reset(){
+        count = 0;
+    }
+
+    static void cpuRelax(){
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+        __asm__ __volatile__("yield");
+#endif
+    }
+};
+
+#endif /* SPINWAIT_H */
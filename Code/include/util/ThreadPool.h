@@ -0,0 +1,243 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file defines a fixed-size thread pool shared by the parallel algorithms
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <stdexcept>
+#include <exception>
+using namespace std;
+
+/*
+! ThreadPool
+? Functionality:
+    * Owns "nthreads" worker threads that execute submitted tasks (void()).
+    * wait() blocks until every submitted task has finished; the waiting thread
+      runs queued tasks itself while it waits. It counts every task, the caller's
+      own included, so it must be called from outside the pool (a task calling
+      it gets a std::logic_error instead of a deadlock).
+    * Sub-tasks: submit(task, group) counts the task in a TaskGroup as well, and
+      wait(group) returns when the tasks of that group are finished. It may be
+      called from a task: the waiting worker runs queued tasks (its sub-tasks
+      or others) meanwhile, so nested waits cannot starve the pool.
+    * parallelFor(begin, end, fn) splits [begin, end) into contiguous blocks and
+      calls fn(blockBegin, blockEnd) on the workers; it waits on its own group,
+      so a task may call it too.
+    * A task that throws does not stop its worker: the first exception of a group
+      is rethrown by wait(group), that of an ungrouped task by wait().
+? Notes:
+    * nthreads <= 0 means std::thread::hardware_concurrency().
+    * A pool of size 1 still runs tasks on its worker, so timings are comparable.
+? Usage:
+    * ThreadPool pool(4);
+    * pool.parallelFor(0, n, [&](int lo, int hi){ for(int i=lo; i<hi; i++) work(i); });
+    * ThreadPool::TaskGroup children;           //inside a task
+    * pool.submit(left, children); pool.submit(right, children); pool.wait(children);
+*/
+class ThreadPool{
+public:
+    //tasks submitted with submit(task, group), waited for by wait(group)
+    class TaskGroup{
+    private:
+        friend class ThreadPool;
+        int pending;
+        exception_ptr error;    //first exception thrown by a task of the group
+    public:
+        TaskGroup(): pending(0){}
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+    };
+
+private:
+    struct Task{
+        function<void()> run;
+        TaskGroup* group;
+    };
+
+    vector<thread> workers;
+    deque<Task> tasks;
+    mutex lock;
+    condition_variable taskReady;
+    condition_variable allDone;
+    int pending;    //submitted but not finished
+    int waiting;    //threads asleep in wait(), woken by new tasks to help with them
+    bool stopping;
+    exception_ptr error;    //first exception thrown by an ungrouped task
+
+public:
+    ThreadPool(int nthreads=0){
+        if(nthreads <= 0) nthreads = defaultThreads();
+        this->pending = 0;
+        this->waiting = 0;
+        this->stopping = false;
+        for(int idx=0; idx < nthreads; idx++)
+            workers.push_back(thread(&ThreadPool::workerLoop, this));
+    }
+    ~ThreadPool(){
+        {
+            unique_lock<mutex> guard(lock);
+            stopping = true;
+        }
+        taskReady.notify_all();
+        for(auto& worker: workers) worker.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size(){
+        return (int)workers.size();
+    }
+
+    static int defaultThreads(){
+        int n = (int)thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+    /*
+    ! submit(task): queue a task for the workers
+    */
+    void submit(function<void()> task){
+        enqueue(std::move(task), nullptr);
+    }
+    /*
+    ! submit(task, group): queue a task counted in group
+    */
+    void submit(function<void()> task, TaskGroup& group){
+        enqueue(std::move(task), &group);
+    }
+
+    /*
+    ! wait(): block until all submitted tasks are finished (helping with the queue)
+    ? Exceptions:
+        * std::logic_error if called from a task of this pool (use a TaskGroup)
+        * the first exception thrown by an ungrouped task since the last wait()
+    */
+    void wait(){
+        if(current() == this) throw std::logic_error("ThreadPool: wait() called from a task, wait on a TaskGroup instead");
+        unique_lock<mutex> guard(lock);
+        while(pending > 0){
+            if(!tasks.empty()) runOne(guard);
+            else sleep(guard);
+        }
+        rethrow(error);
+    }
+    /*
+    ! wait(group): block until the tasks of group are finished (helping with the queue)
+    ? Exceptions:
+        * the first exception thrown by a task of group, once all of them are finished
+    */
+    void wait(TaskGroup& group){
+        unique_lock<mutex> guard(lock);
+        while(group.pending > 0){
+            if(!tasks.empty()) runOne(guard);
+            else sleep(guard);
+        }
+        rethrow(group.error);
+    }
+
+    /*
+    ! parallelFor(begin, end, fn, grain)
+    ? Functionality:
+        * Calls fn(lo, hi) on disjoint blocks covering [begin, end) and waits for them.
+        * Blocks are at least "grain" long; by default one block per worker.
+    */
+    template<class F>
+    void parallelFor(long long begin, long long end, F fn, long long grain=0){
+        long long n = end - begin;
+        if(n <= 0) return;
+        long long nblocks = size();
+        if(grain > 0 && n / grain < nblocks) nblocks = n / grain;
+        if(nblocks <= 1){
+            fn(begin, end);
+            return;
+        }
+        long long step = n / nblocks, extra = n % nblocks, lo = begin;
+        TaskGroup blocks;
+        for(long long block=0; block < nblocks; block++){
+            long long hi = lo + step + (block < extra ? 1 : 0);
+            submit([fn, lo, hi](){ fn(lo, hi); }, blocks);
+            lo = hi;
+        }
+        wait(blocks);
+    }
+
+private:
+    //the pool whose task the calling thread is running, nullptr outside tasks
+    static ThreadPool*& current(){
+        static thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    void enqueue(function<void()> task, TaskGroup* group){
+        {
+            unique_lock<mutex> guard(lock);
+            tasks.push_back(Task{std::move(task), group});
+            pending++;
+            if(group != nullptr) group->pending++;
+            if(waiting > 0) allDone.notify_all();
+        }
+        taskReady.notify_one();
+    }
+    void sleep(unique_lock<mutex>& guard){
+        waiting++;
+        allDone.wait(guard);
+        waiting--;
+    }
+    //runs the first queued task without the lock, then counts it as finished
+    void runOne(unique_lock<mutex>& guard){
+        ThreadPool* outer = current();
+        current() = this;
+        runFront(guard);
+        current() = outer;
+    }
+    void runFront(unique_lock<mutex>& guard){
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        guard.unlock();
+        exception_ptr thrown;
+        try{
+            task.run();
+        }
+        catch(...){
+            thrown = std::current_exception();
+        }
+        guard.lock();
+        finish(task, thrown);
+    }
+    //with the lock held
+    void finish(Task& task, exception_ptr thrown){
+        if(thrown){
+            exception_ptr& first = task.group != nullptr ? task.group->error : error;
+            if(!first) first = thrown;
+        }
+        bool groupDone = task.group != nullptr && --task.group->pending == 0;
+        if(--pending == 0 || groupDone) allDone.notify_all();
+    }
+    //with the lock held: throws the stored exception, if any, and forgets it
+    static void rethrow(exception_ptr& stored){
+        if(!stored) return;
+        exception_ptr thrown = stored;
+        stored = nullptr;
+        std::rethrow_exception(thrown);
+    }
+
+    void workerLoop(){
+        current() = this;
+        unique_lock<mutex> guard(lock);
+        while(true){
+            taskReady.wait(guard, [this](){ return stopping || !tasks.empty(); });
+            if(tasks.empty()) return; //stopping and drained
+            runFront(guard);
+        }
+    }
+};
+
+#endif /* THREADPOOL_H */
@@ -0,0 +1,455 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file contains testcases for the approximate membership filters (BlockedBloomFilter,
+    * CuckooFilter) and FilteredMap
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <regex>
+#include <random>
+#include <climits>
+#include <limits>
+#include <atomic>
+#include "hash/BloomFilter.h"
+#include "hash/CuckooFilter.h"
+#include "hash/FilteredMap.h"
+using namespace std;
+namespace fs = std::filesystem;
+int num_task = 4;
+vector<vector<string>> expected_task (num_task, vector<string>(1000, ""));
+vector<vector<string>> output_task (num_task, vector<string>(1000, ""));
+vector<int> diffTasks(0);
+vector<int> doTasks(0);
+
+void compareFile(const string& filename1, const string& filename2) {
+    string log_file = "TestLog/Filter/FilterTestLog_Compare.txt";
+    fstream file(log_file, ios::out);
+    if (!file.is_open()) {
+        std::cout << "Cannot open file" << std::endl;
+        return;
+    }
+    
+    streambuf* stream_buffer_cout = cout.rdbuf();
+    cout.rdbuf(file.rdbuf());
+
+    fstream file1(filename1);
+    fstream file2(filename2);
+
+    // Store content of tasks in vector
+    string line;
+    int num = 1;
+    int num_line = 0;
+    while (getline(file1, line)) {
+        // if line contains "Task", store it in expected_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        expected_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    num = 1;
+    num_line = 0;
+    while (getline(file2, line)) {
+        // if line contains "Task", store it in output_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        output_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    // Compare content of tasks
+    for (int task = 0; task < num_task; task++) {
+        int count_diff = 0;
+        if (output_task[task][0] == "") continue;
+        doTasks.push_back(task + 1);
+        for (int line = 0; line < expected_task[task].size(); line++) {
+            if (expected_task[task][line] != output_task[task][line]) {
+                count_diff++;
+                cout << "Task " << task << " - Line " << line << ":\n";
+                cout << "Expected: " << expected_task[task][line];
+                cout << "Output: " << output_task[task][line];
+            }
+        }
+        if (count_diff > 0) {
+            diffTasks.push_back(task + 1);
+        }
+    }
+    
+    cout.rdbuf(stream_buffer_cout);
+    float prop = (float)diffTasks.size() / (float)doTasks.size();
+    if (prop == 0) {
+        std::cout << "All tasks are correct" << std::endl;
+    } else {
+        std::cout << "Number of tasks to do: " << doTasks.size() << std::endl;
+        std::cout << "Number of tasks with differences: " << diffTasks.size() << std::endl;
+        std::cout << "Pass: " << 1 - prop << std::endl;
+        for (int i = 0; i < diffTasks.size(); i++) {
+            std::cout << "Task " << diffTasks[i] << std::endl;
+        }
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: exe_file [OPTIONS] [TASK]" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  ?help: show help" << std::endl;
+    std::cout << "  demo: run demo" << std::endl;
+    std::cout << "  test: run all test" << std::endl;
+    std::cout << "  test [task]: run specific test" << std::endl;
+    std::cout << "  test [start_task] [end_task] : run test from start_task to end_task" << std::endl;
+    std::cout << "This test has " << num_task << " tasks" << std::endl;
+}
+
+// every key in the same buckets with the same fingerprint
+unsigned long long sameHash(int& key) {
+    return 0x123456789ABCDEFull;
+}
+
+/*
+    BlockedBloomFilter: arguments, empty filter, no false negatives, false-positive rate, clear
+*/
+void test1() {
+    double badRates[] = {0, 1, -0.5};
+    for (double rate : badRates) {
+        try {
+            BlockedBloomFilter<int> filter(10, rate);
+        } catch (std::invalid_argument& e) {
+            cout << "fpr " << rate << ": " << e.what() << endl;
+        }
+    }
+    try {
+        BlockedBloomFilter<int> filter(-1);
+    } catch (std::invalid_argument& e) {
+        cout << "capacity -1: " << e.what() << endl;
+    }
+
+    // capacity 0 still has one block
+    BlockedBloomFilter<int> empty(0, 0.01);
+    cout << "Capacity 0: " << empty.memoryBytes() << " bytes, size " << empty.size()
+         << ", mayContain(7): " << empty.mayContain(7) << ", rate " << empty.falsePositiveRate() << endl;
+    empty.add(7);
+    cout << "After add(7): mayContain(7): " << empty.mayContain(7) << ", size " << empty.size() << endl;
+
+    double targets[] = {0.1, 0.01, 0.001};
+    for (double target : targets) {
+        BlockedBloomFilter<int> filter(10000, target);
+        bool added = true;
+        for (int key = 0; key < 10000; key++) added = filter.add(key * 7) && added;
+        bool noFalseNegative = true;
+        for (int key = 0; key < 10000; key++) noFalseNegative = noFalseNegative && filter.mayContain(key * 7);
+        int falsePositives = 0;
+        for (int key = 0; key < 100000; key++) falsePositives += filter.mayContain(key * 7 + 3);
+        double rate = falsePositives / 100000.0;
+        cout << "fpr " << target << ": k " << filter.hashCount() << ", bits per key " << filter.bitsPerKey()
+             << ", add always true: " << added << ", no false negative: " << noFalseNegative
+             << ", measured rate below 2x target: " << (rate < 2 * target)
+             << ", expected rate at capacity within target: " << (filter.falsePositiveRate() <= target) << endl;
+    }
+
+    // past capacity the filter keeps accepting keys, the expected rate grows
+    BlockedBloomFilter<int> small(100, 0.01);
+    for (int key = 0; key < 100; key++) small.add(key);
+    double atCapacity = small.falsePositiveRate();
+    for (int key = 100; key < 1000; key++) small.add(key);
+    bool all = true;
+    for (int key = 0; key < 1000; key++) all = all && small.mayContain(key);
+    cout << "Overfilled 10x: size " << small.size() << ", all found: " << all
+         << ", rate grew: " << (small.falsePositiveRate() > 10 * atCapacity) << endl;
+    small.clear();
+    int left = 0;
+    for (int key = 0; key < 1000; key++) left += small.mayContain(key);
+    cout << "After clear: size " << small.size() << ", keys still reported: " << left << endl;
+
+    BlockedBloomFilter<string> words(3, 0.01);
+    words.add("alpha");
+    words.add("beta");
+    cout << "Strings: alpha " << words.mayContain("alpha") << ", beta " << words.mayContain("beta") << endl;
+}
+
+/*
+    CuckooFilter: arguments, empty filter, add / remove, duplicates, deletion of absent keys
+*/
+void test2() {
+    try {
+        CuckooFilter<int> filter(-5);
+    } catch (std::invalid_argument& e) {
+        cout << "capacity -5: " << e.what() << endl;
+    }
+    try {
+        CuckooFilter<int> filter(10, 1.5);
+    } catch (std::invalid_argument& e) {
+        cout << "fpr 1.5: " << e.what() << endl;
+    }
+    double targets[] = {0.5, 0.01, 0.0001, 1e-9};
+    cout << "Fingerprint bits:";
+    for (double target : targets) cout << " " << CuckooFilter<int>(100, target).fingerprintBits();
+    cout << endl;
+
+    CuckooFilter<int> empty(0);
+    cout << "Capacity 0: " << empty.memoryBytes() << " bytes, size " << empty.size()
+         << ", mayContain(1): " << empty.mayContain(1) << ", remove(1): " << empty.remove(1)
+         << ", load " << empty.loadFactor() << ", rate " << empty.falsePositiveRate() << endl;
+
+    CuckooFilter<int> filter(10000, 0.001);
+    bool added = true;
+    for (int key = 0; key < 9000; key++) added = filter.add(key) && added;
+    bool noFalseNegative = true;
+    for (int key = 0; key < 9000; key++) noFalseNegative = noFalseNegative && filter.mayContain(key);
+    int falsePositives = 0;
+    for (int key = 9000; key < 109000; key++) falsePositives += filter.mayContain(key);
+    cout << "9000 keys: all added: " << added << ", no false negative: " << noFalseNegative
+         << ", measured rate below 2x target: " << (falsePositives / 100000.0 < 0.002)
+         << ", load below 0.95: " << (filter.loadFactor() < 0.95) << endl;
+
+    // remove the even keys: the odd ones are still there, the even ones are (nearly all) gone
+    bool removed = true;
+    for (int key = 0; key < 9000; key += 2) removed = filter.remove(key) && removed;
+    bool oddKept = true;
+    int evenLeft = 0;
+    for (int key = 0; key < 9000; key++) {
+        if (key % 2) oddKept = oddKept && filter.mayContain(key);
+        else evenLeft += filter.mayContain(key);
+    }
+    cout << "Removed the even keys: all removed: " << removed << ", size " << filter.size()
+         << ", odd keys kept: " << oddKept << ", even keys still reported below 1%: " << (evenLeft < 45) << endl;
+
+    // a duplicate is stored twice and removed once at a time
+    CuckooFilter<int> copies(16);
+    copies.add(42);
+    copies.add(42);
+    cout << "42 twice: size " << copies.size() << ", remove: " << copies.remove(42);
+    cout << ", still there: " << copies.mayContain(42) << ", remove: " << copies.remove(42);
+    cout << ", still there: " << copies.mayContain(42) << ", remove again: " << copies.remove(42) << endl;
+    copies.add(1);
+    copies.add(2);
+    copies.clear();
+    cout << "After clear: size " << copies.size() << ", mayContain(1): " << copies.mayContain(1) << endl;
+}
+
+/*
+    CuckooFilter overfill: the victim keeps the last evicted fingerprint, add fails until a remove
+*/
+void test3() {
+    // one key value in two buckets of 4 slots: 8 copies fit, the 9th becomes the victim
+    CuckooFilter<int> filter(8, 0.01, &sameHash);
+    cout << "Adds:";
+    for (int copy = 1; copy <= 10; copy++) cout << " " << filter.add(5);
+    cout << endl;
+    cout << "Size " << filter.size() << ", mayContain(5): " << filter.mayContain(5) << endl;
+    cout << "remove: " << filter.remove(5) << ", size " << filter.size() << ", add again: " << filter.add(5)
+         << ", then: " << filter.add(5) << endl;
+    int removes = 0;
+    while (filter.remove(5)) removes++;
+    cout << "Removed " << removes << " copies, size " << filter.size() << ", mayContain(5): " << filter.mayContain(5)
+         << ", add: " << filter.add(5) << endl;
+
+    // distinct keys until the first failed add: no added key is lost
+    CuckooFilter<int> small(64, 0.001);
+    int key = 0;
+    while (small.add(key)) key++;
+    bool all = true;
+    for (int k = 0; k < key; k++) all = all && small.mayContain(k);
+    cout << "Filled: " << key << " keys for " << small.memoryBytes() / 2 << " slots, all found: " << all
+         << ", load above 0.9: " << (small.loadFactor() > 0.9) << ", add fails again: " << !small.add(-1) << endl;
+    small.remove(0);
+    cout << "After one remove: add: " << small.add(-1) << ", all found: ";
+    all = small.mayContain(-1);
+    for (int k = 1; k < key; k++) all = all && small.mayContain(k);
+    cout << all << endl;
+    small.clear();
+    cout << "After clear: add: " << small.add(0) << ", size " << small.size() << endl;
+}
+
+// filter hash that keeps every key in the first 16 buckets of a cuckoo filter
+unsigned long long lowBucketHash(int& key) {
+    return (unsigned long long)(key & 15) | ((unsigned long long)key << 32);
+}
+
+/*
+    FilteredMap: misses, hits, growth with filter rebuilds, removes with cuckoo and Bloom filters
+*/
+void test4() {
+    FilteredMap<int, int> map(&xMap<int, int>::intKeyHash, 4, 0.01);
+    cout << "Empty: size " << map.size() << ", empty " << map.empty() << ", find null " << (map.find(1) == 0)
+         << ", containsKey " << map.containsKey(1) << ", remove(1, 1) " << map.remove(1, 1) << endl;
+    try {
+        map.get(1);
+    } catch (std::exception& e) {
+        cout << "get: " << e.what() << endl;
+    }
+    try {
+        map.remove(1);
+    } catch (std::exception& e) {
+        cout << "remove: " << e.what() << endl;
+    }
+
+    cout << "put new: " << map.put(1, 10) << ", put existing: " << map.put(1, 11) << ", get: " << map.get(1) << endl;
+    // capacity 4: the fifth key rebuilds the filter with twice the capacity
+    for (int key = 2; key <= 4; key++) map.put(key, key * 10);
+    cout << "4 keys: filter capacity " << map.getFilter().getCapacity() << ", filter size " << map.getFilter().size() << endl;
+    map.put(5, 50);
+    cout << "5 keys: filter capacity " << map.getFilter().getCapacity() << ", filter size " << map.getFilter().size() << endl;
+    for (int key = 6; key <= 1000; key++) map.put(key, key * 10);
+    bool ok = map.size() == 1000;
+    for (int key = 1; key <= 1000; key++) ok = ok && map.find(key) != 0 && *map.find(key) == (key == 1 ? 11 : key * 10);
+    int misses = 0;
+    for (int key = 1001; key <= 11000; key++) misses += map.find(key) == 0;
+    cout << "1000 keys: all found: " << ok << ", filter capacity " << map.getFilter().getCapacity()
+         << ", 10000 misses: " << misses << endl;
+
+    // cuckoo filter: removed keys leave the filter
+    for (int key = 1; key <= 1000; key += 2) map.remove(key);
+    cout << "Removed the odd keys: size " << map.size() << ", filter size " << map.getFilter().size()
+         << ", containsKey(3): " << map.containsKey(3) << ", containsKey(4): " << map.containsKey(4)
+         << ", remove(4, 41): " << map.remove(4, 41) << ", remove(4, 40): " << map.remove(4, 40) << endl;
+
+    FilteredMap<int, int> copy(map);
+    copy.put(3, 30);
+    map.clear();
+    cout << "Copy: size " << copy.size() << ", get(3): " << copy.get(3) << "; original after clear: size " << map.size()
+         << ", filter size " << map.getFilter().size() << endl;
+    map = copy;
+    cout << "Assigned: size " << map.size() << ", containsKey(3): " << map.containsKey(3) << endl;
+
+    // every key in the first 16 buckets: rebuild(100) overflows, the filter is built again for 200
+    FilteredMap<int, int> tight(&xMap<int, int>::intKeyHash, 16, 0.01, 0.75f, 0, 0, 0, &lowBucketHash);
+    for (int key = 0; key < 100; key++) tight.put(key, key);
+    tight.rebuild(tight.size());
+    bool tightOk = true;
+    for (int key = 0; key < 100; key++) tightOk = tightOk && tight.containsKey(key);
+    cout << "rebuild(100): filter capacity " << tight.getFilter().getCapacity() << ", filter size "
+         << tight.getFilter().size() << ", all found: " << tightOk << endl;
+
+    // Bloom filter: removed keys stay in the filter until they outnumber the map
+    FilteredMap<int, int, BlockedBloomFilter<int>> bloom(&xMap<int, int>::intKeyHash, 100, 0.01);
+    for (int key = 0; key < 10; key++) bloom.put(key, key);
+    for (int key = 0; key < 5; key++) bloom.remove(key);
+    cout << "Bloom, 5 of 10 removed: size " << bloom.size() << ", filter size " << bloom.getFilter().size()
+         << ", containsKey(0): " << bloom.containsKey(0) << ", find(0) null: " << (bloom.find(0) == 0) << endl;
+    bloom.remove(5);
+    cout << "Bloom, 6 removed: size " << bloom.size() << ", filter size " << bloom.getFilter().size()
+         << " (rebuilt), containsKey(9): " << bloom.containsKey(9) << endl;
+    try {
+        bloom.get(5);
+    } catch (std::exception& e) {
+        cout << "get: " << e.what() << endl;
+    }
+    bloom.rebuild(0);
+    cout << "rebuild(0): filter capacity " << bloom.getFilter().getCapacity() << ", filter size " << bloom.getFilter().size()
+         << ", keys " << bloom.keys().toString() << endl;
+}
+
+void runDemo() {
+    cout << "Demo: FilteredMap" << endl;
+    FilteredMap<int, int> map(&xMap<int, int>::intKeyHash, 16);
+    for (int key = 1; key <= 5; key++) map.put(key, key * key);
+    cout << "find(3): " << *map.find(3) << ", find(30) null: " << (map.find(30) == 0) << endl;
+    map.println();
+}
+
+// pointer function to store tests
+void (*testFuncs[])() = {
+    test1, test2, test3, test4
+};
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2) {
+        if (string(argv[1]) == "?help") {
+            printUsage();
+            return 0;
+        }
+        else
+        if (string(argv[1]) == "demo") {
+            string file_name = "DemoLog.txt";
+            fstream file_demo(file_name, ios::out);
+            if (!file_demo.is_open()) {
+                std::cout << "Cannot open file" << std::endl;
+                return 0;
+            } 
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file_demo.rdbuf());
+
+            runDemo();
+
+            cout.rdbuf(stream_buffer_cout);
+            return 0;
+        }
+        else if (string(argv[1]) == "test")
+        {
+            string folder = "TestLog/Filter";
+            string path = "FilterTestLog_NhanOutput.txt";
+            string output = "FilterTestLog_YourOutput.txt";
+            fstream file(folder + "/" + output, ios::out);
+            if (!file.is_open()) {
+                fs::create_directory(folder);
+                std::cout << "Create folder " << fs::absolute(folder) << std::endl;
+                file.open(folder + "/" + output, ios::out);
+            }
+            //change cout to file
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file.rdbuf());
+
+            if (string(argv[1]) == "test") {
+                if (argc == 2) {
+                    for (int i = 0; i < num_task; i++) {
+                        std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                        testFuncs[i]();
+                    }
+                } else
+                if (argc == 3) {
+                    int task = stoi(argv[2]);
+                    if (task >= 1 && task <= num_task) {
+                        std::cout << "Task " << task << "---------------------------------------------------" <<std::endl;
+                        testFuncs[task - 1]();
+                    } else {
+                        std::cout << "Task not found" << std::endl;
+                    }
+                } else
+                if (argc == 4) {
+                    int start = stoi(argv[2]);
+                    int end = stoi(argv[3]);
+                    if (start >= 1 && start <= num_task && end >= 1 && end <= num_task && start <= end) {
+                        for (int i = start - 1; i < end; i++) {
+                            std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                            testFuncs[i]();
+                        }
+                    } else {
+                        std::cout << "Task not found or you enter error" << std::endl;
+                    }
+                }
+            }
+
+            // Restore cout
+            cout.rdbuf(stream_buffer_cout);
+            compareFile(folder + "/" + path, folder + "/" + output);
+        }
+    }
+    return 0;
+}
\ No newline at end of file
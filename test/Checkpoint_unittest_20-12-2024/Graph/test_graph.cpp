@@ -6,6 +6,7 @@
 #include <string>
 #include <filesystem>
 #include <regex>
+#include <random>
 using namespace std;
 
 #include "graph/AbstractGraph.h"
@@ -14,10 +15,17 @@ using namespace std;
 #include "graph/DGraphDemo.h"
 #include "graph/UGraphDemo.h"
 #include "graph/TopoSorter.h"
+#include "graph/DynamicTopoOrder.h"
+#include "graph/SCCFinder.h"
+#include "graph/GraphAnalytics.h"
+#include "graph/GraphIO.h"
+#include "graph/VertexIds.h"
+#include "graph/ParallelBFS.h"
+#include "util/DynamicBitset.h"
 
 using namespace std;
 namespace fs = std::filesystem;
-int num_task = 77;
+int num_task = 91;
 
 
 vector<vector<string>> expected_task (num_task, vector<string>(1000, ""));
@@ -2445,6 +2453,871 @@ void sort_topo25() {
 }
 
 
+void graph_index01() {
+  string name = "graph_index01";
+  DGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  char vertices[] = {'1', '2', '3', '7', '8', '6', '4', '5'};
+  for (int idx = 0; idx < 8; idx++) {
+    model.add(vertices[idx]);
+  }
+  model.add('3');
+  model.connect('1', '2', 1.5);
+  model.connect('1', '3');
+  model.connect('2', '7', 2);
+  model.connect('3', '7');
+  model.connect('7', '8');
+  model.connect('6', '4');
+  model.connect('1', '2', 3.5);
+  cout << "weight(1,2): " << model.weight('1', '2') << endl;
+  cout << "connected(2,7): " << model.connected('2', '7') << endl;
+  cout << "connected(7,2): " << model.connected('7', '2') << endl;
+  cout << "inDegree(7): " << model.inDegree('7') << endl;
+  cout << "outDegree(1): " << model.outDegree('1') << endl;
+  try {
+    model.connect('1', '9');
+  } catch (VertexNotFoundException& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+
+  model.remove('7');
+  cout << "contains(7): " << model.contains('7') << endl;
+  cout << "outDegree(2): " << model.outDegree('2') << endl;
+  model.add('7');
+  model.connect('5', '7');
+  cout << model.toString();
+
+  TopoSorter<char> topoSorter(&model, &intKeyHash);
+  DLinkedList<char> result = topoSorter.sort(TopoSorter<char>::BFS);
+  cout << "BFS Topological Sort: ";
+  for (auto it = result.begin(); it != result.end(); it++) {
+    cout << *it << "->";
+  }
+  cout << "NULL" << endl;
+
+  model.clear();
+  cout << "size after clear: " << model.size() << endl;
+  model.add('9');
+  cout << "contains(9): " << model.contains('9') << ", contains(1): " << model.contains('1') << endl;
+}
+
+
+void graph_index02() {
+  string name = "graph_index02";
+  UGraphModel<char> model(&charComparator, &vertex2str);
+  char vertices[] = {'0', '1', '2', '3', '4'};
+  for (int idx = 0; idx < 5; idx++) {
+    model.add(vertices[idx]);
+  }
+  model.connect('0', '1', 4);
+  model.connect('1', '2', 2);
+  model.connect('2', '2', 1);
+  model.connect('3', '4');
+  // turn the index on for a graph that already has vertices and edges
+  model.setVertexHash(&intKeyHash);
+  model.connect('4', '0', 7);
+  cout << "weight(2,1): " << model.weight('2', '1') << endl;
+  cout << "weight(0,4): " << model.weight('0', '4') << endl;
+  model.disconnect('1', '0');
+  model.remove('3');
+  try {
+    model.weight('3', '4');
+  } catch (VertexNotFoundException& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+  try {
+    model.weight('0', '1');
+  } catch (EdgeNotFoundException& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+  cout << model.toString();
+  model.clear();cout << endl;
+}
+
+
+void graph_csr01() {
+  string name = "graph_csr01";
+  DGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  char vertices[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  for (int idx = 0; idx < 10; idx++) {
+    model.add(vertices[idx]);
+  }
+  model.connect('0', '1', 2);
+  model.connect('0', '5', 1);
+  model.connect('1', '7');
+  model.connect('3', '2', 4);
+  model.connect('3', '4');
+  model.connect('3', '7');
+  model.connect('3', '8', 0.5);
+  model.connect('4', '8');
+  model.connect('6', '0');
+  model.connect('6', '1');
+  model.connect('6', '2');
+  model.connect('8', '2');
+  model.connect('8', '7');
+  model.connect('9', '4');
+
+  CSRGraph<char>* csr = model.freeze();
+  model.connect('9', '5');  // the snapshot does not change
+  cout << csr->toString();
+  cout << "indexOf(8): " << csr->indexOf('8') << ", indexOf(X): " << csr->indexOf('X') << endl;
+  cout << "inDegree(7): " << csr->inDegree(csr->indexOf('7'))
+       << ", outDegree(3): " << csr->outDegree(csr->indexOf('3')) << endl;
+  cout << "weight(3,8): " << csr->weight('3', '8') << endl;
+  try {
+    csr->weight('9', '5');
+  } catch (EdgeNotFoundException& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+  cout << "neighbors(6):";
+  for (int to : csr->neighbors(csr->indexOf('6'))) {
+    cout << " " << csr->vertex(to);
+  }
+  cout << endl;
+
+  TopoSorter<char> csrSorter(csr);
+  TopoSorter<char> linkedSorter(&model, &intKeyHash);
+  DLinkedList<char> bfs = csrSorter.sort(TopoSorter<char>::BFS);
+  DLinkedList<char> dfs = csrSorter.sort(TopoSorter<char>::DFS);
+  cout << "BFS Topological Sort: " << bfs.toString() << endl;
+  cout << "DFS Topological Sort: " << dfs.toString() << endl;
+  model.disconnect('9', '5');
+  cout << "same as linked: "
+       << (bfs.toString() == linkedSorter.sort(TopoSorter<char>::BFS).toString()) << " "
+       << (dfs.toString() == linkedSorter.sort(TopoSorter<char>::DFS).toString()) << endl;
+  delete csr;
+  model.clear();cout << endl;
+}
+
+float zeroHeuristic(char& vertex, char& goal) {
+  return 0;
+}
+
+void graph_path01() {
+  string name = "graph_path01";
+  DGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  for (char vertex = '0'; vertex <= '5'; vertex++) {
+    model.add(vertex);
+  }
+  model.connect('0', '1', 5);
+  model.connect('0', '2', 3);
+  model.connect('0', '4', 2);
+  model.connect('1', '2', 2);
+  model.connect('1', '3', 6);
+  model.connect('2', '1', 1);
+  model.connect('2', '3', 2);
+  model.connect('4', '1', 6);
+  model.connect('4', '2', 10);
+  model.connect('4', '3', 4);
+  model.connect('5', '0', 1);
+
+  DGraphAlgorithm<char> finder;
+  DLinkedList<Path<char>*> list = finder.dijkstra(&model, '0');
+  cout << "Dijkstra output:" << endl;
+  for (Path<char>* path : list) {
+    cout << path->toString(&vertex2str) << endl;
+    delete path;
+  }
+
+  Path<char>* paths[3] = {finder.shortestPath(&model, '0', '3'),
+                          finder.bidirectionalDijkstra(&model, '0', '3'),
+                          finder.aStar(&model, '0', '3', &zeroHeuristic)};
+  string names[3] = {"shortestPath", "bidirectional", "aStar"};
+  for (int idx = 0; idx < 3; idx++) {
+    cout << names[idx] << "(0,3): " << paths[idx]->toString(&vertex2str) << endl;
+    delete paths[idx];
+  }
+  Path<char>* none = finder.bidirectionalDijkstra(&model, '3', '0');
+  cout << "bidirectional(3,0): " << (none == nullptr ? "unreachable" : none->toString(&vertex2str)) << endl;
+  delete none;
+  try {
+    finder.dijkstra(&model, 'X');
+  } catch (VertexNotFoundException& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+  model.clear();
+}
+
+void graph_path02() {
+  string name = "graph_path02";
+  DGraphModel<char> model(&charComparator, &vertex2str);
+  for (char vertex = 'A'; vertex <= 'E'; vertex++) {
+    model.add(vertex);
+  }
+  model.connect('A', 'B', 4);
+  model.connect('A', 'C', 5);
+  model.connect('B', 'D', 3);
+  model.connect('C', 'B', -3);
+  model.connect('D', 'E', 2);
+  model.connect('C', 'E', 6);
+
+  DGraphAlgorithm<char> finder;
+  DLinkedList<Path<char>*> list = finder.bellman_ford(&model, 'A');
+  cout << "Bellman-Ford output:" << endl;
+  for (Path<char>* path : list) {
+    cout << path->toString(&vertex2str) << endl;
+    delete path;
+  }
+  try {
+    finder.dijkstra(&model, 'A');
+  } catch (std::invalid_argument& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+  // the one-to-one searches reject the snapshot before searching, even when the
+  // negative edge is not on the way ('C' is not reachable from 'B')
+  try {
+    finder.shortestPath(&model, 'B', 'E');
+  } catch (std::invalid_argument& e) {
+    cout << "shortestPath: " << e.what() << endl;
+  }
+  try {
+    finder.bidirectionalDijkstra(&model, 'A', 'E');
+  } catch (std::invalid_argument& e) {
+    cout << "bidirectional: " << e.what() << endl;
+  }
+  try {
+    finder.aStar(&model, 'A', 'E', &zeroHeuristic);
+  } catch (std::invalid_argument& e) {
+    cout << "aStar: " << e.what() << endl;
+  }
+  // the static engines throw when they reach the negative edge
+  CSRGraph<char>* csr = model.freeze();
+  CSRGraph<char>* reverse = csr->transpose();
+  try {
+    DGraphAlgorithm<char>::bidirectionalDijkstra(csr, reverse, csr->indexOf('C'), csr->indexOf('D'));
+  } catch (std::invalid_argument& e) {
+    cout << "bidirectional engine: " << e.what() << endl;
+  }
+  try {
+    DGraphAlgorithm<char>::aStar(csr, csr->indexOf('A'), csr->indexOf('E'), &zeroHeuristic);
+  } catch (std::invalid_argument& e) {
+    cout << "aStar engine: " << e.what() << endl;
+  }
+  cout << "aStar engine B->E: " << DGraphAlgorithm<char>::aStar(csr, csr->indexOf('B'), csr->indexOf('E'), &zeroHeuristic) << endl;
+  delete reverse;
+  delete csr;
+
+  model.connect('D', 'C', -1);
+  try {
+    finder.bellman_ford(&model, 'A');
+  } catch (NegativeCycleException& e) {
+    cout << "Error: " << e.what();
+  }
+  model.clear();cout << endl;
+}
+
+void graph_dyntopo01() {
+  string name = "graph_dyntopo01";
+  DGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  for (char vertex = '0'; vertex <= '5'; vertex++) {
+    model.add(vertex);
+  }
+  model.connect('0', '1');
+  model.connect('1', '2');
+
+  DynamicTopoOrder<char> topo(&model);
+  topo.add('6');
+  cout << "Initial order: " << topo.order().toString() << endl;
+  char edges[][2] = {{'5', '0'}, {'2', '3'}, {'4', '1'}, {'6', '5'}, {'3', '4'}, {'2', '6'}};
+  for (auto& edge : edges) {
+    try {
+      topo.connect(edge[0], edge[1]);
+      cout << "connect(" << edge[0] << "," << edge[1] << "): " << topo.order().toString() << endl;
+    } catch (CycleException& e) {
+      cout << "connect(" << edge[0] << "," << edge[1] << "): " << e.what();
+    }
+  }
+  cout << "tryConnect(3,6): " << topo.tryConnect('3', '6') << ", tryConnect(5,5): " << topo.tryConnect('5', '5') << endl;
+  cout << "positionOf(6): " << topo.positionOf('6') << ", precedes(6,0): " << topo.precedes('6', '0') << endl;
+  cout << "edges in graph: " << model.outDegree('2') << " out of 2, " << model.inDegree('4') << " into 4" << endl;
+  TopoSorter<char> sorter(&model, &intKeyHash);
+  cout << "BFS Topological Sort: " << sorter.sort(TopoSorter<char>::BFS).toString() << endl;
+  try {
+    topo.connect('7', '0');
+  } catch (VertexNotFoundException& e) {
+    cout << "Error: " << e.what();
+  }
+  model.clear();cout << endl;
+}
+
+void printTreeEdges(UGraphModel<char>& tree) {
+  float total = 0;
+  for (char from : tree.vertices()) {
+    for (char to : tree.getOutwardEdges(from)) {
+      if (from < to) {
+        cout << " " << from << "-" << to << "(" << tree.weight(from, to) << ")";
+        total += tree.weight(from, to);
+      }
+    }
+  }
+  cout << ", total: " << total << endl;
+}
+
+void graph_mst01() {
+  string name = "graph_mst01";
+  UGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  for (char vertex = '0'; vertex <= '8'; vertex++) {
+    model.add(vertex);
+  }
+  model.connect('0', '1', 4);
+  model.connect('0', '2', 1);
+  model.connect('1', '2', 2);
+  model.connect('1', '3', 5);
+  model.connect('2', '3', 8);
+  model.connect('2', '4', 10);
+  model.connect('3', '4', 2);
+  model.connect('3', '5', 6);
+  model.connect('4', '5', 3);
+  model.connect('6', '7', 1);
+  model.connect('7', '7', 9);
+
+  UGraphAlgorithm<char> algorithm;
+  UGraphModel<char>* kruskal = algorithm.kruskal(&model);
+  UGraphModel<char>* prim = algorithm.prim(&model);
+  UGraphModel<char>* tree = algorithm.minSpanningTree(&model);
+  cout << "Kruskal:";
+  printTreeEdges(*kruskal);
+  cout << "Prim:";
+  printTreeEdges(*prim);
+  cout << "minSpanningTree size: " << tree->size() << endl;
+  delete kruskal;
+  delete prim;
+  delete tree;
+
+  ThreadPool pool(2);
+  DLinkedList<DLinkedList<char>*> groups = algorithm.connectedComponents(&model);
+  DLinkedList<DLinkedList<char>*> parallelGroups = algorithm.connectedComponents(&model, &pool);
+  cout << "Components:";
+  for (DLinkedList<char>* group : groups) {
+    cout << " " << group->toString();
+    delete group;
+  }
+  cout << endl << "Parallel components:";
+  for (DLinkedList<char>* group : parallelGroups) {
+    cout << " " << group->toString();
+    delete group;
+  }
+  cout << endl;
+
+  UnionFind sets(6);
+  sets.unite(0, 1);
+  sets.unite(2, 3);
+  cout << "unite(1,0): " << sets.unite(1, 0) << ", unite(1,3): " << sets.unite(1, 3)
+       << ", connected(0,2): " << sets.connected(0, 2) << ", count: " << sets.count() << endl;
+  model.clear();cout << endl;
+}
+
+
+void printComponents(DLinkedList<DLinkedList<char>*>& groups) {
+  for (DLinkedList<char>* group : groups) {
+    cout << " " << group->toString();
+    delete group;
+  }
+  cout << endl;
+}
+
+void graph_scc01() {
+  string name = "graph_scc01";
+  DGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  for (char vertex = '0'; vertex <= '8'; vertex++) {
+    model.add(vertex);
+  }
+  model.connect('0', '1');
+  model.connect('1', '2');
+  model.connect('2', '0');
+  model.connect('2', '3');
+  model.connect('3', '4');
+  model.connect('4', '3');
+  model.connect('4', '5');
+  model.connect('6', '7');
+  model.connect('7', '6');
+  model.connect('7', '5');
+  model.connect('6', '3', 2);
+  model.connect('7', '4', 5);
+  model.connect('8', '8');
+
+  SCCFinder<char> finder(&model);
+  DLinkedList<DLinkedList<char>*> tarjan = finder.components(SCCFinder<char>::TARJAN);
+  cout << "Tarjan:";
+  printComponents(tarjan);
+  DLinkedList<DLinkedList<char>*> kosaraju = finder.components(SCCFinder<char>::KOSARAJU);
+  cout << "Kosaraju:";
+  printComponents(kosaraju);
+  cout << "count: " << finder.count() << endl;
+  CSRGraph<int>* dag = finder.condense();
+  cout << "Condensation:";
+  for (int from = 0; from < dag->size(); from++) {
+    for (int edge = dag->edgeBegin(from); edge < dag->edgeEnd(from); edge++) {
+      cout << " " << from << "->" << dag->target(edge) << "(" << dag->weightAt(edge) << ")";
+    }
+  }
+  cout << endl;
+  TopoSorter<int> dagSorter(dag);
+  cout << "Condensation order: " << dagSorter.strictSort().toString() << endl;
+  delete dag;
+
+  cout << "findCycle: " << finder.findCycle().toString() << endl;
+  TopoSorter<char> sorter(&model, &intKeyHash);
+  try {
+    sorter.strictSort(TopoSorter<char>::BFS);
+  } catch (CycleException& e) {
+    cout << "Error: " << e.what();
+  }
+  model.disconnect('2', '0');
+  model.disconnect('4', '3');
+  model.disconnect('7', '6');
+  model.disconnect('8', '8');
+  cout << "hasCycle after disconnect: " << finder.hasCycle() << endl;
+  cout << "strictSort: " << sorter.strictSort(TopoSorter<char>::BFS).toString() << endl;
+  model.connect('5', '0');
+  try {
+    DynamicTopoOrder<char> topo(&model);
+  } catch (CycleException& e) {
+    cout << "Error: " << e.what();
+  }
+  model.clear();cout << endl;
+}
+
+void printScores(DGraphModel<char>& model, double* score) {
+  int id = 0;
+  for (char vertex : model.vertices()) {
+    cout << " " << vertex << ":" << fixed << setprecision(4) << score[id++];
+  }
+  cout << defaultfloat << setprecision(6) << endl;
+}
+
+void graph_rank01() {
+  string name = "graph_rank01";
+  DGraphModel<char> model(&charComparator, &vertex2str, &intKeyHash);
+  for (char vertex = 'A'; vertex <= 'F'; vertex++) {
+    model.add(vertex);
+  }
+  model.connect('A', 'B');
+  model.connect('A', 'C');
+  model.connect('B', 'C');
+  model.connect('C', 'A');
+  model.connect('D', 'C');
+  model.connect('E', 'C');
+  model.connect('E', 'D');
+  model.connect('F', 'E');
+
+  ThreadPool pool(2);
+  GraphAnalytics<char> analytics(&model, &pool, 2);
+  double rank[6];
+  int iterations = analytics.pageRank(rank, 0.85, 1e-10, 200);
+  cout << "PageRank:";
+  printScores(model, rank);
+  cout << "converged: " << (analytics.getResidual() < 1e-10) << ", iterations < 200: " << (iterations < 200) << endl;
+  cout << "top 3: " << analytics.top(rank, 3).toString() << endl;
+
+  DLinkedList<char> seeds;
+  seeds.add('F');
+  analytics.personalizedPageRank(seeds, rank, 0.85, 1e-10, 200);
+  cout << "Personalized (F):";
+  printScores(model, rank);
+
+  double score[6];
+  analytics.degreeCentrality(score, GraphAnalytics<char>::IN);
+  cout << "In-degree:";
+  printScores(model, score);
+  analytics.degreeCentrality(score);
+  cout << "Degree:";
+  printScores(model, score);
+  analytics.closenessCentrality(score);
+  cout << "Closeness:";
+  printScores(model, score);
+  try {
+    seeds.add('X');
+    analytics.personalizedPageRank(seeds, rank);
+  } catch (VertexNotFoundException& e) {
+    cout << "Error: " << e.what();
+  }
+  model.clear();cout << endl;
+}
+
+void graph_io01() {
+  string name = "graph_io01";
+  ofstream text("graph_io01.txt");
+  text << "# from to weight\n0 1 2.5\n0 2\n1 2 1.5\n\n2 0 4 # back edge\n0 1 3\n4 2 1e1\n";
+  text.close();
+  CSRGraph<int>* csr = GraphLoader::loadText("graph_io01.txt", true, 1);
+  cout << "text: " << csr->size() << " vertices, " << csr->edgeCount() << " edges:";
+  for (int from = 0; from < csr->size(); from++) {
+    for (int edge = csr->edgeBegin(from); edge < csr->edgeEnd(from); edge++) {
+      cout << " " << from << "->" << csr->target(edge) << "(" << csr->weightAt(edge) << ")";
+    }
+  }
+  cout << endl;
+
+  ofstream csv("graph_io01.csv");
+  csv << "source,target\n0,1\n1,2\n2,2\n";
+  csv.close();
+  CSRGraph<int>* undirected = GraphLoader::loadCSV("graph_io01.csv", false);
+  cout << "csv (undirected): " << undirected->edgeCount() << " stored edges, degree of 1: " << undirected->outDegree(1) << endl;
+
+  GraphFile::write(csr, "graph_io01.csrg");
+  CSRGraph<int>* mapped = GraphFile::map("graph_io01.csrg");
+  cout << "mapped: " << mapped->size() << " vertices, " << mapped->edgeCount() << " edges, inDegree(2): "
+       << mapped->inDegree(2) << ", weight(4,2): " << mapped->weight(4, 2) << endl;
+
+  DGraphModel<int> model(&intComparator, &vertexInt2str);
+  model.addAll(mapped);
+  cout << "model: " << model.size() << " vertices, outDegree(0): " << model.outDegree(0)
+       << ", connected(2,0): " << model.connected(2, 0) << ", inward of 2: " << model.getInwardEdges(2).toString() << endl;
+  delete mapped;
+  delete undirected;
+  delete csr;
+
+  ofstream broken("graph_io01.txt");
+  broken << "0 1\n1 x\n";
+  broken.close();
+  try {
+    GraphLoader::loadText("graph_io01.txt");
+  } catch (std::runtime_error& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+  remove("graph_io01.txt");
+  remove("graph_io01.csv");
+  remove("graph_io01.csrg");
+  model.clear();cout << endl;
+}
+
+string bitsStr(DynamicBitset& bits) {
+  string text;
+  for (int id = 0; id < bits.size(); id++) text += bits.test(id) ? '1' : '0';
+  return text;
+}
+
+string setBits(DynamicBitset& bits) {
+  stringstream os;
+  os << "[";
+  for (int id = bits.findNext(0); id != -1; id = bits.findNext(id + 1)) os << (os.tellp() > 1 ? ", " : "") << id;
+  os << "]";
+  return os.str();
+}
+
+void graph_bitset01() {
+  string name = "graph_bitset01";
+  DynamicBitset empty;
+  cout << "empty: size " << empty.size() << ", empty " << empty.empty() << ", words " << empty.wordCount()
+       << ", count " << empty.count() << ", any " << empty.any() << ", findNext(0) " << empty.findNext(0)
+       << ", findNextClear(0) " << empty.findNextClear(0) << endl;
+  empty.fill(true);
+  empty.reset();
+  cout << "fill/reset on empty: size " << empty.size() << ", count " << empty.count() << endl;
+
+  DynamicBitset bits(10);
+  bits.set(1);
+  bits.set(9);
+  cout << "testAndSet(4): " << bits.testAndSet(4) << ", again: " << bits.testAndSet(4) << endl;
+  bits.reset(1);
+  cout << "10 bits: " << bitsStr(bits) << ", set " << setBits(bits) << ", count " << bits.count() << ", [9] " << bits[9] << endl;
+
+  // word boundaries: 63, 64, 65 bits
+  int sizes[] = {63, 64, 65, 128, 130};
+  for (int size : sizes) {
+    DynamicBitset ones(size, true);
+    cout << size << " ones: words " << ones.wordCount() << ", count " << ones.count()
+         << ", findNextClear(0) " << ones.findNextClear(0) << ", findNext(" << size - 1 << ") " << ones.findNext(size - 1)
+         << ", findNext(" << size << ") " << ones.findNext(size) << endl;
+  }
+
+  // grow with ones from a partial word: the new bits are set, the old ones kept
+  DynamicBitset grow(3);
+  grow.set(0);
+  grow.resize(70, true);
+  cout << "resize(3 -> 70, true): count " << grow.count() << ", test(1) " << grow.test(1) << ", test(3) " << grow.test(3)
+       << ", findNextClear(0) " << grow.findNextClear(0) << endl;
+  // shrink: the bits past size() are cleared, growing again gives zeros
+  grow.resize(5);
+  cout << "resize(5): " << bitsStr(grow) << ", count " << grow.count() << ", words " << grow.wordCount() << endl;
+  grow.resize(66);
+  cout << "resize(66): count " << grow.count() << ", findNext(5) " << grow.findNext(5) << endl;
+  // fill(true) keeps the tail bits of the last word clear
+  grow.fill(true);
+  cout << "fill(true): count " << grow.count() << ", last word " << grow.data()[1] << ", findNextClear(0) " << grow.findNextClear(0) << endl;
+  grow.fill(false);
+  cout << "fill(false): count " << grow.count() << ", any " << grow.any() << endl;
+
+  DynamicBitset pushed;
+  for (int id = 0; id < 130; id++) pushed.pushBack(id % 3 == 0);
+  cout << "pushBack x130: size " << pushed.size() << ", words " << pushed.wordCount() << ", count " << pushed.count()
+       << ", findNext(127) " << pushed.findNext(127) << ", findNextClear(129) " << pushed.findNextClear(129) << endl;
+
+  DynamicBitset a(100), b(100);
+  for (int id = 0; id < 100; id += 2) a.set(id);
+  for (int id = 0; id < 100; id += 3) b.set(id);
+  DynamicBitset both = a;
+  both &= b;
+  DynamicBitset either = a;
+  either |= b;
+  DynamicBitset onlyA = a;
+  onlyA.andNot(b);
+  cout << "multiples of 2 and 3 below 100: & " << both.count() << ", | " << either.count() << ", andNot " << onlyA.count()
+       << ", first of &: " << both.findNext(1) << ", 96 in andNot " << onlyA.test(96) << endl;
+  DynamicBitset copy = both;
+  cout << "==: " << (copy == both) << ", after reset(6): " << (copy.reset(6), copy == both)
+       << ", different sizes: " << (DynamicBitset(100) == DynamicBitset(101)) << endl;
+  cout << endl;
+}
+
+// "vertex % capacity": vertices spaced 8 apart all hash to multiples of 8
+int spacedHash(int& vertex, int capacity) {
+  return vertex % capacity;
+}
+int constantHash(int& vertex, int capacity) {
+  return 7;
+}
+int nameHash(string& vertex, int capacity) {
+  unsigned int code = 0;
+  for (char c : vertex) code = code * 31 + (unsigned char)tolower(c);
+  return (int)(code % (unsigned int)capacity);
+}
+bool caseless(string& lhs, string& rhs) {
+  if (lhs.size() != rhs.size()) return false;
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (tolower(lhs[i]) != tolower(rhs[i])) return false;
+  }
+  return true;
+}
+
+class VertexIdsProbe : public VertexIds<int> {
+public:
+  VertexIdsProbe(int (*hash)(int&, int), int capacity = 0) : VertexIds<int>(hash, 0, capacity) {}
+  int slotCount() {
+    return (int)this->slots.size();
+  }
+};
+
+void graph_ids01() {
+  string name = "graph_ids01";
+  try {
+    VertexIds<int> ids(0);
+  } catch (std::invalid_argument& e) {
+    cout << "Error: " << e.what() << endl;
+  }
+
+  VertexIdsProbe ids(&spacedHash);
+  cout << "empty: size " << ids.size() << ", slots " << ids.slotCount() << ", indexOf(8) " << ids.indexOf(8)
+       << ", contains(0) " << ids.contains(0) << endl;
+  // at most half full: the 9th vertex doubles MIN_SLOTS
+  for (int n = 0; n < 8; n++) ids.intern(n * 8);
+  cout << "8 vertices: slots " << ids.slotCount() << endl;
+  ids.intern(64);
+  cout << "9 vertices: slots " << ids.slotCount() << ", intern(64) again " << ids.intern(64) << ", size " << ids.size() << endl;
+  for (int n = 9; n < 1000; n++) ids.intern(n * 8);
+  bool ok = true;
+  for (int n = 0; n < 1000; n++) ok = ok && ids.indexOf(n * 8) == n && ids.vertex(n) == n * 8 && ids[n] == n * 8;
+  int missing = 0;
+  for (int n = 0; n < 1000; n++) missing += ids.indexOf(n * 8 + 4) == -1;
+  cout << "1000 vertices: slots " << ids.slotCount() << ", ids in order " << ok << ", absent found -1: " << missing << endl;
+  ids.clear();
+  cout << "clear: size " << ids.size() << ", slots " << ids.slotCount() << ", indexOf(0) " << ids.indexOf(0)
+       << ", intern(800) " << ids.intern(800) << endl;
+
+  VertexIdsProbe reserved(&spacedHash, 100);
+  cout << "reserve 100: slots " << reserved.slotCount();
+  for (int n = 0; n < 100; n++) reserved.intern(n);
+  cout << ", after 100 vertices: " << reserved.slotCount();
+  reserved.reserve(10);
+  cout << ", reserve(10): " << reserved.slotCount() << endl;
+
+  // every vertex in one home slot: linear probing still tells them apart
+  VertexIds<int> clash(&constantHash);
+  for (int n = 0; n < 40; n++) clash.intern(n * n);
+  ok = true;
+  for (int n = 0; n < 40; n++) ok = ok && clash.indexOf(n * n) == n;
+  cout << "constant hash: size " << clash.size() << ", ids in order " << ok << ", indexOf(2) " << clash.indexOf(2) << endl;
+
+  VertexIds<string> names(&nameHash, &caseless);
+  cout << "names: " << names.intern("Paris") << names.intern("Lyon") << names.intern("PARIS") << names.intern("nice")
+       << ", size " << names.size() << ", vertex(0) " << names.vertex(0) << ", indexOf(lyon) " << names.indexOf("lyon")
+       << ", contains(Nice) " << names.contains("Nice") << ", contains(Lille) " << names.contains("Lille") << endl;
+  cout << endl;
+}
+
+// in-degree, reverse neighbours and out-degree of every vertex, then a brute-force check
+// of the counters and reverse lists against connected()
+void printAdjacency(AbstractGraph<char>& graph, string label) {
+  cout << label << ":";
+  DLinkedList<char> vertices = graph.vertices();
+  bool consistent = true;
+  for (char to : vertices) {
+    DLinkedList<char> inward = graph.getInwardEdges(to);
+    cout << " " << to << "(in " << graph.inDegree(to) << " " << inward.toString() << ", out " << graph.outDegree(to) << ")";
+    int in = 0, out = 0;
+    for (char from : vertices) {
+      if (graph.connected(from, to)) {
+        in++;
+        consistent = consistent && inward.contains(from);
+      }
+      if (graph.connected(to, from)) out++;
+    }
+    consistent = consistent && in == graph.inDegree(to) && in == inward.size() && out == graph.outDegree(to);
+  }
+  cout << endl << "  consistent: " << consistent << endl;
+}
+
+void graph_adjacency01() {
+  string name = "graph_adjacency01";
+  bool indexed[] = {false, true};
+  for (bool index : indexed) {
+    cout << "edge index " << (index ? "on" : "off") << endl;
+    DGraphModel<char> model(&charComparator, &vertex2str);
+    model.setEdgeIndex(index);
+    for (char vertex = 'A'; vertex <= 'K'; vertex++) model.add(vertex);
+    // A gets 10 out-edges: past EDGE_INDEX_MIN_DEGREE (8)
+    for (char vertex = 'B'; vertex <= 'K'; vertex++) model.connect('A', vertex, vertex - 'A');
+    model.connect('B', 'C');
+    model.connect('C', 'B');
+    model.connect('D', 'D');
+    model.connect('K', 'A');
+    model.connect('A', 'C', 30);
+    printAdjacency(model, "connect");
+    cout << "  weight(A,C) " << model.weight('A', 'C') << ", weight(A,K) " << model.weight('A', 'K') << endl;
+
+    model.disconnect('A', 'C');
+    model.disconnect('D', 'D');
+    model.disconnect('A', 'K');
+    try {
+      model.disconnect('A', 'C');
+    } catch (EdgeNotFoundException& e) {
+      cout << "  Error: " << e.what() << endl;
+    }
+    printAdjacency(model, "disconnect A-C, D-D, A-K");
+
+    model.remove('B');
+    model.remove('A');
+    printAdjacency(model, "remove B, A");
+    model.connect('C', 'E');
+    model.connect('K', 'C');
+    printAdjacency(model, "connect C-E, K-C");
+    model.clear();
+  }
+
+  UGraphModel<char> ugraph(&charComparator, &vertex2str);
+  for (char vertex = 'A'; vertex <= 'E'; vertex++) ugraph.add(vertex);
+  ugraph.connect('A', 'B');
+  ugraph.connect('A', 'C');
+  ugraph.connect('C', 'C');
+  ugraph.connect('D', 'E');
+  printAdjacency(ugraph, "undirected");
+  ugraph.disconnect('C', 'A');
+  ugraph.remove('E');
+  printAdjacency(ugraph, "undirected, disconnect C-A, remove E");
+  ugraph.clear();cout << endl;
+}
+
+// sequential reference: depth[id] from source, -1 if unreachable
+void sequentialDepths(CSRGraph<int>* csr, int source, vector<int>& depth) {
+  const int* offsets = csr->getOffsets();
+  const int* targets = csr->getTargets();
+  depth.assign(csr->size(), -1);
+  vector<int> queue(1, source);
+  depth[source] = 0;
+  for (size_t head = 0; head < queue.size(); head++) {
+    int id = queue[head];
+    for (int edge = offsets[id]; edge < offsets[id + 1]; edge++) {
+      if (depth[targets[edge]] == -1) {
+        depth[targets[edge]] = depth[id] + 1;
+        queue.push_back(targets[edge]);
+      }
+    }
+  }
+}
+
+// true if order[0..count) lists distinct ids, each after all of its listed predecessors
+bool validTopoOrder(CSRGraph<int>* csr, int* order, int count) {
+  const int* offsets = csr->getOffsets();
+  const int* targets = csr->getTargets();
+  vector<int> position(csr->size(), -1);
+  for (int idx = 0; idx < count; idx++) {
+    if (position[order[idx]] != -1) return false;
+    position[order[idx]] = idx;
+  }
+  for (int from = 0; from < csr->size(); from++) {
+    for (int edge = offsets[from]; edge < offsets[from + 1]; edge++) {
+      int to = targets[edge];
+      if (position[to] != -1 && (position[from] == -1 || position[from] > position[to])) return false;
+    }
+  }
+  return true;
+}
+
+// n vertices, "edges" random edges; a DAG (i -> j only for i < j) unless cyclic
+DGraphModel<int>* randomGraph(std::mt19937& engine, int n, int edges, bool cyclic) {
+  DGraphModel<int>* model = new DGraphModel<int>(&intComparator, &vertexInt2str, &spacedHash);
+  for (int vertex = 0; vertex < n; vertex++) model->add(vertex);
+  for (int edge = 0; edge < edges; edge++) {
+    int from = (int)(engine() % n), to = (int)(engine() % n);
+    if (from == to) continue;
+    if (!cyclic && from > to) std::swap(from, to);
+    model->connect(from, to);
+  }
+  return model;
+}
+
+void graph_parallel01() {
+  string name = "graph_parallel01";
+  std::mt19937 engine(37);
+  ThreadPool pool1(1), pool2(2), pool4(4);
+  ThreadPool* pools[] = {0, &pool1, &pool2, &pool4};
+  string labels[] = {"no pool", "1 thread", "2 threads", "4 threads"};
+  // 0: sparse DAG, 1: dense DAG (bottom-up steps), 2: graph with cycles
+  int sizes[][2] = {{3000, 6000}, {2000, 40000}, {3000, 9000}};
+  for (int kind = 0; kind < 3; kind++) {
+    bool bfsOk[4] = {true, true, true, true}, kahnOk[4] = {true, true, true, true};
+    bool sameOrder = true, bottomUp = false, partial = false;
+    for (int run = 0; run < 5; run++) {
+      DGraphModel<int>* model = randomGraph(engine, sizes[kind][0], sizes[kind][1], kind == 2);
+      CSRGraph<int>* csr = model->freeze();
+      int n = csr->size();
+      int source = (int)(engine() % n);
+      vector<int> expected;
+      sequentialDepths(csr, source, expected);
+      vector<int> reference;
+      for (int p = 0; p < 4; p++) {
+        ParallelBFS<int> bfs(csr, pools[p], 15, 18, 64);
+        vector<int> depth(n), parent(n);
+        int reached = bfs.search(source, depth.data(), parent.data());
+        bool ok = depth == expected && reached == n - (int)std::count(expected.begin(), expected.end(), -1);
+        for (int id = 0; ok && id < n; id++) {
+          if (id == source || depth[id] == -1) ok = parent[id] == -1;
+          else ok = parent[id] >= 0 && depth[parent[id]] == depth[id] - 1 && csr->connected(parent[id], id);
+        }
+        bfsOk[p] = bfsOk[p] && ok;
+        bottomUp = bottomUp || bfs.getBottomUpSteps() > 0;
+
+        vector<int> order(n);
+        int count = TopoSorter<int>::parallelKahn(csr, pools[p], order.data(), 0, 0, 16);
+        kahnOk[p] = kahnOk[p] && validTopoOrder(csr, order.data(), count) && (kind == 2 ? count < n : count == n);
+        partial = partial || count < n;
+        order.resize(count);
+        if (p == 0) reference = order;
+        else sameOrder = sameOrder && order == reference;
+      }
+      delete csr;
+      delete model;
+    }
+    cout << (kind == 0 ? "sparse DAGs" : kind == 1 ? "dense DAGs" : "graphs with cycles") << " (" << sizes[kind][0]
+         << " vertices, " << sizes[kind][1] << " edges, 5 graphs):" << endl;
+    for (int p = 0; p < 4; p++) {
+      cout << "  " << labels[p] << ": BFS depths and parents " << (bfsOk[p] ? "ok" : "FAIL") << ", Kahn "
+           << (kahnOk[p] ? (kind == 2 ? "stops at the cycles" : "valid order") : "FAIL") << endl;
+    }
+    cout << "  same Kahn order for any pool: " << sameOrder << (kind == 1 ? ", bottom-up steps used: " : "")
+         << (kind == 1 ? to_string(bottomUp) : "") << (kind == 2 ? ", partial: " + to_string(partial) : "") << endl;
+  }
+
+  // parallelBfsSort on a model: vertex lists agree with the snapshot order
+  DGraphModel<int>* model = randomGraph(engine, 500, 1500, false);
+  TopoSorter<int> sorter(model);
+  DLinkedList<int> single = sorter.parallelBfsSort(0);
+  DLinkedList<int> parallel = sorter.parallelBfsSort(&pool4);
+  cout << "parallelBfsSort: " << single.size() << " vertices, same for 4 threads: " << (single.toString() == parallel.toString()) << endl;
+  delete model;
+  cout << endl;
+}
+
 void runDemo() {
     std::cout << "Direct Graph Demo 1" << std::endl;
     DGraphDemo1();
@@ -2452,8 +3325,8 @@ void runDemo() {
     DGraphDemo2();
     std::cout << "Direct Graph Demo 3" << std::endl;
     DGraphDemo3();
-    // std::cout << "Dijkstra Demo" << std::endl;
-    // dijkstraDemo();
+    std::cout << "Dijkstra Demo" << std::endl;
+    dijkstraDemo();
 
     std::cout << "Undirect Graph Demo 1" << std::endl;
     ugraphDemo1();
@@ -2505,7 +3378,11 @@ void (*testFuncs[])() = {
     sort_topo06, sort_topo07, sort_topo08, sort_topo09, sort_topo10, 
     sort_topo11, sort_topo12, sort_topo13, sort_topo14, sort_topo15, 
     sort_topo16, sort_topo17, sort_topo18, sort_topo19, sort_topo20, 
-    sort_topo21, sort_topo22, sort_topo23, sort_topo24, sort_topo25 
+    sort_topo21, sort_topo22, sort_topo23, sort_topo24, sort_topo25,
+    graph_index01, graph_index02, graph_csr01,
+    graph_path01, graph_path02, graph_dyntopo01, graph_mst01, graph_scc01, graph_rank01, graph_io01,
+    graph_bitset01, graph_ids01, graph_adjacency01,
+    graph_parallel01
 };
 
 int main(int argc, char* argv[]) {
@@ -14,11 +14,12 @@
 #include "heap/Heap.h"
 #include "util/Point.h"
 #include "heap/HeapDemo.h"
+#include "heap/TopK.h"
 #include <regex>
 #include <random>
 using namespace std;
 namespace fs = std::filesystem;
-int num_task = 6;
+int num_task = 7;
 vector<vector<string>> expected_task (num_task, vector<string>(1000, ""));
 vector<vector<string>> output_task (num_task, vector<string>(1000, ""));
 vector<int> diffTasks(0);
@@ -397,6 +398,63 @@ void test6() {
     cout << endl;
 }
 
+template<class T>
+void printTopK(string label, T* out, int count) {
+    cout << label << " (" << count << "):";
+    for (int idx = 0; idx < count; idx++) cout << " " << out[idx];
+    cout << endl;
+}
+
+int intDescending(int& lhs, int& rhs) {
+    return rhs - lhs;
+}
+
+void test7() {
+    int values[] = {7, 3, 9, 3, 12, 9, -4, 9, 0, 5};
+    int out[16];
+    // k = 0, negative k, empty input: nothing is written
+    cout << "k = 0: " << topK(values, 10, 0, out) << ", k = -2: " << topK(values, 10, -2, out)
+         << ", size 0: " << topK(values, 0, 3, out) << ", null array: " << topK<int>(0, 10, 3, out) << endl;
+
+    int count = topK(values, 10, 1, out);
+    printTopK("k = 1", out, count);
+    count = topK(values, 10, 4, out);
+    printTopK("k = 4, duplicates", out, count);
+    count = topK(values, 10, 10, out);
+    printTopK("k = n", out, count);
+    count = topK(values, 10, 16, out);
+    printTopK("k > n", out, count);
+    count = topK(values, 10, 3, out, &intDescending);
+    printTopK("k = 3, descending comparator (the 3 smallest)", out, count);
+    count = topK(values, 10, 3, out, &SortSimpleOrder<int>::compare4Ascending);
+    printTopK("k = 3, compare4Ascending", out, count);
+    cout << "input unchanged: " << values[0] << " " << values[4] << " " << values[9] << endl;
+
+    string words[] = {"pear", "apple", "fig", "plum", "apple", "kiwi"};
+    string bestWords[3];
+    count = topK(words, 6, 3, bestWords);
+    printTopK("strings", bestWords, count);
+
+    // random runs against a full sort: k on both sides of the sorting network limit (64)
+    std::mt19937 engine(29);
+    int sizes[] = {1, 63, 64, 65, 500};
+    bool ok = true;
+    for (int k : sizes) {
+        vector<int> input(1000);
+        for (int& value : input) value = (int)(engine() % 200);
+        vector<int> best(k);
+        int written = topK(input.data(), 1000, k, best.data());
+        vector<float> floats(input.begin(), input.end());
+        vector<float> bestFloats(k);
+        topK(floats.data(), 1000, k, bestFloats.data());
+        std::sort(input.begin(), input.end(), [](int lhs, int rhs) { return lhs > rhs; });
+        ok = ok && written == k;
+        for (int idx = 0; idx < k; idx++) ok = ok && best[idx] == input[idx] && bestFloats[idx] == (float)input[idx];
+    }
+    cout << "random k = 1, 63, 64, 65, 500 of 1000: " << (ok ? "ok" : "FAIL") << endl;
+    cout << endl;
+}
+
 
 void runDemo() {
 
@@ -438,7 +496,7 @@ void runDemo() {
 
 // pointer function to store 15 test
 void (*testFuncs[])() = {
-    test1, test2, test3, test4, test5, test6
+    test1, test2, test3, test4, test5, test6, test7
 };
 
 // ! NOTES: in function removeItem from original source
@@ -0,0 +1,802 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file contains testcases for the array sorts (IntroSort, ParallelMergeSort,
+    * RadixSort, SortingNetwork, ExternalSort) and ThreadPool
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <regex>
+#include <random>
+#include <climits>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include "sorting/IntroSort.h"
+#include "sorting/ParallelSort.h"
+#include "sorting/DLinkedListSE.h"
+#include "sorting/RadixSort.h"
+#include "sorting/SortingNetwork.h"
+#include "sorting/ExternalSort.h"
+#include "util/ThreadPool.h"
+using namespace std;
+namespace fs = std::filesystem;
+int num_task = 8;
+vector<vector<string>> expected_task (num_task, vector<string>(1000, ""));
+vector<vector<string>> output_task (num_task, vector<string>(1000, ""));
+vector<int> diffTasks(0);
+vector<int> doTasks(0);
+
+void compareFile(const string& filename1, const string& filename2) {
+    string log_file = "TestLog/Sort/SortTestLog_Compare.txt";
+    fstream file(log_file, ios::out);
+    if (!file.is_open()) {
+        std::cout << "Cannot open file" << std::endl;
+        return;
+    }
+    
+    streambuf* stream_buffer_cout = cout.rdbuf();
+    cout.rdbuf(file.rdbuf());
+
+    fstream file1(filename1);
+    fstream file2(filename2);
+
+    // Store content of tasks in vector
+    string line;
+    int num = 1;
+    int num_line = 0;
+    while (getline(file1, line)) {
+        // if line contains "Task", store it in expected_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        expected_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    num = 1;
+    num_line = 0;
+    while (getline(file2, line)) {
+        // if line contains "Task", store it in output_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        output_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    // Compare content of tasks
+    for (int task = 0; task < num_task; task++) {
+        int count_diff = 0;
+        if (output_task[task][0] == "") continue;
+        doTasks.push_back(task + 1);
+        for (int line = 0; line < expected_task[task].size(); line++) {
+            if (expected_task[task][line] != output_task[task][line]) {
+                count_diff++;
+                cout << "Task " << task << " - Line " << line << ":\n";
+                cout << "Expected: " << expected_task[task][line];
+                cout << "Output: " << output_task[task][line];
+            }
+        }
+        if (count_diff > 0) {
+            diffTasks.push_back(task + 1);
+        }
+    }
+    
+    cout.rdbuf(stream_buffer_cout);
+    float prop = (float)diffTasks.size() / (float)doTasks.size();
+    if (prop == 0) {
+        std::cout << "All tasks are correct" << std::endl;
+    } else {
+        std::cout << "Number of tasks to do: " << doTasks.size() << std::endl;
+        std::cout << "Number of tasks with differences: " << diffTasks.size() << std::endl;
+        std::cout << "Pass: " << 1 - prop << std::endl;
+        for (int i = 0; i < diffTasks.size(); i++) {
+            std::cout << "Task " << diffTasks[i] << std::endl;
+        }
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: exe_file [OPTIONS] [TASK]" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  ?help: show help" << std::endl;
+    std::cout << "  demo: run demo" << std::endl;
+    std::cout << "  test: run all test" << std::endl;
+    std::cout << "  test [task]: run specific test" << std::endl;
+    std::cout << "  test [start_task] [end_task] : run test from start_task to end_task" << std::endl;
+    std::cout << "This test has " << num_task << " tasks" << std::endl;
+}
+
+template<class T>
+string arrayStr(T* array, int size) {
+    stringstream os;
+    os << "[";
+    for (int i = 0; i < size; i++) os << (i > 0 ? ", " : "") << array[i];
+    os << "]";
+    return os.str();
+}
+template<class T>
+bool isSorted(T* array, int size) {
+    for (int i = 1; i < size; i++) {
+        if (array[i] < array[i - 1]) return false;
+    }
+    return true;
+}
+// order-independent checksum: same multiset of values before and after a sort
+long long checksum(int* array, int size) {
+    long long sum = 0;
+    for (int i = 0; i < size; i++) sum += (long long)array[i] * array[i] + array[i];
+    return sum;
+}
+
+/*
+    IntroSort: empty and tiny inputs, duplicates, comparators
+*/
+void test1() {
+    IntroSort<int> sorter;
+    sorter.sort(nullptr, 0);
+    int empty[1] = {7};
+    sorter.sort(empty, 0);
+    cout << "Empty: " << arrayStr(empty, 0) << ", untouched: " << empty[0] << endl;
+    int one[] = {5};
+    sorter.sort(one, 1);
+    cout << "One: " << arrayStr(one, 1) << endl;
+    int two[] = {9, -3};
+    sorter.sort(two, 2);
+    cout << "Two: " << arrayStr(two, 2) << endl;
+
+    int values[] = {5, 3, 9, 3, -1, 0, 12, 7, 3, 8, -4, 5};
+    int size = sizeof(values) / sizeof(values[0]);
+    sorter.sort(values, size);
+    cout << "Ascending: " << arrayStr(values, size) << endl;
+    sorter.sort(values, size, &SortSimpleOrder<int>::compare4Desending);
+    cout << "Descending: " << arrayStr(values, size) << endl;
+
+    string words[] = {"pear", "apple", "fig", "kiwi", "banana", "apple"};
+    IntroSort<string> wordSorter;
+    wordSorter.sort(words, 6);
+    cout << "Strings: " << arrayStr(words, 6) << endl;
+
+    double reals[] = {2.5, -1.0, 3.25, 0.0, -7.5, 2.5};
+    IntroSort<double>().sort(reals, 6);
+    cout << "Doubles: " << arrayStr(reals, 6) << endl;
+}
+
+/*
+    IntroSort: insertion thresholds down to the minimum, on inputs that trigger
+    the pattern-breaking swaps (random, sorted, reversed, organ pipe, few keys)
+*/
+void test2() {
+    std::mt19937 engine(26);
+    int size = 5000;
+    vector<int> source(size);
+    string names[] = {"random", "sorted", "reversed", "organ pipe", "few keys", "sawtooth"};
+    int thresholds[] = {0, 3, 4, 5, 24};
+    for (int pattern = 0; pattern < 6; pattern++) {
+        for (int i = 0; i < size; i++) {
+            if (pattern == 0) source[i] = (int)(engine() % 100000);
+            else if (pattern == 1) source[i] = i;
+            else if (pattern == 2) source[i] = size - i;
+            else if (pattern == 3) source[i] = i < size / 2 ? i : size - i;
+            else if (pattern == 4) source[i] = (int)(engine() % 4);
+            else source[i] = i % 97;
+        }
+        cout << names[pattern] << ":";
+        for (int threshold : thresholds) {
+            vector<int> work = source;
+            IntroSort<int> sorter(threshold);
+            sorter.sort(work.data(), size);
+            bool same = checksum(work.data(), size) == checksum(source.data(), size);
+            cout << " " << threshold << "->" << (isSorted(work.data(), size) && same ? "ok" : "FAIL");
+        }
+        cout << endl;
+    }
+    // exactly sized heap arrays: a swap one past the end is caught by the sanitizers
+    bool allSorted = true;
+    for (int seed = 0; seed < 200; seed++) {
+        std::mt19937 local(seed);
+        int n = 25 + (int)(local() % 200);
+        int* array = new int[n];
+        for (int i = 0; i < n; i++) array[i] = (int)(local() % (seed % 3 == 0 ? 5 : 1000));
+        long long before = checksum(array, n);
+        IntroSort<int>(3).sort(array, n);
+        allSorted = allSorted && isSorted(array, n) && checksum(array, n) == before;
+        delete[] array;
+    }
+    cout << "200 small arrays, threshold 3: " << (allSorted ? "ok" : "FAIL") << endl;
+    vector<int> small = {4, 1, 3, 2};
+    IntroSort<int>(3).sort(small.data(), 4);
+    cout << "Threshold 3, four items: " << arrayStr(small.data(), 4) << endl;
+    cout << "MIN_INSERTION_THRESHOLD: " << IntroSort<int>::MIN_INSERTION_THRESHOLD << endl;
+}
+
+/*
+    ThreadPool: parallelFor blocks, submit/wait, sub-tasks waited for inside tasks
+*/
+void test3() {
+    ThreadPool pool(3);
+    cout << "Workers: " << pool.size() << endl;
+
+    std::atomic<long long> sum(0);
+    std::atomic<int> blocks(0);
+    pool.parallelFor(0, 1000, [&](long long lo, long long hi) {
+        long long local = 0;
+        for (long long i = lo; i < hi; i++) local += i;
+        sum += local;
+        blocks++;
+    });
+    cout << "parallelFor sum: " << sum << ", blocks: " << blocks << endl;
+    blocks = 0;
+    pool.parallelFor(5, 5, [&](long long lo, long long hi) { blocks++; });
+    cout << "Empty range, blocks: " << blocks << endl;
+    pool.parallelFor(0, 10, [&](long long lo, long long hi) { blocks++; }, 8);
+    cout << "10 items, grain 8, blocks: " << blocks << endl;
+
+    std::atomic<int> done(0);
+    for (int i = 0; i < 100; i++) pool.submit([&]() { done++; });
+    pool.wait();
+    cout << "submit x100 then wait: " << done << endl;
+    pool.wait();
+    cout << "wait with nothing queued: ok" << endl;
+
+    // every worker blocks in a task that waits for its own sub-tasks
+    std::atomic<int> children(0), nested(0);
+    for (int parent = 0; parent < 6; parent++) {
+        pool.submit([&]() {
+            ThreadPool::TaskGroup group;
+            for (int child = 0; child < 8; child++) pool.submit([&]() { children++; }, group);
+            pool.wait(group);
+            pool.parallelFor(0, 30, [&](long long lo, long long hi) { nested += (int)(hi - lo); });
+        });
+    }
+    pool.wait();
+    cout << "Sub-tasks: " << children << ", nested parallelFor items: " << nested << endl;
+
+    ThreadPool::TaskGroup outside;
+    std::atomic<int> grouped(0);
+    for (int i = 0; i < 5; i++) pool.submit([&]() { grouped++; }, outside);
+    pool.wait(outside);
+    cout << "Group waited from outside: " << grouped << endl;
+
+    string message = "none";
+    pool.submit([&]() {
+        try {
+            pool.wait();
+        } catch (std::logic_error& e) {
+            message = e.what();
+        }
+    });
+    pool.wait();
+    cout << "wait() inside a task: " << message << endl;
+
+    // exceptions of tasks: stored on their group (or the pool), rethrown by the wait
+    ThreadPool::TaskGroup failing;
+    std::atomic<int> ran(0);
+    for (int i = 0; i < 10; i++) {
+        pool.submit([&, i]() {
+            ran++;
+            if (i % 4 == 3) throw std::runtime_error("task " + to_string(i) + " failed");
+        }, failing);
+    }
+    try {
+        pool.wait(failing);
+        cout << "wait(group): no exception" << endl;
+    } catch (std::runtime_error& e) {
+        cout << "wait(group) rethrows: " << (string(e.what()).find("failed") != string::npos) << ", tasks run: " << ran << endl;
+    }
+    pool.wait(failing);
+    cout << "wait(group) again: nothing to rethrow" << endl;
+    pool.submit([]() { throw std::out_of_range("ungrouped"); });
+    try {
+        pool.wait();
+    } catch (std::out_of_range& e) {
+        cout << "wait() rethrows: " << e.what() << endl;
+    }
+    done = 0;
+    for (int i = 0; i < 30; i++) pool.submit([&]() { done++; });
+    pool.wait();
+    cout << "Workers still running: " << done << endl;
+}
+
+/*
+    ParallelMergeSort and DLinkedListSE::parallelSort
+*/
+int compareIntDesc(int& lhs, int& rhs) {
+    return rhs - lhs;
+}
+int compareTens(int& lhs, int& rhs) {
+    return lhs / 10 - rhs / 10;
+}
+int compareFailsOn13(int& lhs, int& rhs) {
+    if (lhs == 13 || rhs == 13) throw std::runtime_error("comparator: 13");
+    return lhs - rhs;
+}
+void test4() {
+    ThreadPool pool(4);
+    ParallelMergeSort<int> sorter(&pool, 0, 16);
+    std::mt19937 engine(27);
+    int sizes[] = {0, 1, 2, 15, 16, 17, 1000, 100003};
+    for (int size : sizes) {
+        vector<int> values(size + 1);
+        for (int i = 0; i < size; i++) values[i] = (int)(engine() % 1000) - 500;
+        long long before = checksum(values.data(), size);
+        sorter.sort(values.data(), size);
+        cout << "size " << size << ": " << (isSorted(values.data(), size) && checksum(values.data(), size) == before ? "ok" : "FAIL") << endl;
+    }
+    int values[] = {31, 4, 15, 92, 65, 35, 89, 79, 32, 38, 46, 26, 43, 38, 32, 79, 50, 28};
+    ParallelMergeSort<int> small(&pool, 0, 4);
+    small.sort(values, 18, &compareIntDesc);
+    cout << "Descending: " << arrayStr(values, 18) << endl;
+    string words[] = {"delta", "alpha", "echo", "charlie", "bravo", "foxtrot"};
+    ParallelMergeSort<string>(&pool, 0, 2).sort(words, 6);
+    cout << "Strings: " << arrayStr(words, 6) << endl;
+
+    DLinkedListSE<int> list;
+    int items[] = {42, 17, 45, 13, 11, 49, 15, 24, 40, 19, 47, 12};
+    for (int item : items) list.add(item);
+    list.parallelSort(&compareTens, &pool);
+    cout << "List by tens (stable): " << list.toString() << endl;
+    DLinkedListSE<int> empty;
+    empty.parallelSort(0, &pool);
+    cout << "Empty list: " << empty.toString() << endl;
+    DLinkedListSE<int> large;
+    for (int i = 0; i < 50000; i++) large.add((int)(engine() % 100000));
+    large.parallelSort(0, &pool);
+    bool ordered = true;
+    int previous = -1;
+    for (int item : large) {
+        if (item < previous) ordered = false;
+        previous = item;
+    }
+    cout << "50000 items: " << (ordered && large.size() == 50000 ? "ok" : "FAIL") << endl;
+
+    // called from pool tasks: the sorts wait on their own task groups, not on the pool
+    vector<int> inner(20000);
+    DLinkedListSE<int> innerList;
+    for (int i = 0; i < 20000; i++) {
+        inner[i] = (int)(engine() % 100000);
+        innerList.add(inner[i]);
+    }
+    pool.submit([&]() { ParallelMergeSort<int>(&pool, 0, 16).sort(inner.data(), 20000); });
+    pool.submit([&]() { innerList.parallelSort(0, &pool); });
+    pool.wait();
+    bool listOrdered = innerList.size() == 20000;
+    previous = -1;
+    for (int item : innerList) {
+        if (item < previous) listOrdered = false;
+        previous = item;
+    }
+    cout << "Sorted inside pool tasks: array " << (isSorted(inner.data(), 20000) ? "ok" : "FAIL")
+         << ", list " << (listOrdered ? "ok" : "FAIL") << endl;
+
+    // a shared pool busy with an unrelated task that only ends after the sorts
+    std::atomic<bool> release(false);
+    pool.submit([&]() {
+        while (!release) std::this_thread::yield();
+    });
+    for (int i = 0; i < 20000; i++) inner[i] = (int)(engine() % 100000);
+    sorter.sort(inner.data(), 20000);
+    large.parallelSort(&compareIntDesc, &pool);
+    release = true;
+    pool.wait();
+    cout << "Sorted beside a busy task: array " << (isSorted(inner.data(), 20000) ? "ok" : "FAIL")
+         << ", list front " << large.get(0) << " >= back " << large.get(49999) << ": " << (large.get(0) >= large.get(49999)) << endl;
+
+    // a throwing comparator: the exception reaches the caller, the list keeps its order
+    vector<int> failing(5000);
+    for (int i = 0; i < 5000; i++) failing[i] = i % 100;
+    try {
+        sorter.sort(failing.data(), 5000, &compareFailsOn13);
+    } catch (std::runtime_error& e) {
+        cout << "ParallelMergeSort: " << e.what() << endl;
+    }
+    try {
+        list.parallelSort(&compareFailsOn13, &pool);
+    } catch (std::runtime_error& e) {
+        cout << "parallelSort: " << e.what() << ", list kept: " << list.toString() << endl;
+    }
+    try {
+        list.parallelSort(&compareFailsOn13);
+    } catch (std::runtime_error& e) {
+        cout << "parallelSort with its own pool: " << e.what() << ", size " << list.size() << endl;
+    }
+}
+
+/*
+    RadixSort: signed and unsigned integers, IEEE floats (signed zeros, infinities),
+    strings with shared prefixes, descending order, fallbacks and radixSortByKey
+*/
+struct Score {
+    double score;
+    int id;
+};
+void test5() {
+    RadixSort<int> intSorter;
+    int empty[1] = {3};
+    intSorter.sort(empty, 0);
+    int one[] = {-8};
+    intSorter.sort(one, 1);
+    cout << "Empty / one: " << arrayStr(empty, 0) << " " << arrayStr(one, 1) << endl;
+
+    std::mt19937 engine(28);
+    vector<int> ints(300);
+    for (int& value : ints) value = (int)engine();
+    ints[0] = INT_MIN;
+    ints[1] = INT_MAX;
+    ints[2] = 0;
+    ints[3] = -1;
+    intSorter.sort(ints.data(), (int)ints.size());
+    cout << "int: " << (isSorted(ints.data(), (int)ints.size()) ? "ok" : "FAIL") << ", first: " << ints[0] << ", last: " << ints.back() << endl;
+    intSorter.sort(ints.data(), (int)ints.size(), &SortSimpleOrder<int>::compare4Desending);
+    cout << "int descending, first: " << ints[0] << ", last: " << ints.back() << endl;
+
+    vector<unsigned int> unsigneds(200);
+    for (unsigned int& value : unsigneds) value = engine();
+    unsigneds[7] = 0u;
+    unsigneds[9] = 4294967295u;
+    RadixSort<unsigned int>().sort(unsigneds.data(), (int)unsigneds.size());
+    cout << "unsigned: " << (isSorted(unsigneds.data(), (int)unsigneds.size()) ? "ok" : "FAIL") << ", last: " << unsigneds.back() << endl;
+
+    vector<long long> longs(200);
+    for (long long& value : longs) value = ((long long)engine() << 32 | engine()) - (1LL << 62);
+    RadixSort<long long>().sort(longs.data(), (int)longs.size());
+    cout << "long long: " << (isSorted(longs.data(), (int)longs.size()) ? "ok" : "FAIL") << endl;
+
+    double inf = std::numeric_limits<double>::infinity();
+    vector<double> reals = {3.5, -0.0, 0.0, -inf, 1e-300, -2.25, inf, -1e300, 7.0, -0.5};
+    for (int i = 0; i < 100; i++) reals.push_back(((double)engine() - 2147483648.0) / 1000.0);
+    RadixSort<double>().sort(reals.data(), (int)reals.size());
+    cout << "double: " << (isSorted(reals.data(), (int)reals.size()) ? "ok" : "FAIL")
+         << ", ends: " << reals[0] << " " << reals.back() << endl;
+    float floats[] = {2.5f, -1.0f, 0.0f, -0.0f, 3.25f, -7.5f};
+    RadixSort<float>().sort(floats, 6, &SortSimpleOrder<float>::compare4Desending);
+    cout << "float descending: " << arrayStr(floats, 6) << endl;
+
+    long double wide[] = {2.5L, -1.0L, 9.0L, 0.5L};
+    RadixSort<long double>().sort(wide, 4);
+    cout << "long double (IntroSort fallback): " << arrayStr(wide, 4) << endl;
+    int custom[] = {14, 3, 25, 8, 31};
+    intSorter.sort(custom, 5, &compareIntDesc);
+    cout << "Custom comparator (IntroSort fallback): " << arrayStr(custom, 5) << endl;
+
+    string words[] = {"banana", "", "band", "ban", "b", "apple", "bandana", "", "applesauce", "app",
+                      "zebra", "bandit", "ban", "a"};
+    RadixSort<string>().sort(words, 14);
+    cout << "Strings: " << arrayStr(words, 14) << endl;
+    RadixSort<string>::sortStrings(words, 14, true);
+    cout << "Strings descending: " << arrayStr(words, 14) << endl;
+    vector<string> many(500);
+    for (string& word : many) {
+        int length = (int)(engine() % 6);
+        word = "pre";
+        for (int i = 0; i < length; i++) word += (char)('a' + engine() % 3);
+    }
+    RadixSort<string>().sort(many.data(), (int)many.size());
+    cout << "500 prefixed strings: " << (isSorted(many.data(), (int)many.size()) ? "ok" : "FAIL") << endl;
+
+    Score scores[] = {{2.5, 1}, {-1.0, 2}, {2.5, 3}, {0.0, 4}, {-1.0, 5}, {9.75, 6}, {2.5, 7}};
+    radixSortByKey(scores, 7, [](Score& item) { return item.score; });
+    cout << "radixSortByKey (stable):";
+    for (Score& item : scores) cout << " " << item.score << "#" << item.id;
+    cout << endl;
+    radixSortByKey(scores, 7, [](Score& item) { return item.id; }, true);
+    cout << "radixSortByKey id descending:";
+    for (Score& item : scores) cout << " " << item.id;
+    cout << endl;
+}
+
+/*
+    SortingNetwork: every size from 0 to MAX_SIZE with each kernel (a kernel the CPU
+    lacks is replaced by the best available one), type maxima and NaNs
+*/
+template<class T>
+bool networkSizes(std::mt19937& engine, T (*make)(std::mt19937&)) {
+    bool ok = true;
+    for (int kernel = 0; kernel < 3; kernel++) {
+        for (int n = 0; n <= SortingNetwork<T>::MAX_SIZE; n++) {
+            vector<T> values(n + 1);
+            for (int i = 0; i < n; i++) values[i] = make(engine);
+            if (n > 2) values[n / 2] = std::numeric_limits<T>::max();
+            values[n] = (T)42;      // guard past the end
+            vector<T> expected(values.begin(), values.begin() + n);
+            std::sort(expected.begin(), expected.end());
+            SortingNetwork<T>::sort(values.data(), n, kernel);
+            ok = ok && std::equal(expected.begin(), expected.end(), values.begin()) && values[n] == (T)42;
+        }
+    }
+    return ok;
+}
+int32_t makeInt(std::mt19937& engine) { return (int32_t)(engine() % 200) - 100; }
+float makeFloat(std::mt19937& engine) { return (float)(engine() % 1000) / 8.0f - 60.0f; }
+double makeDouble(std::mt19937& engine) { return (double)engine() / 3.0 - 1e9; }
+void test6() {
+    std::mt19937 engine(29);
+    cout << "int32 sizes 0-64, 3 kernels: " << (networkSizes<int32_t>(engine, &makeInt) ? "ok" : "FAIL") << endl;
+    cout << "float sizes 0-64, 3 kernels: " << (networkSizes<float>(engine, &makeFloat) ? "ok" : "FAIL") << endl;
+    cout << "double sizes 0-64, 3 kernels: " << (networkSizes<double>(engine, &makeDouble) ? "ok" : "FAIL") << endl;
+
+    int32_t ints[] = {INT_MAX, 5, -3, INT_MIN, 5, 0, INT_MAX, -3, 9};
+    SortingNetwork<int32_t>::sort(ints, 9);
+    cout << "int32 with extremes: " << arrayStr(ints, 9) << endl;
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    float floats[] = {3.0f, nan, -1.5f, 2.0f, nan, -8.0f, 0.5f, 1.0f, 7.0f, -2.0f};
+    SortingNetwork<float>::sort(floats, 10);
+    cout << "float with 2 NaNs: " << arrayStr(floats, 8) << ", last two NaN: "
+         << (floats[8] != floats[8] && floats[9] != floats[9]) << endl;
+    double one[] = {4.5};
+    SortingNetwork<double>::sort(one, 1);
+    cout << "One double: " << arrayStr(one, 1) << endl;
+    cout << "supported: int32 " << SortingNetwork<int32_t>::supported << ", double " << SortingNetwork<double>::supported
+         << ", long long " << SortingNetwork<long long>::supported << endl;
+}
+
+/*
+    ExternalSort: empty input, unique keys, lexicographic rows, a budget small enough
+    for several merge passes, and a key column out of range
+*/
+vector<int> readRows(string path, int width) {
+    BinaryRowReader<int> reader(path, width);
+    vector<int> rows;
+    vector<int> row(width);
+    while (reader.read(row.data(), 1)) rows.insert(rows.end(), row.begin(), row.end());
+    return rows;
+}
+void writeRows(string path, int width, vector<int>& rows) {
+    BinaryRowWriter<int> writer(path, width);
+    if (!rows.empty()) writer.write(rows.data(), (long long)rows.size() / width);
+}
+void test7() {
+    string input = "extsort_test_in.bin", output = "extsort_test_out.bin";
+    vector<int> rows;
+    writeRows(input, 2, rows);
+    ExternalSort<int> emptySorter(ExternalSort<int>::DEFAULT_MEMORY, 0);
+    cout << "Empty: " << emptySorter.sortBinaryFile(input, output, 2) << " rows, " << readRows(output, 2).size() << " values" << endl;
+
+    rows = {5, 50, 1, 10, 4, 40, 1, 11, 3, 30, 5, 51, 2, 20, 1, 12};
+    writeRows(input, 2, rows);
+    ExternalSort<int> uniqueSorter(ExternalSort<int>::DEFAULT_MEMORY, 0, 0, true);
+    long long written = uniqueSorter.sortBinaryFile(input, output, 2);
+    cout << "Unique by column 0: " << written << " rows " << arrayStr(readRows(output, 2).data(), (int)written * 2) << endl;
+    ExternalSort<int> rowSorter(ExternalSort<int>::DEFAULT_MEMORY, ExternalSort<int>::ALL_COLUMNS);
+    written = rowSorter.sortBinaryFile(input, output, 2);
+    cout << "All columns: " << arrayStr(readRows(output, 2).data(), (int)written * 2) << endl;
+    ExternalSort<int> descSorter(ExternalSort<int>::DEFAULT_MEMORY, 1, &compareIntDesc);
+    written = descSorter.sortBinaryFile(input, output, 2);
+    cout << "Column 1 descending: " << arrayStr(readRows(output, 2).data(), (int)written * 2) << endl;
+
+    std::mt19937 engine(30);
+    int nrows = 100000;
+    rows.assign(nrows * 2, 0);
+    for (int i = 0; i < nrows; i++) {
+        rows[2 * i] = (int)(engine() % 1000000);
+        rows[2 * i + 1] = i;
+    }
+    writeRows(input, 2, rows);
+    ExternalSort<int> smallBudget(128 << 10, 0);
+    written = smallBudget.sortBinaryFile(input, output, 2);
+    vector<int> sorted = readRows(output, 2);
+    bool ordered = (int)sorted.size() == nrows * 2;
+    long long keySum = 0, idSum = 0;
+    for (int i = 0; ordered && i < nrows; i++) {
+        if (i > 0 && sorted[2 * i] < sorted[2 * (i - 1)]) ordered = false;
+        keySum += sorted[2 * i];
+        idSum += sorted[2 * i + 1];
+    }
+    long long expectedKeys = 0;
+    for (int i = 0; i < nrows; i++) expectedKeys += rows[2 * i];
+    ordered = ordered && keySum == expectedKeys && idSum == (long long)nrows * (nrows - 1) / 2;
+    cout << "128 KB budget: " << written << " rows, " << smallBudget.getRunCount() << " runs, "
+         << smallBudget.getMergePasses() << " merge passes, " << (ordered ? "ok" : "FAIL") << endl;
+
+    // stability across runs and merge passes: key i % 7, id i; unique keeps the first id of each key
+    for (int i = 0; i < nrows; i++) {
+        rows[2 * i] = i % 7;
+        rows[2 * i + 1] = i;
+    }
+    writeRows(input, 2, rows);
+    written = smallBudget.sortBinaryFile(input, output, 2);
+    sorted = readRows(output, 2);
+    bool stable = written == nrows;
+    for (int i = 1; stable && i < nrows; i++) {
+        stable = sorted[2 * i] > sorted[2 * (i - 1)] || (sorted[2 * i] == sorted[2 * (i - 1)] && sorted[2 * i + 1] > sorted[2 * (i - 1) + 1]);
+    }
+    cout << "Equal keys over " << smallBudget.getRunCount() << " runs: " << (stable ? "input order kept" : "FAIL") << endl;
+    ExternalSort<int> uniqueSmall(128 << 10, 0, 0, true);
+    written = uniqueSmall.sortBinaryFile(input, output, 2);
+    cout << "Unique over " << uniqueSmall.getRunCount() << " runs: " << arrayStr(readRows(output, 2).data(), (int)written * 2) << endl;
+    // one column with a comparator: equal values keep their order, unique keeps the first
+    rows = {15, 12, 31, 11, 38, 19, 33};
+    writeRows(input, 1, rows);
+    ExternalSort<int> byTens(ExternalSort<int>::DEFAULT_MEMORY, 0, &compareTens);
+    written = byTens.sortBinaryFile(input, output, 1);
+    cout << "By tens: " << arrayStr(readRows(output, 1).data(), (int)written);
+    ExternalSort<int> byTensUnique(ExternalSort<int>::DEFAULT_MEMORY, 0, &compareTens, true);
+    written = byTensUnique.sortBinaryFile(input, output, 1);
+    cout << ", unique: " << arrayStr(readRows(output, 1).data(), (int)written) << endl;
+
+    try {
+        ExternalSort<int> wrongColumn(ExternalSort<int>::DEFAULT_MEMORY, 2);
+        wrongColumn.sortBinaryFile(input, output, 2);
+    } catch (std::runtime_error& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+/*
+    ExternalSort on .npy files: 2-D and 1-D tables, header kept, spilled runs, dtype mismatch
+*/
+void test8() {
+    string input = "extsort_test_in.npy", output = "extsort_test_out.npy";
+    {
+        NpyRowWriter<float> writer(input, 3);
+        float table[][3] = {{2.5f, 0, 1}, {-1, 1, 1}, {2.5f, 2, 0}, {0.5f, 3, 1}, {-1, 4, 0}};
+        writer.write(&table[0][0], 5);
+    }
+    ExternalSort<float> byFirst(ExternalSort<float>::DEFAULT_MEMORY, 0);
+    long long written = byFirst.sortNpyFile(input, output);
+    {
+        NpyRowReader<float> reader(output);
+        cout << "2-D: " << written << " rows, shape (" << reader.getHeader().shape[0] << ", " << reader.getHeader().shape[1]
+             << "), dtype " << reader.getHeader().descr << ":";
+        float row[3];
+        while (reader.read(row, 1)) cout << " (" << row[0] << ", " << row[1] << ", " << row[2] << ")";
+        cout << endl;
+    }
+    ExternalSort<float> byLast(ExternalSort<float>::DEFAULT_MEMORY, 2, 0, true);
+    written = byLast.sortNpyFile(input, output);
+    {
+        NpyRowReader<float> reader(output);
+        cout << "Unique by column 2: " << written << " rows:";
+        float row[3];
+        while (reader.read(row, 1)) cout << " (" << row[0] << ", " << row[1] << ", " << row[2] << ")";
+        cout << endl;
+    }
+
+    {
+        NpyRowWriter<float> empty(input, 1, true);
+    }
+    written = byFirst.sortNpyFile(input, output);
+    cout << "Empty 1-D: " << written << " rows, shape size " << NpyRowReader<float>(output).getHeader().shape.size() << endl;
+
+    // 1-D table larger than the budget: spilled runs, the output stays 1-D
+    std::mt19937 engine(8);
+    int nrows = 50000;
+    {
+        NpyRowWriter<float> writer(input, 1, true);
+        vector<float> values(nrows);
+        for (float& value : values) value = (float)(engine() % 100000) / 8;
+        writer.write(values.data(), nrows);
+    }
+    ExternalSort<float> smallBudget(64 << 10, 0);
+    written = smallBudget.sortNpyFile(input, output);
+    NpyRowReader<float> reader(output);
+    vector<float> values(nrows + 1);
+    long long got = reader.read(values.data(), nrows + 1);
+    bool ordered = got == nrows;
+    for (int i = 1; ordered && i < nrows; i++) ordered = values[i - 1] <= values[i];
+    cout << "1-D, 64 KB budget: " << written << " rows, " << smallBudget.getRunCount() << " runs, shape size "
+         << reader.getHeader().shape.size() << ", " << (ordered ? "ok" : "FAIL") << endl;
+
+    try {
+        ExternalSort<int> wrongType;
+        wrongType.sortNpyFile(input, output);
+    } catch (std::runtime_error& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+void runDemo() {
+    cout << "Demo: IntroSort" << endl;
+    int values[] = {42, 7, 19, 3, 88, 7, 1};
+    IntroSort<int>().sort(values, 7);
+    cout << arrayStr(values, 7) << endl;
+}
+
+// pointer function to store tests
+void (*testFuncs[])() = {
+    test1, test2, test3, test4, test5, test6, test7, test8
+};
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2) {
+        if (string(argv[1]) == "?help") {
+            printUsage();
+            return 0;
+        }
+        else
+        if (string(argv[1]) == "demo") {
+            string file_name = "DemoLog.txt";
+            fstream file_demo(file_name, ios::out);
+            if (!file_demo.is_open()) {
+                std::cout << "Cannot open file" << std::endl;
+                return 0;
+            } 
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file_demo.rdbuf());
+
+            runDemo();
+
+            cout.rdbuf(stream_buffer_cout);
+            return 0;
+        }
+        else if (string(argv[1]) == "test")
+        {
+            string folder = "TestLog/Sort";
+            string path = "SortTestLog_NhanOutput.txt";
+            string output = "SortTestLog_YourOutput.txt";
+            fstream file(folder + "/" + output, ios::out);
+            if (!file.is_open()) {
+                fs::create_directory(folder);
+                std::cout << "Create folder " << fs::absolute(folder) << std::endl;
+                file.open(folder + "/" + output, ios::out);
+            }
+            //change cout to file
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file.rdbuf());
+
+            if (string(argv[1]) == "test") {
+                if (argc == 2) {
+                    for (int i = 0; i < num_task; i++) {
+                        std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                        testFuncs[i]();
+                    }
+                } else
+                if (argc == 3) {
+                    int task = stoi(argv[2]);
+                    if (task >= 1 && task <= num_task) {
+                        std::cout << "Task " << task << "---------------------------------------------------" <<std::endl;
+                        testFuncs[task - 1]();
+                    } else {
+                        std::cout << "Task not found" << std::endl;
+                    }
+                } else
+                if (argc == 4) {
+                    int start = stoi(argv[2]);
+                    int end = stoi(argv[3]);
+                    if (start >= 1 && start <= num_task && end >= 1 && end <= num_task && start <= end) {
+                        for (int i = start - 1; i < end; i++) {
+                            std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                            testFuncs[i]();
+                        }
+                    } else {
+                        std::cout << "Task not found or you enter error" << std::endl;
+                    }
+                }
+            }
+
+            // Restore cout
+            cout.rdbuf(stream_buffer_cout);
+            compareFile(folder + "/" + path, folder + "/" + output);
+        }
+    }
+    return 0;
+}
\ No newline at end of file
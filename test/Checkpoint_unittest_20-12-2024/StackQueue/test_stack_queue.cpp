@@ -0,0 +1,478 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file contains testcases for the array-backed queues and stacks (ArrayQueue,
+    * ArrayStack) and the concurrent queues (SPSCQueue, MPMCQueue)
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <regex>
+#include <random>
+#include <climits>
+#include <limits>
+#include <atomic>
+#include "stacknqueue/ArrayQueue.h"
+#include "stacknqueue/ArrayStack.h"
+#include "stacknqueue/SPSCQueue.h"
+#include "stacknqueue/MPMCQueue.h"
+#include <thread>
+using namespace std;
+namespace fs = std::filesystem;
+int num_task = 4;
+vector<vector<string>> expected_task (num_task, vector<string>(1000, ""));
+vector<vector<string>> output_task (num_task, vector<string>(1000, ""));
+vector<int> diffTasks(0);
+vector<int> doTasks(0);
+
+void compareFile(const string& filename1, const string& filename2) {
+    string log_file = "TestLog/StackQueue/StackQueueTestLog_Compare.txt";
+    fstream file(log_file, ios::out);
+    if (!file.is_open()) {
+        std::cout << "Cannot open file" << std::endl;
+        return;
+    }
+    
+    streambuf* stream_buffer_cout = cout.rdbuf();
+    cout.rdbuf(file.rdbuf());
+
+    fstream file1(filename1);
+    fstream file2(filename2);
+
+    // Store content of tasks in vector
+    string line;
+    int num = 1;
+    int num_line = 0;
+    while (getline(file1, line)) {
+        // if line contains "Task", store it in expected_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        expected_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    num = 1;
+    num_line = 0;
+    while (getline(file2, line)) {
+        // if line contains "Task", store it in output_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        output_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    // Compare content of tasks
+    for (int task = 0; task < num_task; task++) {
+        int count_diff = 0;
+        if (output_task[task][0] == "") continue;
+        doTasks.push_back(task + 1);
+        for (int line = 0; line < expected_task[task].size(); line++) {
+            if (expected_task[task][line] != output_task[task][line]) {
+                count_diff++;
+                cout << "Task " << task << " - Line " << line << ":\n";
+                cout << "Expected: " << expected_task[task][line];
+                cout << "Output: " << output_task[task][line];
+            }
+        }
+        if (count_diff > 0) {
+            diffTasks.push_back(task + 1);
+        }
+    }
+    
+    cout.rdbuf(stream_buffer_cout);
+    float prop = (float)diffTasks.size() / (float)doTasks.size();
+    if (prop == 0) {
+        std::cout << "All tasks are correct" << std::endl;
+    } else {
+        std::cout << "Number of tasks to do: " << doTasks.size() << std::endl;
+        std::cout << "Number of tasks with differences: " << diffTasks.size() << std::endl;
+        std::cout << "Pass: " << 1 - prop << std::endl;
+        for (int i = 0; i < diffTasks.size(); i++) {
+            std::cout << "Task " << diffTasks[i] << std::endl;
+        }
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: exe_file [OPTIONS] [TASK]" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  ?help: show help" << std::endl;
+    std::cout << "  demo: run demo" << std::endl;
+    std::cout << "  test: run all test" << std::endl;
+    std::cout << "  test [task]: run specific test" << std::endl;
+    std::cout << "  test [start_task] [end_task] : run test from start_task to end_task" << std::endl;
+    std::cout << "This test has " << num_task << " tasks" << std::endl;
+}
+
+string pointStr(int*& item) {
+    return "<" + to_string(*item) + ">";
+}
+
+/*
+    ArrayQueue: empty queue, wrap-around of the ring, growth while wrapped, remove
+*/
+void test1() {
+    ArrayQueue<int> queue(0, 0, 4);
+    cout << "Empty: " << queue.toString() << ", size: " << queue.size() << ", empty: " << queue.empty() << endl;
+    try {
+        queue.pop();
+    } catch (Underflow& e) {
+        cout << "pop on empty: Underflow" << endl;
+    }
+    try {
+        queue.peek();
+    } catch (Underflow& e) {
+        cout << "peek on empty: Underflow" << endl;
+    }
+    try {
+        queue.get(0);
+    } catch (std::out_of_range& e) {
+        cout << "get(0) on empty: " << e.what() << endl;
+    }
+
+    // push 3, pop 2, push 3: the front is at slot 2 and the rear wraps to slot 0
+    for (int i = 1; i <= 3; i++) queue.push(i);
+    cout << "pop: " << queue.pop() << " " << queue.pop() << endl;
+    for (int i = 4; i <= 6; i++) queue.push(i);
+    cout << "Wrapped: " << queue.toString() << ", get(3): " << queue.get(3) << endl;
+    // full while wrapped: growth unrolls the ring
+    queue.push(7);
+    queue.push(8);
+    cout << "Grown: " << queue.toString() << ", peek: " << queue.peek() << endl;
+
+    cout << "remove 5: " << queue.remove(5) << ", remove 3: " << queue.remove(3) << ", remove 42: " << queue.remove(42) << endl;
+    cout << "After remove: " << queue.toString() << ", contains 7: " << queue.contains(7) << ", contains 5: " << queue.contains(5) << endl;
+
+    cout << "Iterator:";
+    for (ArrayQueue<int>::Iterator it = queue.front(); it != queue.rear(); it++) cout << " " << *it;
+    cout << endl;
+    for (ArrayQueue<int>::Iterator it = queue.front(); it != queue.rear(); it++) {
+        if (*it % 2 == 0) it.remove();
+    }
+    cout << "Odd items kept: " << queue.toString() << endl;
+
+    ArrayQueue<int> copy(queue);
+    copy.push(100);
+    ArrayQueue<int> assigned;
+    assigned = copy;
+    cout << "Copy: " << copy.toString() << ", original: " << queue.toString() << ", assigned: " << assigned.toString() << endl;
+
+    // 1000 pushes interleaved with pops keep FIFO order through several growths
+    ArrayQueue<int> fifo(0, 0, 1);
+    int next = 0, expect = 0;
+    bool ordered = true;
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 10; i++) fifo.push(next++);
+        for (int i = 0; i < 7; i++) ordered = ordered && fifo.pop() == expect++;
+    }
+    while (!fifo.empty()) ordered = ordered && fifo.pop() == expect++;
+    cout << "FIFO over 1000 items: " << (ordered && expect == 1000 ? "ok" : "FAIL") << endl;
+
+    queue.clear();
+    queue.push(9);
+    cout << "After clear and push: " << queue.toString() << endl;
+
+    ArrayQueue<int*> owned(&ArrayQueue<int*>::free);
+    owned.push(new int(1));
+    owned.push(new int(2));
+    delete owned.pop();
+    owned.push(new int(3));
+    cout << "Owned pointers: " << owned.toString(&pointStr) << endl;
+}
+
+/*
+    ArrayStack: empty stack, growth from capacity 1, remove, iterator
+*/
+void test2() {
+    ArrayStack<int> stack(0, 0, 1);
+    cout << "Empty: " << stack.toString() << ", size: " << stack.size() << ", empty: " << stack.empty() << endl;
+    try {
+        stack.pop();
+    } catch (Underflow& e) {
+        cout << "pop on empty: Underflow" << endl;
+    }
+    try {
+        stack.peek();
+    } catch (Underflow& e) {
+        cout << "peek on empty: Underflow" << endl;
+    }
+
+    for (int i = 1; i <= 9; i++) stack.push(i * 10);
+    cout << "Pushed 9: " << stack.toString() << ", peek: " << stack.peek() << endl;
+    cout << "pop: " << stack.pop() << " " << stack.pop() << endl;
+    cout << "remove 30: " << stack.remove(30) << ", remove 90: " << stack.remove(90) << ", contains 10: " << stack.contains(10) << endl;
+    cout << "After remove: " << stack.toString() << endl;
+
+    cout << "Iterator:";
+    for (ArrayStack<int>::Iterator it = stack.top(); it != stack.bottom(); it++) cout << " " << *it;
+    cout << endl;
+    for (ArrayStack<int>::Iterator it = stack.top(); it != stack.bottom(); it++) {
+        if (*it == 60 || *it == 10) it.remove();
+    }
+    cout << "Without 60 and 10: " << stack.toString() << endl;
+
+    ArrayStack<int> copy(stack);
+    copy.push(1);
+    cout << "Copy: " << copy.toString() << ", original: " << stack.toString() << endl;
+
+    ArrayStack<string> words;
+    words.reserve(100);
+    string text[] = {"a", "b", "c", "d"};
+    for (string word : text) words.push(word);
+    string reversed = "";
+    while (!words.empty()) reversed += words.pop();
+    cout << "Reversed: " << reversed << endl;
+
+    stack.clear();
+    cout << "After clear: " << stack.toString() << ", size: " << stack.size() << endl;
+
+    ArrayStack<int*> owned(&ArrayStack<int*>::free);
+    for (int i = 0; i < 20; i++) owned.push(new int(i));
+    delete owned.pop();
+    cout << "Owned pointers: " << owned.size() << ", top: " << *owned.peek() << endl;
+}
+
+/*
+    SPSCQueue: empty, full at the rounded capacity, batches, close, one producer
+    and one consumer thread
+*/
+void test3() {
+    SPSCQueue<int> tiny(1);
+    SPSCQueue<int> queue(5);
+    cout << "Capacity 1 -> " << tiny.capacity() << ", 5 -> " << queue.capacity() << endl;
+    int item = -1;
+    cout << "tryPop on empty: " << queue.tryPop(item) << ", item: " << item << ", tryPopN: " << queue.tryPopN(&item, 4) << endl;
+
+    int pushed = 0;
+    while (queue.tryPush(pushed)) pushed++;
+    cout << "tryPush until full: " << pushed << ", size: " << queue.sizeApprox() << endl;
+    int batch[8];
+    cout << "tryPushN on full: " << queue.tryPushN(batch, 8) << endl;
+    int popped = queue.tryPopN(batch, 3);
+    cout << "tryPopN(3): " << popped << " -> " << batch[0] << " " << batch[1] << " " << batch[2] << endl;
+    int more[] = {100, 101, 102, 103, 104};
+    cout << "tryPushN(5) with room for 3: " << queue.tryPushN(more, 5) << endl;
+    cout << "Drain:";
+    while (queue.tryPop(item)) cout << " " << item;
+    cout << endl;
+
+    queue.push(7);
+    queue.close();
+    bool first = queue.pop(item);
+    cout << "Closed: pop " << first << " (" << item << "), then pop " << queue.pop(item)
+         << ", popN " << queue.popN(batch, 8) << ", isClosed " << queue.isClosed() << endl;
+
+    // 200000 items through 64 slots, single items and batches
+    SPSCQueue<int> pipe(64);
+    const int N = 200000;
+    long long sum = 0;
+    bool ordered = true;
+    std::thread consumer([&]() {
+        int values[16];
+        int expect = 0;
+        while (int n = pipe.popN(values, 16)) {
+            for (int i = 0; i < n; i++) {
+                ordered = ordered && values[i] == expect++;
+                sum += values[i];
+            }
+        }
+        ordered = ordered && expect == N;
+    });
+    int values[10];
+    for (int i = 0; i < N; ) {
+        if (i % 3 == 0 && i + 10 <= N) {
+            for (int k = 0; k < 10; k++) values[k] = i + k;
+            pipe.pushN(values, 10);
+            i += 10;
+        } else {
+            pipe.push(i++);
+        }
+    }
+    pipe.close();
+    consumer.join();
+    cout << "Threads: sum " << sum << ", in order: " << ordered << endl;
+}
+
+/*
+    MPMCQueue: empty, full, batches, close, four producers and four consumers
+*/
+void test4() {
+    MPMCQueue<int> queue(3);
+    cout << "Capacity 3 -> " << queue.capacity() << endl;
+    int item = -1;
+    cout << "tryPop on empty: " << queue.tryPop(item) << ", tryPopN: " << queue.tryPopN(&item, 4) << endl;
+    int pushed = 0;
+    while (queue.tryPush(pushed + 1)) pushed++;
+    cout << "tryPush until full: " << pushed << ", size: " << queue.sizeApprox() << endl;
+    int batch[8] = {0};
+    cout << "tryPushN on full: " << queue.tryPushN(batch, 8) << endl;
+    cout << "tryPopN(8): " << queue.tryPopN(batch, 8) << " -> " << batch[0] << " " << batch[1] << " " << batch[2] << " " << batch[3] << endl;
+    int more[] = {10, 20, 30, 40, 50, 60};
+    cout << "tryPushN(6): " << queue.tryPushN(more, 6) << ", pop:";
+    while (queue.tryPop(item)) cout << " " << item;
+    cout << endl;
+    queue.push(5);
+    queue.close();
+    bool first = queue.pop(item);
+    cout << "Closed: pop " << first << " (" << item << "), then pop " << queue.pop(item) << ", popN " << queue.popN(batch, 8) << endl;
+
+    // each item is producer * PER + seq: the sum is fixed and each producer's items stay in order
+    const int PRODUCERS = 4, CONSUMERS = 4, PER = 50000;
+    MPMCQueue<int> shared(128);
+    std::atomic<long long> sum(0);
+    std::atomic<int> count(0), disorder(0);
+    vector<std::thread> threads;
+    for (int c = 0; c < CONSUMERS; c++) {
+        threads.push_back(std::thread([&, c]() {
+            vector<int> last(PRODUCERS, -1);
+            int values[8];
+            long long local = 0;
+            int n, seen = 0;
+            while ((n = (c % 2 == 0 ? shared.popN(values, 8) : (shared.pop(values[0]) ? 1 : 0))) > 0) {
+                for (int i = 0; i < n; i++) {
+                    int producer = values[i] / PER, seq = values[i] % PER;
+                    if (seq <= last[producer]) disorder++;
+                    last[producer] = seq;
+                    local += values[i];
+                }
+                seen += n;
+            }
+            sum += local;
+            count += seen;
+        }));
+    }
+    vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.push_back(std::thread([&, p]() {
+            int values[5];
+            for (int seq = 0; seq < PER; ) {
+                if (p % 2 == 0 && seq + 5 <= PER) {
+                    for (int k = 0; k < 5; k++) values[k] = p * PER + seq + k;
+                    shared.pushN(values, 5);
+                    seq += 5;
+                } else {
+                    shared.push(p * PER + seq++);
+                }
+            }
+        }));
+    }
+    for (std::thread& producer : producers) producer.join();
+    shared.close();
+    for (std::thread& consumer : threads) consumer.join();
+    long long total = (long long)PRODUCERS * PER;
+    cout << "Threads: items " << count << ", sum " << (sum == total * (total - 1) / 2 ? "ok" : "FAIL")
+         << ", per-producer order kept: " << (disorder == 0) << endl;
+}
+
+void runDemo() {
+    cout << "Demo: ArrayQueue" << endl;
+    ArrayQueue<int> queue;
+    for (int i = 1; i <= 5; i++) queue.push(i);
+    queue.pop();
+    queue.println();
+}
+
+// pointer function to store tests
+void (*testFuncs[])() = {
+    test1, test2, test3, test4
+};
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2) {
+        if (string(argv[1]) == "?help") {
+            printUsage();
+            return 0;
+        }
+        else
+        if (string(argv[1]) == "demo") {
+            string file_name = "DemoLog.txt";
+            fstream file_demo(file_name, ios::out);
+            if (!file_demo.is_open()) {
+                std::cout << "Cannot open file" << std::endl;
+                return 0;
+            } 
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file_demo.rdbuf());
+
+            runDemo();
+
+            cout.rdbuf(stream_buffer_cout);
+            return 0;
+        }
+        else if (string(argv[1]) == "test")
+        {
+            string folder = "TestLog/StackQueue";
+            string path = "StackQueueTestLog_NhanOutput.txt";
+            string output = "StackQueueTestLog_YourOutput.txt";
+            fstream file(folder + "/" + output, ios::out);
+            if (!file.is_open()) {
+                fs::create_directory(folder);
+                std::cout << "Create folder " << fs::absolute(folder) << std::endl;
+                file.open(folder + "/" + output, ios::out);
+            }
+            //change cout to file
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file.rdbuf());
+
+            if (string(argv[1]) == "test") {
+                if (argc == 2) {
+                    for (int i = 0; i < num_task; i++) {
+                        std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                        testFuncs[i]();
+                    }
+                } else
+                if (argc == 3) {
+                    int task = stoi(argv[2]);
+                    if (task >= 1 && task <= num_task) {
+                        std::cout << "Task " << task << "---------------------------------------------------" <<std::endl;
+                        testFuncs[task - 1]();
+                    } else {
+                        std::cout << "Task not found" << std::endl;
+                    }
+                } else
+                if (argc == 4) {
+                    int start = stoi(argv[2]);
+                    int end = stoi(argv[3]);
+                    if (start >= 1 && start <= num_task && end >= 1 && end <= num_task && start <= end) {
+                        for (int i = start - 1; i < end; i++) {
+                            std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                            testFuncs[i]();
+                        }
+                    } else {
+                        std::cout << "Task not found or you enter error" << std::endl;
+                    }
+                }
+            }
+
+            // Restore cout
+            cout.rdbuf(stream_buffer_cout);
+            compareFile(folder + "/" + path, folder + "/" + output);
+        }
+    }
+    return 0;
+}
\ No newline at end of file
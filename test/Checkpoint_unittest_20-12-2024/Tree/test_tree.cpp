@@ -0,0 +1,945 @@
+/*
+    * Last update: 2026-10-19
+    * Version 1.0
+    * This file contains testcases for the trees (BPlusTree, tree walks, AVL,
+    * ConcurrentSkipList, RadixTree)
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <regex>
+#include <random>
+#include <climits>
+#include <limits>
+#include <atomic>
+#include "tree/BPlusTree.h"
+#include "tree/TreeTraversal.h"
+#include "tree/ConcurrentSkipList.h"
+#include "tree/AVL.h"
+#include <thread>
+#include "util/NodePool.h"
+#include "tree/RadixTree.h"
+#include <map>
+using namespace std;
+namespace fs = std::filesystem;
+int num_task = 6;
+vector<vector<string>> expected_task (num_task, vector<string>(1000, ""));
+vector<vector<string>> output_task (num_task, vector<string>(1000, ""));
+vector<int> diffTasks(0);
+vector<int> doTasks(0);
+
+void compareFile(const string& filename1, const string& filename2) {
+    string log_file = "TestLog/Tree/TreeTestLog_Compare.txt";
+    fstream file(log_file, ios::out);
+    if (!file.is_open()) {
+        std::cout << "Cannot open file" << std::endl;
+        return;
+    }
+    
+    streambuf* stream_buffer_cout = cout.rdbuf();
+    cout.rdbuf(file.rdbuf());
+
+    fstream file1(filename1);
+    fstream file2(filename2);
+
+    // Store content of tasks in vector
+    string line;
+    int num = 1;
+    int num_line = 0;
+    while (getline(file1, line)) {
+        // if line contains "Task", store it in expected_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        expected_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    num = 1;
+    num_line = 0;
+    while (getline(file2, line)) {
+        // if line contains "Task", store it in output_task
+        if (regex_match(line, regex("Task [0-9]+.*"))) {
+            num_line = 0;
+            // Extract numbers from the line
+            regex number_regex("[0-9]+");
+            auto numbers_begin = sregex_iterator(line.begin(), line.end(), number_regex);
+            auto numbers_end = sregex_iterator();
+
+            for (std::sregex_iterator i = numbers_begin; i != numbers_end; ++i) {
+                std::smatch match = *i;
+                num = std::stoi(match.str());
+                break;  
+            }
+        }
+        output_task[num - 1][num_line] += line + '\n';
+        num_line++;
+    }
+
+    // Compare content of tasks
+    for (int task = 0; task < num_task; task++) {
+        int count_diff = 0;
+        if (output_task[task][0] == "") continue;
+        doTasks.push_back(task + 1);
+        for (int line = 0; line < expected_task[task].size(); line++) {
+            if (expected_task[task][line] != output_task[task][line]) {
+                count_diff++;
+                cout << "Task " << task << " - Line " << line << ":\n";
+                cout << "Expected: " << expected_task[task][line];
+                cout << "Output: " << output_task[task][line];
+            }
+        }
+        if (count_diff > 0) {
+            diffTasks.push_back(task + 1);
+        }
+    }
+    
+    cout.rdbuf(stream_buffer_cout);
+    float prop = (float)diffTasks.size() / (float)doTasks.size();
+    if (prop == 0) {
+        std::cout << "All tasks are correct" << std::endl;
+    } else {
+        std::cout << "Number of tasks to do: " << doTasks.size() << std::endl;
+        std::cout << "Number of tasks with differences: " << diffTasks.size() << std::endl;
+        std::cout << "Pass: " << 1 - prop << std::endl;
+        for (int i = 0; i < diffTasks.size(); i++) {
+            std::cout << "Task " << diffTasks[i] << std::endl;
+        }
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: exe_file [OPTIONS] [TASK]" << std::endl;
+    std::cout << "OPTIONS:" << std::endl;
+    std::cout << "  ?help: show help" << std::endl;
+    std::cout << "  demo: run demo" << std::endl;
+    std::cout << "  test: run all test" << std::endl;
+    std::cout << "  test [task]: run specific test" << std::endl;
+    std::cout << "  test [start_task] [end_task] : run test from start_task to end_task" << std::endl;
+    std::cout << "This test has " << num_task << " tasks" << std::endl;
+}
+
+template<class T>
+string listStr(DLinkedList<T> list) {
+    stringstream os;
+    os << "[";
+    bool first = true;
+    for (T item : list) {
+        os << (first ? "" : ", ") << item;
+        first = false;
+    }
+    os << "]";
+    return os.str();
+}
+
+// 64-byte nodes: 3 entries per leaf, 4 keys per inner node, so splits and merges come quickly
+typedef BPlusTree<int, int*, 64> SmallBPlus;
+
+// keys ascending along the leaf chain, size and descending walk consistent
+string checkBPlus(SmallBPlus& tree) {
+    int n = 0, last = INT_MIN;
+    bool ordered = true;
+    for (SmallBPlus::Iterator it = tree.begin(); it != tree.end(); it++) {
+        ordered = ordered && (n == 0 || last < it.key());
+        last = it.key();
+        n++;
+    }
+    int back = 0;
+    tree.traverse([&back](int& key, int*& value) { back++; }, TreeOrder::RNL);
+    return (ordered && n == tree.size() && back == n) ? "ok" : "BROKEN";
+}
+
+/*
+    BPlusTree: empty tree, leaf and inner splits at the capacity limits, borrowing and
+    merging at the minimum fill, buildFromSorted
+*/
+void test1() {
+    SmallBPlus tree;
+    bool found = true, success = true;
+    cout << "Capacities: leaf " << SmallBPlus::LEAF_CAPACITY << ", inner " << SmallBPlus::INNER_CAPACITY
+         << ", minimum leaf " << SmallBPlus::LEAF_MIN << ", inner " << SmallBPlus::INNER_MIN << endl;
+    cout << "Empty: " << tree.toString() << ", size " << tree.size() << ", height " << tree.height()
+         << ", empty " << tree.empty() << endl;
+    tree.search(1, found);
+    tree.remove(1, &success);
+    cout << "Empty search: " << found << ", remove: " << success << ", begin==end: " << (tree.begin() == tree.end())
+         << ", range: " << (tree.range(0, 9).begin() == tree.end()) << ", bfsKey: " << listStr(tree.bfsKey()) << endl;
+
+    // a full leaf, then one more key in the middle: even split
+    int middle[] = {10, 30, 20, 25};
+    for (int key : middle) {
+        tree.add(key);
+        cout << "add " << key << ": " << tree.toString() << ", height " << tree.height() << endl;
+    }
+    tree.clear();
+    // appending to the last leaf splits it full / 1 entry
+    for (int key = 1; key <= 4; key++) tree.add(key);
+    cout << "Append 1-4: " << tree.toString() << endl;
+    for (int key = 5; key <= 15; key++) tree.add(key);
+    cout << "Append 1-15: " << tree.toString() << ", height " << tree.height() << endl;
+    // the root holds INNER_CAPACITY keys now: the next leaf split splits it too
+    for (int key = 16; key <= 19; key++) tree.add(key);
+    cout << "Append 1-19: " << tree.toString() << ", height " << tree.height() << endl;
+    int* value = new int(77);
+    tree.add(7, value);
+    cout << "Replace 7: size " << tree.size() << ", value " << *tree.search(7, found) << endl;
+    tree.add(7, 0);
+    delete value;
+
+    // removals: a leaf left empty (below LEAF_MIN) borrows from a sibling with spare entries,
+    // else merges with it; the merges of 17 and 13 empty an inner node and the root
+    int removals[] = {1, 2, 3, 19, 18, 10, 11, 12, 4, 16, 17, 13};
+    for (int key : removals) {
+        tree.remove(key, &success);
+        cout << "remove " << key << " (" << success << "): " << tree.toString() << ", height " << tree.height() << endl;
+    }
+    tree.remove(100, &success);
+    cout << "remove 100: " << success << ", size " << tree.size() << endl;
+    cout << "lowerBound(10): " << tree.lowerBound(10).key() << ", upperBound(14): " << tree.upperBound(14).key()
+         << ", upperBound(15) is end: " << (tree.upperBound(15) == tree.end()) << endl;
+    cout << "range(8, 14):";
+    SmallBPlus::Range range = tree.range(8, 14);
+    for (SmallBPlus::Iterator it = range.begin(); it != range.end(); it++) cout << " " << it.key();
+    cout << endl;
+    int left[] = {5, 6, 7, 8, 9, 14, 15};
+    for (int key : left) tree.remove(key);
+    cout << "All removed: " << tree.toString() << ", size " << tree.size() << ", height " << tree.height() << endl;
+
+    // random order, checked after every step
+    std::mt19937 engine(43);
+    vector<int> keys;
+    bool ok = true;
+    for (int i = 0; i < 2000; i++) {
+        int key = (int)(engine() % 5000);
+        tree.add(key);
+        keys.push_back(key);
+        if (i % 50 == 0) ok = ok && checkBPlus(tree) == "ok";
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    cout << "2000 random adds: " << tree.size() << " keys (" << keys.size() << " distinct), height " << tree.height()
+         << ", " << (ok ? "ok" : "BROKEN") << endl;
+    for (int i = 0; i < (int)keys.size(); i++) {
+        int pick = (int)(engine() % keys.size());
+        std::swap(keys[i], keys[pick]);
+    }
+    for (int i = 0; i < (int)keys.size(); i++) {
+        tree.remove(keys[i], &success);
+        ok = ok && success;
+        if (i % 50 == 0) ok = ok && checkBPlus(tree) == "ok";
+    }
+    cout << "Removed in random order: size " << tree.size() << ", height " << tree.height() << ", " << (ok ? "ok" : "BROKEN") << endl;
+
+    // buildFromSorted: packed leaves, inner levels built bottom-up
+    int sorted[13];
+    for (int i = 0; i < 13; i++) sorted[i] = i * 10;
+    tree.buildFromSorted(sorted, 0, 13);
+    cout << "buildFromSorted(13): " << tree.toString() << ", height " << tree.height() << ", " << checkBPlus(tree) << endl;
+    tree.add(125);
+    tree.remove(0);
+    cout << "then add 125, remove 0: " << tree.toString() << endl;
+    SmallBPlus copy(tree);
+    copy.add(1000);
+    cout << "Copy: " << copy.size() << " keys, original: " << tree.size() << " keys" << endl;
+    tree.buildFromSorted(sorted, 0, 0);
+    cout << "buildFromSorted(0): " << tree.toString() << ", height " << tree.height() << endl;
+    int unsorted[] = {1, 3, 3};
+    try {
+        copy.buildFromSorted(unsorted, 0, 3);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << ", size kept: " << copy.size() << endl;
+    }
+    try {
+        copy.buildFromSorted(unsorted, 0, -1);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+}
+
+struct WalkNode {
+    int key;
+    WalkNode* left;
+    WalkNode* right;
+    WalkNode(int key, WalkNode* left = 0, WalkNode* right = 0) : key(key), left(left), right(right) {}
+};
+string orderName(int order) {
+    string names[] = {"NLR", "LNR", "LRN", "RNL", "BFS"};
+    return names[order];
+}
+void deleteWalkTree(WalkNode* root) {
+    for (WalkNode* node : BinaryTreeWalk<WalkNode>(root, TreeOrder::LRN)) delete node;
+}
+
+/*
+    Tree walks: BinaryTreeWalk in every order (empty tree, uneven tree, long chain),
+    walk/traverse of BPlusTree and ConcurrentSkipList, unknown orders
+*/
+void test2() {
+    /*
+            50
+          /    \
+        30      70
+       /  \       \
+     20    40      80
+          /       /
+        35      75
+    */
+    WalkNode* root = new WalkNode(50,
+        new WalkNode(30, new WalkNode(20), new WalkNode(40, new WalkNode(35))),
+        new WalkNode(70, 0, new WalkNode(80, new WalkNode(75))));
+    for (int order = TreeOrder::NLR; order <= TreeOrder::BFS; order++) {
+        cout << orderName(order) << ":";
+        for (WalkNode* node : BinaryTreeWalk<WalkNode>(root, order)) cout << " " << node->key;
+        cout << endl;
+    }
+    int sum = 0;
+    BinaryTreeWalk<WalkNode>(root, TreeOrder::BFS).forEach([&sum](WalkNode* node) { sum += node->key; });
+    cout << "forEach sum: " << sum << endl;
+    deleteWalkTree(root);
+
+    int visited = 0;
+    for (int order = TreeOrder::NLR; order <= TreeOrder::BFS; order++) {
+        for (WalkNode* node : BinaryTreeWalk<WalkNode>(0, order)) visited += node->key + 1;
+    }
+    cout << "Empty tree, all orders: " << visited << " nodes" << endl;
+    WalkNode* single = new WalkNode(9);
+    cout << "One node:";
+    for (int order = TreeOrder::NLR; order <= TreeOrder::BFS; order++) {
+        for (WalkNode* node : BinaryTreeWalk<WalkNode>(single, order)) cout << " " << orderName(order) << "=" << node->key;
+    }
+    cout << endl;
+    delete single;
+
+    // a chain of 100000 left children: no recursion, so no stack overflow
+    WalkNode* chain = 0;
+    for (int key = 0; key < 100000; key++) chain = new WalkNode(key, chain);
+    for (int order = TreeOrder::NLR; order <= TreeOrder::BFS; order++) {
+        int count = 0, first = -1;
+        for (WalkNode* node : BinaryTreeWalk<WalkNode>(chain, order)) {
+            if (count++ == 0) first = node->key;
+        }
+        cout << "Chain " << orderName(order) << ": " << count << " nodes, first " << first << endl;
+    }
+    deleteWalkTree(chain);
+    try {
+        BinaryTreeWalk<WalkNode> bad(0, 7);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+
+    SmallBPlus bplus;
+    for (int key = 1; key <= 10; key++) bplus.add(key * 10);
+    for (int order = TreeOrder::NLR; order <= TreeOrder::BFS; order++) {
+        cout << "BPlusTree " << orderName(order) << ":";
+        SmallBPlus::Range entries = bplus.walk(order);
+        for (SmallBPlus::Iterator it = entries.begin(); it != entries.end(); it++) cout << " " << it.key();
+        cout << endl;
+    }
+    string keys = "";
+    bplus.traverse([&keys](int& key, int*& value) { keys += to_string(key) + " "; }, TreeOrder::RNL);
+    cout << "BPlusTree traverse RNL: " << keys << endl;
+    SmallBPlus emptyPlus;
+    cout << "Empty BPlusTree RNL is empty: " << (emptyPlus.walk(TreeOrder::RNL).begin() == emptyPlus.end()) << endl;
+    try {
+        bplus.walk(-1);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+
+    ConcurrentSkipList<int, int*> skip;
+    cout << "Empty skip list LNR, RNL empty: " << (skip.walk().begin() == skip.end()) << " "
+         << (skip.walk(TreeOrder::RNL).begin() == skip.end()) << endl;
+    int order5[] = {40, 10, 50, 30, 20, 60};
+    for (int key : order5) skip.add(key);
+    for (int order = TreeOrder::NLR; order <= TreeOrder::BFS; order++) {
+        cout << "ConcurrentSkipList " << orderName(order) << ":";
+        for (ConcurrentSkipList<int, int*>::Iterator it = skip.walk(order).begin(); it != skip.end(); it++) cout << " " << it.key();
+        cout << endl;
+    }
+    keys = "";
+    skip.traverse([&keys](int& key, int*& value) { keys += to_string(key) + " "; }, TreeOrder::RNL);
+    cout << "ConcurrentSkipList traverse RNL: " << keys << endl;
+    cout << "descendingList size: " << skip.descendingList().size() << endl;
+    // entries removed after the walk started are skipped when reached
+    ConcurrentSkipList<int, int*>::Range reverse = skip.walk(TreeOrder::RNL);
+    ConcurrentSkipList<int, int*>::Iterator it = reverse.begin();
+    cout << "RNL with removals during the walk: " << it.key();
+    skip.remove(50);
+    skip.remove(30);
+    for (++it; it != reverse.end(); ++it) cout << " " << it.key();
+    cout << endl;
+    try {
+        skip.traverse([](int& key, int*& value) {}, 5);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+}
+
+struct Weight {
+    typedef double Type;
+    static double get(int& key, double*& value) { return *value; }
+};
+
+/*
+    AVL order statistics: empty tree, rotations, kth/rank/countRange/select, multiset,
+    range summaries, a random sequence checked against a sorted vector
+*/
+void test3() {
+    AVL<int, int*> tree;
+    bool found = true;
+    cout << "Empty: " << tree.toString() << ", size " << tree.size() << ", height " << tree.height()
+         << ", rank(5) " << tree.rank(5) << ", countRange(0, 9) " << tree.countRange(0, 9) << endl;
+    try {
+        tree.kth(0);
+    } catch (std::out_of_range& e) {
+        cout << "kth(0): " << e.what() << endl;
+    }
+    tree.remove(3, &found);
+    cout << "remove on empty: " << found << endl;
+
+    // ascending inserts: every third one rotates
+    for (int key = 1; key <= 7; key++) {
+        tree.add(key * 10);
+        cout << "add " << key * 10 << ": " << tree.toString(0, true) << endl;
+    }
+    cout << "kth:";
+    for (int k = 0; k < tree.size(); k++) cout << " " << tree.kth(k);
+    cout << endl;
+    cout << "rank(10) " << tree.rank(10) << ", rank(35) " << tree.rank(35) << ", rank(70) " << tree.rank(70)
+         << ", rank(100) " << tree.rank(100) << ", rank(-5) " << tree.rank(-5) << endl;
+    cout << "countRange(20, 50) " << tree.countRange(20, 50) << ", (25, 45) " << tree.countRange(25, 45)
+         << ", (50, 20) " << tree.countRange(50, 20) << ", (70, 70) " << tree.countRange(70, 70) << endl;
+    try {
+        tree.kth(7);
+    } catch (std::out_of_range& e) {
+        cout << "kth(7): " << e.what() << endl;
+    }
+    cout << "traverseRange(25, 60):";
+    tree.traverseRange(25, 60, [](int& key, int*& value) { cout << " " << key; });
+    cout << endl;
+    int marks[] = {1, 2, 3, 4, 5, 6, 7};
+    AVL<int, int*> marked;
+    for (int idx = 0; idx < 7; idx++) marked.add((idx + 1) * 10, &marks[idx]);
+    cout << "select(25, 60):";
+    for (int* mark : marked.select(25, 60)) cout << " " << *mark;
+    cout << ", select(61, 69) size " << marked.select(61, 69).size() << endl;
+    // removals rebalance: the left side empties
+    int removals[] = {10, 30, 20};
+    for (int key : removals) {
+        tree.remove(key);
+        cout << "remove " << key << ": " << tree.toString(0, true) << ", kth(0) " << tree.kth(0) << endl;
+    }
+
+    AVL<int, int*> scores(true);
+    int samples[] = {5, 3, 5, 8, 5, 1, 3};
+    for (int key : samples) scores.add(key);
+    cout << "Multiset: size " << scores.size() << ", kth:";
+    for (int k = 0; k < scores.size(); k++) cout << " " << scores.kth(k);
+    cout << ", rank(5) " << scores.rank(5) << ", countRange(5, 5) " << scores.countRange(5, 5) << endl;
+    scores.remove(5);
+    cout << "remove one 5: size " << scores.size() << ", countRange(5, 5) " << scores.countRange(5, 5)
+         << ", median " << scores.kth(scores.size() / 2) << endl;
+
+    AVL<int, int*, AVLSum<int, int*>> sums;
+    AVL<int, int*, AVLMin<int, int*>> mins;
+    AVL<int, int*, AVLMax<int, int*>> maxs;
+    for (int key = 1; key <= 20; key++) {
+        sums.add(key * 3);
+        mins.add(key * 3);
+        maxs.add(key * 3);
+    }
+    cout << "Sum [10, 30]: " << sums.aggregate(10, 30, found) << " (" << found << ")";
+    cout << ", min [10, 30]: " << mins.aggregate(10, 30, found);
+    cout << ", max [10, 30]: " << maxs.aggregate(10, 30, found);
+    cout << ", sum all: " << sums.aggregate(INT_MIN, INT_MAX, found) << endl;
+    int none = sums.aggregate(31, 32, found);
+    cout << "Sum [31, 32]: " << none << " (" << found << "), sum [30, 10]: ";
+    none = sums.aggregate(30, 10, found);
+    cout << none << " (" << found << ")" << endl;
+    sums.remove(30);
+    cout << "Sum [10, 30] after remove 30: " << sums.aggregate(10, 30, found) << endl;
+
+    double weights[] = {2.5, 0.5, 4.0, 1.0};
+    AVL<int, double*, AVLMax<int, double*, Weight>> heaviest;
+    for (int i = 0; i < 4; i++) heaviest.add(i, &weights[i]);
+    cout << "Heaviest of keys [0, 1]: " << heaviest.aggregate(0, 1, found) << ", [1, 3]: " << heaviest.aggregate(1, 3, found) << endl;
+
+    // 3000 random operations against a sorted vector
+    std::mt19937 engine(45);
+    AVL<int, int*> random(true);
+    vector<int> model;
+    bool ok = true;
+    for (int i = 0; i < 3000; i++) {
+        int key = (int)(engine() % 500);
+        if (engine() % 3 == 0 && !model.empty()) {
+            bool removed = false;
+            random.remove(key, &removed);
+            vector<int>::iterator pos = std::lower_bound(model.begin(), model.end(), key);
+            bool present = pos != model.end() && *pos == key;
+            if (present) model.erase(pos);
+            ok = ok && removed == present;
+        } else {
+            random.add(key);
+            model.insert(std::upper_bound(model.begin(), model.end(), key), key);
+        }
+        if (i % 100 == 0 && !model.empty()) {
+            int k = (int)(engine() % model.size());
+            int lo = (int)(engine() % 500), hi = lo + (int)(engine() % 100);
+            int expected = (int)(std::upper_bound(model.begin(), model.end(), hi) - std::lower_bound(model.begin(), model.end(), lo));
+            ok = ok && random.kth(k) == model[k]
+                    && random.rank(lo) == (int)(std::lower_bound(model.begin(), model.end(), lo) - model.begin())
+                    && random.countRange(lo, hi) == expected;
+        }
+    }
+    int bound = 0;
+    for (int n = random.size() + 2; n > 1; n >>= 1) bound++;
+    cout << "3000 random operations: size " << random.size() << " (" << model.size() << "), height "
+         << random.height() << " <= " << (int)(1.44 * bound) << ": " << (random.height() <= 1.44 * bound) << ", "
+         << (ok ? "ok" : "BROKEN") << endl;
+}
+
+string entryStr(int& key, int*& value) {
+    return to_string(key) + "=" + (value == 0 ? "null" : to_string(*value));
+}
+
+/*
+    ConcurrentSkipList: empty list, add/replace/remove, bounds and ranges, iterators,
+    collect/clear, threads adding and removing disjoint keys
+*/
+void test4() {
+    ConcurrentSkipList<int, int*> list;
+    bool found = true, success = true;
+    cout << "Empty: " << list.toString() << ", size " << list.size() << ", height " << list.height()
+         << ", empty " << list.empty() << endl;
+    list.search(1, found);
+    list.remove(1, &success);
+    cout << "search " << found << ", remove " << success << ", begin==end " << (list.begin() == list.end())
+         << ", lowerBound(0)==end " << (list.lowerBound(0) == list.end()) << ", ascending " << list.ascendingList().size() << endl;
+
+    int values[] = {100, 200, 300, 400};
+    int keys[] = {30, 10, 40, 20, 50, 5};
+    for (int i = 0; i < 6; i++) list.add(keys[i], i < 4 ? &values[i] : 0);
+    cout << "Added: " << list.toString(&entryStr) << ", size " << list.size() << endl;
+    list.add(40, &values[0]);
+    cout << "Replace 40: " << *list.search(40, found) << ", size " << list.size() << endl;
+    int* removed = list.remove(10, &success);
+    cout << "remove 10: " << success << " -> " << *removed << ", again: ";
+    list.remove(10, &success);
+    cout << success << ", search 10: ";
+    list.search(10, found);
+    cout << found << endl;
+    cout << "lowerBound(25) " << list.lowerBound(25).key() << ", lowerBound(30) " << list.lowerBound(30).key()
+         << ", lowerBound(51)==end " << (list.lowerBound(51) == list.end()) << endl;
+    cout << "range(20, 40):";
+    for (int* value : list.range(20, 40)) cout << " " << (value == 0 ? 0 : *value);
+    cout << ", range(6, 19) empty: " << (list.range(6, 19).begin() == list.end())
+         << ", range(40, 20) empty: " << (list.range(40, 20).begin() == list.end()) << endl;
+    cout << "Iterator:";
+    for (ConcurrentSkipList<int, int*>::Iterator it = list.begin(); it != list.end(); it++) cout << " " << it.key();
+    cout << endl;
+    cout << "height in 1.." << ConcurrentSkipList<int, int*>::MAX_LEVEL << ": "
+         << (list.height() >= 1 && list.height() <= ConcurrentSkipList<int, int*>::MAX_LEVEL) << endl;
+    list.collect();
+    cout << "After collect: " << list.toString() << ", size " << list.size() << endl;
+    list.clear();
+    cout << "After clear: " << list.toString() << ", size " << list.size() << ", height " << list.height() << endl;
+
+    // 4 threads add 5000 keys each (key % 4 == thread), then remove the odd ones
+    const int THREADS = 4, PER = 5000;
+    vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.push_back(std::thread([&list, t]() {
+            for (int i = 0; i < PER; i++) list.add(i * THREADS + t);
+            for (int i = 0; i < PER; i++) {
+                int key = i * THREADS + t;
+                if (key % 2 == 1) list.remove(key);
+            }
+        }));
+    }
+    // a reader walks the list meanwhile: the keys it sees are ascending
+    bool ascending = true;
+    std::thread reader([&list, &ascending]() {
+        for (int round = 0; round < 20; round++) {
+            int last = -1;
+            for (ConcurrentSkipList<int, int*>::Iterator it = list.begin(); it != list.end(); it++) {
+                ascending = ascending && last < it.key();
+                last = it.key();
+            }
+        }
+    });
+    for (std::thread& thread : threads) thread.join();
+    reader.join();
+    bool ok = list.size() == THREADS * PER / 2;
+    int expected = 0;
+    for (ConcurrentSkipList<int, int*>::Iterator it = list.begin(); it != list.end(); it++) {
+        ok = ok && it.key() == expected;
+        expected += 2;
+    }
+    cout << "Threads: size " << list.size() << ", even keys only: " << (ok ? "ok" : "BROKEN")
+         << ", reader saw ascending keys: " << ascending << endl;
+    list.collect();
+    cout << "After collect: size " << list.size() << ", range(100, 120):";
+    for (ConcurrentSkipList<int, int*>::Iterator it = list.range(100, 120).begin(); it != list.end(); it++) cout << " " << it.key();
+    cout << endl;
+}
+
+struct PoolItem {
+    static int alive;
+    int id;
+    string name;
+    PoolItem(int id, string name) : id(id), name(name) { alive++; }
+    ~PoolItem() { alive--; }
+};
+int PoolItem::alive = 0;
+
+/*
+    NodePool and the AVL bulk operations: slot reuse, reset, buildFromSorted (empty,
+    balanced, bad input), merge (disjoint, overlapping, multiset, with itself)
+*/
+void test5() {
+    NodePool<PoolItem> pool;
+    cout << "Empty pool: size " << pool.size() << ", capacity " << pool.capacity() << endl;
+    vector<PoolItem*> items;
+    for (int i = 0; i < 100; i++) items.push_back(pool.create(i, "item" + to_string(i)));
+    cout << "100 created: size " << pool.size() << ", capacity " << pool.capacity() << " (blocks of "
+         << NodePool<PoolItem>::FIRST_BLOCK << " then " << 2 * NodePool<PoolItem>::FIRST_BLOCK << "), alive " << PoolItem::alive << endl;
+    PoolItem* freed = items[10];
+    pool.destroy(items[10]);
+    pool.destroy(items[20]);
+    PoolItem* reused = pool.create(500, "reused");
+    cout << "destroy 2, create 1: size " << pool.size() << ", last freed slot reused: " << (reused == items[20])
+         << ", alive " << PoolItem::alive << endl;
+    PoolItem* again = pool.create(501, "again");
+    cout << "next create takes the other freed slot: " << (again == freed) << endl;
+    items[10] = again;
+    items[20] = reused;
+    for (PoolItem* item : items) pool.destroy(item);
+    cout << "All destroyed: size " << pool.size() << ", alive " << PoolItem::alive << endl;
+    pool.reset();
+    long long capacity = pool.capacity();
+    for (int i = 0; i < 150; i++) pool.create(i, "x");
+    cout << "reset keeps the blocks: capacity " << capacity << " -> " << pool.capacity() << ", size " << pool.size() << endl;
+    // reset does not run destructors: the owner does (here, by hand)
+    PoolItem::alive = 0;
+    pool.release();
+    cout << "release: capacity " << pool.capacity() << ", size " << pool.size() << endl;
+
+    AVL<int, int*> tree;
+    int keys[15];
+    for (int i = 0; i < 15; i++) keys[i] = (i + 1) * 10;
+    tree.buildFromSorted(keys, 0, 0);
+    cout << "buildFromSorted(0): " << tree.toString() << ", size " << tree.size() << endl;
+    tree.buildFromSorted(keys, 0, 1);
+    cout << "buildFromSorted(1): " << tree.toString() << endl;
+    tree.buildFromSorted(keys, 0, 6);
+    cout << "buildFromSorted(6): " << tree.toString(0, true) << ", height " << tree.height() << endl;
+    tree.buildFromSorted(keys, 0, 15);
+    cout << "buildFromSorted(15): height " << tree.height() << ", bfsKey " << listStr(tree.bfsKey()) << endl;
+    cout << "then kth(7) " << tree.kth(7) << ", rank(85) " << tree.rank(85) << endl;
+    int values[] = {1, 2, 3};
+    int* pointers[] = {&values[0], &values[1], &values[2]};
+    int withValues[] = {7, 8, 9};
+    tree.buildFromSorted(withValues, pointers, 3);
+    bool found = false;
+    cout << "With values: 8 -> " << *tree.search(8, found) << endl;
+    int unsorted[] = {1, 5, 5, 9};
+    try {
+        tree.buildFromSorted(unsorted, 0, 4);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << ", tree kept: " << tree.toString() << endl;
+    }
+    try {
+        tree.buildFromSorted(unsorted, 0, -2);
+    } catch (std::invalid_argument& e) {
+        cout << "Error: " << e.what() << endl;
+    }
+    AVL<int, int*> bag(true);
+    bag.buildFromSorted(unsorted, 0, 4);
+    cout << "Multiset accepts equal keys: " << bag.toString() << ", countRange(5, 5) " << bag.countRange(5, 5) << endl;
+
+    // merge
+    AVL<int, int*> left, right, empty;
+    for (int key = 1; key <= 9; key += 2) left.add(key);
+    for (int key = 2; key <= 10; key += 2) right.add(key);
+    left.merge(right);
+    cout << "Disjoint merge: " << listStr(left.bfsKey()) << ", size " << left.size() << ", height " << left.height()
+         << ", right kept: " << right.size() << endl;
+    left.merge(empty);
+    empty.merge(right);
+    cout << "Merge with empty: " << left.size() << ", into empty: " << empty.size() << endl;
+    int a = 100, b = 200;
+    AVL<int, int*> first, second;
+    first.add(1, &a);
+    first.add(2, &a);
+    second.add(2, &b);
+    second.add(3, &b);
+    first.merge(second);
+    cout << "Overlapping merge: size " << first.size() << ", 2 -> " << *first.search(2, found) << " (from the argument)" << endl;
+    first.merge(first);
+    cout << "Merge with itself: size " << first.size() << endl;
+    AVL<int, int*> multi(true), other(true);
+    multi.add(5, &a);
+    multi.add(7, &a);
+    other.add(5, &b);
+    other.add(6, &b);
+    multi.merge(other);
+    cout << "Multiset merge:";
+    multi.traverse([](int& key, int*& value) { cout << " " << key << "=" << *value; });
+    cout << endl;
+    multi.merge(multi);
+    cout << "Multiset merged with itself: size " << multi.size() << ", countRange(5, 5) " << multi.countRange(5, 5) << endl;
+
+    // the tree's pool: clear keeps the memory, the next batch reuses it
+    AVL<int, int*> big;
+    for (int round = 0; round < 3; round++) {
+        for (int key = 0; key < 10000; key++) big.add(key);
+        bool ok = big.size() == 10000 && big.kth(1234) == 1234;
+        big.clear();
+        cout << "Round " << round << ": " << (ok ? "ok" : "BROKEN") << ", cleared size " << big.size() << endl;
+    }
+    AVL<int, int*> copy(left);
+    copy.remove(1);
+    cout << "Copy: " << copy.size() << ", original: " << left.size() << endl;
+}
+
+// RadixTree with its root layout visible
+class RadixProbe : public RadixTree<int> {
+public:
+    string rootLayout() {
+        if (this->root == 0) return "empty";
+        string names[] = {"Leaf", "Node4", "Node16", "Node48", "Node256"};
+        if (this->root->type == LEAF) return "Leaf";
+        Inner* inner = (Inner*)this->root;
+        return names[inner->type] + "(" + to_string(inner->count) + ")";
+    }
+};
+string radixKeys(DLinkedList<string> keys) {
+    stringstream os;
+    os << "[";
+    bool first = true;
+    for (string key : keys) {
+        os << (first ? "" : ", ") << (key.empty() ? "\"\"" : key);
+        first = false;
+    }
+    os << "]";
+    return os.str();
+}
+
+/*
+    RadixTree: empty tree and empty key, node growth 4 -> 16 -> 48 -> 256 and shrinking
+    back, path compression, prefix queries, a random run checked against std::map
+*/
+void test6() {
+    RadixProbe tree;
+    bool found = true;
+    cout << "Empty: " << tree.toString() << ", size " << tree.size() << ", layout " << tree.rootLayout()
+         << ", find null " << (tree.find("a") == 0) << ", keys " << radixKeys(tree.keys()) << endl;
+    try {
+        tree.get("a");
+    } catch (KeyNotFound& e) {
+        cout << "get: " << e.what() << endl;
+    }
+    try {
+        tree.remove("a");
+    } catch (KeyNotFound& e) {
+        cout << "remove: " << e.what() << endl;
+    }
+    tree.longestPrefixMatch("abc", found);
+    cout << "longestPrefixMatch on empty: " << found << ", withPrefix empty: "
+         << (tree.withPrefix("").begin() == tree.end()) << endl;
+
+    tree.put("", 1);
+    cout << "Empty key: get " << tree.get("") << ", layout " << tree.rootLayout() << endl;
+    tree.put("a", 2);
+    tree.put("ab", 3);
+    string match;
+    int value = tree.longestPrefixMatch("xyz", found, &match);
+    cout << "With a, ab: layout " << tree.rootLayout() << ", keys " << radixKeys(tree.keys())
+         << ", longestPrefixMatch(xyz) -> " << value << " (\"" << match << "\")" << endl;
+    cout << "remove empty key: " << tree.remove("") << ", keys " << radixKeys(tree.keys()) << ", layout " << tree.rootLayout() << endl;
+    cout << "put existing: " << tree.put("ab", 30) << " -> " << tree.get("ab") << ", size " << tree.size() << endl;
+    tree.clear();
+
+    // one byte after "x" per child: the root grows through every layout
+    int growth[] = {1, 4, 5, 16, 17, 48, 49, 256};
+    int added = 0;
+    for (int target : growth) {
+        for (; added < target; added++) tree.put(string("x") + (char)added, added);
+        cout << target << " children: " << tree.rootLayout() << endl;
+    }
+    bool ok = true;
+    for (int b = 0; b < 256; b++) ok = ok && tree.get(string("x") + (char)b) == b;
+    cout << "All 256 found: " << ok << ", size " << tree.size() << endl;
+    // removals shrink with a margin: 256 -> 48 below 37, 48 -> 16 below 13, 16 -> 4 below 4
+    int shrinkAt[] = {48, 37, 36, 13, 12, 4, 3, 2, 1, 0};
+    int left = 256;
+    for (int target : shrinkAt) {
+        for (; left > target; left--) tree.remove(string("x") + (char)(left - 1));
+        cout << target << " left: " << tree.rootLayout() << ", size " << tree.size() << endl;
+    }
+
+    // path compression and prefix queries
+    string words[] = {"romane", "romanus", "romulus", "rubens", "ruber", "rubicon", "rubicundus", "FC_3", "FC_3.weight", "FC_3.bias", "FC_30.weight"};
+    for (int i = 0; i < 11; i++) tree.put(words[i], i);
+    cout << "Words: " << tree.size() << ", layout " << tree.rootLayout() << endl;
+    cout << "withPrefix(rom): " << radixKeys(tree.keysWithPrefix("rom")) << endl;
+    cout << "withPrefix(rubic): " << radixKeys(tree.keysWithPrefix("rubic")) << endl;
+    cout << "withPrefix(FC_3): " << radixKeys(tree.keysWithPrefix("FC_3")) << endl;
+    cout << "withPrefix(FC_3.): " << radixKeys(tree.keysWithPrefix("FC_3.")) << endl;
+    cout << "withPrefix(roma) values:";
+    RadixTree<int>::Range range = tree.withPrefix("roma");
+    for (RadixTree<int>::Iterator it = range.begin(); it != range.end(); ++it) cout << " " << it.value();
+    cout << endl;
+    cout << "withPrefix(rx): " << radixKeys(tree.keysWithPrefix("rx")) << ", withPrefix(romanesque): "
+         << radixKeys(tree.keysWithPrefix("romanesque")) << endl;
+    string queries[] = {"FC_3.weight.grad", "FC_3.bi", "FC_3", "FC_30.weight", "FC_", "rubicundusx"};
+    for (string query : queries) {
+        match = "";
+        value = tree.longestPrefixMatch(query, found, &match);
+        cout << "longestPrefixMatch(" << query << "): " << (found ? match + " -> " + to_string(value) : "none") << endl;
+    }
+    cout << "remove(rubens, 99): " << tree.remove("rubens", 99) << ", remove(rubens, 3): " << tree.remove("rubens", 3)
+         << ", containsKey(rubens): " << tree.containsKey("rubens") << ", containsValue(4): " << tree.containsValue(4) << endl;
+    tree.remove("FC_3");
+    cout << "remove FC_3: " << radixKeys(tree.keysWithPrefix("FC")) << endl;
+    RadixTree<int> copy(tree);
+    copy.remove("romane");
+    cout << "Copy: " << copy.size() << ", original: " << tree.size() << endl;
+    cout << "toString(rom): ";
+    RadixTree<int> small;
+    small.put("rom", 1);
+    small.put("roman", 2);
+    small.println();
+
+    // random keys over a small alphabet (many shared prefixes), checked against std::map
+    std::mt19937 engine(48);
+    RadixTree<int> random;
+    map<string, int> model;
+    ok = true;
+    for (int i = 0; i < 5000; i++) {
+        string key = "";
+        int length = (int)(engine() % 6);
+        for (int c = 0; c < length; c++) key += (char)('a' + engine() % 3);
+        if (engine() % 3 == 0) {
+            bool present = model.erase(key) > 0;
+            ok = ok && random.containsKey(key) == present;
+            if (present) random.remove(key);
+        } else {
+            random.put(key, i);
+            model[key] = i;
+        }
+    }
+    ok = ok && random.size() == (int)model.size();
+    map<string, int>::iterator expected = model.begin();
+    for (RadixTree<int>::Iterator it = random.begin(); it != random.end() && ok; ++it, ++expected) {
+        ok = expected != model.end() && it.key() == expected->first && it.value() == expected->second;
+    }
+    int prefixed = 0;
+    for (RadixTree<int>::Iterator it = random.withPrefix("ab").begin(); it != random.end(); ++it) prefixed++;
+    int expectedPrefixed = 0;
+    for (map<string, int>::iterator it = model.begin(); it != model.end(); ++it) expectedPrefixed += it->first.compare(0, 2, "ab") == 0;
+    cout << "5000 random operations: size " << random.size() << " (" << model.size() << "), in key order: "
+         << (ok ? "ok" : "BROKEN") << ", withPrefix(ab): " << prefixed << " (" << expectedPrefixed << ")" << endl;
+    for (map<string, int>::iterator it = model.begin(); it != model.end(); ++it) random.remove(it->first);
+    cout << "All removed: size " << random.size() << ", " << random.toString() << endl;
+}
+
+void runDemo() {
+    cout << "Demo: BPlusTree" << endl;
+    SmallBPlus tree;
+    for (int key = 1; key <= 10; key++) tree.add(key * 3);
+    tree.println();
+}
+
+// pointer function to store tests
+void (*testFuncs[])() = {
+    test1, test2, test3, test4, test5, test6
+};
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2) {
+        if (string(argv[1]) == "?help") {
+            printUsage();
+            return 0;
+        }
+        else
+        if (string(argv[1]) == "demo") {
+            string file_name = "DemoLog.txt";
+            fstream file_demo(file_name, ios::out);
+            if (!file_demo.is_open()) {
+                std::cout << "Cannot open file" << std::endl;
+                return 0;
+            } 
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file_demo.rdbuf());
+
+            runDemo();
+
+            cout.rdbuf(stream_buffer_cout);
+            return 0;
+        }
+        else if (string(argv[1]) == "test")
+        {
+            string folder = "TestLog/Tree";
+            string path = "TreeTestLog_NhanOutput.txt";
+            string output = "TreeTestLog_YourOutput.txt";
+            fstream file(folder + "/" + output, ios::out);
+            if (!file.is_open()) {
+                fs::create_directory(folder);
+                std::cout << "Create folder " << fs::absolute(folder) << std::endl;
+                file.open(folder + "/" + output, ios::out);
+            }
+            //change cout to file
+            streambuf* stream_buffer_cout = cout.rdbuf();
+            cout.rdbuf(file.rdbuf());
+
+            if (string(argv[1]) == "test") {
+                if (argc == 2) {
+                    for (int i = 0; i < num_task; i++) {
+                        std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                        testFuncs[i]();
+                    }
+                } else
+                if (argc == 3) {
+                    int task = stoi(argv[2]);
+                    if (task >= 1 && task <= num_task) {
+                        std::cout << "Task " << task << "---------------------------------------------------" <<std::endl;
+                        testFuncs[task - 1]();
+                    } else {
+                        std::cout << "Task not found" << std::endl;
+                    }
+                } else
+                if (argc == 4) {
+                    int start = stoi(argv[2]);
+                    int end = stoi(argv[3]);
+                    if (start >= 1 && start <= num_task && end >= 1 && end <= num_task && start <= end) {
+                        for (int i = start - 1; i < end; i++) {
+                            std::cout << "Task " << i + 1 << "---------------------------------------------------" <<std::endl;
+                            testFuncs[i]();
+                        }
+                    } else {
+                        std::cout << "Task not found or you enter error" << std::endl;
+                    }
+                }
+            }
+
+            // Restore cout
+            cout.rdbuf(stream_buffer_cout);
+            compareFile(folder + "/" + path, folder + "/" + output);
+        }
+    }
+    return 0;
+}
\ No newline at end of file